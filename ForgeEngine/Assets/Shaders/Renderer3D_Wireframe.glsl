@@ -13,13 +13,16 @@ layout(std140, binding = 0) uniform Camera
 };
 
 uniform mat4 u_Transform;
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
 uniform int u_EntityID; // ← ADICIONADO: Uniform para entity ID
 
 layout(location = 0) out flat int v_EntityID;
 
 void main()
 {
-    vec4 worldPosition = u_Transform * vec4(a_Position, 1.0);
+    vec3 position = a_Position * u_PositionScale + u_PositionOffset;
+    vec4 worldPosition = u_Transform * vec4(position, 1.0);
     gl_Position = u_ViewProjection * worldPosition;
 
     v_EntityID = u_EntityID;
@@ -7,11 +7,18 @@
 #include "Core/Log/Felog.h"
 #include "Core/TimeStep.h"
 #include "Core/Time.h"
+#include "Core/Debug/FlightRecorder.h"
+#include "Core/Debug/FrameTelemetry.h"
 #include "Core/Debug/Instrumentor.h"
+#include "Core/Debug/SamplingProfiler.h"
 #include "Core/Input/Input.h"
 #include "Core/Event/Event.h"
 #include "Core/Event/WindowApplicationEvent.h"
+#include "Core/Renderer/GpuProfiler.h"
 #include "Core/Renderer/Renderer3D.h"
+#include "Core/Renderer/TextureStreamer.h"
+#include "Core/System/CpuInfo.h"
+#include "Core/Threading/JobSystem.h"
 #include "../UI/Editor/MainUI.h"
 // #include "Core/Renderer/Renderer3D.h"
 
@@ -25,6 +32,9 @@ namespace ForgeEngine {
     FENGINE_CORE_ASSERT(!instance_, "Application already exists!");
     instance_ = this;
 
+    // Detected once here, every SIMD kernel dispatches on the cached result
+    CpuInfo::Log();
+
     // Set working directory here
     if (!specification_.WorkingDirectory.empty())
       std::filesystem::current_path(specification_.WorkingDirectory);
@@ -32,7 +42,12 @@ namespace ForgeEngine {
     window_ = Window::Create(WindowProps(specification_.Name,specification_.WindowWidth, specification_.WindowHeight));
     window_->SetEventCallback(FENGINE_BIND_EVENT_FN(Application::OnEvent));
 
+    log_messages_counter_ = FrameTelemetry::RegisterCounter("Log Messages");
+
+    JobSystem::Init();
     Renderer3D::Init();
+    if (specification_.EnableFlightRecorder)
+      FlightRecorder::Init(specification_.FlightRecording);
 
     imgui_layer_ = new ImGuiLayer();
     main_ui_layer_ = new MainUI();
@@ -44,7 +59,10 @@ namespace ForgeEngine {
     FENGINE_PROFILE_FUNCTION();
 
     //ScriptEngine::Shutdown();
+    SamplingProfiler::Stop();
+    FlightRecorder::Shutdown();
     Renderer3D::Shutdown();
+    JobSystem::Shutdown();
   }
 
   void Application::PushLayer(Layer *layer) {
@@ -66,7 +84,7 @@ namespace ForgeEngine {
   }
 
   void Application::SubmitToMainThread(const std::function<void()> &function) {
-    std::scoped_lock<std::mutex> lock(main_thread_queue_mutex_);
+    ForgeLockGuard lock(main_thread_queue_mutex_);
 
     main_thread_queue_.emplace_back(function);
   }
@@ -98,6 +116,19 @@ namespace ForgeEngine {
 
       ExecuteMainThreadQueue();
 
+      if (TextureStreamer *streamer = TextureStreamer::Get()) {
+        FENGINE_PROFILE_SCOPE("TextureStreamer ProcessUploads");
+        streamer->ProcessUploads();
+      }
+
+      GpuProfiler *gpuProfiler = GpuProfiler::Get();
+      if (gpuProfiler)
+        gpuProfiler->BeginFrame();
+
+      FrameRecord frame;
+      frame.FrameMs = timestep.GetMilliseconds();
+      Time phaseTimer;
+
       if (!minimized_) {
         {
           FENGINE_PROFILE_SCOPE("LayerStack OnUpdate");
@@ -105,6 +136,8 @@ namespace ForgeEngine {
           for (Layer *layer: layer_stack_)
             layer->OnUpdate(timestep);
         }
+        frame.UpdateMs = phaseTimer.ElapsedMillis();
+        phaseTimer.Reset();
 
         imgui_layer_->Begin(); {
           FENGINE_PROFILE_SCOPE("LayerStack OnImGuiRender");
@@ -113,9 +146,18 @@ namespace ForgeEngine {
             layer->OnImGuiRender();
         }
         imgui_layer_->End();
+        frame.RenderMs = phaseTimer.ElapsedMillis();
+        phaseTimer.Reset();
       }
 
+      if (gpuProfiler)
+        gpuProfiler->EndFrame();
+
       window_->OnUpdate();
+      frame.SwapMs = phaseTimer.ElapsedMillis();
+
+      SubmitFrameTelemetry(frame);
+      SamplingProfiler::EndFrame();
     }
   }
 
@@ -145,6 +187,12 @@ namespace ForgeEngine {
         {
           FENGINE_CORE_INFO("Escape key was pressed!");
           Application::Close();
+          break;
+        }
+      case Key::F9:
+        {
+          FlightRecorder::Trigger("Capture requested (F9)");
+          break;
         }
     }
 
@@ -153,11 +201,33 @@ namespace ForgeEngine {
 
 
   void Application::ExecuteMainThreadQueue() {
-    std::scoped_lock<std::mutex> lock(main_thread_queue_mutex_);
+    ForgeLockGuard lock(main_thread_queue_mutex_);
 
     for (auto &func: main_thread_queue_)
       func();
 
     main_thread_queue_.clear();
   }
+
+  void Application::SubmitFrameTelemetry(FrameRecord &frame) {
+    Renderer3D::Statistics stats = Renderer3D::GetStats();
+    frame.DrawCalls = stats.DrawCalls;
+    frame.Instances = stats.TotalInstances;
+    frame.VisibleObjects = stats.VisibleMeshCount;
+    frame.CulledObjects = stats.CulledMeshCount;
+
+    GpuProfiler *gpuProfiler = GpuProfiler::Get();
+    if (gpuProfiler && gpuProfiler->IsEnabled()) {
+      const GpuFrameTimings &gpuFrame = gpuProfiler->GetLatestFrame();
+      if (!gpuFrame.Scopes.empty())
+        frame.GpuMs = (float)gpuFrame.TotalMs;
+    }
+
+    uint64_t logMessages = Felog::GetStats().Messages;
+    FrameTelemetry::SetCounter(log_messages_counter_, (float)(logMessages - log_messages_last_));
+    log_messages_last_ = logMessages;
+
+    FrameTelemetry::Submit(frame);
+    FlightRecorder::OnFrame(frame);
+  }
 }
@@ -6,12 +6,15 @@
 #include "Core/Imgui/ImguiLayer.h"
 #include "Core/Layer/Layer.h"
 #include "Core/Layer/LayerStack.h"
+#include "Core/Debug/FlightRecorder.h"
+#include "Core/Threading/ForgeMutex.h"
 
 
 using namespace std;
 
 namespace ForgeEngine {
   class MainUI;
+  struct FrameRecord;
 
   struct ApplicationCommandLineArgs {
     int Count = 0;
@@ -29,6 +32,10 @@ namespace ForgeEngine {
     uint32_t WindowWidth = 1280;
     uint32_t WindowHeight = 720;
     ApplicationCommandLineArgs CommandLineArgs;
+    // Keeps the last seconds of profiling data and dumps them on slow
+    // frames or F9
+    bool EnableFlightRecorder = true;
+    FlightRecorderSpecification FlightRecording;
   };
 
   class Application {
@@ -67,6 +74,8 @@ namespace ForgeEngine {
     void ExecuteMainThreadQueue();
 
   private:
+    void SubmitFrameTelemetry(FrameRecord &frame);
+
     ApplicationSpecification specification_;
     Scope<Window> window_;
     ImGuiLayer *imgui_layer_;
@@ -75,9 +84,12 @@ namespace ForgeEngine {
     bool minimized_ = false;
     LayerStack layer_stack_;
     float last_frame_time_ = 0.0f;
+    // FrameTelemetry counter of the log calls made during a frame
+    uint32_t log_messages_counter_ = 0;
+    uint64_t log_messages_last_ = 0;
 
     vector<function<void()> > main_thread_queue_;
-    mutex main_thread_queue_mutex_;
+    ForgeMutex main_thread_queue_mutex_{"Main Thread Queue"};
 
   private:
     static Application *instance_;
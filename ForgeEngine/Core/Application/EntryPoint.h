@@ -1,22 +1,28 @@
 #pragma once
 #include "Core/Assert/Assert.h"
 #include "Core/Application/Application.h"
+#include "Core/Debug/SamplingProfiler.h"
 
 extern ForgeEngine::Application *ForgeEngine::CreateApplication(ApplicationCommandLineArgs args);
 
 int main(int argc, char **argv) {
   ForgeEngine::Felog::Init();
+  FENGINE_PROFILE_THREAD("Main");
+  ForgeEngine::SamplingProfiler::RegisterThread("Main");
 
-  FENGINE_PROFILE_BEGIN_SESSION("Startup", "Profile-Startup.json");
+  FENGINE_PROFILE_BEGIN_SESSION("Startup", "Profile-Startup.ftrace");
   auto app = ForgeEngine::CreateApplication({argc, argv});
   FENGINE_PROFILE_END_SESSION();
 
-  FENGINE_PROFILE_BEGIN_SESSION("Runtime", "Profile-Runtime.json");
+  FENGINE_PROFILE_BEGIN_SESSION("Runtime", "Profile-Runtime.ftrace");
   app->Run();
   FENGINE_PROFILE_END_SESSION();
 
-  FENGINE_PROFILE_BEGIN_SESSION("Shutdown", "Profile-Shutdown.json");
+  FENGINE_PROFILE_BEGIN_SESSION("Shutdown", "Profile-Shutdown.ftrace");
   delete app;
   FENGINE_PROFILE_END_SESSION();
+
+  ForgeEngine::SamplingProfiler::UnregisterThread();
+  ForgeEngine::Felog::Shutdown();
   return 0;
 }
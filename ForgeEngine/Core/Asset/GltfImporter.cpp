@@ -0,0 +1,992 @@
+#include "Core/Asset/GltfImporter.h"
+
+#include "FEPCH.h"
+#include "Core/Asset/Json.h"
+#include "Core/Asset/MeshOptimizer.h"
+#include "Core/Asset/MeshSimplifier.h"
+#include "Core/Asset/MeshletBuilder.h"
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Threading/JobSystem.h"
+#include "ThirdParty/stbimage/stb_image.h"
+
+#include <gtc/matrix_transform.hpp>
+#include <gtc/quaternion.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        static constexpr uint32_t GlbMagic = 0x46546C67;     // "glTF"
+        static constexpr uint32_t GlbJsonChunk = 0x4E4F534A; // "JSON"
+        static constexpr uint32_t GlbBinChunk = 0x004E4942;  // "BIN\0"
+
+        static constexpr uint32_t GltfTriangles = 4;
+
+        // Floats per vertex of the StandardVertex staging layout the importer
+        // decodes into (position, normal, tangent, uv). The GPU gets the
+        // quantized vertices, do not size buffers by this.
+        static constexpr uint32_t GltfVertexFloats = 11;
+
+        struct GltfBufferSpan
+        {
+            const uint8_t* Data = nullptr;
+            uint64_t Size = 0;
+        };
+
+        // Accessor resolved against its buffer view, Data is nullptr for
+        // accessors without a view (all zeros per the spec)
+        struct GltfAccessor
+        {
+            const uint8_t* Data = nullptr;
+            uint32_t Count = 0;
+            uint32_t ComponentType = 0;
+            uint32_t Components = 0;
+            uint32_t Stride = 0;
+            bool Normalized = false;
+        };
+
+        struct GltfPrimitiveJob
+        {
+            uint32_t Mesh = 0;
+            uint32_t Primitive = 0;
+            glm::mat4 Transform = glm::mat4(1.0f);
+        };
+
+        struct GltfDecodedPrimitive
+        {
+            std::vector<float> Vertices;
+            std::vector<uint32_t> Indices;
+            int32_t Material = -1;
+            bool Valid = false;
+            MeshOptimizationStats Optimization;
+            std::vector<MeshLodLevel> Lods;
+            // Empty for primitives too small to cluster
+            MeshletData Meshlets;
+        };
+
+        struct GltfDecodedImage
+        {
+            std::vector<uint8_t> Pixels;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+        };
+
+        static float MillisecondsSince(std::chrono::steady_clock::time_point& start)
+        {
+            auto now = std::chrono::steady_clock::now();
+            float ms = std::chrono::duration<float, std::milli>(now - start).count();
+            start = now;
+            return ms;
+        }
+
+        static bool HasExtension(const std::string& path, const char* extension)
+        {
+            std::string ext = std::filesystem::path(path).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                           [](unsigned char c) { return (char)std::tolower(c); });
+            return ext == extension;
+        }
+
+        static bool DecodeBase64(std::string_view text, std::vector<uint8_t>& out)
+        {
+            auto value = [](char c) -> int {
+                if (c >= 'A' && c <= 'Z')
+                    return c - 'A';
+                if (c >= 'a' && c <= 'z')
+                    return c - 'a' + 26;
+                if (c >= '0' && c <= '9')
+                    return c - '0' + 52;
+                if (c == '+' || c == '-')
+                    return 62;
+                if (c == '/' || c == '_')
+                    return 63;
+                return -1;
+            };
+
+            out.clear();
+            out.reserve(text.size() / 4 * 3);
+
+            uint32_t bits = 0;
+            int32_t bitCount = 0;
+            for (char c : text)
+            {
+                if (c == '=')
+                    break;
+
+                int v = value(c);
+                if (v < 0)
+                    return false;
+
+                bits = (bits << 6) | (uint32_t)v;
+                bitCount += 6;
+                if (bitCount >= 8)
+                {
+                    bitCount -= 8;
+                    out.push_back((uint8_t)(bits >> bitCount));
+                }
+            }
+            return true;
+        }
+
+        // Relative URIs may be percent encoded ("my%20mesh.bin")
+        static std::string DecodeUri(const std::string& uri)
+        {
+            std::string out;
+            out.reserve(uri.size());
+            for (size_t i = 0; i < uri.size(); i++)
+            {
+                if (uri[i] == '%' && i + 2 < uri.size()
+                    && std::isxdigit((unsigned char)uri[i + 1])
+                    && std::isxdigit((unsigned char)uri[i + 2]))
+                {
+                    out += (char)std::stoi(uri.substr(i + 1, 2), nullptr, 16);
+                    i += 2;
+                }
+                else
+                {
+                    out += uri[i];
+                }
+            }
+            return out;
+        }
+
+        static bool IsDataUri(const std::string& uri)
+        {
+            return uri.compare(0, 5, "data:") == 0;
+        }
+
+        static bool DecodeDataUri(const std::string& uri, std::vector<uint8_t>& out)
+        {
+            size_t comma = uri.find(',');
+            if (comma == std::string::npos
+                || uri.rfind(";base64", comma) == std::string::npos)
+                return false;
+            return DecodeBase64(std::string_view(uri).substr(comma + 1), out);
+        }
+
+        static uint32_t ComponentSize(uint32_t componentType)
+        {
+            switch (componentType)
+            {
+            case 5120: // BYTE
+            case 5121: // UNSIGNED_BYTE
+                return 1;
+            case 5122: // SHORT
+            case 5123: // UNSIGNED_SHORT
+                return 2;
+            case 5125: // UNSIGNED_INT
+            case 5126: // FLOAT
+                return 4;
+            }
+            return 0;
+        }
+
+        static uint32_t ComponentCount(const std::string& type)
+        {
+            if (type == "SCALAR")
+                return 1;
+            if (type == "VEC2")
+                return 2;
+            if (type == "VEC3")
+                return 3;
+            if (type == "VEC4" || type == "MAT2")
+                return 4;
+            if (type == "MAT3")
+                return 9;
+            if (type == "MAT4")
+                return 16;
+            return 0;
+        }
+
+        // Resolves a buffer view to a byte range, nullptr data on failure
+        static GltfBufferSpan ResolveBufferView(
+            const JsonValue& document, const std::vector<GltfBufferSpan>& buffers,
+            uint32_t viewIndex)
+        {
+            const JsonValue& view = document["bufferViews"][viewIndex];
+            uint32_t buffer = view["buffer"].AsUInt(UINT32_MAX);
+            uint64_t offset = view["byteOffset"].AsUInt(0);
+            uint64_t length = view["byteLength"].AsUInt(0);
+
+            if (buffer >= buffers.size() || !buffers[buffer].Data
+                || offset > buffers[buffer].Size
+                || length > buffers[buffer].Size - offset)
+                return {};
+
+            return { buffers[buffer].Data + offset, length };
+        }
+
+        static bool ResolveAccessor(const JsonValue& document,
+                                    const std::vector<GltfBufferSpan>& buffers,
+                                    uint32_t index, GltfAccessor& out)
+        {
+            const JsonValue& accessor = document["accessors"][index];
+            if (!accessor.IsObject())
+                return false;
+
+            if (accessor.Contains("sparse"))
+            {
+                FENGINE_CORE_WARN("Sparse glTF accessors are not supported "
+                                  "(accessor {})", index);
+                return false;
+            }
+
+            out.Count = accessor["count"].AsUInt(0);
+            out.ComponentType = accessor["componentType"].AsUInt(0);
+            out.Components = ComponentCount(accessor["type"].AsString());
+            out.Normalized = accessor["normalized"].AsBool(false);
+
+            uint32_t elementSize = ComponentSize(out.ComponentType) * out.Components;
+            if (elementSize == 0)
+                return false;
+
+            if (!accessor.Contains("bufferView"))
+            {
+                out.Data = nullptr;
+                out.Stride = elementSize;
+                return true;
+            }
+
+            uint32_t viewIndex = accessor["bufferView"].AsUInt(UINT32_MAX);
+            GltfBufferSpan view = ResolveBufferView(document, buffers, viewIndex);
+            if (!view.Data)
+                return false;
+
+            out.Stride = document["bufferViews"][viewIndex]["byteStride"].AsUInt(0);
+            if (out.Stride == 0)
+                out.Stride = elementSize;
+
+            uint64_t offset = accessor["byteOffset"].AsUInt(0);
+            uint64_t required = out.Count == 0
+                ? 0
+                : offset + (uint64_t)out.Stride * (out.Count - 1) + elementSize;
+            if (required > view.Size)
+                return false;
+
+            out.Data = view.Data + offset;
+            return true;
+        }
+
+        // Reads up to 4 components of element i as floats, applying the
+        // normalized integer conversions from the spec
+        static void ReadFloats(const GltfAccessor& accessor, uint32_t i, float* out,
+                               uint32_t count)
+        {
+            count = std::min(count, accessor.Components);
+            if (!accessor.Data)
+            {
+                for (uint32_t c = 0; c < count; c++)
+                    out[c] = 0.0f;
+                return;
+            }
+
+            const uint8_t* element = accessor.Data + (size_t)i * accessor.Stride;
+            for (uint32_t c = 0; c < count; c++)
+            {
+                switch (accessor.ComponentType)
+                {
+                case 5126:
+                    std::memcpy(&out[c], element + c * 4, 4);
+                    break;
+                case 5120:
+                {
+                    float v = (float)((const int8_t*)element)[c];
+                    out[c] = accessor.Normalized ? std::max(v / 127.0f, -1.0f) : v;
+                    break;
+                }
+                case 5121:
+                {
+                    float v = (float)element[c];
+                    out[c] = accessor.Normalized ? v / 255.0f : v;
+                    break;
+                }
+                case 5122:
+                {
+                    int16_t s;
+                    std::memcpy(&s, element + c * 2, 2);
+                    out[c] = accessor.Normalized ? std::max(s / 32767.0f, -1.0f)
+                                                 : (float)s;
+                    break;
+                }
+                case 5123:
+                {
+                    uint16_t s;
+                    std::memcpy(&s, element + c * 2, 2);
+                    out[c] = accessor.Normalized ? s / 65535.0f : (float)s;
+                    break;
+                }
+                case 5125:
+                {
+                    uint32_t s;
+                    std::memcpy(&s, element + c * 4, 4);
+                    out[c] = (float)s;
+                    break;
+                }
+                }
+            }
+        }
+
+        static uint32_t ReadIndex(const GltfAccessor& accessor, uint32_t i)
+        {
+            if (!accessor.Data)
+                return 0;
+
+            const uint8_t* element = accessor.Data + (size_t)i * accessor.Stride;
+            switch (accessor.ComponentType)
+            {
+            case 5121:
+                return *element;
+            case 5123:
+            {
+                uint16_t index;
+                std::memcpy(&index, element, 2);
+                return index;
+            }
+            case 5125:
+            {
+                uint32_t index;
+                std::memcpy(&index, element, 4);
+                return index;
+            }
+            }
+            return 0;
+        }
+
+        static glm::mat4 NodeLocalTransform(const JsonValue& node)
+        {
+            const JsonValue& matrix = node["matrix"];
+            if (matrix.Size() == 16)
+            {
+                glm::mat4 result;
+                for (uint32_t i = 0; i < 16; i++)
+                    result[i / 4][i % 4] = matrix[i].AsFloat();
+                return result;
+            }
+
+            const JsonValue& t = node["translation"];
+            const JsonValue& r = node["rotation"];
+            const JsonValue& s = node["scale"];
+
+            glm::vec3 translation(t[0].AsFloat(), t[1].AsFloat(), t[2].AsFloat());
+            glm::quat rotation(r[3].AsFloat(1.0f), r[0].AsFloat(), r[1].AsFloat(),
+                               r[2].AsFloat());
+            glm::vec3 scale(s[0].AsFloat(1.0f), s[1].AsFloat(1.0f),
+                            s[2].AsFloat(1.0f));
+
+            return glm::translate(glm::mat4(1.0f), translation)
+                * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+        }
+
+        // Any unit vector perpendicular to n
+        static glm::vec3 PerpendicularTo(const glm::vec3& n)
+        {
+            glm::vec3 axis = std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f)
+                                                  : glm::vec3(0.0f, 1.0f, 0.0f);
+            return glm::normalize(glm::cross(n, axis));
+        }
+
+        static void DecodePrimitive(const JsonValue& document,
+                                    const std::vector<GltfBufferSpan>& buffers,
+                                    const GltfPrimitiveJob& job,
+                                    GltfDecodedPrimitive& out)
+        {
+            const JsonValue& primitive
+                = document["meshes"][job.Mesh]["primitives"][job.Primitive];
+            const JsonValue& attributes = primitive["attributes"];
+
+            if (primitive["mode"].AsUInt(GltfTriangles) != GltfTriangles)
+            {
+                FENGINE_CORE_WARN("Skipping glTF mesh {} primitive {}: only "
+                                  "triangle lists are supported", job.Mesh,
+                                  job.Primitive);
+                return;
+            }
+
+            GltfAccessor positions;
+            if (!attributes.Contains("POSITION")
+                || !ResolveAccessor(document, buffers,
+                                    attributes["POSITION"].AsUInt(), positions)
+                || positions.Components != 3)
+            {
+                FENGINE_CORE_WARN("Skipping glTF mesh {} primitive {}: missing "
+                                  "or invalid positions", job.Mesh, job.Primitive);
+                return;
+            }
+
+            uint32_t vertexCount = positions.Count;
+
+            // Optional attributes are dropped when they do not match the
+            // position count instead of failing the whole primitive
+            auto optional = [&](const char* name, uint32_t components,
+                                GltfAccessor& accessor) {
+                return attributes.Contains(name)
+                    && ResolveAccessor(document, buffers,
+                                       attributes[name].AsUInt(), accessor)
+                    && accessor.Count == vertexCount
+                    && accessor.Components >= components;
+            };
+
+            GltfAccessor normals, tangents, texCoords;
+            bool hasNormals = optional("NORMAL", 3, normals);
+            bool hasTangents = optional("TANGENT", 3, tangents);
+            bool hasTexCoords = optional("TEXCOORD_0", 2, texCoords);
+
+            // Indices
+            if (primitive.Contains("indices"))
+            {
+                GltfAccessor indices;
+                if (!ResolveAccessor(document, buffers,
+                                     primitive["indices"].AsUInt(), indices)
+                    || indices.Components != 1)
+                {
+                    FENGINE_CORE_WARN("Skipping glTF mesh {} primitive {}: "
+                                      "invalid indices", job.Mesh, job.Primitive);
+                    return;
+                }
+
+                out.Indices.resize(indices.Count);
+                for (uint32_t i = 0; i < indices.Count; i++)
+                {
+                    out.Indices[i] = ReadIndex(indices, i);
+                    if (out.Indices[i] >= vertexCount)
+                    {
+                        FENGINE_CORE_WARN("Skipping glTF mesh {} primitive {}: "
+                                          "index out of range", job.Mesh,
+                                          job.Primitive);
+                        out.Indices.clear();
+                        return;
+                    }
+                }
+            }
+            else
+            {
+                out.Indices.resize(vertexCount);
+                for (uint32_t i = 0; i < vertexCount; i++)
+                    out.Indices[i] = i;
+            }
+
+            out.Indices.resize(out.Indices.size() / 3 * 3);
+
+            // A mirroring transform flips the winding
+            glm::mat3 linear(job.Transform);
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+            if (glm::determinant(linear) < 0.0f)
+            {
+                for (size_t i = 0; i < out.Indices.size(); i += 3)
+                    std::swap(out.Indices[i + 1], out.Indices[i + 2]);
+            }
+
+            std::vector<glm::vec3> position(vertexCount);
+            std::vector<glm::vec3> normal(vertexCount, glm::vec3(0.0f));
+            std::vector<glm::vec3> tangent(vertexCount, glm::vec3(0.0f));
+            std::vector<glm::vec2> uv(vertexCount, glm::vec2(0.0f));
+
+            for (uint32_t i = 0; i < vertexCount; i++)
+            {
+                float p[3];
+                ReadFloats(positions, i, p, 3);
+                position[i] = glm::vec3(job.Transform * glm::vec4(p[0], p[1], p[2], 1.0f));
+
+                if (hasNormals)
+                {
+                    float n[3];
+                    ReadFloats(normals, i, n, 3);
+                    normal[i] = normalMatrix * glm::vec3(n[0], n[1], n[2]);
+                }
+
+                if (hasTangents)
+                {
+                    float t[3];
+                    ReadFloats(tangents, i, t, 3);
+                    tangent[i] = linear * glm::vec3(t[0], t[1], t[2]);
+                }
+
+                if (hasTexCoords)
+                {
+                    // glTF puts the uv origin at the top left, our images are
+                    // flipped on load so v points up
+                    float t[2];
+                    ReadFloats(texCoords, i, t, 2);
+                    uv[i] = glm::vec2(t[0], 1.0f - t[1]);
+                }
+            }
+
+            // Area weighted face normals
+            if (!hasNormals)
+            {
+                for (size_t i = 0; i < out.Indices.size(); i += 3)
+                {
+                    uint32_t a = out.Indices[i], b = out.Indices[i + 1],
+                             c = out.Indices[i + 2];
+                    glm::vec3 face = glm::cross(position[b] - position[a],
+                                                position[c] - position[a]);
+                    normal[a] += face;
+                    normal[b] += face;
+                    normal[c] += face;
+                }
+            }
+
+            // Per triangle uv derivatives accumulated per vertex (Lengyel)
+            if (!hasTangents && hasTexCoords)
+            {
+                for (size_t i = 0; i < out.Indices.size(); i += 3)
+                {
+                    uint32_t a = out.Indices[i], b = out.Indices[i + 1],
+                             c = out.Indices[i + 2];
+                    glm::vec3 e1 = position[b] - position[a];
+                    glm::vec3 e2 = position[c] - position[a];
+                    glm::vec2 d1 = uv[b] - uv[a];
+                    glm::vec2 d2 = uv[c] - uv[a];
+
+                    float det = d1.x * d2.y - d2.x * d1.y;
+                    if (std::abs(det) < 1e-12f)
+                        continue;
+
+                    glm::vec3 t = (e1 * d2.y - e2 * d1.y) / det;
+                    tangent[a] += t;
+                    tangent[b] += t;
+                    tangent[c] += t;
+                }
+            }
+
+            out.Vertices.resize((size_t)vertexCount * GltfVertexFloats);
+            for (uint32_t i = 0; i < vertexCount; i++)
+            {
+                glm::vec3 n = glm::length(normal[i]) > 0.0f ? glm::normalize(normal[i])
+                                                            : glm::vec3(0.0f, 1.0f, 0.0f);
+
+                // Gram-Schmidt against the normal, degenerate uv mappings get
+                // an arbitrary but valid basis
+                glm::vec3 t = tangent[i] - n * glm::dot(n, tangent[i]);
+                t = glm::length(t) > 1e-6f ? glm::normalize(t) : PerpendicularTo(n);
+
+                float* vertex = &out.Vertices[(size_t)i * GltfVertexFloats];
+                vertex[0] = position[i].x;
+                vertex[1] = position[i].y;
+                vertex[2] = position[i].z;
+                vertex[3] = n.x;
+                vertex[4] = n.y;
+                vertex[5] = n.z;
+                vertex[6] = t.x;
+                vertex[7] = t.y;
+                vertex[8] = t.z;
+                vertex[9] = uv[i].x;
+                vertex[10] = uv[i].y;
+            }
+
+            // Exporters rarely care about the post-transform cache
+            out.Optimization = MeshOptimizer::Optimize(
+                out.Vertices.data(), vertexCount, GltfVertexFloats * sizeof(float), 0,
+                out.Indices.data(), out.Indices.size());
+            out.Vertices.resize((size_t)vertexCount * GltfVertexFloats);
+
+            out.Lods = MeshSimplifier::GenerateLods(
+                out.Indices.data(), out.Indices.size(), out.Vertices.data(), vertexCount,
+                GltfVertexFloats * sizeof(float), 0);
+
+            // LOD 0 is drawn in clusters, its indices come from the meshlets
+            if (out.Indices.size() / 3 >= Mesh::MinMeshletTriangles)
+                out.Meshlets = MeshletBuilder::Build(
+                    out.Indices.data(), out.Indices.size(), out.Vertices.data(),
+                    vertexCount, GltfVertexFloats * sizeof(float), 0);
+
+            if (primitive.Contains("material"))
+                out.Material = (int32_t)primitive["material"].AsUInt();
+            out.Valid = !out.Indices.empty();
+        }
+    } // namespace Utils
+
+    Ref<Model> GltfImporter::Import(const std::string& path, GltfImportStats* stats)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        GltfImportStats importStats;
+        auto importStart = std::chrono::steady_clock::now();
+        auto stageStart = importStart;
+
+        std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+        // Read: map the file, split .glb into its chunks
+        Scope<MappedFile> file = MappedFile::Open(path);
+        if (!file)
+            return nullptr;
+
+        std::string_view json;
+        Utils::GltfBufferSpan binChunk;
+
+        const uint8_t* bytes = file->GetData();
+        uint32_t magic = 0;
+        if (file->GetSize() >= 4)
+            std::memcpy(&magic, bytes, 4);
+
+        if (magic == Utils::GlbMagic)
+        {
+            uint32_t header[5] = {};
+            if (file->GetSize() >= sizeof(header))
+                std::memcpy(header, bytes, sizeof(header));
+
+            uint32_t version = header[1], length = header[2];
+            uint32_t jsonLength = header[3], jsonType = header[4];
+            if (version != 2 || length > file->GetSize()
+                || jsonType != Utils::GlbJsonChunk
+                || jsonLength > length - sizeof(header))
+            {
+                FENGINE_CORE_ERROR("'{}' is not a valid glTF 2.0 binary", path);
+                return nullptr;
+            }
+
+            json = std::string_view((const char*)bytes + sizeof(header), jsonLength);
+
+            // The BIN chunk is optional and referenced in place, chunks are
+            // 4 byte aligned by the spec
+            uint64_t binOffset = sizeof(header) + (uint64_t)jsonLength;
+            if (binOffset + 8 <= length)
+            {
+                uint32_t chunk[2];
+                std::memcpy(chunk, bytes + binOffset, sizeof(chunk));
+                if (chunk[1] == Utils::GlbBinChunk
+                    && chunk[0] <= length - binOffset - 8)
+                {
+                    binChunk.Data = bytes + binOffset + 8;
+                    binChunk.Size = chunk[0];
+                }
+            }
+        }
+        else
+        {
+            json = std::string_view((const char*)bytes, file->GetSize());
+        }
+
+        // Parse
+        importStats.ReadMs = Utils::MillisecondsSince(stageStart);
+
+        JsonValue document;
+        std::string error;
+        if (!JsonValue::Parse(json, document, &error))
+        {
+            FENGINE_CORE_ERROR("Failed to parse glTF '{}': {}", path, error);
+            return nullptr;
+        }
+
+        if (document["asset"]["version"].AsString().compare(0, 1, "2") != 0)
+        {
+            FENGINE_CORE_ERROR("'{}' is not a glTF 2.0 file", path);
+            return nullptr;
+        }
+
+        importStats.ParseMs = Utils::MillisecondsSince(stageStart);
+
+        // Buffers: the GLB chunk, external files (mapped) or data URIs
+        std::vector<Utils::GltfBufferSpan> buffers;
+        std::vector<Scope<MappedFile>> bufferFiles;
+        std::vector<std::vector<uint8_t>> bufferData;
+
+        const JsonValue& bufferList = document["buffers"];
+        buffers.resize(bufferList.Size());
+        for (uint32_t i = 0; i < bufferList.Size(); i++)
+        {
+            const JsonValue& buffer = bufferList[i];
+            uint64_t byteLength = buffer["byteLength"].AsUInt(0);
+            const std::string& uri = buffer["uri"].AsString();
+
+            Utils::GltfBufferSpan span;
+            if (uri.empty())
+            {
+                if (i == 0)
+                    span = binChunk;
+            }
+            else if (Utils::IsDataUri(uri))
+            {
+                bufferData.emplace_back();
+                if (Utils::DecodeDataUri(uri, bufferData.back()))
+                    span = { bufferData.back().data(), bufferData.back().size() };
+            }
+            else
+            {
+                std::string bufferPath = (directory / Utils::DecodeUri(uri)).string();
+                Scope<MappedFile> bufferFile = MappedFile::Open(bufferPath);
+                if (bufferFile)
+                {
+                    span = { bufferFile->GetData(), bufferFile->GetSize() };
+                    bufferFiles.push_back(std::move(bufferFile));
+                }
+            }
+
+            if (!span.Data || span.Size < byteLength)
+            {
+                FENGINE_CORE_ERROR("glTF '{}': buffer {} is missing or truncated",
+                                   path, i);
+                return nullptr;
+            }
+
+            span.Size = byteLength;
+            buffers[i] = span;
+        }
+
+        importStats.ReadMs += Utils::MillisecondsSince(stageStart);
+
+        // Flatten the default scene into (mesh, primitive, world transform)
+        std::vector<Utils::GltfPrimitiveJob> jobs;
+        const JsonValue& nodes = document["nodes"];
+        const JsonValue& meshes = document["meshes"];
+
+        std::vector<std::pair<uint32_t, glm::mat4>> stack;
+        const JsonValue& scene = document["scenes"][document["scene"].AsUInt(0)];
+        if (scene.IsObject())
+        {
+            for (const JsonValue& root : scene["nodes"].GetElements())
+                stack.emplace_back(root.AsUInt(UINT32_MAX), glm::mat4(1.0f));
+        }
+        else
+        {
+            // No scene: every mesh once, untransformed
+            for (uint32_t mesh = 0; mesh < meshes.Size(); mesh++)
+            {
+                for (uint32_t p = 0; p < meshes[mesh]["primitives"].Size(); p++)
+                    jobs.push_back({ mesh, p, glm::mat4(1.0f) });
+            }
+        }
+
+        // Guards against cyclic node graphs in broken files
+        uint32_t visited = 0;
+        while (!stack.empty() && visited++ <= nodes.Size())
+        {
+            auto [nodeIndex, parent] = stack.back();
+            stack.pop_back();
+
+            const JsonValue& node = nodes[nodeIndex];
+            if (!node.IsObject())
+                continue;
+
+            glm::mat4 world = parent * Utils::NodeLocalTransform(node);
+
+            if (node.Contains("mesh"))
+            {
+                uint32_t mesh = node["mesh"].AsUInt();
+                for (uint32_t p = 0; p < meshes[mesh]["primitives"].Size(); p++)
+                    jobs.push_back({ mesh, p, world });
+            }
+
+            for (const JsonValue& child : node["children"].GetElements())
+                stack.emplace_back(child.AsUInt(UINT32_MAX), world);
+        }
+
+        // Decode primitives on the workers, one job per primitive instance
+        std::vector<Utils::GltfDecodedPrimitive> primitives(jobs.size());
+        JobSystem::ParallelFor((uint32_t)jobs.size(), 1,
+                               [&](uint32_t begin, uint32_t end) {
+                                   FENGINE_PROFILE_SCOPE("GltfImporter DecodePrimitives");
+                                   for (uint32_t i = begin; i < end; i++)
+                                       Utils::DecodePrimitive(document, buffers,
+                                                              jobs[i], primitives[i]);
+                               });
+
+        importStats.DecodeMs = Utils::MillisecondsSince(stageStart);
+
+        // Only images referenced by a material are loaded
+        const JsonValue& materialList = document["materials"];
+        const JsonValue& textures = document["textures"];
+        const JsonValue& images = document["images"];
+
+        auto imageOf = [&](const JsonValue& textureInfo) -> uint32_t {
+            if (!textureInfo.IsObject())
+                return UINT32_MAX;
+            uint32_t image = textures[textureInfo["index"].AsUInt(UINT32_MAX)]["source"]
+                                 .AsUInt(UINT32_MAX);
+            return image < images.Size() ? image : UINT32_MAX;
+        };
+
+        std::vector<bool> imageUsed(images.Size(), false);
+        for (const JsonValue& material : materialList.GetElements())
+        {
+            uint32_t albedo = imageOf(material["pbrMetallicRoughness"]["baseColorTexture"]);
+            uint32_t normal = imageOf(material["normalTexture"]);
+            if (albedo != UINT32_MAX)
+                imageUsed[albedo] = true;
+            if (normal != UINT32_MAX)
+                imageUsed[normal] = true;
+        }
+
+        // External images go through the texture streamer, embedded ones
+        // (buffer views and data URIs) are decoded here on the workers
+        std::vector<Utils::GltfDecodedImage> decodedImages(images.Size());
+        JobSystem::ParallelFor(
+            (uint32_t)images.Size(), 1, [&](uint32_t begin, uint32_t end) {
+                FENGINE_PROFILE_SCOPE("GltfImporter DecodeImages");
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    const JsonValue& image = images[i];
+                    const std::string& uri = image["uri"].AsString();
+                    if (!imageUsed[i] || (!uri.empty() && !Utils::IsDataUri(uri)))
+                        continue;
+
+                    std::vector<uint8_t> encodedData;
+                    Utils::GltfBufferSpan encoded;
+                    if (!uri.empty())
+                    {
+                        if (Utils::DecodeDataUri(uri, encodedData))
+                            encoded = { encodedData.data(), encodedData.size() };
+                    }
+                    else
+                    {
+                        encoded = Utils::ResolveBufferView(
+                            document, buffers, image["bufferView"].AsUInt(UINT32_MAX));
+                    }
+
+                    int width, height, channels;
+                    stbi_uc* pixels = encoded.Data
+                        ? stbi_load_from_memory(encoded.Data, (int)encoded.Size,
+                                                &width, &height, &channels, 4)
+                        : nullptr;
+                    if (!pixels)
+                    {
+                        FENGINE_CORE_WARN("glTF '{}': could not decode image {}",
+                                          path, i);
+                        continue;
+                    }
+
+                    Utils::GltfDecodedImage& decoded = decodedImages[i];
+                    decoded.Width = (uint32_t)width;
+                    decoded.Height = (uint32_t)height;
+                    decoded.Pixels.assign(pixels, pixels + (size_t)width * height * 4);
+                    stbi_image_free(pixels);
+                }
+            });
+
+        importStats.ImageDecodeMs = Utils::MillisecondsSince(stageStart);
+
+        // Upload: textures, materials and meshes on the calling thread
+        std::vector<Ref<Texture2D>> imageTextures(images.Size());
+        for (uint32_t i = 0; i < images.Size(); i++)
+        {
+            if (!imageUsed[i])
+                continue;
+
+            const std::string& uri = images[i]["uri"].AsString();
+            const Utils::GltfDecodedImage& decoded = decodedImages[i];
+            if (!uri.empty() && !Utils::IsDataUri(uri))
+            {
+                imageTextures[i] = Texture2D::CreateAsync(
+                    (directory / Utils::DecodeUri(uri)).string());
+            }
+            else if (!decoded.Pixels.empty())
+            {
+                TextureSpecification specification;
+                specification.Width = decoded.Width;
+                specification.Height = decoded.Height;
+
+                imageTextures[i] = Texture2D::Create(specification);
+                imageTextures[i]->SetData((void*)decoded.Pixels.data(),
+                                          (uint32_t)decoded.Pixels.size());
+            }
+
+            if (imageTextures[i])
+                importStats.Textures++;
+        }
+
+        std::vector<Ref<Material>> materials;
+        materials.reserve(materialList.Size());
+        for (const JsonValue& source : materialList.GetElements())
+        {
+            const JsonValue& pbr = source["pbrMetallicRoughness"];
+            const JsonValue& color = pbr["baseColorFactor"];
+
+            Ref<Material> material = CreateRef<Material>();
+            material->SetAlbedoColor({ color[0].AsFloat(1.0f), color[1].AsFloat(1.0f),
+                                       color[2].AsFloat(1.0f), color[3].AsFloat(1.0f) });
+            material->SetMetallic(pbr["metallicFactor"].AsFloat(1.0f));
+            material->SetRoughness(pbr["roughnessFactor"].AsFloat(1.0f));
+
+            uint32_t albedo = imageOf(pbr["baseColorTexture"]);
+            if (albedo != UINT32_MAX)
+                material->SetAlbedoMap(imageTextures[albedo]);
+
+            uint32_t normal = imageOf(source["normalTexture"]);
+            if (normal != UINT32_MAX)
+                material->SetNormalMap(imageTextures[normal]);
+
+            materials.push_back(material);
+        }
+
+        // The decoded vertices are laid out exactly like StandardVertex
+        static_assert(sizeof(StandardVertex) == Utils::GltfVertexFloats * sizeof(float));
+
+        Ref<Model> model = CreateRef<Model>();
+        for (const Utils::GltfDecodedPrimitive& primitive : primitives)
+        {
+            if (!primitive.Valid)
+                continue;
+
+            uint32_t vertexCount = (uint32_t)(primitive.Vertices.size()
+                                              / Utils::GltfVertexFloats);
+
+            Ref<Mesh> mesh = CreateRef<Mesh>();
+            mesh->SetQuantizedVertices(
+                reinterpret_cast<const StandardVertex*>(primitive.Vertices.data()),
+                vertexCount);
+            if (primitive.Meshlets.Meshlets.empty())
+                mesh->SetIndices(primitive.Indices);
+            else
+                mesh->SetMeshlets(primitive.Meshlets);
+            for (const MeshLodLevel& lod : primitive.Lods)
+                mesh->AddLod(lod.Indices, lod.Error);
+
+            if (primitive.Material >= 0 && (size_t)primitive.Material < materials.size())
+                mesh->SetMaterial(materials[primitive.Material]);
+
+            model->AddMesh(mesh);
+
+            importStats.Primitives++;
+            importStats.Vertices += vertexCount;
+            importStats.Indices += primitive.Indices.size();
+            importStats.Lods += (uint32_t)primitive.Lods.size();
+            importStats.Meshlets += (uint32_t)primitive.Meshlets.Meshlets.size();
+
+            // Triangle weighted so big primitives dominate like they do on the GPU
+            const MeshOptimizationStats& optimization = primitive.Optimization;
+            importStats.ACMRBefore += optimization.Before.ACMR * optimization.Before.Triangles;
+            importStats.ACMRAfter += optimization.After.ACMR * optimization.After.Triangles;
+        }
+
+        if (importStats.Indices > 0)
+        {
+            importStats.ACMRBefore /= (float)(importStats.Indices / 3);
+            importStats.ACMRAfter /= (float)(importStats.Indices / 3);
+        }
+
+        importStats.UploadMs = Utils::MillisecondsSince(stageStart);
+        importStats.TotalMs = std::chrono::duration<float, std::milli>(
+                                  std::chrono::steady_clock::now() - importStart)
+                                  .count();
+        importStats.Meshes = (uint32_t)meshes.Size();
+        importStats.Materials = (uint32_t)materials.size();
+
+        FENGINE_CORE_INFO("Imported '{}': {} primitives, {} vertices, {} indices, "
+                          "{} materials, {} textures",
+                          path, importStats.Primitives, importStats.Vertices,
+                          importStats.Indices, importStats.Materials,
+                          importStats.Textures);
+        FENGINE_CORE_INFO("  read {:.2f} ms, parse {:.2f} ms, decode {:.2f} ms, "
+                          "images {:.2f} ms, upload {:.2f} ms, total {:.2f} ms",
+                          importStats.ReadMs, importStats.ParseMs,
+                          importStats.DecodeMs, importStats.ImageDecodeMs,
+                          importStats.UploadMs, importStats.TotalMs);
+        FENGINE_CORE_INFO("  vertex cache ACMR {:.3f} -> {:.3f}, {} LODs, {} meshlets",
+                          importStats.ACMRBefore, importStats.ACMRAfter,
+                          importStats.Lods, importStats.Meshlets);
+
+        if (stats)
+            *stats = importStats;
+
+        return model;
+    }
+
+    bool GltfImporter::IsGltfPath(const std::string& path)
+    {
+        return Utils::HasExtension(path, ".gltf") || Utils::HasExtension(path, ".glb");
+    }
+} // namespace ForgeEngine
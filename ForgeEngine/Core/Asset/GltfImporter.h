@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/Renderer/Mesh.h"
+#include <string>
+
+namespace ForgeEngine
+{
+    // Wall time of each import stage, in milliseconds, plus what was created
+    struct GltfImportStats
+    {
+        float ReadMs = 0.0f;        // mapping the file and its buffers
+        float ParseMs = 0.0f;       // JSON document
+        float DecodeMs = 0.0f;      // accessors, optimization, LODs, meshlets (workers)
+        float ImageDecodeMs = 0.0f; // embedded images (workers)
+        float UploadMs = 0.0f;      // GPU buffers and textures (main thread)
+        float TotalMs = 0.0f;
+
+        uint32_t Meshes = 0;
+        uint32_t Primitives = 0;
+        uint32_t Materials = 0;
+        uint32_t Textures = 0;
+        uint64_t Vertices = 0;
+        uint64_t Indices = 0;
+        uint32_t Lods = 0; // levels generated beyond LOD 0, all primitives
+        uint32_t Meshlets = 0;
+
+        // Simulated post-transform cache misses per triangle (FIFO 16),
+        // before and after the MeshOptimizer pass
+        float ACMRBefore = 0.0f;
+        float ACMRAfter = 0.0f;
+    };
+
+    // glTF 2.0 importer for .gltf and .glb files. Every triangle primitive
+    // instanced by the default scene becomes one Mesh with the engine layout
+    // (a_Position, a_Normal, a_Tangent, a_TexCoord); node transforms are baked
+    // into the vertices since Model is a flat list of meshes, and every
+    // primitive goes through the MeshOptimizer and gets an LOD chain from the
+    // MeshSimplifier, large ones are split into meshlets. Binary chunks
+    // and external buffers are memory mapped and read in place, primitives
+    // and embedded images are decoded on the JobSystem workers.
+    class GltfImporter
+    {
+    public:
+        // Must be called on the thread that owns the graphics context.
+        // Returns nullptr when the file cannot be read or is not valid glTF.
+        static Ref<Model> Import(const std::string& path,
+                                 GltfImportStats* stats = nullptr);
+
+        static bool IsGltfPath(const std::string& path);
+    };
+} // namespace ForgeEngine
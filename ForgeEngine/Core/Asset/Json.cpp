@@ -0,0 +1,344 @@
+#include "Core/Asset/Json.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ForgeEngine
+{
+    class JsonParser
+    {
+    public:
+        JsonParser(std::string_view text) : m_Text(text) {}
+
+        bool Parse(JsonValue& out, std::string* error)
+        {
+            bool ok = ParseValue(out, 0);
+            if (ok)
+            {
+                SkipWhitespace();
+                ok = m_Position == m_Text.size();
+            }
+
+            if (!ok && error)
+                *error = "invalid JSON at offset " + std::to_string(m_Position);
+            return ok;
+        }
+
+    private:
+        static constexpr uint32_t MaxDepth = 256;
+
+        void SkipWhitespace()
+        {
+            while (m_Position < m_Text.size()
+                   && (m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t'
+                       || m_Text[m_Position] == '\n'
+                       || m_Text[m_Position] == '\r'))
+                m_Position++;
+        }
+
+        bool Consume(char c)
+        {
+            SkipWhitespace();
+            if (m_Position < m_Text.size() && m_Text[m_Position] == c)
+            {
+                m_Position++;
+                return true;
+            }
+            return false;
+        }
+
+        bool ConsumeLiteral(const char* literal)
+        {
+            size_t length = std::strlen(literal);
+            if (m_Text.compare(m_Position, length, literal) != 0)
+                return false;
+            m_Position += length;
+            return true;
+        }
+
+        bool ParseValue(JsonValue& out, uint32_t depth)
+        {
+            if (depth > MaxDepth)
+                return false;
+
+            SkipWhitespace();
+            if (m_Position >= m_Text.size())
+                return false;
+
+            switch (m_Text[m_Position])
+            {
+            case '{':
+                return ParseObject(out, depth);
+            case '[':
+                return ParseArray(out, depth);
+            case '"':
+                out.m_Type = JsonValue::Type::String;
+                return ParseString(out.m_String);
+            case 't':
+                out.m_Type = JsonValue::Type::Bool;
+                out.m_Bool = true;
+                return ConsumeLiteral("true");
+            case 'f':
+                out.m_Type = JsonValue::Type::Bool;
+                out.m_Bool = false;
+                return ConsumeLiteral("false");
+            case 'n':
+                out.m_Type = JsonValue::Type::Null;
+                return ConsumeLiteral("null");
+            default:
+                return ParseNumber(out);
+            }
+        }
+
+        bool ParseObject(JsonValue& out, uint32_t depth)
+        {
+            out.m_Type = JsonValue::Type::Object;
+            m_Position++;
+
+            if (Consume('}'))
+                return true;
+
+            do
+            {
+                SkipWhitespace();
+                std::string key;
+                if (!ParseString(key) || !Consume(':'))
+                    return false;
+
+                out.m_Members.emplace_back(std::move(key), JsonValue());
+                if (!ParseValue(out.m_Members.back().second, depth + 1))
+                    return false;
+            } while (Consume(','));
+
+            return Consume('}');
+        }
+
+        bool ParseArray(JsonValue& out, uint32_t depth)
+        {
+            out.m_Type = JsonValue::Type::Array;
+            m_Position++;
+
+            if (Consume(']'))
+                return true;
+
+            do
+            {
+                out.m_Elements.emplace_back();
+                if (!ParseValue(out.m_Elements.back(), depth + 1))
+                    return false;
+            } while (Consume(','));
+
+            return Consume(']');
+        }
+
+        bool ParseHex(uint32_t& value)
+        {
+            if (m_Position + 4 > m_Text.size())
+                return false;
+
+            value = 0;
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                char c = m_Text[m_Position++];
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                    value |= c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    value |= c - 'A' + 10;
+                else
+                    return false;
+            }
+            return true;
+        }
+
+        static void AppendUtf8(std::string& out, uint32_t codepoint)
+        {
+            if (codepoint < 0x80)
+            {
+                out += (char)codepoint;
+            }
+            else if (codepoint < 0x800)
+            {
+                out += (char)(0xC0 | (codepoint >> 6));
+                out += (char)(0x80 | (codepoint & 0x3F));
+            }
+            else if (codepoint < 0x10000)
+            {
+                out += (char)(0xE0 | (codepoint >> 12));
+                out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                out += (char)(0x80 | (codepoint & 0x3F));
+            }
+            else
+            {
+                out += (char)(0xF0 | (codepoint >> 18));
+                out += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+                out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                out += (char)(0x80 | (codepoint & 0x3F));
+            }
+        }
+
+        bool ParseString(std::string& out)
+        {
+            if (m_Position >= m_Text.size() || m_Text[m_Position] != '"')
+                return false;
+            m_Position++;
+
+            while (m_Position < m_Text.size())
+            {
+                char c = m_Text[m_Position++];
+                if (c == '"')
+                    return true;
+
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+
+                if (m_Position >= m_Text.size())
+                    return false;
+
+                char escape = m_Text[m_Position++];
+                switch (escape)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    out += escape;
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u':
+                {
+                    uint32_t codepoint;
+                    if (!ParseHex(codepoint))
+                        return false;
+
+                    // Surrogate pair
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+                    {
+                        uint32_t low;
+                        if (!ConsumeLiteral("\\u") || !ParseHex(low)
+                            || low < 0xDC00 || low > 0xDFFF)
+                            return false;
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10)
+                            + (low - 0xDC00);
+                    }
+
+                    AppendUtf8(out, codepoint);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        bool ParseNumber(JsonValue& out)
+        {
+            const char* begin = m_Text.data() + m_Position;
+            size_t length = 0;
+            while (m_Position + length < m_Text.size()
+                   && std::strchr("+-0123456789.eE", m_Text[m_Position + length]))
+                length++;
+
+            if (length == 0)
+                return false;
+
+            // strtod needs a terminated buffer, numbers are short
+            std::string number(begin, length);
+            char* end = nullptr;
+            out.m_Type = JsonValue::Type::Number;
+            out.m_Number = std::strtod(number.c_str(), &end);
+            m_Position += length;
+            return end == number.c_str() + length;
+        }
+
+    private:
+        std::string_view m_Text;
+        size_t m_Position = 0;
+    };
+
+    static const JsonValue s_NullValue;
+    static const std::string s_EmptyString;
+
+    bool JsonValue::AsBool(bool fallback) const
+    {
+        return m_Type == Type::Bool ? m_Bool : fallback;
+    }
+
+    double JsonValue::AsNumber(double fallback) const
+    {
+        return m_Type == Type::Number ? m_Number : fallback;
+    }
+
+    uint32_t JsonValue::AsUInt(uint32_t fallback) const
+    {
+        return m_Type == Type::Number && m_Number >= 0.0 ? (uint32_t)m_Number
+                                                         : fallback;
+    }
+
+    const std::string& JsonValue::AsString() const
+    {
+        return m_Type == Type::String ? m_String : s_EmptyString;
+    }
+
+    size_t JsonValue::Size() const
+    {
+        if (m_Type == Type::Array)
+            return m_Elements.size();
+        if (m_Type == Type::Object)
+            return m_Members.size();
+        return 0;
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const
+    {
+        if (m_Type != Type::Array || index >= m_Elements.size())
+            return s_NullValue;
+        return m_Elements[index];
+    }
+
+    const JsonValue& JsonValue::operator[](std::string_view key) const
+    {
+        if (m_Type != Type::Object)
+            return s_NullValue;
+
+        for (const auto& [name, value] : m_Members)
+        {
+            if (name == key)
+                return value;
+        }
+        return s_NullValue;
+    }
+
+    bool JsonValue::Contains(std::string_view key) const
+    {
+        return !(*this)[key].IsNull();
+    }
+
+    bool JsonValue::Parse(std::string_view text, JsonValue& out,
+                          std::string* error)
+    {
+        out = JsonValue();
+        JsonParser parser(text);
+        return parser.Parse(out, error);
+    }
+} // namespace ForgeEngine
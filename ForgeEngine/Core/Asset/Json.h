@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Small read-only JSON document used by the asset importers. Lookups
+    // never fail: a missing key or index yields a null value, so chains like
+    // doc["meshes"][0]["name"] can be written without checks.
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            Null = 0,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        Type GetType() const { return m_Type; }
+        bool IsNull() const { return m_Type == Type::Null; }
+        bool IsNumber() const { return m_Type == Type::Number; }
+        bool IsString() const { return m_Type == Type::String; }
+        bool IsArray() const { return m_Type == Type::Array; }
+        bool IsObject() const { return m_Type == Type::Object; }
+
+        bool AsBool(bool fallback = false) const;
+        double AsNumber(double fallback = 0.0) const;
+        float AsFloat(float fallback = 0.0f) const { return (float)AsNumber(fallback); }
+        uint32_t AsUInt(uint32_t fallback = 0) const;
+        const std::string& AsString() const;
+
+        // Element count for arrays and objects, 0 otherwise
+        size_t Size() const;
+
+        const JsonValue& operator[](size_t index) const;
+        const JsonValue& operator[](std::string_view key) const;
+        bool Contains(std::string_view key) const; // present and not null
+
+        const std::vector<JsonValue>& GetElements() const { return m_Elements; }
+        const std::vector<std::pair<std::string, JsonValue>>& GetMembers() const { return m_Members; }
+
+        // Returns false and fills error (with the byte offset) on malformed input
+        static bool Parse(std::string_view text, JsonValue& out,
+                          std::string* error = nullptr);
+
+    private:
+        friend class JsonParser;
+
+        Type m_Type = Type::Null;
+        bool m_Bool = false;
+        double m_Number = 0.0;
+        std::string m_String;
+        std::vector<JsonValue> m_Elements;
+        std::vector<std::pair<std::string, JsonValue>> m_Members;
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,589 @@
+#include "Core/Asset/MeshOptimizer.h"
+
+#include "Core/Debug/Instrumentor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        // Forsyth's tuning values
+        static constexpr uint32_t ForsythCacheSize = 32;
+        static constexpr uint32_t ForsythMaxValence = 32;
+        static constexpr float ForsythCacheDecayPower = 1.5f;
+        static constexpr float ForsythLastTriangleScore = 0.75f;
+        static constexpr float ForsythValenceBoostScale = 2.0f;
+        static constexpr float ForsythValenceBoostPower = 0.5f;
+
+        // Cache assumed when placing the overdraw cluster boundaries
+        static constexpr uint32_t OverdrawCacheSize = 16;
+
+        struct ForsythTables
+        {
+            float Cache[ForsythCacheSize];
+            float Valence[ForsythMaxValence + 1];
+
+            ForsythTables()
+            {
+                for (uint32_t i = 0; i < ForsythCacheSize; i++)
+                {
+                    // The last triangle's vertices get a fixed score so the
+                    // next triangle does not just reuse them in the same order
+                    Cache[i] = i < 3
+                        ? ForsythLastTriangleScore
+                        : std::pow(1.0f - (float)(i - 3) / (ForsythCacheSize - 3),
+                                   ForsythCacheDecayPower);
+                }
+
+                Valence[0] = 0.0f;
+                for (uint32_t i = 1; i <= ForsythMaxValence; i++)
+                {
+                    Valence[i] = ForsythValenceBoostScale
+                        * std::pow((float)i, -ForsythValenceBoostPower);
+                }
+            }
+        };
+
+        static float ForsythVertexScore(const ForsythTables& tables,
+                                        int32_t cachePosition, uint32_t remaining)
+        {
+            // Nothing left to draw with this vertex
+            if (remaining == 0)
+                return -1.0f;
+
+            float score = cachePosition >= 0 ? tables.Cache[cachePosition] : 0.0f;
+            return score + tables.Valence[std::min(remaining, ForsythMaxValence)];
+        }
+
+        // Vertex -> triangle adjacency in CSR form
+        struct TriangleAdjacency
+        {
+            std::vector<uint32_t> Offsets;
+            std::vector<uint32_t> Counts;
+            std::vector<uint32_t> Triangles;
+
+            void Build(const uint32_t* indices, size_t indexCount,
+                       uint32_t vertexCount)
+            {
+                Offsets.assign(vertexCount + 1, 0);
+                Counts.assign(vertexCount, 0);
+                Triangles.resize(indexCount);
+
+                for (size_t i = 0; i < indexCount; i++)
+                    Counts[indices[i]]++;
+
+                for (uint32_t v = 0; v < vertexCount; v++)
+                    Offsets[v + 1] = Offsets[v] + Counts[v];
+
+                std::fill(Counts.begin(), Counts.end(), 0);
+                for (size_t i = 0; i < indexCount; i++)
+                {
+                    uint32_t v = indices[i];
+                    Triangles[Offsets[v] + Counts[v]++] = (uint32_t)(i / 3);
+                }
+            }
+        };
+
+        static void ReadPosition(const uint8_t* vertices, uint32_t stride,
+                                 uint32_t positionOffset, uint32_t index,
+                                 float* position)
+        {
+            std::memcpy(position,
+                        vertices + (size_t)index * stride + positionOffset,
+                        sizeof(float) * 3);
+        }
+
+        // Cache misses per triangle, used for the overdraw cluster boundaries
+        static void SimulateFifoMisses(const uint32_t* indices, size_t indexCount,
+                                       uint32_t vertexCount, uint32_t cacheSize,
+                                       std::vector<uint8_t>& misses)
+        {
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+
+            misses.resize(indexCount / 3);
+            for (size_t t = 0; t < indexCount / 3; t++)
+            {
+                uint8_t triangleMisses = 0;
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    uint32_t v = indices[t * 3 + k];
+                    if (time - timestamps[v] > cacheSize)
+                    {
+                        timestamps[v] = time++;
+                        triangleMisses++;
+                    }
+                }
+                misses[t] = triangleMisses;
+            }
+        }
+    } // namespace Utils
+
+    uint32_t MeshOptimizer::WeldVertices(void* vertices, uint32_t vertexCount,
+                                         uint32_t stride, uint32_t* indices,
+                                         size_t indexCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        uint8_t* bytes = (uint8_t*)vertices;
+
+        // FNV-1a over the whole vertex, equality is an exact byte compare
+        auto hash = [bytes, stride](uint32_t index) {
+            const uint8_t* vertex = bytes + (size_t)index * stride;
+            size_t h = 14695981039346656037ull;
+            for (uint32_t i = 0; i < stride; i++)
+                h = (h ^ vertex[i]) * 1099511628211ull;
+            return h;
+        };
+        auto equal = [bytes, stride](uint32_t a, uint32_t b) {
+            return std::memcmp(bytes + (size_t)a * stride, bytes + (size_t)b * stride,
+                               stride) == 0;
+        };
+
+        std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)>
+            unique(vertexCount, hash, equal);
+        std::vector<uint32_t> remap(vertexCount);
+
+        uint32_t uniqueCount = 0;
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            auto [it, inserted] = unique.emplace(v, uniqueCount);
+            if (inserted)
+            {
+                // Compacting forward never overwrites a vertex we still need
+                if (uniqueCount != v)
+                {
+                    std::memcpy(bytes + (size_t)uniqueCount * stride,
+                                bytes + (size_t)v * stride, stride);
+                    // The map key must now point at the moved copy
+                    unique.erase(it);
+                    unique.emplace(uniqueCount, uniqueCount);
+                }
+                remap[v] = uniqueCount++;
+            }
+            else
+            {
+                remap[v] = it->second;
+            }
+        }
+
+        for (size_t i = 0; i < indexCount; i++)
+            indices[i] = remap[indices[i]];
+
+        return uniqueCount;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount,
+                                            uint32_t vertexCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        using namespace Utils;
+        static const ForsythTables tables;
+
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return;
+
+        TriangleAdjacency adjacency;
+        adjacency.Build(indices, triangleCount * 3, vertexCount);
+
+        // Counts now hold the number of triangles not emitted yet
+        std::vector<int32_t> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++)
+            vertexScore[v] = ForsythVertexScore(tables, -1, adjacency.Counts[v]);
+
+        std::vector<float> triangleScore(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            triangleScore[t] = vertexScore[indices[t * 3]]
+                + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+
+        uint32_t cache[ForsythCacheSize + 3];
+        uint32_t cacheCount = 0;
+
+        size_t best = std::max_element(triangleScore.begin(), triangleScore.end())
+            - triangleScore.begin();
+        size_t cursor = 0;
+
+        while (output.size() < triangleCount * 3)
+        {
+            // Nothing in the cache can continue the strip, take the next
+            // triangle in input order
+            if (best == SIZE_MAX)
+            {
+                while (emitted[cursor])
+                    cursor++;
+                best = cursor;
+            }
+
+            const uint32_t* triangle = &indices[best * 3];
+            emitted[best] = true;
+
+            uint32_t newCache[ForsythCacheSize + 3];
+            uint32_t newCount = 0;
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t v = triangle[k];
+                output.push_back(v);
+                newCache[newCount++] = v;
+
+                // Remove the triangle from the vertex's live list
+                uint32_t* begin = &adjacency.Triangles[adjacency.Offsets[v]];
+                uint32_t* end = begin + adjacency.Counts[v];
+                *std::find(begin, end, (uint32_t)best) = *(end - 1);
+                adjacency.Counts[v]--;
+            }
+
+            for (uint32_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t v = cache[i];
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                    newCache[newCount++] = v;
+            }
+
+            // Vertices pushed past the cache end lose their position score
+            for (uint32_t i = ForsythCacheSize; i < newCount; i++)
+            {
+                cachePosition[newCache[i]] = -1;
+                vertexScore[newCache[i]] = ForsythVertexScore(
+                    tables, -1, adjacency.Counts[newCache[i]]);
+            }
+
+            cacheCount = std::min(newCount, ForsythCacheSize);
+            std::memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+
+            for (uint32_t i = 0; i < cacheCount; i++)
+            {
+                cachePosition[cache[i]] = (int32_t)i;
+                vertexScore[cache[i]] = ForsythVertexScore(
+                    tables, (int32_t)i, adjacency.Counts[cache[i]]);
+            }
+
+            // Only triangles touching the cache changed score
+            best = SIZE_MAX;
+            float bestScore = -1.0f;
+            for (uint32_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t v = cache[i];
+                for (uint32_t j = 0; j < adjacency.Counts[v]; j++)
+                {
+                    uint32_t t = adjacency.Triangles[adjacency.Offsets[v] + j];
+                    float score = vertexScore[indices[t * 3]]
+                        + vertexScore[indices[t * 3 + 1]]
+                        + vertexScore[indices[t * 3 + 2]];
+                    triangleScore[t] = score;
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                         const void* vertices, uint32_t vertexCount,
+                                         uint32_t stride, uint32_t positionOffset,
+                                         float threshold)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        const uint8_t* bytes = (const uint8_t*)vertices;
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2)
+            return;
+
+        // Hard boundaries: the cache was flushed, every vertex missed
+        std::vector<uint8_t> misses;
+        Utils::SimulateFifoMisses(indices, triangleCount * 3, vertexCount,
+                                  Utils::OverdrawCacheSize, misses);
+
+        std::vector<size_t> hard;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            if (t == 0 || misses[t] == 3)
+                hard.push_back(t);
+        }
+        hard.push_back(triangleCount);
+
+        uint32_t totalMisses = 0;
+        for (uint8_t triangleMisses : misses)
+            totalMisses += triangleMisses;
+        float targetACMR = threshold * (float)totalMisses / (float)triangleCount;
+
+        // Soft boundaries: replay each hard cluster with a cold cache and cut
+        // it as soon as the piece so far is within threshold of the mesh
+        // ACMR, so reordering the pieces costs at most that much
+        std::vector<size_t> clusters;
+        std::vector<uint32_t> timestamps(vertexCount, 0);
+        uint32_t time = Utils::OverdrawCacheSize + 1;
+
+        for (size_t c = 0; c + 1 < hard.size(); c++)
+        {
+            size_t start = hard[c], end = hard[c + 1];
+            uint32_t runningMisses = 0;
+
+            clusters.push_back(start);
+            time += Utils::OverdrawCacheSize + 1;
+
+            for (size_t t = start; t < end; t++)
+            {
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    uint32_t v = indices[t * 3 + k];
+                    if (time - timestamps[v] > Utils::OverdrawCacheSize)
+                    {
+                        timestamps[v] = time++;
+                        runningMisses++;
+                    }
+                }
+
+                float runningACMR = (float)runningMisses / (float)(t - start + 1);
+                if (t + 1 < end && runningACMR <= targetACMR)
+                {
+                    clusters.push_back(t + 1);
+                    start = t + 1;
+                    runningMisses = 0;
+                    time += Utils::OverdrawCacheSize + 1;
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+
+        // Mesh centroid
+        float meshCenter[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            float p[3];
+            Utils::ReadPosition(bytes, stride, positionOffset, v, p);
+            for (uint32_t k = 0; k < 3; k++)
+                meshCenter[k] += p[k];
+        }
+        for (uint32_t k = 0; k < 3; k++)
+            meshCenter[k] /= (float)std::max(vertexCount, 1u);
+
+        // Clusters facing away from the mesh center are likely to occlude
+        // the rest, draw them first
+        size_t clusterCount = clusters.size() - 1;
+        std::vector<float> sortKey(clusterCount);
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            float center[3] = {0.0f, 0.0f, 0.0f};
+            float normal[3] = {0.0f, 0.0f, 0.0f};
+            float totalArea = 0.0f;
+
+            for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+            {
+                float a[3], b[3], p[3];
+                float p0[3], p1[3], p2[3];
+                Utils::ReadPosition(bytes, stride, positionOffset, indices[t * 3], p0);
+                Utils::ReadPosition(bytes, stride, positionOffset, indices[t * 3 + 1], p1);
+                Utils::ReadPosition(bytes, stride, positionOffset, indices[t * 3 + 2], p2);
+
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    a[k] = p1[k] - p0[k];
+                    b[k] = p2[k] - p0[k];
+                }
+
+                // Area weighted normal, its length is twice the area
+                p[0] = a[1] * b[2] - a[2] * b[1];
+                p[1] = a[2] * b[0] - a[0] * b[2];
+                p[2] = a[0] * b[1] - a[1] * b[0];
+                float area = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    normal[k] += p[k];
+                    center[k] += (p0[k] + p1[k] + p2[k]) * (area / 3.0f);
+                }
+                totalArea += area;
+            }
+
+            float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1]
+                                     + normal[2] * normal[2]);
+            if (totalArea <= 0.0f || length <= 0.0f)
+            {
+                sortKey[c] = 0.0f;
+                continue;
+            }
+
+            float key = 0.0f;
+            for (uint32_t k = 0; k < 3; k++)
+                key += (center[k] / totalArea - meshCenter[k]) * (normal[k] / length);
+            sortKey[c] = key;
+        }
+
+        std::vector<uint32_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&sortKey](uint32_t a, uint32_t b) {
+            return sortKey[a] > sortKey[b];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (uint32_t c : order)
+        {
+            output.insert(output.end(), indices + clusters[c] * 3,
+                          indices + clusters[c + 1] * 3);
+        }
+
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    uint32_t MeshOptimizer::OptimizeVertexFetch(void* vertices, uint32_t vertexCount,
+                                                uint32_t stride, uint32_t* indices,
+                                                size_t indexCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+        uint32_t next = 0;
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            uint32_t& target = remap[indices[i]];
+            if (target == UINT32_MAX)
+                target = next++;
+            indices[i] = target;
+        }
+
+        uint8_t* bytes = (uint8_t*)vertices;
+        std::vector<uint8_t> reordered((size_t)next * stride);
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            if (remap[v] != UINT32_MAX)
+            {
+                std::memcpy(&reordered[(size_t)remap[v] * stride],
+                            bytes + (size_t)v * stride, stride);
+            }
+        }
+
+        std::memcpy(bytes, reordered.data(), reordered.size());
+        return next;
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices,
+                                                       size_t indexCount,
+                                                       uint32_t vertexCount,
+                                                       uint32_t cacheSize,
+                                                       VertexCacheModel model)
+    {
+        VertexCacheStats stats;
+        stats.Triangles = (uint32_t)(indexCount / 3);
+        if (stats.Triangles == 0 || cacheSize == 0)
+            return stats;
+
+        std::vector<bool> referenced(vertexCount, false);
+        uint32_t uniqueVertices = 0;
+
+        if (model == VertexCacheModel::FIFO)
+        {
+            // A vertex is cached while fewer than cacheSize misses happened
+            // since it was inserted
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+
+            for (size_t i = 0; i < stats.Triangles * 3; i++)
+            {
+                uint32_t v = indices[i];
+                if (time - timestamps[v] > cacheSize)
+                {
+                    timestamps[v] = time++;
+                    stats.Transforms++;
+                }
+
+                if (!referenced[v])
+                {
+                    referenced[v] = true;
+                    uniqueVertices++;
+                }
+            }
+        }
+        else
+        {
+            std::vector<uint32_t> cache;
+            cache.reserve(cacheSize + 1);
+
+            for (size_t i = 0; i < stats.Triangles * 3; i++)
+            {
+                uint32_t v = indices[i];
+                auto it = std::find(cache.begin(), cache.end(), v);
+                if (it == cache.end())
+                {
+                    stats.Transforms++;
+                    if (cache.size() == cacheSize)
+                        cache.pop_back();
+                }
+                else
+                {
+                    cache.erase(it);
+                }
+                cache.insert(cache.begin(), v);
+
+                if (!referenced[v])
+                {
+                    referenced[v] = true;
+                    uniqueVertices++;
+                }
+            }
+        }
+
+        stats.ACMR = (float)stats.Transforms / (float)stats.Triangles;
+        stats.ATVR = (float)stats.Transforms / (float)std::max(uniqueVertices, 1u);
+        return stats;
+    }
+
+    MeshOptimizationStats MeshOptimizer::Optimize(
+        void* vertices, uint32_t& vertexCount, uint32_t stride,
+        uint32_t positionOffset, uint32_t* indices, size_t indexCount,
+        const MeshOptimizationSettings& settings)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        auto start = std::chrono::steady_clock::now();
+
+        MeshOptimizationStats stats;
+        stats.VerticesBefore = vertexCount;
+        stats.Before = AnalyzeVertexCache(indices, indexCount, vertexCount,
+                                          settings.CacheSize, settings.CacheModel);
+
+        if (settings.WeldVertices)
+            vertexCount = WeldVertices(vertices, vertexCount, stride, indices,
+                                       indexCount);
+
+        OptimizeVertexCache(indices, indexCount, vertexCount);
+
+        if (settings.OptimizeOverdraw)
+            OptimizeOverdraw(indices, indexCount, vertices, vertexCount, stride,
+                             positionOffset, settings.OverdrawThreshold);
+
+        vertexCount = OptimizeVertexFetch(vertices, vertexCount, stride, indices,
+                                          indexCount);
+
+        stats.VerticesAfter = vertexCount;
+        stats.After = AnalyzeVertexCache(indices, indexCount, vertexCount,
+                                         settings.CacheSize, settings.CacheModel);
+        stats.OptimizeMs = std::chrono::duration<float, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        return stats;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ForgeEngine
+{
+    enum class VertexCacheModel
+    {
+        FIFO = 0, // fixed function style post-transform cache
+        LRU
+    };
+
+    // Result of simulating a post-transform vertex cache over an index buffer.
+    // ACMR is shaded vertices per triangle (0.5 is the best a regular grid can
+    // reach, 3.0 the worst), ATVR is shaded vertices per referenced vertex
+    // (1.0 is perfect).
+    struct VertexCacheStats
+    {
+        float ACMR = 0.0f;
+        float ATVR = 0.0f;
+        uint32_t Transforms = 0;
+        uint32_t Triangles = 0;
+    };
+
+    struct MeshOptimizationSettings
+    {
+        bool WeldVertices = true;
+        bool OptimizeOverdraw = true;
+        // How much ACMR the overdraw pass may give up to get better ordering
+        float OverdrawThreshold = 1.05f;
+        // Cache used when reporting ACMR/ATVR
+        uint32_t CacheSize = 16;
+        VertexCacheModel CacheModel = VertexCacheModel::FIFO;
+    };
+
+    struct MeshOptimizationStats
+    {
+        VertexCacheStats Before;
+        VertexCacheStats After;
+        uint32_t VerticesBefore = 0;
+        uint32_t VerticesAfter = 0;
+        float OptimizeMs = 0.0f;
+    };
+
+    // Offline index and vertex reordering for triangle lists, meant to run at
+    // import/cook time or on freshly generated meshes. Every pass works in
+    // place on interleaved vertices whose position is three floats at
+    // positionOffset.
+    class MeshOptimizer
+    {
+    public:
+        // Merges byte-identical vertices and remaps the indices. Returns the
+        // new vertex count, the tail of the vertex array is left untouched.
+        static uint32_t WeldVertices(void* vertices, uint32_t vertexCount,
+                                     uint32_t stride, uint32_t* indices,
+                                     size_t indexCount);
+
+        // Tom Forsyth's linear-speed vertex cache optimization
+        static void OptimizeVertexCache(uint32_t* indices, size_t indexCount,
+                                        uint32_t vertexCount);
+
+        // Splits a cache optimized index buffer into clusters (Sander et al.,
+        // "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+        // and draws outward facing clusters first. threshold bounds the ACMR
+        // lost to the extra cluster boundaries.
+        static void OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                     const void* vertices, uint32_t vertexCount,
+                                     uint32_t stride, uint32_t positionOffset,
+                                     float threshold = 1.05f);
+
+        // Reorders vertices by first use and drops unreferenced ones so the
+        // vertex fetch walks memory linearly. Returns the new vertex count.
+        static uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount,
+                                            uint32_t stride, uint32_t* indices,
+                                            size_t indexCount);
+
+        static VertexCacheStats AnalyzeVertexCache(
+            const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+            uint32_t cacheSize = 16,
+            VertexCacheModel model = VertexCacheModel::FIFO);
+
+        // Weld, vertex cache, overdraw and fetch passes in that order.
+        // vertexCount is updated to the optimized count.
+        static MeshOptimizationStats Optimize(
+            void* vertices, uint32_t& vertexCount, uint32_t stride,
+            uint32_t positionOffset, uint32_t* indices, size_t indexCount,
+            const MeshOptimizationSettings& settings = {});
+    };
+} // namespace ForgeEngine
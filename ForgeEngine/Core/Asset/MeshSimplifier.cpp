@@ -0,0 +1,654 @@
+#include "Core/Asset/MeshSimplifier.h"
+
+#include "Core/Asset/MeshOptimizer.h"
+#include "Core/Debug/Instrumentor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        // Extra weight of the planes that hold borders and seams in place
+        static constexpr float SimplifierBoundaryWeight = 2.0f;
+        // Collapses later in a pass may cost this much more than the one
+        // that reached the pass goal, locked vertices skip many candidates
+        static constexpr float SimplifierPassErrorSlack = 1.5f;
+        // Cosine of the largest rotation a collapse may give a triangle
+        static constexpr float SimplifierFlipThreshold = 0.25f;
+
+        enum class SimplifierVertexKind : uint8_t
+        {
+            Manifold = 0, // interior vertex, collapses anywhere
+            Border,       // on an open edge, only collapses along it
+            Seam,         // split attributes, only collapses along the seam
+            Locked        // anything more complex stays put
+        };
+
+        // [from][to]
+        static constexpr bool SimplifierCanCollapse[4][4] = {
+            {true, true, true, true},
+            {false, true, false, false},
+            {false, false, true, false},
+            {false, false, false, false},
+        };
+
+        struct SimplifierVector
+        {
+            float X, Y, Z;
+        };
+
+        static SimplifierVector Subtract(const SimplifierVector& a, const SimplifierVector& b)
+        {
+            return {a.X - b.X, a.Y - b.Y, a.Z - b.Z};
+        }
+
+        static SimplifierVector Cross(const SimplifierVector& a, const SimplifierVector& b)
+        {
+            return {a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X};
+        }
+
+        static float Dot(const SimplifierVector& a, const SimplifierVector& b)
+        {
+            return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+        }
+
+        static float Normalize(SimplifierVector& v)
+        {
+            float length = std::sqrt(Dot(v, v));
+            if (length > 0.0f)
+            {
+                v.X /= length;
+                v.Y /= length;
+                v.Z /= length;
+            }
+            return length;
+        }
+
+        // Symmetric 4x4 error matrix of a set of weighted planes
+        struct Quadric
+        {
+            float A00, A11, A22;
+            float A10, A20, A21;
+            float B0, B1, B2;
+            float C;
+            float W;
+        };
+
+        static Quadric QuadricFromPlane(const SimplifierVector& n, float d, float w)
+        {
+            Quadric q;
+            q.A00 = n.X * n.X * w;
+            q.A11 = n.Y * n.Y * w;
+            q.A22 = n.Z * n.Z * w;
+            q.A10 = n.X * n.Y * w;
+            q.A20 = n.X * n.Z * w;
+            q.A21 = n.Y * n.Z * w;
+            q.B0 = n.X * d * w;
+            q.B1 = n.Y * d * w;
+            q.B2 = n.Z * d * w;
+            q.C = d * d * w;
+            q.W = w;
+            return q;
+        }
+
+        static void QuadricAdd(Quadric& q, const Quadric& r)
+        {
+            q.A00 += r.A00;
+            q.A11 += r.A11;
+            q.A22 += r.A22;
+            q.A10 += r.A10;
+            q.A20 += r.A20;
+            q.A21 += r.A21;
+            q.B0 += r.B0;
+            q.B1 += r.B1;
+            q.B2 += r.B2;
+            q.C += r.C;
+            q.W += r.W;
+        }
+
+        // Weighted mean squared distance from v to the planes
+        static float QuadricError(const Quadric& q, const SimplifierVector& v)
+        {
+            float rx = q.A00 * v.X + q.A10 * v.Y + q.A20 * v.Z + 2.0f * q.B0;
+            float ry = q.A10 * v.X + q.A11 * v.Y + q.A21 * v.Z + 2.0f * q.B1;
+            float rz = q.A20 * v.X + q.A21 * v.Y + q.A22 * v.Z + 2.0f * q.B2;
+            float error = std::fabs(rx * v.X + ry * v.Y + rz * v.Z + q.C);
+            return q.W > 0.0f ? error / q.W : 0.0f;
+        }
+
+        static Quadric QuadricFromTriangle(const SimplifierVector& p0,
+                                           const SimplifierVector& p1,
+                                           const SimplifierVector& p2)
+        {
+            SimplifierVector normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+            float area = Normalize(normal) * 0.5f;
+            return QuadricFromPlane(normal, -Dot(normal, p0), area);
+        }
+
+        // Plane through the edge p0-p1, perpendicular to the triangle
+        static Quadric QuadricFromTriangleEdge(const SimplifierVector& p0,
+                                               const SimplifierVector& p1,
+                                               const SimplifierVector& p2)
+        {
+            SimplifierVector edge = Subtract(p1, p0);
+            float length = Normalize(edge);
+
+            SimplifierVector toOpposite = Subtract(p2, p0);
+            float along = Dot(toOpposite, edge);
+            SimplifierVector normal = {toOpposite.X - edge.X * along,
+                                       toOpposite.Y - edge.Y * along,
+                                       toOpposite.Z - edge.Z * along};
+            Normalize(normal);
+
+            return QuadricFromPlane(normal, -Dot(normal, p0),
+                                    length * length * SimplifierBoundaryWeight);
+        }
+
+        struct SimplifierPositionKey
+        {
+            uint32_t X, Y, Z;
+
+            bool operator==(const SimplifierPositionKey& other) const
+            {
+                return X == other.X && Y == other.Y && Z == other.Z;
+            }
+        };
+
+        struct SimplifierPositionHash
+        {
+            size_t operator()(const SimplifierPositionKey& key) const
+            {
+                return (size_t)key.X * 73856093u ^ (size_t)key.Y * 19349663u
+                    ^ (size_t)key.Z * 83492791u;
+            }
+        };
+
+        // Outgoing half-edges (the next corner of every triangle around a
+        // vertex) and the triangles themselves, in CSR form
+        struct SimplifierAdjacency
+        {
+            std::vector<uint32_t> Offsets;
+            std::vector<uint32_t> Counts;
+            std::vector<uint32_t> Next;
+            std::vector<uint32_t> Triangles;
+
+            void Build(const uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+            {
+                Offsets.assign(vertexCount + 1, 0);
+                Counts.assign(vertexCount, 0);
+                Next.resize(indexCount);
+                Triangles.resize(indexCount);
+
+                for (size_t i = 0; i < indexCount; i++)
+                    Counts[indices[i]]++;
+
+                for (uint32_t v = 0; v < vertexCount; v++)
+                    Offsets[v + 1] = Offsets[v] + Counts[v];
+
+                std::fill(Counts.begin(), Counts.end(), 0);
+                for (size_t i = 0; i < indexCount; i++)
+                {
+                    uint32_t v = indices[i];
+                    size_t corner = i % 3;
+                    uint32_t slot = Offsets[v] + Counts[v]++;
+                    Next[slot] = indices[i - corner + (corner + 1) % 3];
+                    Triangles[slot] = (uint32_t)(i / 3);
+                }
+            }
+
+            bool HasEdge(uint32_t from, uint32_t to) const
+            {
+                for (uint32_t i = Offsets[from]; i < Offsets[from] + Counts[from]; i++)
+                {
+                    if (Next[i] == to)
+                        return true;
+                }
+                return false;
+            }
+        };
+
+        struct SimplifierCollapse
+        {
+            uint32_t From;
+            uint32_t To;
+            float Error;
+        };
+
+        // Same-position vertices point to the first one in remap and form a
+        // circular list through wedge
+        static void BuildPositionRemap(const std::vector<SimplifierVector>& positions,
+                                       const uint32_t* indices, size_t indexCount,
+                                       std::vector<uint32_t>& remap,
+                                       std::vector<uint32_t>& wedge)
+        {
+            uint32_t vertexCount = (uint32_t)positions.size();
+            remap.resize(vertexCount);
+            wedge.resize(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; v++)
+            {
+                remap[v] = v;
+                wedge[v] = v;
+            }
+
+            std::vector<bool> referenced(vertexCount, false);
+            for (size_t i = 0; i < indexCount; i++)
+                referenced[indices[i]] = true;
+
+            std::unordered_map<SimplifierPositionKey, uint32_t, SimplifierPositionHash> first;
+            first.reserve(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; v++)
+            {
+                if (!referenced[v])
+                    continue;
+
+                // + 0.0f folds -0 into +0 so both hash alike
+                SimplifierPositionKey key;
+                float x = positions[v].X + 0.0f, y = positions[v].Y + 0.0f,
+                      z = positions[v].Z + 0.0f;
+                std::memcpy(&key.X, &x, sizeof(float));
+                std::memcpy(&key.Y, &y, sizeof(float));
+                std::memcpy(&key.Z, &z, sizeof(float));
+
+                auto [it, inserted] = first.emplace(key, v);
+                if (inserted)
+                    continue;
+
+                uint32_t r = it->second;
+                remap[v] = r;
+                wedge[v] = wedge[r];
+                wedge[r] = v;
+            }
+        }
+
+        static void ClassifyVertices(const SimplifierAdjacency& adjacency,
+                                     const std::vector<uint32_t>& remap,
+                                     const std::vector<uint32_t>& wedge,
+                                     std::vector<SimplifierVertexKind>& kinds)
+        {
+            uint32_t vertexCount = (uint32_t)remap.size();
+
+            // The single vertex on the other end of an open half-edge, none
+            // (UINT32_MAX) or the vertex itself when there are several
+            std::vector<uint32_t> openIn(vertexCount, UINT32_MAX);
+            std::vector<uint32_t> openOut(vertexCount, UINT32_MAX);
+
+            for (uint32_t v = 0; v < vertexCount; v++)
+            {
+                for (uint32_t i = adjacency.Offsets[v];
+                     i < adjacency.Offsets[v] + adjacency.Counts[v]; i++)
+                {
+                    uint32_t target = adjacency.Next[i];
+                    if (adjacency.HasEdge(target, v))
+                        continue;
+
+                    openIn[target] = openIn[target] == UINT32_MAX ? v : target;
+                    openOut[v] = openOut[v] == UINT32_MAX ? target : v;
+                }
+            }
+
+            kinds.assign(vertexCount, SimplifierVertexKind::Locked);
+            for (uint32_t v = 0; v < vertexCount; v++)
+            {
+                if (remap[v] != v)
+                    continue;
+
+                SimplifierVertexKind kind = SimplifierVertexKind::Locked;
+                if (wedge[v] == v)
+                {
+                    if (openIn[v] == UINT32_MAX && openOut[v] == UINT32_MAX)
+                        kind = SimplifierVertexKind::Manifold;
+                    else if (openIn[v] != UINT32_MAX && openIn[v] != v
+                             && openOut[v] != UINT32_MAX && openOut[v] != v)
+                        kind = SimplifierVertexKind::Border;
+                }
+                else if (wedge[wedge[v]] == v)
+                {
+                    // Two wedges, each with one open edge in and out that
+                    // meet the other wedge's edges once remapped
+                    uint32_t w = wedge[v];
+                    bool single = openIn[v] != UINT32_MAX && openIn[v] != v
+                        && openOut[v] != UINT32_MAX && openOut[v] != v
+                        && openIn[w] != UINT32_MAX && openIn[w] != w
+                        && openOut[w] != UINT32_MAX && openOut[w] != w;
+                    if (single && remap[openIn[v]] == remap[openOut[w]]
+                        && remap[openOut[v]] == remap[openIn[w]])
+                        kind = SimplifierVertexKind::Seam;
+                }
+
+                // Every wedge shares the classification of the first one
+                uint32_t w = v;
+                do
+                {
+                    kinds[w] = kind;
+                    w = wedge[w];
+                } while (w != v);
+            }
+        }
+
+        // True when moving every wedge of from onto position would turn a
+        // triangle around
+        static bool HasTriangleFlips(const SimplifierAdjacency& adjacency,
+                                     const std::vector<SimplifierVector>& positions,
+                                     const std::vector<uint32_t>& remap,
+                                     const std::vector<uint32_t>& wedge,
+                                     const uint32_t* indices, uint32_t from,
+                                     uint32_t to)
+        {
+            const SimplifierVector& target = positions[to];
+            uint32_t w = from;
+            do
+            {
+                for (uint32_t i = adjacency.Offsets[w];
+                     i < adjacency.Offsets[w] + adjacency.Counts[w]; i++)
+                {
+                    const uint32_t* triangle = &indices[adjacency.Triangles[i] * 3];
+                    uint32_t corner = triangle[0] == w ? 0 : triangle[1] == w ? 1 : 2;
+                    uint32_t b = triangle[(corner + 1) % 3];
+                    uint32_t c = triangle[(corner + 2) % 3];
+
+                    // Collapses away together with the edge
+                    if (remap[b] == remap[to] || remap[c] == remap[to])
+                        continue;
+
+                    SimplifierVector edgeB = Subtract(positions[b], positions[w]);
+                    SimplifierVector edgeC = Subtract(positions[c], positions[w]);
+                    SimplifierVector before = Cross(edgeB, edgeC);
+
+                    SimplifierVector movedB = Subtract(positions[b], target);
+                    SimplifierVector movedC = Subtract(positions[c], target);
+                    SimplifierVector after = Cross(movedB, movedC);
+
+                    // Reject anything that turns by more than ~75 degrees, a
+                    // plain sign test lets slivers fold over
+                    float lengths = std::sqrt(Dot(before, before) * Dot(after, after));
+                    if (Dot(before, after) <= SimplifierFlipThreshold * lengths)
+                        return true;
+                }
+                w = wedge[w];
+            } while (w != from);
+
+            return false;
+        }
+    } // namespace Utils
+
+    size_t MeshSimplifier::Simplify(uint32_t* destination, const uint32_t* indices,
+                                    size_t indexCount, const void* vertices,
+                                    uint32_t vertexCount, uint32_t stride,
+                                    uint32_t positionOffset, size_t targetIndexCount,
+                                    float targetError, float* error)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        using namespace Utils;
+
+        if (destination != indices)
+            std::memmove(destination, indices, indexCount * sizeof(uint32_t));
+        if (error)
+            *error = 0.0f;
+        if (indexCount < 3 || targetIndexCount >= indexCount)
+            return indexCount;
+
+        // Work in a unit box so errors are relative to the mesh extent
+        std::vector<SimplifierVector> positions(vertexCount);
+        SimplifierVector min = {FLT_MAX, FLT_MAX, FLT_MAX};
+        SimplifierVector max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        const uint8_t* bytes = (const uint8_t*)vertices;
+        for (uint32_t v = 0; v < vertexCount; v++)
+        {
+            std::memcpy(&positions[v], bytes + (size_t)v * stride + positionOffset,
+                        sizeof(SimplifierVector));
+            min = {std::min(min.X, positions[v].X), std::min(min.Y, positions[v].Y),
+                   std::min(min.Z, positions[v].Z)};
+            max = {std::max(max.X, positions[v].X), std::max(max.Y, positions[v].Y),
+                   std::max(max.Z, positions[v].Z)};
+        }
+
+        float extent = std::max(max.X - min.X, std::max(max.Y - min.Y, max.Z - min.Z));
+        float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+        for (SimplifierVector& position : positions)
+            position = {(position.X - min.X) * scale, (position.Y - min.Y) * scale,
+                        (position.Z - min.Z) * scale};
+
+        std::vector<uint32_t> remap, wedge;
+        BuildPositionRemap(positions, destination, indexCount, remap, wedge);
+
+        SimplifierAdjacency adjacency;
+        adjacency.Build(destination, indexCount, vertexCount);
+
+        std::vector<SimplifierVertexKind> kinds;
+        ClassifyVertices(adjacency, remap, wedge, kinds);
+
+        // One quadric per position, shared by its wedges
+        std::vector<Quadric> quadrics(vertexCount, Quadric{});
+        for (size_t t = 0; t < indexCount; t += 3)
+        {
+            uint32_t i0 = destination[t], i1 = destination[t + 1], i2 = destination[t + 2];
+            Quadric q = QuadricFromTriangle(positions[i0], positions[i1], positions[i2]);
+            QuadricAdd(quadrics[remap[i0]], q);
+            QuadricAdd(quadrics[remap[i1]], q);
+            QuadricAdd(quadrics[remap[i2]], q);
+
+            for (uint32_t e = 0; e < 3; e++)
+            {
+                uint32_t a = destination[t + e];
+                uint32_t b = destination[t + (e + 1) % 3];
+                uint32_t c = destination[t + (e + 2) % 3];
+
+                bool boundaryA = kinds[a] == SimplifierVertexKind::Border
+                    || kinds[a] == SimplifierVertexKind::Seam;
+                bool boundaryB = kinds[b] == SimplifierVertexKind::Border
+                    || kinds[b] == SimplifierVertexKind::Seam;
+                if ((!boundaryA && !boundaryB) || adjacency.HasEdge(b, a))
+                    continue;
+
+                // A seam shows up as an open edge on both of its sides
+                if (kinds[a] == SimplifierVertexKind::Seam
+                    && kinds[b] == SimplifierVertexKind::Seam && remap[b] > remap[a])
+                    continue;
+
+                Quadric edge = QuadricFromTriangleEdge(positions[a], positions[b],
+                                                       positions[c]);
+                QuadricAdd(quadrics[remap[a]], edge);
+                QuadricAdd(quadrics[remap[b]], edge);
+            }
+        }
+
+        float errorLimit = targetError * targetError;
+        float resultError = 0.0f;
+        size_t resultCount = indexCount;
+
+        std::vector<SimplifierCollapse> collapses;
+        std::vector<uint32_t> collapseRemap(vertexCount);
+        std::vector<bool> collapseLocked(vertexCount);
+
+        auto collapseError = [&](uint32_t from, uint32_t to) {
+            Quadric q = quadrics[remap[from]];
+            QuadricAdd(q, quadrics[remap[to]]);
+            return QuadricError(q, positions[to]);
+        };
+
+        while (resultCount > targetIndexCount)
+        {
+            adjacency.Build(destination, resultCount, vertexCount);
+
+            // Candidate edges, each in its cheapest allowed direction
+            collapses.clear();
+            for (size_t t = 0; t < resultCount; t += 3)
+            {
+                for (uint32_t e = 0; e < 3; e++)
+                {
+                    uint32_t i0 = destination[t + e];
+                    uint32_t i1 = destination[t + (e + 1) % 3];
+                    SimplifierVertexKind k0 = kinds[i0], k1 = kinds[i1];
+
+                    // Manifold edges are seen from both triangles
+                    if ((k0 == SimplifierVertexKind::Manifold
+                         || k1 == SimplifierVertexKind::Manifold)
+                        && remap[i1] > remap[i0])
+                        continue;
+
+                    // Borders and seams only move along their open edges
+                    bool open = !adjacency.HasEdge(i1, i0);
+                    bool forward = SimplifierCanCollapse[(int)k0][(int)k1]
+                        && (k0 == SimplifierVertexKind::Manifold || (k0 == k1 && open));
+                    bool backward = SimplifierCanCollapse[(int)k1][(int)k0]
+                        && (k1 == SimplifierVertexKind::Manifold || (k0 == k1 && open));
+
+                    float forwardError = forward ? collapseError(i0, i1) : FLT_MAX;
+                    float backwardError = backward ? collapseError(i1, i0) : FLT_MAX;
+
+                    if (forwardError <= backwardError && forward)
+                        collapses.push_back({i0, i1, forwardError});
+                    else if (backward)
+                        collapses.push_back({i1, i0, backwardError});
+                }
+            }
+
+            collapses.erase(std::remove_if(collapses.begin(), collapses.end(),
+                                           [&](const SimplifierCollapse& collapse) {
+                                               return collapse.Error > errorLimit;
+                                           }),
+                            collapses.end());
+            if (collapses.empty())
+                break;
+
+            std::sort(collapses.begin(), collapses.end(),
+                      [](const SimplifierCollapse& a, const SimplifierCollapse& b) {
+                          return a.Error < b.Error;
+                      });
+
+            // An interior collapse removes two triangles, a border one
+            size_t trianglesToRemove = (resultCount - targetIndexCount) / 3;
+            size_t goal = std::max<size_t>(1, std::min(collapses.size(),
+                                                       (trianglesToRemove + 1) / 2));
+            float passErrorLimit = std::min(errorLimit,
+                                            collapses[goal - 1].Error * SimplifierPassErrorSlack);
+
+            for (uint32_t v = 0; v < vertexCount; v++)
+                collapseRemap[v] = v;
+            std::fill(collapseLocked.begin(), collapseLocked.end(), false);
+
+            size_t removed = 0;
+            uint32_t applied = 0;
+            for (const SimplifierCollapse& collapse : collapses)
+            {
+                if (removed >= trianglesToRemove || collapse.Error > passErrorLimit)
+                    break;
+
+                uint32_t r0 = remap[collapse.From], r1 = remap[collapse.To];
+                if (collapseLocked[r0] || collapseLocked[r1])
+                    continue;
+
+                if (HasTriangleFlips(adjacency, positions, remap, wedge, destination,
+                                     collapse.From, collapse.To))
+                    continue;
+
+                SimplifierVertexKind kind = kinds[collapse.From];
+                if (kind == SimplifierVertexKind::Seam)
+                {
+                    // The other side of the seam follows along
+                    uint32_t s0 = wedge[collapse.From], s1 = wedge[collapse.To];
+                    if (!adjacency.HasEdge(s0, s1) && !adjacency.HasEdge(s1, s0))
+                        continue;
+                    collapseRemap[s0] = s1;
+                }
+                collapseRemap[collapse.From] = collapse.To;
+
+                QuadricAdd(quadrics[r1], quadrics[r0]);
+
+                // Lock the whole ring around the moved vertex so later flip
+                // checks in this pass never see stale triangles
+                uint32_t w = collapse.From;
+                do
+                {
+                    for (uint32_t i = adjacency.Offsets[w];
+                         i < adjacency.Offsets[w] + adjacency.Counts[w]; i++)
+                    {
+                        const uint32_t* triangle = &destination[adjacency.Triangles[i] * 3];
+                        collapseLocked[remap[triangle[0]]] = true;
+                        collapseLocked[remap[triangle[1]]] = true;
+                        collapseLocked[remap[triangle[2]]] = true;
+                    }
+                    w = wedge[w];
+                } while (w != collapse.From);
+                collapseLocked[r1] = true;
+
+                removed += kind == SimplifierVertexKind::Border ? 1 : 2;
+                resultError = std::max(resultError, collapse.Error);
+                applied++;
+            }
+
+            if (applied == 0)
+                break;
+
+            size_t write = 0;
+            for (size_t t = 0; t < resultCount; t += 3)
+            {
+                uint32_t a = collapseRemap[destination[t]];
+                uint32_t b = collapseRemap[destination[t + 1]];
+                uint32_t c = collapseRemap[destination[t + 2]];
+
+                if (remap[a] == remap[b] || remap[b] == remap[c] || remap[c] == remap[a])
+                    continue;
+
+                destination[write++] = a;
+                destination[write++] = b;
+                destination[write++] = c;
+            }
+            resultCount = write;
+        }
+
+        if (error)
+            *error = std::sqrt(resultError);
+        return resultCount;
+    }
+
+    std::vector<MeshLodLevel> MeshSimplifier::GenerateLods(
+        const uint32_t* indices, size_t indexCount, const void* vertices,
+        uint32_t vertexCount, uint32_t stride, uint32_t positionOffset,
+        const MeshSimplificationSettings& settings)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        std::vector<MeshLodLevel> lods;
+        std::vector<uint32_t> source(indices, indices + indexCount);
+
+        // Each level starts from the previous one, so errors add up
+        float error = 0.0f;
+        for (uint32_t level = 0; level < settings.LodCount; level++)
+        {
+            float budget = settings.MaxError - error;
+            if (budget <= 0.0f)
+                break;
+
+            size_t target = (size_t)(source.size() / 3 * settings.ReductionPerLod) * 3;
+
+            MeshLodLevel lod;
+            lod.Indices.resize(source.size());
+            float levelError = 0.0f;
+            size_t count = Simplify(lod.Indices.data(), source.data(), source.size(),
+                                    vertices, vertexCount, stride, positionOffset,
+                                    target, budget, &levelError);
+
+            if (count == 0
+                || (float)count > (float)source.size() * (1.0f - settings.MinReduction))
+                break;
+
+            lod.Indices.resize(count);
+            MeshOptimizer::OptimizeVertexCache(lod.Indices.data(), count, vertexCount);
+
+            error += levelError;
+            lod.Error = error;
+
+            source = lod.Indices;
+            lods.push_back(std::move(lod));
+        }
+
+        return lods;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ForgeEngine
+{
+    struct MeshSimplificationSettings
+    {
+        // Number of levels built after LOD 0
+        uint32_t LodCount = 3;
+        // Triangle count of each level relative to the previous one
+        float ReductionPerLod = 0.5f;
+        // Collapses stop once the geometric error, relative to the mesh
+        // extent, would exceed this
+        float MaxError = 0.05f;
+        // Levels that remove less than this fraction of the previous level's
+        // triangles are dropped, they would cost memory for no gain
+        float MinReduction = 0.1f;
+    };
+
+    struct MeshLodLevel
+    {
+        std::vector<uint32_t> Indices;
+        // Largest collapse error, relative to the mesh extent
+        float Error = 0.0f;
+    };
+
+    // Quadric error metric simplification (Garland and Heckbert, "Surface
+    // Simplification Using Quadric Error Metrics") restricted to half-edge
+    // collapses, so every level reuses the original vertex buffer and only
+    // needs its own index buffer. Open borders and UV/normal seams only
+    // collapse along themselves, anything more complex is locked.
+    class MeshSimplifier
+    {
+    public:
+        // Writes at most indexCount indices to destination and returns how
+        // many were written. Positions are three floats at positionOffset.
+        // error, when given, receives the largest collapse error relative to
+        // the mesh extent.
+        static size_t Simplify(uint32_t* destination, const uint32_t* indices,
+                               size_t indexCount, const void* vertices,
+                               uint32_t vertexCount, uint32_t stride,
+                               uint32_t positionOffset, size_t targetIndexCount,
+                               float targetError, float* error = nullptr);
+
+        // Builds successively coarser levels from a triangle list, each one
+        // simplified from the previous and reordered for the vertex cache
+        static std::vector<MeshLodLevel> GenerateLods(
+            const uint32_t* indices, size_t indexCount, const void* vertices,
+            uint32_t vertexCount, uint32_t stride, uint32_t positionOffset,
+            const MeshSimplificationSettings& settings = {});
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,346 @@
+#include "Core/Asset/MeshletBuilder.h"
+
+#include "Core/Debug/Instrumentor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        // Cones wider than this (cosine of the half angle) almost never cull
+        static constexpr float MeshletMinConeDot = 0.1f;
+
+        struct MeshletVector
+        {
+            float X, Y, Z;
+        };
+
+        static MeshletVector MeshletReadPosition(const uint8_t* vertices, uint32_t stride,
+                                                 uint32_t positionOffset, uint32_t index)
+        {
+            MeshletVector position;
+            std::memcpy(&position, vertices + (size_t)index * stride + positionOffset,
+                        sizeof(position));
+            return position;
+        }
+
+        static float MeshletDot(const MeshletVector& a, const MeshletVector& b)
+        {
+            return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+        }
+
+        static float MeshletLength(const MeshletVector& v)
+        {
+            return std::sqrt(MeshletDot(v, v));
+        }
+
+        // Unnormalized face normal, its length is twice the triangle area
+        static MeshletVector MeshletFaceNormal(const MeshletVector& a, const MeshletVector& b,
+                                               const MeshletVector& c)
+        {
+            MeshletVector e1 = {b.X - a.X, b.Y - a.Y, b.Z - a.Z};
+            MeshletVector e2 = {c.X - a.X, c.Y - a.Y, c.Z - a.Z};
+            return {e1.Y * e2.Z - e1.Z * e2.Y, e1.Z * e2.X - e1.X * e2.Z,
+                    e1.X * e2.Y - e1.Y * e2.X};
+        }
+    } // namespace Utils
+
+    MeshletBounds MeshletBuilder::ComputeBounds(const uint32_t* indices, size_t indexCount,
+                                                const void* vertices, uint32_t stride,
+                                                uint32_t positionOffset)
+    {
+        MeshletBounds bounds;
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return bounds;
+
+        const uint8_t* data = static_cast<const uint8_t*>(vertices);
+
+        // Sphere around the box center, a little looser than a minimal
+        // sphere but stable and cheap
+        Utils::MeshletVector min = {FLT_MAX, FLT_MAX, FLT_MAX};
+        Utils::MeshletVector max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            Utils::MeshletVector p = Utils::MeshletReadPosition(data, stride, positionOffset,
+                                                                indices[i]);
+            min = {std::fmin(min.X, p.X), std::fmin(min.Y, p.Y), std::fmin(min.Z, p.Z)};
+            max = {std::fmax(max.X, p.X), std::fmax(max.Y, p.Y), std::fmax(max.Z, p.Z)};
+        }
+
+        Utils::MeshletVector center = {(min.X + max.X) * 0.5f, (min.Y + max.Y) * 0.5f,
+                                       (min.Z + max.Z) * 0.5f};
+        float radius = 0.0f;
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            Utils::MeshletVector p = Utils::MeshletReadPosition(data, stride, positionOffset,
+                                                                indices[i]);
+            Utils::MeshletVector d = {p.X - center.X, p.Y - center.Y, p.Z - center.Z};
+            radius = std::fmax(radius, Utils::MeshletLength(d));
+        }
+
+        bounds.Center[0] = center.X;
+        bounds.Center[1] = center.Y;
+        bounds.Center[2] = center.Z;
+        bounds.Radius = radius;
+
+        // Normal cone: average of the unit face normals, opened until it
+        // holds every one of them
+        std::vector<Utils::MeshletVector> normals;
+        normals.reserve(triangleCount);
+        Utils::MeshletVector axis = {0.0f, 0.0f, 0.0f};
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            Utils::MeshletVector n = Utils::MeshletFaceNormal(
+                Utils::MeshletReadPosition(data, stride, positionOffset, indices[t * 3 + 0]),
+                Utils::MeshletReadPosition(data, stride, positionOffset, indices[t * 3 + 1]),
+                Utils::MeshletReadPosition(data, stride, positionOffset, indices[t * 3 + 2]));
+
+            float length = Utils::MeshletLength(n);
+            if (length <= 0.0f)
+                continue; // degenerate triangles face nowhere
+
+            n = {n.X / length, n.Y / length, n.Z / length};
+            normals.push_back(n);
+            axis = {axis.X + n.X, axis.Y + n.Y, axis.Z + n.Z};
+        }
+
+        float axisLength = Utils::MeshletLength(axis);
+        if (normals.empty() || axisLength <= 1e-6f)
+            return bounds;
+
+        axis = {axis.X / axisLength, axis.Y / axisLength, axis.Z / axisLength};
+
+        float minDot = 1.0f;
+        for (const Utils::MeshletVector& n : normals)
+            minDot = std::fmin(minDot, Utils::MeshletDot(n, axis));
+
+        bounds.ConeAxis[0] = axis.X;
+        bounds.ConeAxis[1] = axis.Y;
+        bounds.ConeAxis[2] = axis.Z;
+        if (minDot > Utils::MeshletMinConeDot)
+            bounds.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+        return bounds;
+    }
+
+    MeshletData MeshletBuilder::Build(const uint32_t* indices, size_t indexCount,
+                                      const void* vertices, uint32_t vertexCount,
+                                      uint32_t stride, uint32_t positionOffset,
+                                      const MeshletSettings& settings)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        MeshletData result;
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+            return result;
+
+        uint32_t maxVertices = std::max(settings.MaxVertices, 3u);
+        uint32_t maxTriangles = std::max(settings.MaxTriangles, 1u);
+        const uint8_t* data = static_cast<const uint8_t*>(vertices);
+
+        // Per triangle centroid and unit normal, plus the mean area to know
+        // how large a full meshlet is expected to be
+        std::vector<Utils::MeshletVector> centroids(triangleCount);
+        std::vector<Utils::MeshletVector> normals(triangleCount);
+        double totalArea = 0.0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            Utils::MeshletVector a = Utils::MeshletReadPosition(data, stride, positionOffset,
+                                                                indices[t * 3 + 0]);
+            Utils::MeshletVector b = Utils::MeshletReadPosition(data, stride, positionOffset,
+                                                                indices[t * 3 + 1]);
+            Utils::MeshletVector c = Utils::MeshletReadPosition(data, stride, positionOffset,
+                                                                indices[t * 3 + 2]);
+
+            centroids[t] = {(a.X + b.X + c.X) / 3.0f, (a.Y + b.Y + c.Y) / 3.0f,
+                            (a.Z + b.Z + c.Z) / 3.0f};
+
+            Utils::MeshletVector n = Utils::MeshletFaceNormal(a, b, c);
+            float length = Utils::MeshletLength(n);
+            totalArea += length * 0.5f;
+            normals[t] = length > 0.0f
+                ? Utils::MeshletVector{n.X / length, n.Y / length, n.Z / length}
+                : Utils::MeshletVector{0.0f, 0.0f, 0.0f};
+        }
+
+        float meanArea = (float)(totalArea / (double)triangleCount);
+        float expectedRadius = std::sqrt(meanArea * (float)maxTriangles / 3.14159265f);
+        float inverseRadius = expectedRadius > 0.0f ? 1.0f / expectedRadius : 1.0f;
+
+        // Vertex to triangle adjacency in compressed rows
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+            adjacencyOffsets[indices[i] + 1]++;
+        for (uint32_t v = 0; v < vertexCount; v++)
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+            adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
+
+        // Unemitted triangles around each vertex
+        std::vector<uint32_t> liveTriangles(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++)
+            liveTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        // Meshlet that last took each vertex, tells whether a candidate
+        // triangle would add it again
+        std::vector<uint32_t> vertexMeshlet(vertexCount, UINT32_MAX);
+
+        result.Indices.reserve(triangleCount * 3);
+        result.Meshlets.reserve(triangleCount / maxTriangles + 1);
+        result.Bounds.reserve(triangleCount / maxTriangles + 1);
+
+        std::vector<uint32_t> meshletVertices;
+        meshletVertices.reserve(maxVertices);
+        uint32_t meshletIndex = 0;
+        uint32_t meshletTriangles = 0;
+        Utils::MeshletVector centroidSum = {0.0f, 0.0f, 0.0f};
+        Utils::MeshletVector normalSum = {0.0f, 0.0f, 0.0f};
+        size_t emittedCount = 0;
+        size_t seedCursor = 0;
+
+        auto addTriangle = [&](uint32_t triangle) {
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t v = indices[triangle * 3 + k];
+                if (vertexMeshlet[v] != meshletIndex)
+                {
+                    vertexMeshlet[v] = meshletIndex;
+                    meshletVertices.push_back(v);
+                }
+                liveTriangles[v]--;
+                result.Indices.push_back(v);
+            }
+
+            const Utils::MeshletVector& c = centroids[triangle];
+            const Utils::MeshletVector& n = normals[triangle];
+            centroidSum = {centroidSum.X + c.X, centroidSum.Y + c.Y, centroidSum.Z + c.Z};
+            normalSum = {normalSum.X + n.X, normalSum.Y + n.Y, normalSum.Z + n.Z};
+
+            emitted[triangle] = 1;
+            emittedCount++;
+            meshletTriangles++;
+        };
+
+        auto finishMeshlet = [&]() {
+            Meshlet meshlet;
+            meshlet.IndexCount = meshletTriangles * 3;
+            meshlet.FirstIndex = (uint32_t)result.Indices.size() - meshlet.IndexCount;
+            meshlet.VertexCount = (uint32_t)meshletVertices.size();
+
+            result.Meshlets.push_back(meshlet);
+            result.Bounds.push_back(ComputeBounds(result.Indices.data() + meshlet.FirstIndex,
+                                                  meshlet.IndexCount, vertices, stride,
+                                                  positionOffset));
+
+            meshletIndex++;
+            meshletTriangles = 0;
+            meshletVertices.clear();
+            centroidSum = {0.0f, 0.0f, 0.0f};
+            normalSum = {0.0f, 0.0f, 0.0f};
+        };
+
+        while (emittedCount < triangleCount)
+        {
+            // Neighbours of the current meshlet: the best one that still
+            // fits, and the best one overall to seed the next meshlet with
+            int64_t bestFit = -1;
+            uint32_t bestFitExtra = UINT32_MAX;
+            float bestFitScore = FLT_MAX;
+            int64_t bestSeed = -1;
+            float bestSeedScore = FLT_MAX;
+
+            if (meshletTriangles > 0)
+            {
+                float inverseCount = 1.0f / (float)meshletTriangles;
+                Utils::MeshletVector center = {centroidSum.X * inverseCount,
+                                               centroidSum.Y * inverseCount,
+                                               centroidSum.Z * inverseCount};
+                float normalLength = Utils::MeshletLength(normalSum);
+                Utils::MeshletVector axis = normalLength > 0.0f
+                    ? Utils::MeshletVector{normalSum.X / normalLength,
+                                           normalSum.Y / normalLength,
+                                           normalSum.Z / normalLength}
+                    : Utils::MeshletVector{0.0f, 0.0f, 0.0f};
+
+                for (uint32_t v : meshletVertices)
+                {
+                    for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+                    {
+                        uint32_t triangle = adjacency[a];
+                        if (emitted[triangle])
+                            continue;
+
+                        uint32_t extra = 0;
+                        bool closesVertex = false;
+                        for (uint32_t k = 0; k < 3; k++)
+                        {
+                            uint32_t corner = indices[triangle * 3 + k];
+                            extra += vertexMeshlet[corner] != meshletIndex;
+                            closesVertex |= liveTriangles[corner] == 1;
+                        }
+
+                        const Utils::MeshletVector& c = centroids[triangle];
+                        Utils::MeshletVector d = {c.X - center.X, c.Y - center.Y,
+                                                  c.Z - center.Z};
+                        float spread = 1.0f - Utils::MeshletDot(normals[triangle], axis);
+                        float score = Utils::MeshletLength(d) * inverseRadius
+                            + settings.ConeWeight * spread;
+
+                        if (score < bestSeedScore)
+                        {
+                            bestSeed = triangle;
+                            bestSeedScore = score;
+                        }
+
+                        if (meshletVertices.size() + extra > maxVertices)
+                            continue;
+
+                        // Taking the last triangle of a vertex first keeps
+                        // the leftovers from fragmenting into tiny meshlets
+                        uint32_t priority = closesVertex ? 0 : extra;
+                        if (priority < bestFitExtra
+                            || (priority == bestFitExtra && score < bestFitScore))
+                        {
+                            bestFit = triangle;
+                            bestFitExtra = priority;
+                            bestFitScore = score;
+                        }
+                    }
+                }
+            }
+
+            if (bestFit >= 0 && meshletTriangles < maxTriangles)
+            {
+                addTriangle((uint32_t)bestFit);
+                continue;
+            }
+
+            // Full, or nothing connected is left: start over next to it, or
+            // from the next unused triangle in index order
+            if (meshletTriangles > 0)
+                finishMeshlet();
+
+            if (bestSeed < 0)
+            {
+                while (emitted[seedCursor])
+                    seedCursor++;
+                bestSeed = (int64_t)seedCursor;
+            }
+            addTriangle((uint32_t)bestSeed);
+        }
+
+        if (meshletTriangles > 0)
+            finishMeshlet();
+
+        return result;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ForgeEngine
+{
+    struct MeshletSettings
+    {
+        uint32_t MaxVertices = 64;
+        uint32_t MaxTriangles = 124;
+        // How much the builder favours triangles facing the same way as the
+        // meshlet over spatially compact ones; higher values give tighter
+        // normal cones and more backface culling
+        float ConeWeight = 0.25f;
+    };
+
+    // A contiguous range of MeshletData::Indices, always whole triangles
+    struct Meshlet
+    {
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+        uint32_t VertexCount = 0;
+    };
+
+    // Object space culling data of one meshlet. Every triangle faces away
+    // from a viewer at position v when
+    //   dot(Center - v, ConeAxis) >= ConeCutoff * length(Center - v) + Radius
+    // ConeCutoff is 1 when the triangles spread over too many directions,
+    // which makes the test always fail.
+    struct MeshletBounds
+    {
+        float Center[3] = {0.0f, 0.0f, 0.0f};
+        float Radius = 0.0f;
+        float ConeAxis[3] = {0.0f, 0.0f, 0.0f};
+        float ConeCutoff = 1.0f;
+    };
+
+    struct MeshletData
+    {
+        // The input triangles reordered so each meshlet is one range
+        std::vector<uint32_t> Indices;
+        std::vector<Meshlet> Meshlets;
+        // Parallel to Meshlets, kept apart so culling only walks the bounds
+        std::vector<MeshletBounds> Bounds;
+    };
+
+    // Splits triangle lists into small clusters that can be culled on their
+    // own. Clusters grow greedily from a seed triangle, preferring neighbours
+    // that add the fewest new vertices, then the closest and best aligned
+    // ones. Positions are three floats at positionOffset.
+    class MeshletBuilder
+    {
+    public:
+        static MeshletData Build(const uint32_t* indices, size_t indexCount,
+                                 const void* vertices, uint32_t vertexCount,
+                                 uint32_t stride, uint32_t positionOffset,
+                                 const MeshletSettings& settings = {});
+
+        // Bounding sphere and normal cone of an arbitrary triangle list
+        static MeshletBounds ComputeBounds(const uint32_t* indices, size_t indexCount,
+                                           const void* vertices, uint32_t stride,
+                                           uint32_t positionOffset);
+    };
+} // namespace ForgeEngine
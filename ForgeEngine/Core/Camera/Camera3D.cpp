@@ -34,7 +34,8 @@ void Camera3D::SetPerspective(float fov, float aspectRatio, float nearClip, floa
 void Camera3D::SetViewport(float width, float height)
 {
     m_AspectRatio = width / height;
-    FENGINE_CORE_INFO("Viewport ({},{})", width, height);
+    m_ViewportHeight = height;
+    FENGINE_CORE_DEBUG("Viewport ({},{})", width, height);
     m_Projection = glm::perspective(glm::radians(m_FOV), m_AspectRatio, m_NearClip, m_FarClip);
     RecalculateFrustum();
     RecalculateViewMatrix();
@@ -175,6 +176,32 @@ bool Camera3D::AABBInFrustum(const glm::vec3& min, const glm::vec3& max) const
     return true;
 }
 
+bool Camera3D::OBBInFrustum(const glm::mat4& transform, const glm::vec3& localMin,
+                            const glm::vec3& localMax) const
+{
+    glm::vec3 halfExtent = (localMax - localMin) * 0.5f;
+    glm::vec3 center = glm::vec3(transform * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+
+    // Scaled box axes in world space
+    glm::vec3 axisX = glm::vec3(transform[0]) * halfExtent.x;
+    glm::vec3 axisY = glm::vec3(transform[1]) * halfExtent.y;
+    glm::vec3 axisZ = glm::vec3(transform[2]) * halfExtent.z;
+
+    for (const auto& plane : m_FrustumPlanes)
+    {
+        glm::vec3 normal = glm::vec3(plane);
+
+        // Half the box's extent along the plane normal
+        float radius = std::abs(glm::dot(normal, axisX))
+            + std::abs(glm::dot(normal, axisY))
+            + std::abs(glm::dot(normal, axisZ));
+
+        if (glm::dot(normal, center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
 void Camera3D::DebugFrustum() const
 {
 #ifdef FENGINE_DEBUG_FRUSTUM
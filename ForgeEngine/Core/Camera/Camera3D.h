@@ -35,6 +35,10 @@ public:
     bool PointInFrustum(const glm::vec3& point) const;
     bool SphereInFrustum(const glm::vec3& center, float radius) const;
     bool AABBInFrustum(const glm::vec3& min, const glm::vec3& max) const;
+    // Local box under an affine transform, tested as the oriented box it
+    // becomes instead of the world AABB around it
+    bool OBBInFrustum(const glm::mat4& transform, const glm::vec3& localMin,
+                      const glm::vec3& localMax) const;
 
 
     // Position and orientation control
@@ -59,6 +63,8 @@ public:
     float GetFarClip() const { return m_FarClip; }
     float GetAspectRatio() const { return m_AspectRatio; }
     float GetFOV() const { return m_FOV; }
+    // Height of the target in pixels, 0 until SetViewport is called
+    float GetViewportHeight() const { return m_ViewportHeight; }
 
     // Debug functions
     void DebugFrustum() const;
@@ -76,6 +82,7 @@ private:
     float m_AspectRatio = 1.778f;
     float m_NearClip = 0.1f;
     float m_FarClip = 1000.0f;
+    float m_ViewportHeight = 0.0f;
 
     // View and projection matrices
     glm::mat4 m_ViewMatrix = glm::mat4(1.0f);
@@ -0,0 +1,250 @@
+#include "Core/Debug/FlightRecorder.h"
+
+#include "Core/Debug/FrameTelemetry.h"
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Log/Felog.h"
+#include "Core/Threading/JobSystem.h"
+#include <spdlog/details/os.h>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Ring of the latest log lines. Every entry keeps its string storage,
+    // so logging in the steady state does not allocate.
+    class FlightRecorderLogSink : public spdlog::sinks::base_sink<LogSinkMutex>
+    {
+    public:
+        explicit FlightRecorderLogSink(uint32_t capacity)
+            : m_Lines(std::max(capacity, 1u))
+        {
+            for (LogLine& line : m_Lines)
+                line.Text.reserve(FlightRecorder::MaxLogLineLength);
+        }
+
+        void AppendTo(std::vector<uint8_t>& block, uint64_t fromSteady)
+        {
+            ForgeLockGuard lock(mutex_);
+            uint64_t count = std::min<uint64_t>(m_Written, m_Lines.size());
+            for (uint64_t i = m_Written - count; i < m_Written; i++)
+            {
+                const LogLine& line = m_Lines[i % m_Lines.size()];
+                if (line.Steady < fromSteady) continue;
+
+                block.push_back((uint8_t)TraceFormat::RecordType::LogLine);
+                TraceFormat::Append(block, line.Steady);
+                block.push_back(line.Level);
+                TraceFormat::AppendText(block, line.Text);
+            }
+        }
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg& msg) override
+        {
+            // Log lines carry wall clock time, the trace runs on the steady clock
+            auto age = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now() - msg.time).count();
+
+            LogLine& line = m_Lines[m_Written++ % m_Lines.size()];
+            line.Steady = Instrumentor::SteadyNanoseconds() - (uint64_t)std::max<int64_t>(age, 0);
+            line.Level = (uint8_t)msg.level;
+            line.Text.assign(msg.logger_name.data(), msg.logger_name.size());
+            line.Text += ": ";
+            size_t room = FlightRecorder::MaxLogLineLength - std::min<size_t>(
+                line.Text.size(), FlightRecorder::MaxLogLineLength);
+            line.Text.append(msg.payload.data(), std::min(msg.payload.size(), room));
+        }
+
+        void flush_() override {}
+
+    private:
+        struct LogLine
+        {
+            uint64_t Steady = 0;
+            uint8_t Level = 0;
+            std::string Text;
+        };
+
+        std::vector<LogLine> m_Lines;
+        uint64_t m_Written = 0;
+    };
+
+    struct FlightRecorderData
+    {
+        ForgeMutex Mutex{"FlightRecorder"};
+        bool Active = false;
+        FlightRecorderSpecification Specification;
+        std::shared_ptr<FlightRecorderLogSink> LogSink;
+        std::vector<FrameRecord> Frames;
+        uint64_t LastCaptureSteady = 0;
+        uint32_t CaptureCount = 0;
+        std::string LastCapturePath;
+    };
+
+    static FlightRecorderData s_FlightData;
+
+    static uint64_t FlightSecondsToNanoseconds(float seconds)
+    {
+        return (uint64_t)(std::max(seconds, 0.0f) * 1e9);
+    }
+
+    // Note: you must own s_FlightData.Mutex. marker is the steady time the
+    // annotation points at.
+    static std::string CaptureFlightRecord(const std::string& reason, uint64_t marker)
+    {
+        FlightRecorderData& data = s_FlightData;
+        const FlightRecorderSpecification& specification = data.Specification;
+
+        uint64_t now = Instrumentor::SteadyNanoseconds();
+        uint64_t window = std::min(FlightSecondsToNanoseconds(specification.WindowSeconds), now);
+        uint64_t from = now - window;
+
+        auto block = std::make_shared<std::vector<uint8_t>>();
+        Instrumentor::Get().CaptureFlightRecording("Flight Record", window, *block);
+
+        uint32_t frameCount = FrameTelemetry::GetHistory(data.Frames.data(),
+                                                         (uint32_t)data.Frames.size());
+        for (uint32_t i = 0; i < frameCount; i++)
+        {
+            const FrameRecord& frame = data.Frames[i];
+            if (frame.EndNanoseconds < from) continue;
+
+            TraceFormat::FrameMarker frameMarker;
+            frameMarker.Index = frame.FrameIndex;
+            frameMarker.End = frame.EndNanoseconds;
+            frameMarker.Begin = frameMarker.End - std::min<uint64_t>(
+                (uint64_t)((double)frame.FrameMs * 1e6), frameMarker.End);
+            frameMarker.Hitch = frame.Hitch
+                || (specification.HitchThresholdMs > 0.0f
+                    && frame.FrameMs >= specification.HitchThresholdMs);
+            block->push_back((uint8_t)TraceFormat::RecordType::Frame);
+            TraceFormat::Append(*block, frameMarker);
+        }
+
+        data.LogSink->AppendTo(*block, from);
+
+        block->push_back((uint8_t)TraceFormat::RecordType::Annotation);
+        TraceFormat::Append(*block, marker);
+        TraceFormat::AppendText(*block, reason);
+
+        std::tm time = spdlog::details::os::localtime();
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &time);
+        std::string path = (std::filesystem::path(specification.OutputDirectory)
+            / ("FlightRecord-" + std::string(stamp) + "-" + std::to_string(data.CaptureCount)
+               + ".ftrace")).string();
+
+        data.CaptureCount++;
+        data.LastCapturePath = path;
+        data.LastCaptureSteady = now;
+
+        // Writing can take longer than a frame, keep it off the caller
+        JobSystem::Submit([block, path]() {
+            FENGINE_PROFILE_SCOPE("FlightRecorder Write");
+            std::ofstream out(path, std::ios::binary);
+            if (!out)
+            {
+                FENGINE_CORE_ERROR("FlightRecorder: could not write '{}'", path);
+                return;
+            }
+            out.write((const char*)block->data(), (std::streamsize)block->size());
+        });
+
+        FENGINE_CORE_WARN("FlightRecorder: {}, captured the last {:.1f} s to '{}'", reason,
+                          (double)window / 1e9, path);
+        return path;
+    }
+
+    void FlightRecorder::Init(const FlightRecorderSpecification& specification)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        FlightRecorderData& data = s_FlightData;
+        ForgeLockGuard lock(data.Mutex);
+        if (data.Active) return;
+
+        std::error_code error;
+        std::filesystem::create_directories(specification.OutputDirectory, error);
+        if (error)
+        {
+            FENGINE_CORE_ERROR("FlightRecorder: could not create '{}': {}",
+                               specification.OutputDirectory, error.message());
+            return;
+        }
+
+        data.Specification = specification;
+        data.Frames.resize(FrameTelemetry::Capacity);
+        data.LogSink = std::make_shared<FlightRecorderLogSink>(specification.LogCapacity);
+        data.LogSink->set_level(spdlog::level::trace);
+        Felog::AddSink(data.LogSink);
+        Instrumentor::Get().SetFlightRecording(true);
+        data.Active = true;
+    }
+
+    void FlightRecorder::Shutdown()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        FlightRecorderData& data = s_FlightData;
+        ForgeLockGuard lock(data.Mutex);
+        if (!data.Active) return;
+
+        Instrumentor::Get().SetFlightRecording(false);
+        Felog::RemoveSink(data.LogSink);
+        data.LogSink.reset();
+        data.Frames.clear();
+        data.Frames.shrink_to_fit();
+        data.Active = false;
+    }
+
+    bool FlightRecorder::IsActive()
+    {
+        ForgeLockGuard lock(s_FlightData.Mutex);
+        return s_FlightData.Active;
+    }
+
+    void FlightRecorder::OnFrame(const FrameRecord& frame)
+    {
+        FlightRecorderData& data = s_FlightData;
+        float threshold = data.Specification.HitchThresholdMs;
+        if (threshold <= 0.0f || frame.FrameMs < threshold) return;
+
+        ForgeLockGuard lock(data.Mutex);
+        if (!data.Active) return;
+
+        // A run of slow frames, like a loading screen, captures once
+        uint64_t cooldown = FlightSecondsToNanoseconds(data.Specification.CooldownSeconds);
+        if (data.CaptureCount > 0 && frame.EndNanoseconds - data.LastCaptureSteady < cooldown)
+            return;
+
+        char reason[96];
+        std::snprintf(reason, sizeof(reason), "Frame %llu took %.1f ms",
+                      (unsigned long long)frame.FrameIndex, frame.FrameMs);
+        uint64_t frameMs = (uint64_t)((double)frame.FrameMs * 1e6);
+        CaptureFlightRecord(reason, frame.EndNanoseconds - std::min(frameMs, frame.EndNanoseconds));
+    }
+
+    std::string FlightRecorder::Trigger(const std::string& reason)
+    {
+        ForgeLockGuard lock(s_FlightData.Mutex);
+        if (!s_FlightData.Active) return {};
+        return CaptureFlightRecord(reason, Instrumentor::SteadyNanoseconds());
+    }
+
+    uint32_t FlightRecorder::GetCaptureCount()
+    {
+        ForgeLockGuard lock(s_FlightData.Mutex);
+        return s_FlightData.CaptureCount;
+    }
+
+    std::string FlightRecorder::GetLastCapturePath()
+    {
+        ForgeLockGuard lock(s_FlightData.Mutex);
+        return s_FlightData.LastCapturePath;
+    }
+} // namespace ForgeEngine
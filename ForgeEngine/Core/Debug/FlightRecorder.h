@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ForgeEngine
+{
+    struct FrameRecord;
+
+    struct FlightRecorderSpecification
+    {
+        // How far back a capture reaches. Profile scopes are also bounded by
+        // the per thread buffers of the Instrumentor (32768 events each).
+        float WindowSeconds = 5.0f;
+        // Frames longer than this trigger a capture, 0 only captures on
+        // request
+        float HitchThresholdMs = 100.0f;
+        // Minimum time between two automatic captures
+        float CooldownSeconds = 10.0f;
+        // Log lines kept, each cut to MaxLogLineLength characters
+        uint32_t LogCapacity = 1024;
+        std::string OutputDirectory = ".";
+    };
+
+    // Always-on recording of the last few seconds: profile scopes stay in
+    // the Instrumentor buffers, log lines and frame telemetry in fixed rings.
+    // A slow frame, a call to Trigger or the capture hotkey writes that
+    // window to a FlightRecord-*.ftrace file next to the other traces, with
+    // the cause annotated; Tools/TraceConverter reads it like a session.
+    class FlightRecorder
+    {
+    public:
+        static constexpr uint32_t MaxLogLineLength = 256;
+
+        static void Init(const FlightRecorderSpecification& specification = {});
+        static void Shutdown();
+        static bool IsActive();
+
+        // Application loop, after the frame was submitted to FrameTelemetry
+        static void OnFrame(const FrameRecord& frame);
+
+        // Captures the window now from any thread, the file is written on a
+        // job. Returns its path, empty when the recorder is not running.
+        static std::string Trigger(const std::string& reason);
+
+        static uint32_t GetCaptureCount();
+        static std::string GetLastCapturePath();
+    };
+} // namespace ForgeEngine
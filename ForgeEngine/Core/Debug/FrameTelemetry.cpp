@@ -0,0 +1,287 @@
+#include "Core/Debug/FrameTelemetry.h"
+
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Log/Felog.h"
+#include "Core/Threading/ForgeMutex.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace ForgeEngine
+{
+    // Weight of the newest frame in the running average hitches are
+    // measured against, roughly the last 20 frames
+    static constexpr float s_HitchAverageWeight = 0.05f;
+
+    struct FrameTelemetryData
+    {
+        FrameRecord Frames[FrameTelemetry::Capacity];
+        // Frames submitted so far; the newest record is Written - 1
+        std::atomic<uint64_t> Written{0};
+        float AverageMs = 0.0f;
+        std::atomic<float> HitchFactor{2.0f};
+        std::atomic<uint64_t> TotalHitches{0};
+
+        std::atomic<float> Counters[FrameRecord::MaxCounters] = {};
+        ForgeMutex CounterMutex{"FrameTelemetry Counters"};
+        std::vector<std::string> CounterNames;
+    };
+
+    static FrameTelemetryData s_TelemetryData;
+
+    void FrameTelemetry::Submit(FrameRecord& record)
+    {
+        FrameTelemetryData& data = s_TelemetryData;
+
+        float average = data.AverageMs;
+        record.Hitch = average > 0.0f
+            && record.FrameMs > average * data.HitchFactor.load(std::memory_order_relaxed);
+        // A lasting slowdown is taken into the average within a few dozen
+        // frames instead of counting as a hitch forever
+        data.AverageMs = average > 0.0f
+            ? average + s_HitchAverageWeight * (record.FrameMs - average)
+            : record.FrameMs;
+        if (record.Hitch)
+            data.TotalHitches.fetch_add(1, std::memory_order_relaxed);
+
+        for (uint32_t i = 0; i < FrameRecord::MaxCounters; i++)
+            record.Counters[i] = data.Counters[i].load(std::memory_order_relaxed);
+
+        uint64_t index = data.Written.load(std::memory_order_relaxed);
+        record.FrameIndex = index;
+        record.EndNanoseconds = Instrumentor::SteadyNanoseconds();
+        data.Frames[index % Capacity] = record;
+        data.Written.store(index + 1, std::memory_order_release);
+    }
+
+    uint32_t FrameTelemetry::GetHistory(FrameRecord* out, uint32_t maxCount)
+    {
+        FrameTelemetryData& data = s_TelemetryData;
+
+        // One slot is kept free for the record the loop may be writing
+        uint64_t end = data.Written.load(std::memory_order_acquire);
+        uint32_t count = (uint32_t)std::min<uint64_t>({end, Capacity - 1, maxCount});
+        uint64_t begin = end - count;
+        for (uint32_t i = 0; i < count; i++)
+            out[i] = data.Frames[(begin + i) % Capacity];
+
+        // Records the loop moved past while they were copied are torn,
+        // everything newer than the oldest live slot is intact
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = data.Written.load(std::memory_order_relaxed);
+        if (after >= Capacity && after - Capacity + 1 > begin)
+        {
+            uint64_t torn = after - Capacity + 1 - begin;
+            if (torn >= count) return 0;
+            std::memmove(out, out + torn, (count - torn) * sizeof(FrameRecord));
+            count -= (uint32_t)torn;
+        }
+        return count;
+    }
+
+    FrameTimeSummary FrameTelemetry::GetSummary(uint32_t frameCount)
+    {
+        std::vector<FrameRecord> frames(std::min(frameCount, Capacity));
+        uint32_t count = GetHistory(frames.data(), (uint32_t)frames.size());
+
+        FrameTimeSummary summary;
+        summary.TotalHitches = s_TelemetryData.TotalHitches.load(std::memory_order_relaxed);
+        if (count == 0) return summary;
+
+        std::vector<float> times(count);
+        double totalMs = 0.0, totalGpuMs = 0.0;
+        uint32_t gpuFrames = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const FrameRecord& frame = frames[i];
+            times[i] = frame.FrameMs;
+            totalMs += frame.FrameMs;
+            if (frame.GpuMs >= 0.0f)
+            {
+                totalGpuMs += frame.GpuMs;
+                gpuFrames++;
+            }
+            if (frame.Hitch) summary.Hitches++;
+        }
+        std::sort(times.begin(), times.end());
+
+        // Nearest rank, so a percentile is always a frame that happened
+        auto percentile = [&](float p) {
+            uint32_t rank = (uint32_t)std::ceil(p * (float)count);
+            return times[std::clamp(rank, 1u, count) - 1];
+        };
+
+        summary.Frames = count;
+        summary.AverageMs = (float)(totalMs / count);
+        summary.MinMs = times.front();
+        summary.MaxMs = times.back();
+        summary.P50Ms = percentile(0.50f);
+        summary.P95Ms = percentile(0.95f);
+        summary.P99Ms = percentile(0.99f);
+        summary.AverageFps = summary.AverageMs > 0.0f ? 1000.0f / summary.AverageMs : 0.0f;
+        if (gpuFrames)
+            summary.AverageGpuMs = (float)(totalGpuMs / gpuFrames);
+        return summary;
+    }
+
+    uint64_t FrameTelemetry::GetFrameCount()
+    {
+        return s_TelemetryData.Written.load(std::memory_order_acquire);
+    }
+
+    void FrameTelemetry::SetHitchFactor(float factor)
+    {
+        s_TelemetryData.HitchFactor.store(std::max(factor, 1.0f), std::memory_order_relaxed);
+    }
+
+    float FrameTelemetry::GetHitchFactor()
+    {
+        return s_TelemetryData.HitchFactor.load(std::memory_order_relaxed);
+    }
+
+    uint32_t FrameTelemetry::RegisterCounter(const std::string& name)
+    {
+        FrameTelemetryData& data = s_TelemetryData;
+        ForgeLockGuard lock(data.CounterMutex);
+
+        auto it = std::find(data.CounterNames.begin(), data.CounterNames.end(), name);
+        if (it != data.CounterNames.end())
+            return (uint32_t)(it - data.CounterNames.begin());
+
+        if (data.CounterNames.size() >= FrameRecord::MaxCounters)
+        {
+            FENGINE_CORE_ERROR("FrameTelemetry: no counter slot left for '{}', {} are in use",
+                               name, FrameRecord::MaxCounters);
+            return InvalidCounter;
+        }
+
+        data.CounterNames.push_back(name);
+        return (uint32_t)data.CounterNames.size() - 1;
+    }
+
+    void FrameTelemetry::SetCounter(uint32_t counter, float value)
+    {
+        if (counter >= FrameRecord::MaxCounters) return;
+        s_TelemetryData.Counters[counter].store(value, std::memory_order_relaxed);
+    }
+
+    void FrameTelemetry::AddCounter(uint32_t counter, float value)
+    {
+        if (counter >= FrameRecord::MaxCounters) return;
+        s_TelemetryData.Counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::vector<std::string> FrameTelemetry::GetCounterNames()
+    {
+        ForgeLockGuard lock(s_TelemetryData.CounterMutex);
+        return s_TelemetryData.CounterNames;
+    }
+
+    static std::vector<FrameRecord> CopyTelemetryHistory()
+    {
+        std::vector<FrameRecord> frames(FrameTelemetry::Capacity);
+        frames.resize(FrameTelemetry::GetHistory(frames.data(), (uint32_t)frames.size()));
+        return frames;
+    }
+
+    bool FrameTelemetry::ExportCsv(const std::string& filepath)
+    {
+        std::ofstream out(filepath);
+        if (!out)
+        {
+            FENGINE_CORE_ERROR("FrameTelemetry: could not write '{}'", filepath);
+            return false;
+        }
+
+        std::vector<FrameRecord> frames = CopyTelemetryHistory();
+        std::vector<std::string> counters = GetCounterNames();
+
+        out << "frame,frame_ms,update_ms,render_ms,swap_ms,gpu_ms,draw_calls,instances,"
+               "visible_objects,culled_objects,hitch";
+        for (const std::string& name : counters)
+            out << ',' << name;
+        out << '\n';
+
+        for (const FrameRecord& frame : frames)
+        {
+            out << frame.FrameIndex << ',' << frame.FrameMs << ',' << frame.UpdateMs << ','
+                << frame.RenderMs << ',' << frame.SwapMs << ',';
+            if (frame.GpuMs >= 0.0f) out << frame.GpuMs;
+            out << ',' << frame.DrawCalls << ',' << frame.Instances << ','
+                << frame.VisibleObjects << ',' << frame.CulledObjects << ','
+                << (frame.Hitch ? 1 : 0);
+            for (size_t i = 0; i < counters.size(); i++)
+                out << ',' << frame.Counters[i];
+            out << '\n';
+        }
+
+        FENGINE_CORE_INFO("FrameTelemetry: wrote {} frames to '{}'", frames.size(), filepath);
+        return true;
+    }
+
+    static void WriteTelemetryJsonString(std::ofstream& out, const std::string& text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if ((unsigned char)c < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+
+    bool FrameTelemetry::ExportJson(const std::string& filepath)
+    {
+        std::ofstream out(filepath);
+        if (!out)
+        {
+            FENGINE_CORE_ERROR("FrameTelemetry: could not write '{}'", filepath);
+            return false;
+        }
+
+        std::vector<FrameRecord> frames = CopyTelemetryHistory();
+        std::vector<std::string> counters = GetCounterNames();
+        FrameTimeSummary summary = GetSummary(Capacity);
+
+        out << "{\"summary\":{\"frames\":" << summary.Frames
+            << ",\"average_ms\":" << summary.AverageMs << ",\"min_ms\":" << summary.MinMs
+            << ",\"max_ms\":" << summary.MaxMs << ",\"p50_ms\":" << summary.P50Ms
+            << ",\"p95_ms\":" << summary.P95Ms << ",\"p99_ms\":" << summary.P99Ms
+            << ",\"average_fps\":" << summary.AverageFps << ",\"hitches\":" << summary.Hitches
+            << ",\"total_hitches\":" << summary.TotalHitches << "},\n\"counters\":[";
+        for (size_t i = 0; i < counters.size(); i++)
+        {
+            if (i) out << ',';
+            WriteTelemetryJsonString(out, counters[i]);
+        }
+        out << "],\n\"frames\":[";
+
+        for (size_t f = 0; f < frames.size(); f++)
+        {
+            const FrameRecord& frame = frames[f];
+            out << (f ? ",\n" : "\n") << "{\"frame\":" << frame.FrameIndex
+                << ",\"frame_ms\":" << frame.FrameMs << ",\"update_ms\":" << frame.UpdateMs
+                << ",\"render_ms\":" << frame.RenderMs << ",\"swap_ms\":" << frame.SwapMs;
+            if (frame.GpuMs >= 0.0f) out << ",\"gpu_ms\":" << frame.GpuMs;
+            out << ",\"draw_calls\":" << frame.DrawCalls << ",\"instances\":" << frame.Instances
+                << ",\"visible_objects\":" << frame.VisibleObjects
+                << ",\"culled_objects\":" << frame.CulledObjects
+                << ",\"hitch\":" << (frame.Hitch ? "true" : "false");
+            if (!counters.empty())
+            {
+                out << ",\"counters\":[";
+                for (size_t i = 0; i < counters.size(); i++)
+                    out << (i ? "," : "") << frame.Counters[i];
+                out << ']';
+            }
+            out << '}';
+        }
+        out << "]}\n";
+
+        FENGINE_CORE_INFO("FrameTelemetry: wrote {} frames to '{}'", frames.size(), filepath);
+        return true;
+    }
+} // namespace ForgeEngine
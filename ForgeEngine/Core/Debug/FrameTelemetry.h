@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // One frame as seen by the application loop. Times are milliseconds.
+    struct FrameRecord
+    {
+        static constexpr uint32_t MaxCounters = 8;
+
+        uint64_t FrameIndex = 0;
+        uint64_t EndNanoseconds = 0; // steady clock, when it was submitted
+        float FrameMs = 0.0f;
+        float UpdateMs = 0.0f; // layer updates, scene submission included
+        float RenderMs = 0.0f; // ImGui build and draw
+        float SwapMs = 0.0f;   // event polling and buffer swap
+        // Latest resolved GPU frame, it trails the CPU by the GPU profiler
+        // latency. Negative when no GPU timings are available.
+        float GpuMs = -1.0f;
+        uint32_t DrawCalls = 0;
+        uint32_t Instances = 0;
+        uint32_t VisibleObjects = 0;
+        uint32_t CulledObjects = 0;
+        bool Hitch = false;
+        float Counters[MaxCounters] = {};
+    };
+
+    struct FrameTimeSummary
+    {
+        uint32_t Frames = 0;
+        float AverageMs = 0.0f;
+        float MinMs = 0.0f;
+        float MaxMs = 0.0f;
+        float P50Ms = 0.0f;
+        float P95Ms = 0.0f;
+        float P99Ms = 0.0f;
+        float AverageFps = 0.0f;
+        float AverageGpuMs = -1.0f;
+        uint32_t Hitches = 0;      // inside the summarized window
+        uint64_t TotalHitches = 0; // since startup
+    };
+
+    // Engine wide frame history. The application loop submits one record per
+    // frame into a fixed ring; readers on any thread copy the newest frames
+    // out without taking a lock and without stalling the loop. A frame is a
+    // hitch when it takes HitchFactor times longer than the running average.
+    class FrameTelemetry
+    {
+    public:
+        static constexpr uint32_t Capacity = 4096;
+        static constexpr uint32_t InvalidCounter = ~0u;
+
+        // Main thread only. Fills in FrameIndex, EndNanoseconds, Hitch and
+        // the counters.
+        static void Submit(FrameRecord& record);
+
+        // Copies up to maxCount of the newest frames into out, oldest first,
+        // and returns how many were copied
+        static uint32_t GetHistory(FrameRecord* out, uint32_t maxCount);
+        static FrameTimeSummary GetSummary(uint32_t frameCount = 600);
+        static uint64_t GetFrameCount();
+
+        static void SetHitchFactor(float factor);
+        static float GetHitchFactor();
+
+        // Named values sampled into every frame record. Registering a name
+        // twice returns the same slot; InvalidCounter when all are taken.
+        static uint32_t RegisterCounter(const std::string& name);
+        static void SetCounter(uint32_t counter, float value);
+        static void AddCounter(uint32_t counter, float value);
+        static std::vector<std::string> GetCounterNames();
+
+        // Whole history, oldest first. Logs and returns false when the file
+        // cannot be written.
+        static bool ExportCsv(const std::string& filepath);
+        static bool ExportJson(const std::string& filepath);
+    };
+} // namespace ForgeEngine
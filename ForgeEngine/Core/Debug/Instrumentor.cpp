@@ -0,0 +1,360 @@
+#include "Core/Debug/Instrumentor.h"
+
+#include "Core/Log/Felog.h"
+#include "Core/System/CpuInfo.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ForgeEngine {
+    // How often the writer wakes to drain the buffers. A ring holds 32768
+    // events, so a thread has to record more than 3 million scopes a second
+    // before it drops any.
+    static constexpr std::chrono::milliseconds s_WriterInterval{10};
+
+    static void AppendTraceHeader(std::vector<uint8_t>& block, const std::string& name)
+    {
+        TraceFormat::FileHeader header;
+        std::memcpy(header.Magic, TraceFormat::Magic, sizeof(header.Magic));
+        header.Version = TraceFormat::Version;
+        header.NameLength = (uint32_t)name.size();
+        TraceFormat::Append(block, header);
+        block.insert(block.end(), name.begin(), name.end());
+    }
+
+    static void AppendTraceClock(std::vector<uint8_t>& block, uint64_t ticks, uint64_t steady)
+    {
+        block.push_back((uint8_t)TraceFormat::RecordType::Clock);
+        TraceFormat::Append(block, TraceFormat::ClockSample{ticks, steady});
+    }
+
+    static void AppendTraceString(std::vector<uint8_t>& block, const char* name)
+    {
+        block.push_back((uint8_t)TraceFormat::RecordType::String);
+        TraceFormat::Append(block, (uint64_t)(uintptr_t)name);
+        TraceFormat::AppendText(block, name);
+    }
+
+    static void AppendTraceThreadName(std::vector<uint8_t>& block, uint32_t thread,
+                                      const std::string& name)
+    {
+        block.push_back((uint8_t)TraceFormat::RecordType::ThreadName);
+        TraceFormat::Append(block, thread);
+        TraceFormat::AppendText(block, name);
+    }
+
+    static void AppendTraceEvents(std::vector<uint8_t>& block, uint32_t thread,
+                                  TraceFormat::EventClock clock,
+                                  const std::vector<TraceFormat::Event>& events)
+    {
+        block.push_back((uint8_t)TraceFormat::RecordType::Events);
+        TraceFormat::Append(block, thread);
+        block.push_back((uint8_t)clock);
+        TraceFormat::Append(block, (uint32_t)events.size());
+        block.insert(block.end(), (const uint8_t*)events.data(),
+                     (const uint8_t*)(events.data() + events.size()));
+    }
+
+    Instrumentor::Instrumentor()
+    {
+        s_UseTsc = CpuInfo::Get().InvariantTSC;
+        m_StartTicks = Now();
+        m_StartSteady = SteadyNanoseconds();
+        m_GpuBuffer = CreateBuffer("GPU");
+        m_GpuBuffer->Clock = TraceFormat::EventClock::SteadyNanoseconds;
+    }
+
+    Instrumentor::~Instrumentor() { EndSession(); }
+
+    void Instrumentor::BeginSession(const std::string& name,
+                                    const std::string& filepath)
+    {
+        ForgeLockGuard lock(m_SessionMutex);
+        if (m_SessionOpen) {
+            // If there is already a current session, then close it before
+            // beginning new one. Subsequent profiling output meant for the
+            // original session will end up in the newly opened session
+            // instead.  That's better than having badly formatted profiling
+            // output.
+            if (Felog::GetCoreLogger()) // Edge case: BeginSession() might
+                                        // be before Felog::Init()
+            {
+                FENGINE_CORE_ERROR("Instrumentor::BeginSession('{0}') when "
+                                   "session '{1}' already open.",
+                                   name, m_SessionName);
+            }
+            InternalEndSession();
+        }
+
+        m_OutputStream.open(filepath, std::ios::binary);
+        if (!m_OutputStream.is_open()) {
+            if (Felog::GetCoreLogger()) // Edge case: BeginSession() might
+                                        // be before Felog::Init()
+            {
+                FENGINE_CORE_ERROR(
+                        "Instrumentor could not open results file '{0}'.",
+                        filepath);
+            }
+            return;
+        }
+
+        m_SessionName = name;
+        m_SessionOpen = true;
+        // Flight recording pauses, the session drains the buffers now
+        s_Overwrite.store(false, std::memory_order_release);
+
+        m_Block.clear();
+        AppendTraceHeader(m_Block, name);
+        m_SessionStartTicks = Now();
+        m_SessionStartSteady = SteadyNanoseconds();
+        AppendTraceClock(m_Block, m_SessionStartTicks, m_SessionStartSteady);
+        m_OutputStream.write((const char*)m_Block.data(), (std::streamsize)m_Block.size());
+        m_Block.clear();
+
+        // Events left over from before the session are skipped
+        m_WrittenNames.clear();
+        {
+            ForgeLockGuard bufferLock(m_BufferMutex);
+            for (auto& buffer : m_Buffers) {
+                buffer->Tail.store(buffer->Head.load(std::memory_order_acquire),
+                                   std::memory_order_release);
+                buffer->Dropped.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        m_StopWriter = false;
+        m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+        UpdateRecording();
+    }
+
+    void Instrumentor::EndSession()
+    {
+        ForgeLockGuard lock(m_SessionMutex);
+        InternalEndSession();
+    }
+
+    // Note: you must already own lock on m_SessionMutex before calling
+    // InternalEndSession()
+    void Instrumentor::InternalEndSession()
+    {
+        if (!m_SessionOpen) return;
+
+        s_Recording.store(false, std::memory_order_release);
+
+        {
+            ForgeLockGuard writerLock(m_WriterMutex);
+            m_StopWriter = true;
+        }
+        m_WriterWake.notify_one();
+        m_Writer.join();
+
+        // Scopes that were open when recording stopped still land here
+        Drain();
+
+        {
+            ForgeLockGuard bufferLock(m_BufferMutex);
+            for (auto& buffer : m_Buffers) {
+                uint32_t index = buffer->ThreadIndex;
+                AppendTraceThreadName(m_Block, index, m_ThreadNames[index]);
+
+                uint32_t dropped = buffer->Dropped.exchange(0, std::memory_order_relaxed);
+                if (dropped) {
+                    m_Block.push_back((uint8_t)TraceFormat::RecordType::Dropped);
+                    TraceFormat::Append(m_Block, index);
+                    TraceFormat::Append(m_Block, dropped);
+                }
+            }
+        }
+        AppendTraceClock(m_Block, Now(), SteadyNanoseconds());
+
+        m_OutputStream.write((const char*)m_Block.data(), (std::streamsize)m_Block.size());
+        m_Block.clear();
+        m_OutputStream.close();
+        m_SessionOpen = false;
+        UpdateRecording();
+    }
+
+    void Instrumentor::SetEnabled(bool enabled)
+    {
+        ForgeLockGuard lock(m_SessionMutex);
+        m_Enabled.store(enabled, std::memory_order_relaxed);
+        UpdateRecording();
+    }
+
+    void Instrumentor::SetFlightRecording(bool enabled)
+    {
+        ForgeLockGuard lock(m_SessionMutex);
+        m_FlightRecording = enabled;
+        UpdateRecording();
+    }
+
+    void Instrumentor::UpdateRecording()
+    {
+        bool overwrite = m_FlightRecording && !m_SessionOpen;
+        s_Overwrite.store(overwrite, std::memory_order_release);
+        s_Recording.store(m_Enabled.load(std::memory_order_relaxed)
+                                  && (m_SessionOpen || overwrite),
+                          std::memory_order_release);
+    }
+
+    void Instrumentor::CaptureFlightRecording(const std::string& name,
+                                              uint64_t windowNanoseconds,
+                                              std::vector<uint8_t>& block)
+    {
+        uint64_t nowTicks = Now();
+        uint64_t nowSteady = SteadyNanoseconds();
+
+        // The window start in ticks comes from the rate measured since
+        // startup, the converter gets it back from the two clock records
+        uint64_t window = std::min(windowNanoseconds, nowSteady - m_StartSteady);
+        double ticksPerNanosecond = nowSteady > m_StartSteady
+                ? (double)(nowTicks - m_StartTicks) / (double)(nowSteady - m_StartSteady)
+                : 1.0;
+        uint64_t fromSteady = nowSteady - window;
+        uint64_t fromTicks = nowTicks - (uint64_t)((double)window * ticksPerNanosecond);
+
+        AppendTraceHeader(block, name);
+        AppendTraceClock(block, fromTicks, fromSteady);
+
+        constexpr uint32_t Capacity = InstrumentorThreadBuffer::Capacity;
+        std::vector<InstrumentorEvent> copied(Capacity - 1);
+        std::vector<TraceFormat::Event> events;
+        std::unordered_set<const char*> writtenNames;
+
+        ForgeLockGuard lock(m_BufferMutex);
+        for (auto& buffer : m_Buffers) {
+            // Copy everything behind the head, the slot the thread may be
+            // writing is left out
+            uint32_t head = buffer->Head.load(std::memory_order_acquire);
+            uint32_t begin = head - (Capacity - 1);
+            for (uint32_t i = 0; i < Capacity - 1; i++)
+                copied[i] = buffer->Events[(begin + i) & (Capacity - 1)];
+
+            // Slots the thread lapped while they were copied are torn
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t lapped = buffer->Head.load(std::memory_order_relaxed) - head;
+            if (lapped >= Capacity - 1) continue;
+
+            bool steady = buffer->Clock == TraceFormat::EventClock::SteadyNanoseconds;
+            uint64_t from = steady ? fromSteady : fromTicks;
+
+            events.clear();
+            for (uint32_t i = lapped; i < Capacity - 1; i++) {
+                const InstrumentorEvent& event = copied[i];
+                // Slots never written yet, or events from before the window
+                if (!event.Name || event.Begin < from || event.End < event.Begin) continue;
+
+                if (writtenNames.insert(event.Name).second)
+                    AppendTraceString(block, event.Name);
+                events.push_back({(uint64_t)(uintptr_t)event.Name, event.Begin, event.End});
+            }
+
+            AppendTraceThreadName(block, buffer->ThreadIndex,
+                                  m_ThreadNames[buffer->ThreadIndex]);
+            if (!events.empty())
+                AppendTraceEvents(block, buffer->ThreadIndex, buffer->Clock, events);
+        }
+
+        AppendTraceClock(block, nowTicks, nowSteady);
+    }
+
+    void Instrumentor::WriteGpuProfile(const char* name,
+                                       FloatingPointMicroseconds start,
+                                       FloatingPointMicroseconds duration)
+    {
+        if (!IsRecording()) return;
+
+        uint64_t begin = (uint64_t)(start.count() * 1000.0);
+        m_GpuBuffer->Push(name, begin, begin + (uint64_t)(duration.count() * 1000.0),
+                          s_Overwrite.load(std::memory_order_relaxed));
+    }
+
+    void Instrumentor::SetThreadName(const std::string& name)
+    {
+        InstrumentorThreadBuffer* buffer = t_Buffer;
+        if (!buffer) buffer = RegisterThread();
+
+        Instrumentor& instrumentor = Get();
+        ForgeLockGuard lock(instrumentor.m_BufferMutex);
+        instrumentor.m_ThreadNames[buffer->ThreadIndex] = name;
+    }
+
+    InstrumentorThreadBuffer* Instrumentor::RegisterThread()
+    {
+        Instrumentor& instrumentor = Get();
+        ForgeLockGuard lock(instrumentor.m_BufferMutex);
+        t_Buffer = instrumentor.CreateBuffer(
+                "Thread " + std::to_string(instrumentor.m_Buffers.size()));
+        return t_Buffer;
+    }
+
+    // Note: callers other than the constructor must own m_BufferMutex
+    InstrumentorThreadBuffer* Instrumentor::CreateBuffer(const std::string& name)
+    {
+        auto buffer = std::make_unique<InstrumentorThreadBuffer>();
+        buffer->ThreadIndex = (uint32_t)m_Buffers.size();
+        m_ThreadNames.push_back(name);
+        m_Buffers.push_back(std::move(buffer));
+        return m_Buffers.back().get();
+    }
+
+    void Instrumentor::WriterLoop()
+    {
+        ForgeUniqueLock lock(m_WriterMutex);
+        while (!m_StopWriter) {
+            m_WriterWake.wait_for(lock, s_WriterInterval, [this] { return m_StopWriter; });
+
+            lock.unlock();
+            Drain();
+            AppendTraceClock(m_Block, Now(), SteadyNanoseconds());
+            m_OutputStream.write((const char*)m_Block.data(), (std::streamsize)m_Block.size());
+            m_Block.clear();
+            lock.lock();
+        }
+    }
+
+    void Instrumentor::Drain()
+    {
+        std::vector<InstrumentorThreadBuffer*> buffers;
+        {
+            ForgeLockGuard lock(m_BufferMutex);
+            buffers.reserve(m_Buffers.size());
+            for (auto& buffer : m_Buffers)
+                buffers.push_back(buffer.get());
+        }
+
+        for (InstrumentorThreadBuffer* buffer : buffers) {
+            uint32_t tail = buffer->Tail.load(std::memory_order_relaxed);
+            uint32_t head = buffer->Head.load(std::memory_order_acquire);
+            if (head == tail) continue;
+
+            // A thread that was still flight recording when the session
+            // began may have wrapped past the tail
+            if (head - tail > InstrumentorThreadBuffer::Capacity) {
+                buffer->Dropped.fetch_add(head - tail - InstrumentorThreadBuffer::Capacity,
+                                          std::memory_order_relaxed);
+                tail = head - InstrumentorThreadBuffer::Capacity;
+            }
+
+            bool steady = buffer->Clock == TraceFormat::EventClock::SteadyNanoseconds;
+            uint64_t sessionStart = steady ? m_SessionStartSteady : m_SessionStartTicks;
+
+            m_EventScratch.clear();
+            for (uint32_t i = tail; i != head; i++) {
+                const InstrumentorEvent& event
+                        = buffer->Events[i & (InstrumentorThreadBuffer::Capacity - 1)];
+                if (event.Begin < sessionStart) continue;
+
+                if (m_WrittenNames.insert(event.Name).second)
+                    AppendTraceString(m_Block, event.Name);
+
+                m_EventScratch.push_back(
+                        {(uint64_t)(uintptr_t)event.Name, event.Begin, event.End});
+            }
+            buffer->Tail.store(head, std::memory_order_release);
+
+            if (!m_EventScratch.empty())
+                AppendTraceEvents(m_Block, buffer->ThreadIndex, buffer->Clock,
+                                  m_EventScratch);
+        }
+    }
+} // namespace ForgeEngine
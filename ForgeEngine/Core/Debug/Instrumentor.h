@@ -1,96 +1,131 @@
 #pragma once
-#include "Core/Log/Felog.h"
-#include <algorithm>
+#include "Core/Debug/TraceFormat.h"
+#include "Core/Threading/ForgeMutex.h"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
-#include <iomanip>
-#include <mutex>
-#include <sstream>
+#include <memory>
 #include <string>
 #include <thread>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FENGINE_PROFILE_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Compile time verbosity: 0 strips every scope, 1 keeps FENGINE_PROFILE_SCOPE
+// and FENGINE_PROFILE_FUNCTION, 2 also keeps the FENGINE_PROFILE_DETAIL_*
+// scopes of calls made per draw, like uniform uploads and binds
+#ifndef FENGINE_PROFILE_LEVEL
+#define FENGINE_PROFILE_LEVEL 1
+#endif
+#define FENGINE_PROFILE (FENGINE_PROFILE_LEVEL > 0)
 
 namespace ForgeEngine {
     using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
 
-    struct ProfileResult {
-        std::string Name;
-
-        FloatingPointMicroseconds Start;
-        std::chrono::microseconds ElapsedTime;
-        std::thread::id ThreadID;
+    struct InstrumentorEvent {
+        const char* Name;
+        uint64_t Begin;
+        uint64_t End;
     };
 
-    struct InstrumentationSession {
-        std::string Name;
+    // Ring written only by its thread and read only by the writer thread.
+    // A full ring drops events instead of blocking the thread, unless it is
+    // flight recording, then the oldest events are overwritten.
+    struct InstrumentorThreadBuffer {
+        static constexpr uint32_t Capacity = 1u << 15;
+
+        alignas(64) std::atomic<uint32_t> Head{0};
+        alignas(64) std::atomic<uint32_t> Tail{0};
+        std::atomic<uint32_t> Dropped{0};
+        uint32_t ThreadIndex = 0;
+        TraceFormat::EventClock Clock = TraceFormat::EventClock::Ticks;
+        InstrumentorEvent Events[Capacity];
+
+        void Push(const char* name, uint64_t begin, uint64_t end, bool overwrite)
+        {
+            uint32_t head = Head.load(std::memory_order_relaxed);
+            if (!overwrite && head - Tail.load(std::memory_order_acquire) >= Capacity) {
+                Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Events[head & (Capacity - 1)] = {name, begin, end};
+            Head.store(head + 1, std::memory_order_release);
+        }
     };
 
+    // Scopes only store a static name pointer and two clock reads into the
+    // buffer of their thread. A background thread drains the buffers into
+    // a binary trace (see TraceFormat.h); Tools/TraceConverter turns it
+    // into Chrome / Perfetto JSON.
     class Instrumentor {
     public:
         Instrumentor(const Instrumentor&) = delete;
         Instrumentor(Instrumentor&&) = delete;
 
         void BeginSession(const std::string& name,
-                          const std::string& filepath = "results.json")
+                          const std::string& filepath = "results.ftrace");
+        void EndSession();
+
+        // Pauses recording without closing the session
+        void SetEnabled(bool enabled);
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        // Keeps scopes going into the buffers while no session is open, the
+        // buffers then always hold the most recent events of every thread
+        void SetFlightRecording(bool enabled);
+        bool IsFlightRecording() const { return m_FlightRecording; }
+
+        // Appends a complete trace of the last windowNanoseconds of every
+        // buffer to block. Does not disturb recording or an open session.
+        void CaptureFlightRecording(const std::string& name, uint64_t windowNanoseconds,
+                                    std::vector<uint8_t>& block);
+
+        // GPU scopes resolved frames later, start already on the steady
+        // clock. Only the thread that owns the GPU context may call this.
+        void WriteGpuProfile(const char* name, FloatingPointMicroseconds start,
+                             FloatingPointMicroseconds duration);
+
+        // Track name of the calling thread in the trace
+        static void SetThreadName(const std::string& name);
+
+        static bool IsRecording()
         {
-            std::lock_guard lock(m_Mutex);
-            if (m_CurrentSession) {
-                // If there is already a current session, then close it before
-                // beginning new one. Subsequent profiling output meant for the
-                // original session will end up in the newly opened session
-                // instead.  That's better than having badly formatted profiling
-                // output.
-                if (Felog::GetCoreLogger()) // Edge case: BeginSession() might
-                                            // be before Felog::Init()
-                {
-                    FENGINE_CORE_ERROR("Instrumentor::BeginSession('{0}') when "
-                                       "session '{1}' already open.",
-                                       name, m_CurrentSession->Name);
-                }
-                InternalEndSession();
-            }
-            m_OutputStream.open(filepath);
+            return s_Recording.load(std::memory_order_relaxed);
+        }
 
-            if (m_OutputStream.is_open()) {
-                m_CurrentSession = new InstrumentationSession({name});
-                WriteHeader();
-            }
-            else {
-                if (Felog::GetCoreLogger()) // Edge case: BeginSession() might
-                                            // be before Felog::Init()
-                {
-                    FENGINE_CORE_ERROR(
-                            "Instrumentor could not open results file '{0}'.",
-                            filepath);
-                }
-            }
+        // The TSC where it runs at a constant rate, steady clock
+        // nanoseconds otherwise; the trace carries the conversion
+        static uint64_t Now()
+        {
+#if FENGINE_PROFILE_TSC
+            if (s_UseTsc) return __rdtsc();
+#endif
+            return SteadyNanoseconds();
         }
 
-        void EndSession()
+        static uint64_t SteadyNanoseconds()
         {
-            std::lock_guard lock(m_Mutex);
-            InternalEndSession();
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
         }
 
-        void WriteProfile(const ProfileResult& result)
+        // name must be a static string, only its address is stored
+        static void Record(const char* name, uint64_t begin, uint64_t end)
         {
-            std::stringstream json;
-
-            json << std::setprecision(3) << std::fixed;
-            json << ",{";
-            json << "\"cat\":\"function\",";
-            json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-            json << "\"name\":\"" << result.Name << "\",";
-            json << "\"ph\":\"X\",";
-            json << "\"pid\":0,";
-            json << "\"tid\":" << result.ThreadID << ",";
-            json << "\"ts\":" << result.Start.count();
-            json << "}";
-
-            std::lock_guard lock(m_Mutex);
-            if (m_CurrentSession) {
-                m_OutputStream << json.str();
-                m_OutputStream.flush();
-            }
+            InstrumentorThreadBuffer* buffer = t_Buffer;
+            if (!buffer) buffer = RegisterThread();
+            buffer->Push(name, begin, end, s_Overwrite.load(std::memory_order_relaxed));
         }
 
         static Instrumentor& Get()
@@ -100,75 +135,79 @@ namespace ForgeEngine {
         }
 
     private:
-        Instrumentor(): m_CurrentSession(nullptr) {}
+        Instrumentor();
+        ~Instrumentor();
 
-        ~Instrumentor() { EndSession(); }
+        static InstrumentorThreadBuffer* RegisterThread();
+        InstrumentorThreadBuffer* CreateBuffer(const std::string& name);
 
-        void WriteHeader()
-        {
-            m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
-            m_OutputStream.flush();
-        }
+        void WriterLoop();
+        // Writer thread, or the session owner once the writer stopped
+        void Drain();
+        void InternalEndSession();
+        // Note: you must own m_SessionMutex
+        void UpdateRecording();
 
-        void WriteFooter()
-        {
-            m_OutputStream << "]}";
-            m_OutputStream.flush();
-        }
-
-        // Note: you must already own lock on m_Mutex before
-        // calling InternalEndSession()
-        void InternalEndSession()
-        {
-            if (m_CurrentSession) {
-                WriteFooter();
-                m_OutputStream.close();
-                delete m_CurrentSession;
-                m_CurrentSession = nullptr;
-            }
-        }
+        static inline std::atomic<bool> s_Recording{false};
+        static inline std::atomic<bool> s_Overwrite{false};
+        static inline bool s_UseTsc = false;
+        static inline thread_local InstrumentorThreadBuffer* t_Buffer = nullptr;
 
-    private:
-        std::mutex m_Mutex;
-        InstrumentationSession* m_CurrentSession;
+        // Session state, guarded by m_SessionMutex
+        // The profiler locks keep their statistics but never trace their
+        // waits, recording one could need the lock it waited for
+        ForgeMutex m_SessionMutex{"Instrumentor Session", false};
+        std::string m_SessionName;
         std::ofstream m_OutputStream;
+        bool m_SessionOpen = false;
+        std::atomic<bool> m_Enabled{true};
+        bool m_FlightRecording = false;
+        uint64_t m_SessionStartTicks = 0;
+        uint64_t m_SessionStartSteady = 0;
+
+        // Buffers are never freed, a thread may still hold its pointer
+        ForgeMutex m_BufferMutex{"Instrumentor Buffers", false};
+        std::vector<std::unique_ptr<InstrumentorThreadBuffer>> m_Buffers;
+        std::vector<std::string> m_ThreadNames;
+        InstrumentorThreadBuffer* m_GpuBuffer = nullptr;
+
+        // Clock pair taken at startup, flight captures measure the tick rate
+        // against it
+        uint64_t m_StartTicks = 0;
+        uint64_t m_StartSteady = 0;
+
+        // Owned by whoever drains: the writer thread, or EndSession after it
+        // has been joined
+        std::vector<uint8_t> m_Block;
+        std::vector<TraceFormat::Event> m_EventScratch;
+        std::unordered_set<const char*> m_WrittenNames;
+
+        std::thread m_Writer;
+        ForgeMutex m_WriterMutex{"Instrumentor Writer", false};
+        std::condition_variable_any m_WriterWake;
+        bool m_StopWriter = false;
     };
 
     class InstrumentationTimer {
     public:
-        InstrumentationTimer(const char* name): m_Name(name), m_Stopped(false)
+        explicit InstrumentationTimer(const char* name)
+            : m_Name(Instrumentor::IsRecording() ? name : nullptr),
+              m_Start(m_Name ? Instrumentor::Now() : 0)
         {
-            m_StartTimepoint = std::chrono::steady_clock::now();
         }
 
-        ~InstrumentationTimer()
-        {
-            if (!m_Stopped) Stop();
-        }
+        ~InstrumentationTimer() { Stop(); }
 
         void Stop()
         {
-            auto endTimepoint = std::chrono::steady_clock::now();
-            auto highResStart = FloatingPointMicroseconds{
-                    m_StartTimepoint.time_since_epoch()};
-            auto elapsedTime
-                    = std::chrono::time_point_cast<std::chrono::microseconds>(
-                              endTimepoint)
-                              .time_since_epoch()
-                      - std::chrono::time_point_cast<std::chrono::microseconds>(
-                                m_StartTimepoint)
-                                .time_since_epoch();
-
-            Instrumentor::Get().WriteProfile({m_Name, highResStart, elapsedTime,
-                                              std::this_thread::get_id()});
-
-            m_Stopped = true;
+            if (!m_Name) return;
+            Instrumentor::Record(m_Name, m_Start, Instrumentor::Now());
+            m_Name = nullptr;
         }
 
     private:
         const char* m_Name;
-        std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
-        bool m_Stopped;
+        uint64_t m_Start;
     };
 
     namespace InstrumentorUtils {
@@ -199,7 +238,6 @@ namespace ForgeEngine {
     } // namespace InstrumentorUtils
 } // namespace ForgeEngine
 
-#define FENGINE_PROFILE 1
 #if FENGINE_PROFILE
   // Resolve which function signature macro will be used. Note that this only
 // is resolved when the (pre)compiler starts, so the syntax highlighting
@@ -228,8 +266,11 @@ namespace ForgeEngine {
     ::ForgeEngine::Instrumentor::Get().BeginSession(name, filepath)
 #define FENGINE_PROFILE_END_SESSION()                                          \
     ::ForgeEngine::Instrumentor::Get().EndSession()
+#define FENGINE_PROFILE_THREAD(name)                                           \
+    ::ForgeEngine::Instrumentor::SetThreadName(name)
+// Static, the trace keeps the address of the name until it is written
 #define FENGINE_PROFILE_SCOPE_LINE2(name, line)                                \
-    constexpr auto fixedName##line                                             \
+    static constexpr auto fixedName##line                                      \
             = ::ForgeEngine::InstrumentorUtils::CleanupOutputString(           \
                     name, "__cdecl ");                                         \
     ::ForgeEngine::InstrumentationTimer timer##line(fixedName##line.Data)
@@ -240,6 +281,15 @@ namespace ForgeEngine {
 #else
 #define FENGINE_PROFILE_BEGIN_SESSION(name, filepath)
 #define FENGINE_PROFILE_END_SESSION()
+#define FENGINE_PROFILE_THREAD(name)
 #define FENGINE_PROFILE_SCOPE(name)
 #define FENGINE_PROFILE_FUNCTION()
+#endif
+
+#if FENGINE_PROFILE_LEVEL >= 2
+#define FENGINE_PROFILE_DETAIL_SCOPE(name) FENGINE_PROFILE_SCOPE(name)
+#define FENGINE_PROFILE_DETAIL_FUNCTION()  FENGINE_PROFILE_FUNCTION()
+#else
+#define FENGINE_PROFILE_DETAIL_SCOPE(name)
+#define FENGINE_PROFILE_DETAIL_FUNCTION()
 #endif
\ No newline at end of file
@@ -0,0 +1,606 @@
+#include "Core/Debug/SamplingProfiler.h"
+
+#include "Core/Debug/FrameTelemetry.h"
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Log/Felog.h"
+#include "Core/Threading/ForgeMutex.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+
+#if defined(FENGINE_PLATFORM_LINUX) && (defined(__x86_64__) || defined(__aarch64__))
+#define FENGINE_SAMPLING_SUPPORTED
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// Older glibc headers only have the union member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace ForgeEngine
+{
+    // Samples a thread can hold between two EndFrame calls, a second of
+    // busy time at the default rate
+    static constexpr uint32_t s_SampleRingCapacity = 1024;
+    // Samples kept once collected, newer ones count as dropped
+    static constexpr uint32_t s_MaxStoredSamples = 1u << 20;
+    static constexpr uint32_t s_MinFrequencyHz = 10;
+    static constexpr uint32_t s_MaxFrequencyHz = 10000;
+
+    struct ProfilerSample
+    {
+        uint32_t Depth = 0;
+        uintptr_t Frames[SamplingProfiler::MaxDepth]; // leaf first
+    };
+
+    struct SampledThread
+    {
+        std::string Name;
+        std::atomic<bool> Active{false};
+        // Written by the signal handler on the thread itself, read by
+        // EndFrame. Allocated once and kept, so the handler never sees it go.
+        std::unique_ptr<ProfilerSample[]> Ring;
+        std::atomic<uint32_t> Head{0};
+        std::atomic<uint32_t> Tail{0};
+        std::atomic<uint32_t> Dropped{0};
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        pid_t ThreadId = 0;
+        pthread_t Handle{};
+        uintptr_t StackLow = 0;
+        uintptr_t StackHigh = 0;
+        timer_t Timer{};
+        bool HasTimer = false;
+#endif
+    };
+
+    struct CollectedSample
+    {
+        uint64_t Frame = 0;
+        uint32_t Thread = 0;
+        uint32_t Stack = 0;
+    };
+
+    struct SamplingProfilerData
+    {
+        ForgeMutex Mutex{"SamplingProfiler"};
+        std::atomic<bool> Running{false};
+        uint32_t FrequencyHz = 0;
+        bool HandlerInstalled = false;
+        // Threads are never removed, samples refer to them by index
+        std::vector<std::unique_ptr<SampledThread>> Threads;
+
+        std::vector<CollectedSample> Samples;
+        uint64_t Dropped = 0;
+        // Unique stacks back to back, stack i spans
+        // [StackOffsets[i], StackOffsets[i + 1])
+        std::vector<uintptr_t> StackFrames;
+        std::vector<uint32_t> StackOffsets{0};
+        std::unordered_multimap<uint64_t, uint32_t> StackIds;
+        std::unordered_map<uintptr_t, std::string> Symbols;
+    };
+
+    static SamplingProfilerData s_SamplingData;
+    static thread_local SampledThread* t_SampledThread = nullptr;
+
+    static uint32_t InternStack(SamplingProfilerData& data, const ProfilerSample& sample)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t i = 0; i < sample.Depth; i++)
+        {
+            hash ^= (uint64_t)sample.Frames[i];
+            hash *= 1099511628211ull;
+        }
+
+        auto range = data.StackIds.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            uint32_t begin = data.StackOffsets[it->second];
+            uint32_t end = data.StackOffsets[it->second + 1];
+            if (end - begin == sample.Depth
+                && std::equal(sample.Frames, sample.Frames + sample.Depth,
+                              data.StackFrames.begin() + begin))
+                return it->second;
+        }
+
+        uint32_t id = (uint32_t)data.StackOffsets.size() - 1;
+        data.StackFrames.insert(data.StackFrames.end(), sample.Frames, sample.Frames + sample.Depth);
+        data.StackOffsets.push_back((uint32_t)data.StackFrames.size());
+        data.StackIds.emplace(hash, id);
+        return id;
+    }
+
+    // Note: you must own s_SamplingData.Mutex
+    static void DrainSampledThreads(SamplingProfilerData& data)
+    {
+        uint64_t written = FrameTelemetry::GetFrameCount();
+        uint64_t frame = written ? written - 1 : 0;
+
+        for (uint32_t t = 0; t < (uint32_t)data.Threads.size(); t++)
+        {
+            SampledThread& thread = *data.Threads[t];
+            data.Dropped += thread.Dropped.exchange(0, std::memory_order_relaxed);
+            if (!thread.Ring) continue;
+
+            uint32_t tail = thread.Tail.load(std::memory_order_relaxed);
+            uint32_t head = thread.Head.load(std::memory_order_acquire);
+            for (; tail != head; tail++)
+            {
+                if (data.Samples.size() >= s_MaxStoredSamples)
+                {
+                    data.Dropped++;
+                    continue;
+                }
+                const ProfilerSample& sample = thread.Ring[tail % s_SampleRingCapacity];
+                data.Samples.push_back({frame, t, InternStack(data, sample)});
+            }
+            thread.Tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    // Index of the first collected sample inside the last frameCount frames.
+    // Note: you must own s_SamplingData.Mutex
+    static size_t FirstSampleInWindow(const SamplingProfilerData& data, uint32_t frameCount)
+    {
+        if (frameCount == 0 || data.Samples.empty()) return 0;
+
+        uint64_t last = data.Samples.back().Frame;
+        uint64_t first = last + 1 - std::min<uint64_t>(frameCount, last + 1);
+        auto it = std::lower_bound(data.Samples.begin(), data.Samples.end(), first,
+                                   [](const CollectedSample& sample, uint64_t value) {
+                                       return sample.Frame < value;
+                                   });
+        return (size_t)(it - data.Samples.begin());
+    }
+
+    // Note: you must own s_SamplingData.Mutex. Every frame but the leaf is
+    // a return address, which points past the call.
+    static const std::string& SymbolName(SamplingProfilerData& data, uintptr_t address, bool leaf)
+    {
+        uintptr_t lookup = leaf ? address : address - 1;
+        auto it = data.Symbols.find(lookup);
+        if (it != data.Symbols.end()) return it->second;
+
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "0x%llx", (unsigned long long)lookup);
+        std::string name = buffer;
+
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        Dl_info info{};
+        if (dladdr((void*)lookup, &info))
+        {
+            if (info.dli_sname)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                name = status == 0 && demangled ? demangled : info.dli_sname;
+                std::free(demangled);
+            }
+            else if (info.dli_fname)
+            {
+                const char* module = std::strrchr(info.dli_fname, '/');
+                std::snprintf(buffer, sizeof(buffer), "+0x%llx",
+                              (unsigned long long)(lookup - (uintptr_t)info.dli_fbase));
+                name = std::string(module ? module + 1 : info.dli_fname) + buffer;
+            }
+        }
+#endif
+
+        // The folded format separates frames with ';'
+        std::replace(name.begin(), name.end(), ';', ':');
+        return data.Symbols.emplace(lookup, std::move(name)).first->second;
+    }
+
+#ifdef FENGINE_SAMPLING_SUPPORTED
+    // Follows the chain of {previous frame pointer, return address} records
+    // from the interrupted frame. Code built without frame pointers ends the
+    // walk early; every record is checked to lie on the thread stack, so a
+    // bad chain stops instead of faulting. Without known stack bounds only
+    // the pc is recorded.
+    static uint32_t WalkFramePointers(uintptr_t pc, uintptr_t fp, uintptr_t low, uintptr_t high,
+                                      uintptr_t* frames)
+    {
+        uint32_t depth = 0;
+        frames[depth++] = pc;
+        if (high <= low || high - low < 2 * sizeof(uintptr_t))
+            return depth;
+
+        while (depth < SamplingProfiler::MaxDepth)
+        {
+            if (fp < low || fp > high - 2 * sizeof(uintptr_t) || (fp & (sizeof(uintptr_t) - 1)))
+                break;
+
+            const uintptr_t* record = (const uintptr_t*)fp;
+            uintptr_t next = record[0];
+            uintptr_t returnAddress = record[1];
+            if (returnAddress == 0) break;
+
+            frames[depth++] = returnAddress;
+            // Stacks grow down, callers live at higher addresses
+            if (next <= fp) break;
+            fp = next;
+        }
+        return depth;
+    }
+
+    // Runs on the sampled thread in the middle of whatever it was doing:
+    // no locks, no allocation, nothing but the ring of that thread
+    static void SamplingSignalHandler(int, siginfo_t*, void* context)
+    {
+        SampledThread* thread = t_SampledThread;
+        if (!thread || !s_SamplingData.Running.load(std::memory_order_relaxed)
+            || !thread->Active.load(std::memory_order_relaxed))
+            return;
+
+        int savedErrno = errno;
+
+        uint32_t head = thread->Head.load(std::memory_order_relaxed);
+        if (head - thread->Tail.load(std::memory_order_acquire) >= s_SampleRingCapacity)
+        {
+            thread->Dropped.fetch_add(1, std::memory_order_relaxed);
+            errno = savedErrno;
+            return;
+        }
+
+        const mcontext_t& machine = ((const ucontext_t*)context)->uc_mcontext;
+#if defined(__x86_64__)
+        uintptr_t pc = (uintptr_t)machine.gregs[REG_RIP];
+        uintptr_t sp = (uintptr_t)machine.gregs[REG_RSP];
+        uintptr_t fp = (uintptr_t)machine.gregs[REG_RBP];
+#else
+        uintptr_t pc = (uintptr_t)machine.pc;
+        uintptr_t sp = (uintptr_t)machine.sp;
+        uintptr_t fp = (uintptr_t)machine.regs[29];
+#endif
+
+        // Below the stack pointer nothing is live, and on the main thread
+        // not necessarily mapped
+        ProfilerSample& sample = thread->Ring[head % s_SampleRingCapacity];
+        sample.Depth = WalkFramePointers(pc, fp, std::max(sp, thread->StackLow), thread->StackHigh,
+                                         sample.Frames);
+        thread->Head.store(head + 1, std::memory_order_release);
+
+        errno = savedErrno;
+    }
+
+    static bool InstallSamplingHandler()
+    {
+        struct sigaction action{};
+        action.sa_sigaction = SamplingSignalHandler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0)
+        {
+            FENGINE_CORE_ERROR("SamplingProfiler: could not install the SIGPROF handler: {}",
+                               std::strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    // The timer runs on the CPU clock of the thread, so an idle or blocked
+    // thread takes no samples
+    static bool StartThreadTimer(SampledThread& thread, uint32_t frequencyHz)
+    {
+        clockid_t clock;
+        if (pthread_getcpuclockid(thread.Handle, &clock) != 0)
+        {
+            FENGINE_CORE_ERROR("SamplingProfiler: no CPU clock for thread '{}'", thread.Name);
+            return false;
+        }
+
+        sigevent event{};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = thread.ThreadId;
+        if (timer_create(clock, &event, &thread.Timer) != 0)
+        {
+            FENGINE_CORE_ERROR("SamplingProfiler: could not create a timer for thread '{}': {}",
+                               thread.Name, std::strerror(errno));
+            return false;
+        }
+
+        long interval = 1000000000L / (long)frequencyHz;
+        itimerspec spec{};
+        spec.it_interval.tv_sec = interval / 1000000000L;
+        spec.it_interval.tv_nsec = interval % 1000000000L;
+        spec.it_value = spec.it_interval;
+        timer_settime(thread.Timer, 0, &spec, nullptr);
+        thread.HasTimer = true;
+        return true;
+    }
+
+    static void StopThreadTimer(SampledThread& thread)
+    {
+        if (!thread.HasTimer) return;
+        timer_delete(thread.Timer);
+        thread.HasTimer = false;
+    }
+#endif
+
+    // Note: you must own s_SamplingData.Mutex
+    static void PrepareSampledThread(SampledThread& thread)
+    {
+        if (!thread.Ring)
+            thread.Ring = std::make_unique<ProfilerSample[]>(s_SampleRingCapacity);
+        thread.Tail.store(thread.Head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        thread.Dropped.store(0, std::memory_order_relaxed);
+    }
+
+    bool SamplingProfiler::IsSupported()
+    {
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void SamplingProfiler::RegisterThread(const std::string& name)
+    {
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+
+        if (t_SampledThread)
+        {
+            t_SampledThread->Name = name;
+            return;
+        }
+
+        auto thread = std::make_unique<SampledThread>();
+        thread->Name = name;
+        thread->ThreadId = (pid_t)syscall(SYS_gettid);
+        thread->Handle = pthread_self();
+
+        pthread_attr_t attributes;
+        // Bounds stay 0 when unknown, the samples of the thread then only
+        // hold the interrupted pc
+        if (pthread_getattr_np(thread->Handle, &attributes) == 0)
+        {
+            void* stack = nullptr;
+            size_t size = 0;
+            if (pthread_attr_getstack(&attributes, &stack, &size) == 0)
+            {
+                thread->StackLow = (uintptr_t)stack;
+                thread->StackHigh = (uintptr_t)stack + size;
+            }
+            pthread_attr_destroy(&attributes);
+        }
+
+        t_SampledThread = thread.get();
+        thread->Active.store(true, std::memory_order_relaxed);
+        if (data.Running.load(std::memory_order_relaxed))
+        {
+            PrepareSampledThread(*thread);
+            StartThreadTimer(*thread, data.FrequencyHz);
+        }
+        data.Threads.push_back(std::move(thread));
+#else
+        (void)name;
+#endif
+    }
+
+    void SamplingProfiler::UnregisterThread()
+    {
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        SampledThread* thread = t_SampledThread;
+        if (!thread) return;
+
+        ForgeLockGuard lock(s_SamplingData.Mutex);
+        thread->Active.store(false, std::memory_order_relaxed);
+        StopThreadTimer(*thread);
+        t_SampledThread = nullptr;
+#endif
+    }
+
+    bool SamplingProfiler::Start(uint32_t frequencyHz)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+        if (data.Running.load(std::memory_order_relaxed)) return true;
+
+        if (!data.HandlerInstalled)
+        {
+            if (!InstallSamplingHandler()) return false;
+            data.HandlerInstalled = true;
+        }
+
+        data.Samples.clear();
+        data.Dropped = 0;
+        data.StackFrames.clear();
+        data.StackOffsets.assign(1, 0);
+        data.StackIds.clear();
+        data.FrequencyHz = std::clamp(frequencyHz, s_MinFrequencyHz, s_MaxFrequencyHz);
+
+        for (auto& thread : data.Threads)
+            if (thread->Active.load(std::memory_order_relaxed))
+                PrepareSampledThread(*thread);
+
+        data.Running.store(true, std::memory_order_relaxed);
+        for (auto& thread : data.Threads)
+            if (thread->Active.load(std::memory_order_relaxed))
+                StartThreadTimer(*thread, data.FrequencyHz);
+
+        FENGINE_CORE_INFO("SamplingProfiler: sampling {} threads at {} Hz", data.Threads.size(),
+                          data.FrequencyHz);
+        return true;
+#else
+        (void)frequencyHz;
+        FENGINE_CORE_ERROR("SamplingProfiler: sampling is not supported on this platform");
+        return false;
+#endif
+    }
+
+    void SamplingProfiler::Stop()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+        if (!data.Running.load(std::memory_order_relaxed)) return;
+
+#ifdef FENGINE_SAMPLING_SUPPORTED
+        for (auto& thread : data.Threads)
+            StopThreadTimer(*thread);
+#endif
+        data.Running.store(false, std::memory_order_relaxed);
+        DrainSampledThreads(data);
+    }
+
+    bool SamplingProfiler::IsRunning()
+    {
+        return s_SamplingData.Running.load(std::memory_order_relaxed);
+    }
+
+    void SamplingProfiler::EndFrame()
+    {
+        SamplingProfilerData& data = s_SamplingData;
+        if (!data.Running.load(std::memory_order_relaxed)) return;
+
+        FENGINE_PROFILE_FUNCTION();
+        ForgeLockGuard lock(data.Mutex);
+        DrainSampledThreads(data);
+    }
+
+    SamplingProfilerStats SamplingProfiler::GetStats()
+    {
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+
+        SamplingProfilerStats stats;
+        stats.Running = data.Running.load(std::memory_order_relaxed);
+        stats.FrequencyHz = data.FrequencyHz;
+        for (auto& thread : data.Threads)
+            if (thread->Active.load(std::memory_order_relaxed)) stats.Threads++;
+        stats.Samples = data.Samples.size();
+        stats.Dropped = data.Dropped;
+        stats.UniqueStacks = (uint32_t)data.StackOffsets.size() - 1;
+        if (!data.Samples.empty())
+        {
+            stats.FirstFrame = data.Samples.front().Frame;
+            stats.LastFrame = data.Samples.back().Frame;
+        }
+        return stats;
+    }
+
+    uint64_t SamplingProfiler::GetSampleCount(uint32_t frameCount)
+    {
+        ForgeLockGuard lock(s_SamplingData.Mutex);
+        return s_SamplingData.Samples.size() - FirstSampleInWindow(s_SamplingData, frameCount);
+    }
+
+    std::vector<SampledFunction> SamplingProfiler::GetTopFunctions(uint32_t count,
+                                                                   uint32_t frameCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+
+        // Symbolize each unique stack once, however often it was sampled
+        std::unordered_map<uint32_t, uint32_t> stackCounts;
+        for (size_t i = FirstSampleInWindow(data, frameCount); i < data.Samples.size(); i++)
+            stackCounts[data.Samples[i].Stack]++;
+
+        std::unordered_map<std::string, SampledFunction> functions;
+        std::vector<const std::string*> seen;
+        for (const auto& [stack, samples] : stackCounts)
+        {
+            uint32_t begin = data.StackOffsets[stack];
+            uint32_t end = data.StackOffsets[stack + 1];
+            seen.clear();
+            for (uint32_t f = begin; f < end; f++)
+            {
+                const std::string& name = SymbolName(data, data.StackFrames[f], f == begin);
+                SampledFunction& function = functions[name];
+                if (f == begin) function.SelfSamples += samples;
+                // Recursion counts once towards the total
+                if (std::find_if(seen.begin(), seen.end(),
+                                 [&](const std::string* other) { return *other == name; })
+                    != seen.end())
+                    continue;
+                function.TotalSamples += samples;
+                seen.push_back(&name);
+            }
+        }
+
+        std::vector<SampledFunction> result;
+        result.reserve(functions.size());
+        for (auto& [name, function] : functions)
+        {
+            function.Name = name;
+            result.push_back(std::move(function));
+        }
+
+        std::sort(result.begin(), result.end(), [](const SampledFunction& a, const SampledFunction& b) {
+            if (a.SelfSamples != b.SelfSamples) return a.SelfSamples > b.SelfSamples;
+            return a.TotalSamples > b.TotalSamples;
+        });
+        if (result.size() > count) result.resize(count);
+        return result;
+    }
+
+    bool SamplingProfiler::ExportFoldedStacks(const std::string& filepath, uint32_t frameCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        std::ofstream out(filepath);
+        if (!out)
+        {
+            FENGINE_CORE_ERROR("SamplingProfiler: could not write '{}'", filepath);
+            return false;
+        }
+
+        SamplingProfilerData& data = s_SamplingData;
+        ForgeLockGuard lock(data.Mutex);
+
+        std::unordered_map<uint64_t, uint32_t> stackCounts;
+        for (size_t i = FirstSampleInWindow(data, frameCount); i < data.Samples.size(); i++)
+        {
+            const CollectedSample& sample = data.Samples[i];
+            stackCounts[((uint64_t)sample.Thread << 32) | sample.Stack]++;
+        }
+
+        // Different addresses in one function fold into the same line
+        std::unordered_map<std::string, uint64_t> lines;
+        std::string line;
+        for (const auto& [key, samples] : stackCounts)
+        {
+            uint32_t stack = (uint32_t)key;
+            uint32_t begin = data.StackOffsets[stack];
+            uint32_t end = data.StackOffsets[stack + 1];
+
+            line = data.Threads[key >> 32]->Name;
+            std::replace(line.begin(), line.end(), ';', ':');
+            for (uint32_t f = end; f-- > begin;)
+            {
+                line += ';';
+                line += SymbolName(data, data.StackFrames[f], f == begin);
+            }
+            lines[line] += samples;
+        }
+
+        for (const auto& [text, samples] : lines)
+            out << text << ' ' << samples << '\n';
+
+        FENGINE_CORE_INFO("SamplingProfiler: wrote {} stacks to '{}'", lines.size(), filepath);
+        return true;
+    }
+} // namespace ForgeEngine
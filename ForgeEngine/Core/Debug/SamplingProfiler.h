@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ForgeEngine
+{
+    struct SampledFunction
+    {
+        std::string Name;
+        uint32_t SelfSamples = 0;  // samples with the function on top
+        uint32_t TotalSamples = 0; // samples with the function anywhere
+    };
+
+    struct SamplingProfilerStats
+    {
+        bool Running = false;
+        uint32_t FrequencyHz = 0;
+        uint32_t Threads = 0;
+        uint64_t Samples = 0;
+        uint64_t Dropped = 0; // thread rings or the sample store were full
+        uint32_t UniqueStacks = 0;
+        uint64_t FirstFrame = 0;
+        uint64_t LastFrame = 0;
+    };
+
+    // Statistical profiler for the code no scope covers. Every registered
+    // thread gets a timer on its CPU clock; the signal handler walks the
+    // frame pointers of the interrupted thread into a ring of that thread,
+    // and EndFrame moves the samples into a store tagged with the frame.
+    // Addresses are only turned into names when results are read.
+    //
+    // Linux only (timer_create / SIGPROF). Unwinding needs frame pointers,
+    // see FORGE_FRAME_POINTERS; names need the executable symbols exported
+    // (ENABLE_EXPORTS), otherwise frames show as module+offset.
+    class SamplingProfiler
+    {
+    public:
+        static constexpr uint32_t MaxDepth = 48;
+
+        static bool IsSupported();
+
+        // Calling thread, from the thread itself. Unregister before the
+        // thread exits.
+        static void RegisterThread(const std::string& name);
+        static void UnregisterThread();
+
+        // Clears the previous results. Returns false when sampling could
+        // not be set up. The kernel checks CPU timers on its tick, so rates
+        // above CONFIG_HZ (often 250) sample at the tick rate.
+        static bool Start(uint32_t frequencyHz = 1000);
+        static void Stop();
+        static bool IsRunning();
+
+        // Main thread, once per frame: collects the samples taken since
+        // the last call under the current FrameTelemetry frame index
+        static void EndFrame();
+
+        static SamplingProfilerStats GetStats();
+        // Samples collected in the last frameCount frames, 0 for all
+        static uint64_t GetSampleCount(uint32_t frameCount = 0);
+
+        // Aggregated over the last frameCount collected frames, 0 for all
+        static std::vector<SampledFunction> GetTopFunctions(uint32_t count,
+                                                            uint32_t frameCount = 0);
+
+        // "thread;outer;...;inner count" lines for flamegraph.pl, speedscope
+        // or Perfetto. Logs and returns false when the file cannot be written.
+        static bool ExportFoldedStacks(const std::string& filepath,
+                                       uint32_t frameCount = 0);
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Binary profile trace written by the Instrumentor and read by
+// Tools/TraceConverter. Everything is little endian and unpadded:
+//
+//   FileHeader, session name (NameLength bytes)
+//   then records, each starting with a RecordType byte:
+//     Clock:      ClockSample
+//     String:     uint64_t id, uint32_t length, characters
+//     ThreadName: uint32_t thread, uint32_t length, characters
+//     Events:     uint32_t thread, uint8_t EventClock, uint32_t count,
+//                 count * Event
+//     Dropped:    uint32_t thread, uint32_t count
+//     Frame:      FrameMarker
+//     LogLine:    uint64_t steady nanoseconds, uint8_t level,
+//                 uint32_t length, characters
+//     Annotation: uint64_t steady nanoseconds, uint32_t length, characters
+//
+// String ids are the addresses of the static names, a string record
+// always comes before the first event that uses it. Frame, LogLine and
+// Annotation records are only written by the flight recorder.
+namespace ForgeEngine::TraceFormat {
+    constexpr char Magic[4] = {'F', 'T', 'R', 'C'};
+    constexpr uint32_t Version = 2;
+
+#pragma pack(push, 1)
+    struct FileHeader {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t NameLength;
+    };
+
+    // Profiler clock and steady clock read back to back. The first sample
+    // anchors the session, the span to the last one gives the tick rate.
+    struct ClockSample {
+        uint64_t Ticks;
+        uint64_t SteadyNanoseconds;
+    };
+
+    struct Event {
+        uint64_t Name;
+        uint64_t Begin;
+        uint64_t End;
+    };
+
+    // Application frame on the steady clock
+    struct FrameMarker {
+        uint64_t Index;
+        uint64_t Begin;
+        uint64_t End;
+        uint8_t Hitch;
+    };
+#pragma pack(pop)
+
+    enum class RecordType : uint8_t {
+        Clock = 1,
+        String = 2,
+        ThreadName = 3,
+        Events = 4,
+        Dropped = 5,
+        Frame = 6,
+        LogLine = 7,
+        Annotation = 8,
+    };
+
+    enum class EventClock : uint8_t {
+        Ticks = 0,             // CPU scopes, profiler clock
+        SteadyNanoseconds = 1, // GPU scopes, already on the steady clock
+    };
+
+    template <typename T>
+    void Append(std::vector<uint8_t>& block, const T& value)
+    {
+        const uint8_t* bytes = (const uint8_t*)&value;
+        block.insert(block.end(), bytes, bytes + sizeof(T));
+    }
+
+    // uint32_t length followed by the characters
+    inline void AppendText(std::vector<uint8_t>& block, std::string_view text)
+    {
+        Append(block, (uint32_t)text.size());
+        block.insert(block.end(), text.begin(), text.end());
+    }
+} // namespace ForgeEngine::TraceFormat
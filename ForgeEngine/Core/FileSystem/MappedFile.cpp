@@ -0,0 +1,104 @@
+#include "Core/FileSystem/MappedFile.h"
+
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Log/Felog.h"
+
+#ifdef FENGINE_PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ForgeEngine
+{
+    Scope<MappedFile> MappedFile::Open(const std::string& path)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        // Constructor is private, so CreateScope cannot be used here
+        Scope<MappedFile> file(new MappedFile());
+        file->m_Path = path;
+
+#ifdef FENGINE_PLATFORM_WINDOWS
+        HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ,
+                                        FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            FENGINE_CORE_ERROR("Could not open file '{}'", path);
+            return nullptr;
+        }
+        file->m_FileHandle = fileHandle;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0)
+        {
+            FENGINE_CORE_ERROR("File '{}' is empty", path);
+            return nullptr;
+        }
+        file->m_Size = (size_t)size.QuadPart;
+
+        HANDLE mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY,
+                                            0, 0, nullptr);
+        if (!mapping)
+        {
+            FENGINE_CORE_ERROR("Could not map file '{}'", path);
+            return nullptr;
+        }
+        file->m_MappingHandle = mapping;
+
+        file->m_Data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0,
+                                                     0, 0);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            FENGINE_CORE_ERROR("Could not open file '{}'", path);
+            return nullptr;
+        }
+        file->m_FileDescriptor = fd;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            FENGINE_CORE_ERROR("File '{}' is empty", path);
+            return nullptr;
+        }
+        file->m_Size = (size_t)info.st_size;
+
+        void* data = mmap(nullptr, file->m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        file->m_Data = data == MAP_FAILED ? nullptr : (const uint8_t*)data;
+#endif
+
+        if (!file->m_Data)
+        {
+            FENGINE_CORE_ERROR("Could not map file '{}'", path);
+            return nullptr;
+        }
+
+        return file;
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef FENGINE_PLATFORM_WINDOWS
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle((HANDLE)m_MappingHandle);
+        if (m_FileHandle)
+            CloseHandle((HANDLE)m_FileHandle);
+#else
+        if (m_Data)
+            munmap((void*)m_Data, m_Size);
+        if (m_FileDescriptor >= 0)
+            close(m_FileDescriptor);
+#endif
+    }
+} // namespace ForgeEngine
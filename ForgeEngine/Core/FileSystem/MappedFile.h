@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Config.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ForgeEngine
+{
+    // Read-only memory mapping of a whole file. The pages are loaded lazily by
+    // the OS, so opening is cheap and reading only touches what is used.
+    class MappedFile
+    {
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+        const std::string& GetPath() const { return m_Path; }
+
+        // Returns nullptr when the file cannot be opened or is empty
+        static Scope<MappedFile> Open(const std::string& path);
+
+    private:
+        MappedFile() = default;
+
+    private:
+        std::string m_Path;
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef FENGINE_PLATFORM_WINDOWS
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#else
+        int m_FileDescriptor = -1;
+#endif
+    };
+} // namespace ForgeEngine
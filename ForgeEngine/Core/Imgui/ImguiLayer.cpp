@@ -16,6 +16,7 @@
 #include <ImGuizmo.h>
 #include <glad/glad.h>
 
+#include "Core/Renderer/GpuProfiler.h"
 #include "Core/Renderer/RenderCommand.h"
 
 namespace ForgeEngine
@@ -169,7 +170,10 @@ namespace ForgeEngine
                                 (float)app.GetWindow().GetHeight());
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            FENGINE_GPU_SCOPE("ImGui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         {
@@ -1,13 +1,58 @@
 #include "Felog.h"
-#include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
+#include "Core/Debug/SamplingProfiler.h"
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink-inl.h>
+#ifdef _WIN32
+#include <spdlog/sinks/wincolor_sink-inl.h>
+#else
+#include <spdlog/sinks/ansicolor_sink-inl.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 namespace ForgeEngine
 {
+#ifdef _WIN32
+    using FelogConsoleSink = spdlog::sinks::wincolor_stdout_sink<LogConsoleMutex>;
+#else
+    using FelogConsoleSink = spdlog::sinks::ansicolor_stdout_sink<LogConsoleMutex>;
+#endif
+
     std::shared_ptr<spdlog::logger> Felog::s_CoreLogger;
     std::shared_ptr<spdlog::logger> Felog::s_ClientLogger;
+    std::shared_ptr<spdlog::sinks::dist_sink<LogSinkMutex>> Felog::s_ExtraSinks;
+
+    // Owned here rather than spdlog's global pool, so the log thread is
+    // named in the traces and the sampling profiler
+    static std::shared_ptr<spdlog::details::thread_pool> s_LogThreadPool;
+    static std::vector<spdlog::sink_ptr> s_LogSinks;
 
-    void Felog::Init(const std::string& engineName)
+    static std::shared_ptr<spdlog::logger> CreateFelogLogger(const std::string& name,
+                                                             const LogSpecification& specification)
+    {
+        std::shared_ptr<spdlog::logger> logger;
+        if (s_LogThreadPool)
+            logger = std::make_shared<spdlog::async_logger>(name, s_LogSinks.begin(), s_LogSinks.end(),
+                                                            s_LogThreadPool, specification.Overflow);
+        else
+            logger = std::make_shared<spdlog::logger>(name, s_LogSinks.begin(), s_LogSinks.end());
+
+        logger->set_level(spdlog::level::trace);
+        // Queued messages must not be lost when an error precedes a crash
+        logger->flush_on(spdlog::level::err);
+        spdlog::drop(name);
+        spdlog::register_logger(logger);
+        return logger;
+    }
+
+    ForgeMutex& LogConsoleMutex::mutex()
+    {
+        static ForgeMutex s_ConsoleMutex("Log Console");
+        return s_ConsoleMutex;
+    }
+
+    void Felog::Init(const std::string& engineName, const LogSpecification& specification)
     {
         // optional: control compile-time log level
 #if defined(DEBUG) || defined(_DEBUG)
@@ -20,21 +65,81 @@ namespace ForgeEngine
         spdlog::set_pattern("[%T] [%n] [%^%l%$] %v");
 
         // Create a color console sink
-        auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        auto consoleSink = std::make_shared<FelogConsoleSink>();
         consoleSink->set_level(spdlog::level::trace);
 
         // Create a file sink
-        auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("engine.log", true);
+        auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink<LogSinkMutex>>(specification.FilePath, true);
         fileSink->set_level(spdlog::level::trace);
 
-        // Core logger uses both console and file
-        s_CoreLogger = std::make_shared<spdlog::logger>(engineName, spdlog::sinks_init_list{consoleSink, fileSink});
-        s_CoreLogger->set_level(spdlog::level::trace);
-        spdlog::register_logger(s_CoreLogger);
+        // Sinks added later (AddSink) hang off this one
+        s_ExtraSinks = std::make_shared<spdlog::sinks::dist_sink<LogSinkMutex>>();
+        s_ExtraSinks->set_level(spdlog::level::trace);
+
+        s_LogSinks = {consoleSink, fileSink, s_ExtraSinks};
+
+        if (specification.Async)
+        {
+            s_LogThreadPool = std::make_shared<spdlog::details::thread_pool>(
+                std::max<uint32_t>(specification.QueueSize, 1), 1,
+                [] {
+                    FENGINE_PROFILE_THREAD("Log");
+                    SamplingProfiler::RegisterThread("Log");
+                },
+                [] { SamplingProfiler::UnregisterThread(); });
+            // Stops the log thread before the static data it touches is gone
+            // when the application exits without Shutdown
+            static bool s_ShutdownRegistered = false;
+            if (!s_ShutdownRegistered)
+            {
+                std::atexit(Felog::Shutdown);
+                s_ShutdownRegistered = true;
+            }
+        }
 
-        // (Optional) Client logger
-        s_ClientLogger = std::make_shared<spdlog::logger>("APPLICATION", spdlog::sinks_init_list{consoleSink, fileSink});
-        s_ClientLogger->set_level(spdlog::level::trace);
-        spdlog::register_logger(s_ClientLogger);
+        // Core and client logger share the sinks and the log thread
+        s_CoreLogger = CreateFelogLogger(engineName, specification);
+        s_ClientLogger = CreateFelogLogger("APPLICATION", specification);
+    }
+
+    void Felog::Shutdown()
+    {
+        if (!s_LogThreadPool) return;
+
+        s_CoreLogger->flush();
+        s_ClientLogger->flush();
+
+        LogSpecification synchronous;
+        synchronous.Async = false;
+        auto threadPool = std::move(s_LogThreadPool);
+        s_CoreLogger = CreateFelogLogger(s_CoreLogger->name(), synchronous);
+        s_ClientLogger = CreateFelogLogger(s_ClientLogger->name(), synchronous);
+        // Joins the log thread once the queue is written out
+        threadPool.reset();
+    }
+
+    LogStats Felog::GetStats()
+    {
+        LogStats stats;
+        stats.Messages = s_Messages.load(std::memory_order_relaxed);
+        if (auto threadPool = s_LogThreadPool)
+        {
+            stats.Async = true;
+            stats.Dropped = threadPool->overrun_counter() + threadPool->discard_counter();
+            stats.Queued = threadPool->queue_size();
+        }
+        return stats;
+    }
+
+    void Felog::AddSink(const spdlog::sink_ptr& sink)
+    {
+        if (s_ExtraSinks)
+            s_ExtraSinks->add_sink(sink);
+    }
+
+    void Felog::RemoveSink(const spdlog::sink_ptr& sink)
+    {
+        if (s_ExtraSinks)
+            s_ExtraSinks->remove_sink(sink);
     }
 } // namespace ForgeEngine
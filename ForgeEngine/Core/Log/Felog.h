@@ -1,13 +1,58 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <spdlog/spdlog.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/sinks/dist_sink.h>
+// The compiled spdlog only instantiates its sinks for std::mutex, sinks on
+// LogSinkMutex need the template definitions
+#include <spdlog/sinks/base_sink-inl.h>
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Threading/ForgeMutex.h"
 
 namespace ForgeEngine {
+  // Engine log sinks lock through these, so logging shows up in the lock
+  // contention report
+  struct LogSinkMutex : ForgeMutex {
+    LogSinkMutex() : ForgeMutex("Log Sink") {}
+  };
+
+  // spdlog console sinks share one lock per process, taken from mutex()
+  struct LogConsoleMutex {
+    using mutex_t = ForgeMutex;
+    static mutex_t &mutex();
+  };
+
+  struct LogSpecification {
+    // Async hands the messages to a log thread; the caller only pays for
+    // formatting and a queue slot
+    bool Async = true;
+    // Messages the queue holds before the overflow policy applies
+    uint32_t QueueSize = 8192;
+    // overrun_oldest never stalls the caller, the lost messages are
+    // counted in LogStats::Dropped. block keeps every message.
+    spdlog::async_overflow_policy Overflow = spdlog::async_overflow_policy::overrun_oldest;
+    std::string FilePath = "engine.log";
+  };
+
+  struct LogStats {
+    bool Async = false;
+    uint64_t Messages = 0; // log calls that passed the compile time level
+    uint64_t Dropped = 0;  // overrun or discarded by a full queue
+    uint64_t Queued = 0;   // waiting for the log thread
+  };
+
   class Felog {
   public:
     // Initialize the Logger (call once at startup)
-    static void Init(const std::string &engineName = "FENGINE");
+    static void Init(const std::string &engineName = "FENGINE", const LogSpecification &specification = {});
+    // Writes out the queued messages and stops the log thread; the loggers
+    // keep working synchronously afterwards. Call when no other thread logs.
+    static void Shutdown();
 
     // Retrieve the core logger
     inline static std::shared_ptr<spdlog::logger> &GetCoreLogger() { return s_CoreLogger; }
@@ -15,26 +60,172 @@ namespace ForgeEngine {
     // (Optional) Retrieve a client/user logger
     inline static std::shared_ptr<spdlog::logger> &GetClientLogger() { return s_ClientLogger; }
 
+    // Attach / detach a sink to both loggers, safe while other threads log
+    static void AddSink(const spdlog::sink_ptr &sink);
+    static void RemoveSink(const spdlog::sink_ptr &sink);
+
+    static LogStats GetStats();
+
+    // Used by the log macros
+    static void CountMessage() { s_Messages.fetch_add(1, std::memory_order_relaxed); }
+
+    // Message text of a log macro argument list
+    template<typename Arg, typename... Args>
+    static std::string Format(spdlog::format_string_t<Arg, Args...> format, Arg &&arg, Args &&...args) {
+      return spdlog::fmt_lib::format(format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    static std::string Format(std::string_view text) { return std::string(text); }
+
   private:
     static std::shared_ptr<spdlog::logger> s_CoreLogger;
     static std::shared_ptr<spdlog::logger> s_ClientLogger;
+    static std::shared_ptr<spdlog::sinks::dist_sink<LogSinkMutex> > s_ExtraSinks;
+    static inline std::atomic<uint64_t> s_Messages{0};
+  };
+
+  // State of one FENGINE_*_LOG_RATE_LIMITED call site
+  class LogRateLimiter {
+  public:
+    // True at most once per interval; suppressed receives the calls that
+    // were skipped since the last one that passed
+    bool Allow(uint32_t intervalMs, uint64_t &suppressed) {
+      uint64_t now = Instrumentor::SteadyNanoseconds();
+      uint64_t next = m_Next.load(std::memory_order_relaxed);
+      if (now < next
+          || !m_Next.compare_exchange_strong(next, now + (uint64_t)intervalMs * 1000000,
+                                             std::memory_order_relaxed)) {
+        m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+      return true;
+    }
+
+  private:
+    std::atomic<uint64_t> m_Next{0};
+    std::atomic<uint64_t> m_Suppressed{0};
+  };
+
+  // State of one FENGINE_*_LOG_DEDUP call site. Only the last message is
+  // remembered, by hash.
+  class LogDeduplicator {
+  public:
+    // A repeat is shown again after this long, with the count
+    static constexpr uint64_t RepeatNanoseconds = 5000000000ull;
+
+    // False for a repeat of the previous message; repeats receives how
+    // often the previous message was skipped
+    bool Allow(std::string_view message, uint64_t &repeats) {
+      uint64_t now = Instrumentor::SteadyNanoseconds();
+      size_t hash = std::hash<std::string_view>{}(message);
+      if (m_Hash.exchange(hash, std::memory_order_relaxed) == hash
+          && now < m_ShownAt.load(std::memory_order_relaxed) + RepeatNanoseconds) {
+        m_Repeats.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      m_ShownAt.store(now, std::memory_order_relaxed);
+      repeats = m_Repeats.exchange(0, std::memory_order_relaxed);
+      return true;
+    }
+
+  private:
+    std::atomic<size_t> m_Hash{0};
+    std::atomic<uint64_t> m_ShownAt{0};
+    std::atomic<uint64_t> m_Repeats{0};
   };
 }
-//#define DEBUG
-#ifdef DEBUG
 
-#define FENGINE_CORE_TRACE(...)    ::ForgeEngine::Felog::GetCoreLogger()->trace(__VA_ARGS__)
-#define FENGINE_CORE_INFO(...)     ::ForgeEngine::Felog::GetCoreLogger()->info(__VA_ARGS__)
-#define FENGINE_CORE_WARN(...)     ::ForgeEngine::Felog::GetCoreLogger()->warn(__VA_ARGS__)
-#define FENGINE_CORE_ERROR(...)    ::ForgeEngine::Felog::GetCoreLogger()->error(__VA_ARGS__)
-#define FENGINE_CORE_CRITICAL(...) ::ForgeEngine::Felog::GetCoreLogger()->critical(__VA_ARGS__)
+// Levels as in spdlog::level::level_enum. Calls below FENGINE_LOG_LEVEL are
+// compiled out, arguments included; the CMake option FORGE_LOG_LEVEL sets it.
+#define FENGINE_LOG_LEVEL_TRACE    0
+#define FENGINE_LOG_LEVEL_DEBUG    1
+#define FENGINE_LOG_LEVEL_INFO     2
+#define FENGINE_LOG_LEVEL_WARN     3
+#define FENGINE_LOG_LEVEL_ERROR    4
+#define FENGINE_LOG_LEVEL_CRITICAL 5
+#define FENGINE_LOG_LEVEL_OFF      6
 
+#ifndef FENGINE_LOG_LEVEL
+#if defined(DEBUG) || defined(_DEBUG)
+#define FENGINE_LOG_LEVEL FENGINE_LOG_LEVEL_TRACE
 #else
+#define FENGINE_LOG_LEVEL FENGINE_LOG_LEVEL_INFO
+#endif
+#endif
 
-#define FENGINE_CORE_TRACE(...)    do {} while(false)
-#define FENGINE_CORE_INFO(...)     do {} while(false)
-#define FENGINE_CORE_WARN(...)     do {} while(false)
-#define FENGINE_CORE_ERROR(...)    do {} while(false)
-#define FENGINE_CORE_CRITICAL(...) do {} while(false)
+// For work that only feeds a log call, e.g. if constexpr (FENGINE_LOG_ENABLED(DEBUG)).
+// Level names are pasted right away everywhere, DEBUG and ERROR are macros
+// themselves on some platforms.
+#define FENGINE_LOG_ENABLED(level) (FENGINE_LOG_LEVEL <= FENGINE_LOG_LEVEL_##level)
 
-#endif
+// Every call is a "Log" profile scope, so the time spent logging shows in
+// the traces and the flight recorder
+#define FENGINE_LOG_IMPL(logger, levelValue, ...)                                      \
+  do {                                                                                 \
+    if constexpr (FENGINE_LOG_LEVEL <= (levelValue)) {                                 \
+      FENGINE_PROFILE_SCOPE("Log");                                                    \
+      ::ForgeEngine::Felog::CountMessage();                                            \
+      ::ForgeEngine::Felog::Get##logger##Logger()->log(                                \
+          (::spdlog::level::level_enum)(levelValue), __VA_ARGS__);                     \
+    }                                                                                  \
+  } while (false)
+
+// Logs at most once per intervalMs from this call site and tells how many
+// calls were skipped in between
+#define FENGINE_LOG_RATE_LIMITED_IMPL(logger, levelValue, intervalMs, ...)             \
+  do {                                                                                 \
+    if constexpr (FENGINE_LOG_LEVEL <= (levelValue)) {                                 \
+      static ::ForgeEngine::LogRateLimiter s_LogLimiter;                               \
+      uint64_t logSuppressed = 0;                                                      \
+      if (s_LogLimiter.Allow(intervalMs, logSuppressed)) {                             \
+        if (logSuppressed == 0) {                                                      \
+          FENGINE_LOG_IMPL(logger, levelValue, __VA_ARGS__);                           \
+        } else {                                                                       \
+          FENGINE_LOG_IMPL(logger, levelValue, "{} ({} similar suppressed)",           \
+                           ::ForgeEngine::Felog::Format(__VA_ARGS__), logSuppressed);  \
+        }                                                                              \
+      }                                                                                \
+    }                                                                                  \
+  } while (false)
+
+// Skips a message equal to the previous one from this call site; the
+// repeat count is logged when the message changes or every few seconds
+#define FENGINE_LOG_DEDUP_IMPL(logger, levelValue, ...)                                \
+  do {                                                                                 \
+    if constexpr (FENGINE_LOG_LEVEL <= (levelValue)) {                                 \
+      static ::ForgeEngine::LogDeduplicator s_LogDeduplicator;                         \
+      std::string logMessage = ::ForgeEngine::Felog::Format(__VA_ARGS__);              \
+      uint64_t logRepeats = 0;                                                         \
+      if (s_LogDeduplicator.Allow(logMessage, logRepeats)) {                           \
+        if (logRepeats > 0)                                                            \
+          FENGINE_LOG_IMPL(logger, levelValue, "Previous message repeated {} times",   \
+                           logRepeats);                                                \
+        FENGINE_LOG_IMPL(logger, levelValue, "{}", logMessage);                        \
+      }                                                                                \
+    }                                                                                  \
+  } while (false)
+
+#define FENGINE_CORE_TRACE(...)    FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_TRACE, __VA_ARGS__)
+#define FENGINE_CORE_DEBUG(...)    FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define FENGINE_CORE_INFO(...)     FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_INFO, __VA_ARGS__)
+#define FENGINE_CORE_WARN(...)     FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define FENGINE_CORE_ERROR(...)    FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define FENGINE_CORE_CRITICAL(...) FENGINE_LOG_IMPL(Core, FENGINE_LOG_LEVEL_CRITICAL, __VA_ARGS__)
+
+#define FENGINE_TRACE(...)    FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_TRACE, __VA_ARGS__)
+#define FENGINE_DEBUG(...)    FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define FENGINE_INFO(...)     FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_INFO, __VA_ARGS__)
+#define FENGINE_WARN(...)     FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define FENGINE_ERROR(...)    FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define FENGINE_CRITICAL(...) FENGINE_LOG_IMPL(Client, FENGINE_LOG_LEVEL_CRITICAL, __VA_ARGS__)
+
+// level is one of TRACE, DEBUG, INFO, WARN, ERROR or CRITICAL
+#define FENGINE_CORE_LOG_RATE_LIMITED(level, intervalMs, ...) \
+  FENGINE_LOG_RATE_LIMITED_IMPL(Core, FENGINE_LOG_LEVEL_##level, intervalMs, __VA_ARGS__)
+#define FENGINE_CORE_LOG_DEDUP(level, ...) \
+  FENGINE_LOG_DEDUP_IMPL(Core, FENGINE_LOG_LEVEL_##level, __VA_ARGS__)
+#define FENGINE_LOG_RATE_LIMITED(level, intervalMs, ...) \
+  FENGINE_LOG_RATE_LIMITED_IMPL(Client, FENGINE_LOG_LEVEL_##level, intervalMs, __VA_ARGS__)
+#define FENGINE_LOG_DEDUP(level, ...) \
+  FENGINE_LOG_DEDUP_IMPL(Client, FENGINE_LOG_LEVEL_##level, __VA_ARGS__)
@@ -0,0 +1,45 @@
+#include "Core/Log/LogRingSink.h"
+
+#include <cstring>
+
+namespace ForgeEngine
+{
+    LogRingSink::LogRingSink(uint32_t capacity)
+        : m_Slots(std::max(capacity, 1u)),
+          m_Text(m_Slots.size() * MaxLineLength)
+    {
+    }
+
+    void LogRingSink::sink_it_(const spdlog::details::log_msg& msg)
+    {
+        size_t loggerLength = std::min<size_t>(msg.logger_name.size(), 64);
+        size_t room = MaxLineLength - loggerLength;
+
+        std::string_view payload(msg.payload.data(), msg.payload.size());
+        uint64_t written = m_Written.load(std::memory_order_relaxed);
+        bool continuation = false;
+        do
+        {
+            size_t end = payload.find('\n');
+            std::string_view line = payload.substr(0, end);
+            payload = end == std::string_view::npos ? std::string_view() : payload.substr(end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            size_t index = written % m_Slots.size();
+            Slot& slot = m_Slots[index];
+            slot.Time = msg.time;
+            slot.Level = msg.level;
+            slot.LoggerLength = (uint8_t)loggerLength;
+            slot.TextLength = (uint16_t)std::min(line.size(), room);
+            slot.Continuation = continuation;
+
+            char* text = m_Text.data() + index * MaxLineLength;
+            std::memcpy(text, msg.logger_name.data(), loggerLength);
+            std::memcpy(text + loggerLength, line.data(), slot.TextLength);
+
+            continuation = true;
+            m_Written.store(++written, std::memory_order_release);
+        } while (!payload.empty());
+    }
+} // namespace ForgeEngine
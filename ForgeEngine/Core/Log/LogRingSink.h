@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Core/Log/Felog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // One line of a log message as stored by LogRingSink. The views point
+    // into the ring and are only valid inside the visiting callback.
+    struct LogRecord
+    {
+        uint64_t Sequence = 0;
+        spdlog::level::level_enum Level = spdlog::level::info;
+        spdlog::log_clock::time_point Time;
+        std::string_view Logger;
+        std::string_view Text;
+        // Second or later line of a multi-line message
+        bool Continuation = false;
+    };
+
+    // Keeps the latest log lines as records in storage allocated up front,
+    // so logging does not allocate and readers need no formatted copies.
+    // Messages are split at line breaks, every record is one line of at
+    // most MaxLineLength characters (logger name included).
+    //
+    // Every record gets the next sequence number; GetGeneration is the
+    // number of records written so far and tells readers whether anything
+    // new arrived without taking the lock.
+    class LogRingSink : public spdlog::sinks::base_sink<LogSinkMutex>
+    {
+    public:
+        static constexpr uint32_t MaxLineLength = 256;
+
+        explicit LogRingSink(uint32_t capacity = 4096);
+
+        uint32_t GetCapacity() const { return (uint32_t)m_Slots.size(); }
+        uint64_t GetGeneration() const { return m_Written.load(std::memory_order_acquire); }
+        // Sequence of the oldest record still held
+        uint64_t GetFirstSequence() const
+        {
+            uint64_t written = GetGeneration();
+            return written - std::min<uint64_t>(written, m_Slots.size());
+        }
+
+        // Calls f(const LogRecord&) for every held record from sequence
+        // from on, oldest first, and returns the sequence after the last one
+        template<typename Function>
+        uint64_t ForEach(uint64_t from, Function&& f)
+        {
+            ForgeLockGuard lock(mutex_);
+            uint64_t written = m_Written.load(std::memory_order_relaxed);
+            uint64_t first = written - std::min<uint64_t>(written, m_Slots.size());
+            for (uint64_t sequence = std::max(from, first); sequence < written; sequence++)
+                f(GetRecord(sequence));
+            return written;
+        }
+
+        // Calls f(const LogRecord*) for the given sequences in order, with
+        // nullptr for those already overwritten
+        template<typename Function>
+        void ForEachOf(const uint64_t* sequences, size_t count, Function&& f)
+        {
+            ForgeLockGuard lock(mutex_);
+            uint64_t written = m_Written.load(std::memory_order_relaxed);
+            uint64_t first = written - std::min<uint64_t>(written, m_Slots.size());
+            for (size_t i = 0; i < count; i++)
+            {
+                if (sequences[i] >= first && sequences[i] < written)
+                {
+                    LogRecord record = GetRecord(sequences[i]);
+                    f(&record);
+                }
+                else
+                {
+                    f(nullptr);
+                }
+            }
+        }
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg& msg) override;
+        void flush_() override {}
+
+    private:
+        struct Slot
+        {
+            spdlog::log_clock::time_point Time;
+            spdlog::level::level_enum Level = spdlog::level::info;
+            uint8_t LoggerLength = 0;
+            uint16_t TextLength = 0;
+            bool Continuation = false;
+        };
+
+        // Note: you must own mutex_
+        LogRecord GetRecord(uint64_t sequence) const
+        {
+            size_t index = sequence % m_Slots.size();
+            const Slot& slot = m_Slots[index];
+            const char* text = m_Text.data() + index * MaxLineLength;
+
+            LogRecord record;
+            record.Sequence = sequence;
+            record.Level = slot.Level;
+            record.Time = slot.Time;
+            record.Logger = std::string_view(text, slot.LoggerLength);
+            record.Text = std::string_view(text + slot.LoggerLength, slot.TextLength);
+            record.Continuation = slot.Continuation;
+            return record;
+        }
+
+        std::vector<Slot> m_Slots;
+        // MaxLineLength characters per slot, logger name then text
+        std::vector<char> m_Text;
+        std::atomic<uint64_t> m_Written{0};
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,169 @@
+#include "Core/Math/MathKernels.h"
+#include "Core/Math/MathKernelsImpl.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace ForgeEngine
+{
+    namespace MathKernelsScalar
+    {
+        void ComposeTRS(const TRSStreams& trs, const AffineStreams& out, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                float x = trs.Rotation[0][i], y = trs.Rotation[1][i];
+                float z = trs.Rotation[2][i], w = trs.Rotation[3][i];
+                float sx = trs.Scale[0][i], sy = trs.Scale[1][i], sz = trs.Scale[2][i];
+
+                float xx = x * x * 2.0f, yy = y * y * 2.0f, zz = z * z * 2.0f;
+                float xy = x * y * 2.0f, xz = x * z * 2.0f, yz = y * z * 2.0f;
+                float wx = w * x * 2.0f, wy = w * y * 2.0f, wz = w * z * 2.0f;
+
+                out.M[0][i] = (1.0f - (yy + zz)) * sx;
+                out.M[1][i] = (xy - wz) * sy;
+                out.M[2][i] = (xz + wy) * sz;
+                out.M[3][i] = trs.Position[0][i];
+
+                out.M[4][i] = (xy + wz) * sx;
+                out.M[5][i] = (1.0f - (xx + zz)) * sy;
+                out.M[6][i] = (yz - wx) * sz;
+                out.M[7][i] = trs.Position[1][i];
+
+                out.M[8][i] = (xz - wy) * sx;
+                out.M[9][i] = (yz + wx) * sy;
+                out.M[10][i] = (1.0f - (xx + yy)) * sz;
+                out.M[11][i] = trs.Position[2][i];
+            }
+        }
+
+        void TransformSpheres(const ConstAffineStreams& transforms,
+                              const ConstSphereStreams& local, const SphereStreams& world,
+                              size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                float m[12];
+                for (int k = 0; k < 12; k++)
+                    m[k] = transforms.M[k][i];
+
+                float cx = local.Center[0][i], cy = local.Center[1][i], cz = local.Center[2][i];
+                for (int row = 0; row < 3; row++)
+                {
+                    world.Center[row][i] = m[row * 4] * cx + m[row * 4 + 1] * cy
+                        + m[row * 4 + 2] * cz + m[row * 4 + 3];
+                }
+
+                float scale0 = m[0] * m[0] + m[4] * m[4] + m[8] * m[8];
+                float scale1 = m[1] * m[1] + m[5] * m[5] + m[9] * m[9];
+                float scale2 = m[2] * m[2] + m[6] * m[6] + m[10] * m[10];
+                world.Radius[i] = local.Radius[i]
+                    * std::sqrt(std::fmax(scale0, std::fmax(scale1, scale2)));
+            }
+        }
+
+        void TransformAABBs(const ConstAffineStreams& transforms,
+                            const ConstAABBStreams& local, const AABBStreams& world,
+                            size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                float center[3], extent[3];
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    center[axis] = (local.Min[axis][i] + local.Max[axis][i]) * 0.5f;
+                    extent[axis] = (local.Max[axis][i] - local.Min[axis][i]) * 0.5f;
+                }
+
+                for (int row = 0; row < 3; row++)
+                {
+                    float worldCenter = transforms.M[row * 4 + 3][i];
+                    float worldExtent = 0.0f;
+                    for (int column = 0; column < 3; column++)
+                    {
+                        float m = transforms.M[row * 4 + column][i];
+                        worldCenter += m * center[column];
+                        worldExtent += std::fabs(m) * extent[column];
+                    }
+                    world.Min[row][i] = worldCenter - worldExtent;
+                    world.Max[row][i] = worldCenter + worldExtent;
+                }
+            }
+        }
+
+        void TransformVec4(const float* matrix, const ConstVec4Streams& in,
+                           const Vec4Streams& out, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                float x = in.V[0][i], y = in.V[1][i], z = in.V[2][i], w = in.V[3][i];
+                for (int row = 0; row < 4; row++)
+                {
+                    out.V[row][i] = matrix[row] * x + matrix[4 + row] * y + matrix[8 + row] * z
+                        + matrix[12 + row] * w;
+                }
+            }
+        }
+    } // namespace MathKernelsScalar
+
+    static const MathKernelTable s_ScalarMathKernels = {
+        &MathKernelsScalar::ComposeTRS, &MathKernelsScalar::TransformSpheres,
+        &MathKernelsScalar::TransformAABBs, &MathKernelsScalar::TransformVec4};
+
+    // Picked on first use, SetLevel can override it afterwards
+    static std::atomic<const MathKernelTable*> s_ActiveMathKernels{nullptr};
+    static std::atomic<SimdLevel> s_ActiveSimdLevel{SimdLevel::Scalar};
+
+    bool MathKernels::IsSupported(SimdLevel level) { return GetKernels(level) != nullptr; }
+
+    const MathKernelTable* MathKernels::GetKernels(SimdLevel level)
+    {
+        if (!CpuInfo::Supports(level))
+            return nullptr;
+
+        switch (level)
+        {
+        case SimdLevel::Scalar: return &s_ScalarMathKernels;
+        case SimdLevel::SSE2: return GetSSE2MathKernels();
+        case SimdLevel::AVX2: return GetAVX2MathKernels();
+        case SimdLevel::AVX512: return GetAVX512MathKernels();
+        case SimdLevel::NEON: return GetNEONMathKernels();
+        default: return nullptr;
+        }
+    }
+
+    bool MathKernels::SetLevel(SimdLevel level)
+    {
+        const MathKernelTable* kernels = GetKernels(level);
+        if (!kernels)
+            return false;
+
+        s_ActiveSimdLevel.store(level);
+        s_ActiveMathKernels.store(kernels);
+        return true;
+    }
+
+    SimdLevel MathKernels::GetLevel()
+    {
+        GetActive();
+        return s_ActiveSimdLevel.load();
+    }
+
+    const MathKernelTable& MathKernels::GetActive()
+    {
+        const MathKernelTable* kernels = s_ActiveMathKernels.load(std::memory_order_acquire);
+        if (kernels)
+            return *kernels;
+
+        const MathKernelTable* variants[SimdLevelCount] = {};
+        for (size_t i = 0; i < SimdLevelCount; i++)
+            variants[i] = GetKernels((SimdLevel)i);
+
+        // Racing first calls all pick the same table, no lock needed
+        SimdLevel level;
+        kernels = CpuInfo::Resolve(variants, &level);
+        s_ActiveSimdLevel.store(level);
+        s_ActiveMathKernels.store(kernels, std::memory_order_release);
+        return *kernels;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Core/System/CpuInfo.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace ForgeEngine
+{
+    // Kernel inputs and outputs are structs of arrays: every pointer
+    // addresses one float per entity, so entity i of a stream set is the
+    // i-th element of each of its arrays. Arrays need no alignment and may
+    // not overlap between inputs and outputs.
+
+    // Rotation is a unit quaternion (x, y, z, w)
+    struct TRSStreams
+    {
+        const float* Position[3];
+        const float* Rotation[4];
+        const float* Scale[3];
+    };
+
+    // Row major 3x4 affine matrices, M[row * 4 + column]. Column 3 is the
+    // translation; the implicit last row is (0, 0, 0, 1).
+    template <typename T>
+    struct AffineStreamsT
+    {
+        T* M[12];
+    };
+    using AffineStreams = AffineStreamsT<float>;
+    using ConstAffineStreams = AffineStreamsT<const float>;
+
+    template <typename T>
+    struct SphereStreamsT
+    {
+        T* Center[3];
+        T* Radius;
+    };
+    using SphereStreams = SphereStreamsT<float>;
+    using ConstSphereStreams = SphereStreamsT<const float>;
+
+    template <typename T>
+    struct AABBStreamsT
+    {
+        T* Min[3];
+        T* Max[3];
+    };
+    using AABBStreams = AABBStreamsT<float>;
+    using ConstAABBStreams = AABBStreamsT<const float>;
+
+    template <typename T>
+    struct Vec4StreamsT
+    {
+        T* V[4];
+    };
+    using Vec4Streams = Vec4StreamsT<float>;
+    using ConstVec4Streams = Vec4StreamsT<const float>;
+
+    // One implementation of every kernel for a given instruction set
+    struct MathKernelTable
+    {
+        // T * R * S straight into 3x4 affine matrices
+        void (*ComposeTRS)(const TRSStreams& trs, const AffineStreams& out, size_t count);
+        // Local bounding spheres to world space, radius scaled by the largest
+        // axis scale
+        void (*TransformSpheres)(const ConstAffineStreams& transforms,
+                                 const ConstSphereStreams& local,
+                                 const SphereStreams& world, size_t count);
+        // Local AABBs to the world AABBs around them (Arvo)
+        void (*TransformAABBs)(const ConstAffineStreams& transforms,
+                               const ConstAABBStreams& local,
+                               const AABBStreams& world, size_t count);
+        // One column major 4x4 matrix (glm layout) times every vector
+        void (*TransformVec4)(const float* matrix, const ConstVec4Streams& in,
+                              const Vec4Streams& out, size_t count);
+    };
+
+    // Batch math on many entities at once. Calls go to the fastest kernels
+    // the running CPU supports (see CpuInfo::GetDispatchLevel for the
+    // FORGE_FORCE_ISA override), picked on first use; the scalar set is the
+    // reference the others are checked against and handles the tails that
+    // do not fill a whole SIMD register.
+    class MathKernels
+    {
+    public:
+        static void ComposeTRS(const TRSStreams& trs, const AffineStreams& out, size_t count)
+        {
+            GetActive().ComposeTRS(trs, out, count);
+        }
+
+        static void TransformSpheres(const ConstAffineStreams& transforms,
+                                     const ConstSphereStreams& local,
+                                     const SphereStreams& world, size_t count)
+        {
+            GetActive().TransformSpheres(transforms, local, world, count);
+        }
+
+        static void TransformAABBs(const ConstAffineStreams& transforms,
+                                   const ConstAABBStreams& local, const AABBStreams& world,
+                                   size_t count)
+        {
+            GetActive().TransformAABBs(transforms, local, world, count);
+        }
+
+        static void TransformVec4(const float* matrix, const ConstVec4Streams& in,
+                                  const Vec4Streams& out, size_t count)
+        {
+            GetActive().TransformVec4(matrix, in, out, count);
+        }
+
+        static SimdLevel GetLevel();
+        // Switches every kernel to the given set, fails when the CPU or the
+        // build does not support it
+        static bool SetLevel(SimdLevel level);
+        static bool IsSupported(SimdLevel level);
+
+        // Null when the CPU cannot run the level or no variant was built for
+        // it (SSE4 has none, the SSE2 set covers those CPUs)
+        static const MathKernelTable* GetKernels(SimdLevel level);
+
+    private:
+        static const MathKernelTable& GetActive();
+    };
+} // namespace ForgeEngine
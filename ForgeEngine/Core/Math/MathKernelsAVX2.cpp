@@ -0,0 +1,48 @@
+// Built with AVX2 and FMA enabled for this file only, nothing here may run
+// before MathKernels checked the CPU.
+
+#include "Core/Math/MathKernelsImpl.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace ForgeEngine
+{
+    namespace
+    {
+        struct AVX2Float
+        {
+            static constexpr size_t Width = 8;
+            __m256 Value;
+
+            static AVX2Float Load(const float* data) { return {_mm256_loadu_ps(data)}; }
+            static AVX2Float Set(float value) { return {_mm256_set1_ps(value)}; }
+            static void Store(float* data, AVX2Float v) { _mm256_storeu_ps(data, v.Value); }
+
+            friend AVX2Float operator+(AVX2Float a, AVX2Float b) { return {_mm256_add_ps(a.Value, b.Value)}; }
+            friend AVX2Float operator-(AVX2Float a, AVX2Float b) { return {_mm256_sub_ps(a.Value, b.Value)}; }
+            friend AVX2Float operator*(AVX2Float a, AVX2Float b) { return {_mm256_mul_ps(a.Value, b.Value)}; }
+
+            static AVX2Float MulAdd(AVX2Float a, AVX2Float b, AVX2Float c)
+            {
+                return {_mm256_fmadd_ps(a.Value, b.Value, c.Value)};
+            }
+            static AVX2Float Max(AVX2Float a, AVX2Float b) { return {_mm256_max_ps(a.Value, b.Value)}; }
+            static AVX2Float Abs(AVX2Float a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.Value)}; }
+            static AVX2Float Sqrt(AVX2Float a) { return {_mm256_sqrt_ps(a.Value)}; }
+        };
+
+        const MathKernelTable s_AVX2MathKernels = MathKernelsImpl::MakeKernelTable<AVX2Float>();
+    } // namespace
+
+    const MathKernelTable* GetAVX2MathKernels() { return &s_AVX2MathKernels; }
+} // namespace ForgeEngine
+
+#else
+
+namespace ForgeEngine
+{
+    const MathKernelTable* GetAVX2MathKernels() { return nullptr; }
+} // namespace ForgeEngine
+
+#endif
@@ -0,0 +1,48 @@
+// Built with AVX-512 F enabled for this file only, nothing here may run
+// before MathKernels checked the CPU.
+
+#include "Core/Math/MathKernelsImpl.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace ForgeEngine
+{
+    namespace
+    {
+        struct AVX512Float
+        {
+            static constexpr size_t Width = 16;
+            __m512 Value;
+
+            static AVX512Float Load(const float* data) { return {_mm512_loadu_ps(data)}; }
+            static AVX512Float Set(float value) { return {_mm512_set1_ps(value)}; }
+            static void Store(float* data, AVX512Float v) { _mm512_storeu_ps(data, v.Value); }
+
+            friend AVX512Float operator+(AVX512Float a, AVX512Float b) { return {_mm512_add_ps(a.Value, b.Value)}; }
+            friend AVX512Float operator-(AVX512Float a, AVX512Float b) { return {_mm512_sub_ps(a.Value, b.Value)}; }
+            friend AVX512Float operator*(AVX512Float a, AVX512Float b) { return {_mm512_mul_ps(a.Value, b.Value)}; }
+
+            static AVX512Float MulAdd(AVX512Float a, AVX512Float b, AVX512Float c)
+            {
+                return {_mm512_fmadd_ps(a.Value, b.Value, c.Value)};
+            }
+            static AVX512Float Max(AVX512Float a, AVX512Float b) { return {_mm512_max_ps(a.Value, b.Value)}; }
+            static AVX512Float Abs(AVX512Float a) { return {_mm512_abs_ps(a.Value)}; }
+            static AVX512Float Sqrt(AVX512Float a) { return {_mm512_sqrt_ps(a.Value)}; }
+        };
+
+        const MathKernelTable s_AVX512MathKernels = MathKernelsImpl::MakeKernelTable<AVX512Float>();
+    } // namespace
+
+    const MathKernelTable* GetAVX512MathKernels() { return &s_AVX512MathKernels; }
+} // namespace ForgeEngine
+
+#else
+
+namespace ForgeEngine
+{
+    const MathKernelTable* GetAVX512MathKernels() { return nullptr; }
+} // namespace ForgeEngine
+
+#endif
@@ -0,0 +1,232 @@
+#pragma once
+
+// Shared bodies of the SIMD kernels. Each instruction set file defines a
+// vector type with the operations below and instantiates the templates with
+// it; whatever does not fill a whole vector goes to the scalar kernels.
+//
+//   static constexpr size_t Width;
+//   static V Load(const float*), Set(float);
+//   static void Store(float*, V);
+//   operators + - *, MulAdd(a, b, c) = a * b + c, Max, Abs, Sqrt
+
+#include "Core/Math/MathKernels.h"
+
+namespace ForgeEngine
+{
+    namespace MathKernelsScalar
+    {
+        void ComposeTRS(const TRSStreams& trs, const AffineStreams& out, size_t count);
+        void TransformSpheres(const ConstAffineStreams& transforms,
+                              const ConstSphereStreams& local, const SphereStreams& world,
+                              size_t count);
+        void TransformAABBs(const ConstAffineStreams& transforms,
+                            const ConstAABBStreams& local, const AABBStreams& world,
+                            size_t count);
+        void TransformVec4(const float* matrix, const ConstVec4Streams& in,
+                           const Vec4Streams& out, size_t count);
+    } // namespace MathKernelsScalar
+
+    // Null when the file was built for another architecture
+    const MathKernelTable* GetSSE2MathKernels();
+    const MathKernelTable* GetAVX2MathKernels();
+    const MathKernelTable* GetAVX512MathKernels();
+    const MathKernelTable* GetNEONMathKernels();
+
+    // Internal linkage on purpose: every instruction set file gets its own
+    // copy, the linker must never merge an AVX2 compiled helper into the
+    // SSE2 path
+    namespace
+    {
+    namespace MathKernelsImpl
+    {
+        // Same streams advanced by first entities, for the scalar tails
+        template <typename T, size_t N>
+        inline void OffsetStreams(T* const (&in)[N], T* (&out)[N], size_t first)
+        {
+            for (size_t i = 0; i < N; i++)
+                out[i] = in[i] + first;
+        }
+
+        template <typename V>
+        void ComposeTRS(const TRSStreams& trs, const AffineStreams& out, size_t count)
+        {
+            const V one = V::Set(1.0f);
+            const V two = V::Set(2.0f);
+
+            size_t i = 0;
+            for (; i + V::Width <= count; i += V::Width)
+            {
+                V x = V::Load(trs.Rotation[0] + i), y = V::Load(trs.Rotation[1] + i);
+                V z = V::Load(trs.Rotation[2] + i), w = V::Load(trs.Rotation[3] + i);
+                V sx = V::Load(trs.Scale[0] + i), sy = V::Load(trs.Scale[1] + i);
+                V sz = V::Load(trs.Scale[2] + i);
+
+                V x2 = x * two, y2 = y * two, z2 = z * two;
+                V xx = x * x2, yy = y * y2, zz = z * z2;
+                V xy = x * y2, xz = x * z2, yz = y * z2;
+                V wx = w * x2, wy = w * y2, wz = w * z2;
+
+                V::Store(out.M[0] + i, (one - (yy + zz)) * sx);
+                V::Store(out.M[1] + i, (xy - wz) * sy);
+                V::Store(out.M[2] + i, (xz + wy) * sz);
+                V::Store(out.M[3] + i, V::Load(trs.Position[0] + i));
+
+                V::Store(out.M[4] + i, (xy + wz) * sx);
+                V::Store(out.M[5] + i, (one - (xx + zz)) * sy);
+                V::Store(out.M[6] + i, (yz - wx) * sz);
+                V::Store(out.M[7] + i, V::Load(trs.Position[1] + i));
+
+                V::Store(out.M[8] + i, (xz - wy) * sx);
+                V::Store(out.M[9] + i, (yz + wx) * sy);
+                V::Store(out.M[10] + i, (one - (xx + yy)) * sz);
+                V::Store(out.M[11] + i, V::Load(trs.Position[2] + i));
+            }
+
+            if (i == count)
+                return;
+
+            TRSStreams tailIn;
+            AffineStreams tailOut;
+            OffsetStreams(trs.Position, tailIn.Position, i);
+            OffsetStreams(trs.Rotation, tailIn.Rotation, i);
+            OffsetStreams(trs.Scale, tailIn.Scale, i);
+            OffsetStreams(out.M, tailOut.M, i);
+            MathKernelsScalar::ComposeTRS(tailIn, tailOut, count - i);
+        }
+
+        template <typename V>
+        void TransformSpheres(const ConstAffineStreams& transforms,
+                              const ConstSphereStreams& local, const SphereStreams& world,
+                              size_t count)
+        {
+            size_t i = 0;
+            for (; i + V::Width <= count; i += V::Width)
+            {
+                V m[12];
+                for (int k = 0; k < 12; k++)
+                    m[k] = V::Load(transforms.M[k] + i);
+
+                V cx = V::Load(local.Center[0] + i), cy = V::Load(local.Center[1] + i);
+                V cz = V::Load(local.Center[2] + i);
+                for (int row = 0; row < 3; row++)
+                {
+                    V center = V::MulAdd(m[row * 4], cx,
+                                         V::MulAdd(m[row * 4 + 1], cy,
+                                                   V::MulAdd(m[row * 4 + 2], cz, m[row * 4 + 3])));
+                    V::Store(world.Center[row] + i, center);
+                }
+
+                // Squared lengths of the basis columns, one sqrt at the end
+                V scale0 = V::MulAdd(m[0], m[0], V::MulAdd(m[4], m[4], m[8] * m[8]));
+                V scale1 = V::MulAdd(m[1], m[1], V::MulAdd(m[5], m[5], m[9] * m[9]));
+                V scale2 = V::MulAdd(m[2], m[2], V::MulAdd(m[6], m[6], m[10] * m[10]));
+                V maxScale = V::Sqrt(V::Max(scale0, V::Max(scale1, scale2)));
+                V::Store(world.Radius + i, V::Load(local.Radius + i) * maxScale);
+            }
+
+            if (i == count)
+                return;
+
+            ConstAffineStreams tailTransforms;
+            ConstSphereStreams tailLocal;
+            SphereStreams tailWorld;
+            OffsetStreams(transforms.M, tailTransforms.M, i);
+            OffsetStreams(local.Center, tailLocal.Center, i);
+            tailLocal.Radius = local.Radius + i;
+            OffsetStreams(world.Center, tailWorld.Center, i);
+            tailWorld.Radius = world.Radius + i;
+            MathKernelsScalar::TransformSpheres(tailTransforms, tailLocal, tailWorld, count - i);
+        }
+
+        template <typename V>
+        void TransformAABBs(const ConstAffineStreams& transforms,
+                            const ConstAABBStreams& local, const AABBStreams& world,
+                            size_t count)
+        {
+            const V half = V::Set(0.5f);
+
+            size_t i = 0;
+            for (; i + V::Width <= count; i += V::Width)
+            {
+                V center[3], extent[3];
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    V min = V::Load(local.Min[axis] + i), max = V::Load(local.Max[axis] + i);
+                    center[axis] = (min + max) * half;
+                    extent[axis] = (max - min) * half;
+                }
+
+                for (int row = 0; row < 3; row++)
+                {
+                    V m0 = V::Load(transforms.M[row * 4] + i);
+                    V m1 = V::Load(transforms.M[row * 4 + 1] + i);
+                    V m2 = V::Load(transforms.M[row * 4 + 2] + i);
+                    V t = V::Load(transforms.M[row * 4 + 3] + i);
+
+                    V worldCenter = V::MulAdd(m0, center[0],
+                                              V::MulAdd(m1, center[1],
+                                                        V::MulAdd(m2, center[2], t)));
+                    V worldExtent = V::MulAdd(V::Abs(m0), extent[0],
+                                              V::MulAdd(V::Abs(m1), extent[1],
+                                                        V::Abs(m2) * extent[2]));
+
+                    V::Store(world.Min[row] + i, worldCenter - worldExtent);
+                    V::Store(world.Max[row] + i, worldCenter + worldExtent);
+                }
+            }
+
+            if (i == count)
+                return;
+
+            ConstAffineStreams tailTransforms;
+            ConstAABBStreams tailLocal;
+            AABBStreams tailWorld;
+            OffsetStreams(transforms.M, tailTransforms.M, i);
+            OffsetStreams(local.Min, tailLocal.Min, i);
+            OffsetStreams(local.Max, tailLocal.Max, i);
+            OffsetStreams(world.Min, tailWorld.Min, i);
+            OffsetStreams(world.Max, tailWorld.Max, i);
+            MathKernelsScalar::TransformAABBs(tailTransforms, tailLocal, tailWorld, count - i);
+        }
+
+        template <typename V>
+        void TransformVec4(const float* matrix, const ConstVec4Streams& in,
+                           const Vec4Streams& out, size_t count)
+        {
+            V m[16];
+            for (int k = 0; k < 16; k++)
+                m[k] = V::Set(matrix[k]);
+
+            size_t i = 0;
+            for (; i + V::Width <= count; i += V::Width)
+            {
+                V x = V::Load(in.V[0] + i), y = V::Load(in.V[1] + i);
+                V z = V::Load(in.V[2] + i), w = V::Load(in.V[3] + i);
+                for (int row = 0; row < 4; row++)
+                {
+                    V value = V::MulAdd(m[row], x,
+                                        V::MulAdd(m[4 + row], y,
+                                                  V::MulAdd(m[8 + row], z, m[12 + row] * w)));
+                    V::Store(out.V[row] + i, value);
+                }
+            }
+
+            if (i == count)
+                return;
+
+            ConstVec4Streams tailIn;
+            Vec4Streams tailOut;
+            OffsetStreams(in.V, tailIn.V, i);
+            OffsetStreams(out.V, tailOut.V, i);
+            MathKernelsScalar::TransformVec4(matrix, tailIn, tailOut, count - i);
+        }
+
+        template <typename V>
+        constexpr MathKernelTable MakeKernelTable()
+        {
+            return {&ComposeTRS<V>, &TransformSpheres<V>, &TransformAABBs<V>,
+                    &TransformVec4<V>};
+        }
+    } // namespace MathKernelsImpl
+    } // namespace
+} // namespace ForgeEngine
@@ -0,0 +1,48 @@
+// NEON is part of the AArch64 baseline, no per-file flags or runtime check
+// are needed there.
+
+#include "Core/Math/MathKernelsImpl.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+
+namespace ForgeEngine
+{
+    namespace
+    {
+        struct NEONFloat
+        {
+            static constexpr size_t Width = 4;
+            float32x4_t Value;
+
+            static NEONFloat Load(const float* data) { return {vld1q_f32(data)}; }
+            static NEONFloat Set(float value) { return {vdupq_n_f32(value)}; }
+            static void Store(float* data, NEONFloat v) { vst1q_f32(data, v.Value); }
+
+            friend NEONFloat operator+(NEONFloat a, NEONFloat b) { return {vaddq_f32(a.Value, b.Value)}; }
+            friend NEONFloat operator-(NEONFloat a, NEONFloat b) { return {vsubq_f32(a.Value, b.Value)}; }
+            friend NEONFloat operator*(NEONFloat a, NEONFloat b) { return {vmulq_f32(a.Value, b.Value)}; }
+
+            static NEONFloat MulAdd(NEONFloat a, NEONFloat b, NEONFloat c)
+            {
+                return {vfmaq_f32(c.Value, a.Value, b.Value)};
+            }
+            static NEONFloat Max(NEONFloat a, NEONFloat b) { return {vmaxq_f32(a.Value, b.Value)}; }
+            static NEONFloat Abs(NEONFloat a) { return {vabsq_f32(a.Value)}; }
+            static NEONFloat Sqrt(NEONFloat a) { return {vsqrtq_f32(a.Value)}; }
+        };
+
+        const MathKernelTable s_NEONMathKernels = MathKernelsImpl::MakeKernelTable<NEONFloat>();
+    } // namespace
+
+    const MathKernelTable* GetNEONMathKernels() { return &s_NEONMathKernels; }
+} // namespace ForgeEngine
+
+#else
+
+namespace ForgeEngine
+{
+    const MathKernelTable* GetNEONMathKernels() { return nullptr; }
+} // namespace ForgeEngine
+
+#endif
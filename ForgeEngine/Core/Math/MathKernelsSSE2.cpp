@@ -0,0 +1,48 @@
+// SSE2 is the x86-64 baseline, the kernels need nothing newer so they run
+// on every x86 node; 32-bit builds still check the CPU first.
+
+#include "Core/Math/MathKernelsImpl.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+
+namespace ForgeEngine
+{
+    namespace
+    {
+        struct SSE2Float
+        {
+            static constexpr size_t Width = 4;
+            __m128 Value;
+
+            static SSE2Float Load(const float* data) { return {_mm_loadu_ps(data)}; }
+            static SSE2Float Set(float value) { return {_mm_set1_ps(value)}; }
+            static void Store(float* data, SSE2Float v) { _mm_storeu_ps(data, v.Value); }
+
+            friend SSE2Float operator+(SSE2Float a, SSE2Float b) { return {_mm_add_ps(a.Value, b.Value)}; }
+            friend SSE2Float operator-(SSE2Float a, SSE2Float b) { return {_mm_sub_ps(a.Value, b.Value)}; }
+            friend SSE2Float operator*(SSE2Float a, SSE2Float b) { return {_mm_mul_ps(a.Value, b.Value)}; }
+
+            static SSE2Float MulAdd(SSE2Float a, SSE2Float b, SSE2Float c)
+            {
+                return {_mm_add_ps(_mm_mul_ps(a.Value, b.Value), c.Value)};
+            }
+            static SSE2Float Max(SSE2Float a, SSE2Float b) { return {_mm_max_ps(a.Value, b.Value)}; }
+            static SSE2Float Abs(SSE2Float a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.Value)}; }
+            static SSE2Float Sqrt(SSE2Float a) { return {_mm_sqrt_ps(a.Value)}; }
+        };
+
+        const MathKernelTable s_SSE2MathKernels = MathKernelsImpl::MakeKernelTable<SSE2Float>();
+    } // namespace
+
+    const MathKernelTable* GetSSE2MathKernels() { return &s_SSE2MathKernels; }
+} // namespace ForgeEngine
+
+#else
+
+namespace ForgeEngine
+{
+    const MathKernelTable* GetSSE2MathKernels() { return nullptr; }
+} // namespace ForgeEngine
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glm.hpp>
+
+namespace ForgeEngine
+{
+    // World space AABB of a transformed local AABB (Arvo, Graphics Gems
+    // 1990). Each output axis sums the absolute contribution of every local
+    // axis, which is exact for the box's corners and costs no corner loop.
+    inline void TransformAABB(const glm::mat4& transform, const glm::vec3& localMin,
+                              const glm::vec3& localMax, glm::vec3& outMin,
+                              glm::vec3& outMax)
+    {
+        glm::vec3 center = (localMin + localMax) * 0.5f;
+        glm::vec3 halfExtent = (localMax - localMin) * 0.5f;
+
+        glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+        glm::vec3 worldHalfExtent = glm::abs(glm::vec3(transform[0])) * halfExtent.x
+            + glm::abs(glm::vec3(transform[1])) * halfExtent.y
+            + glm::abs(glm::vec3(transform[2])) * halfExtent.z;
+
+        outMin = worldCenter - worldHalfExtent;
+        outMax = worldCenter + worldHalfExtent;
+    }
+
+    // Largest axis scale of an affine transform, what a bounding sphere
+    // radius has to be multiplied by
+    inline float GetMaxScale(const glm::mat4& transform)
+    {
+        return glm::sqrt(glm::max(glm::max(glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                                           glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1]))),
+                                  glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))));
+    }
+} // namespace ForgeEngine
@@ -14,7 +14,7 @@ namespace ForgeEngine {
     return nullptr;
   }
 
-  Ref<VertexBuffer> VertexBuffer::Create(float *vertices, uint32_t size) {
+  Ref<VertexBuffer> VertexBuffer::Create(const void *vertices, uint32_t size) {
     switch (Renderer::GetAPI()) {
       case RendererAPI::API::None: FENGINE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
         return nullptr;
@@ -25,14 +25,38 @@ namespace ForgeEngine {
     return nullptr;
   }
 
-  Ref<IndexBuffer> IndexBuffer::Create(uint32_t *indices, uint32_t size) {
+  Ref<IndexBuffer> IndexBuffer::Create(const uint32_t *indices, uint32_t size) {
     switch (Renderer::GetAPI()) {
       case RendererAPI::API::None: FENGINE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
         return nullptr;
-      case RendererAPI::API::OpenGL: return CreateRef<OpenGLIndexBuffer>(indices, size);
+      case RendererAPI::API::OpenGL: return CreateRef<OpenGLIndexBuffer>(indices, size, IndexType::UInt32);
     }
 
     FENGINE_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
+
+  Ref<IndexBuffer> IndexBuffer::Create(const uint16_t *indices, uint32_t size) {
+    switch (Renderer::GetAPI()) {
+      case RendererAPI::API::None: FENGINE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+        return nullptr;
+      case RendererAPI::API::OpenGL: return CreateRef<OpenGLIndexBuffer>(indices, size, IndexType::UInt16);
+    }
+
+    FENGINE_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+
+  Ref<IndexBuffer> IndexBuffer::Create(const uint32_t *indices, uint32_t size, IndexType type) {
+    if (type == IndexType::UInt32)
+      return Create(indices, size);
+
+    std::vector<uint16_t> narrowed(size);
+    for (uint32_t i = 0; i < size; i++) {
+      FENGINE_CORE_ASSERT(indices[i] < 0xffff || indices[i] == PrimitiveRestartIndex,
+                          "Index does not fit a 16 bit index buffer!");
+      narrowed[i] = (uint16_t)indices[i];
+    }
+    return Create(narrowed.data(), size);
+  }
 } // BEngine
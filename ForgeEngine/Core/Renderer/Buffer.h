@@ -16,7 +16,19 @@ namespace ForgeEngine
         Int2,
         Int3,
         Int4,
-        Bool
+        Bool,
+
+        // Converted to float by the vertex fetch, normalized or not depending
+        // on BufferElement::Normalized
+        Half2,
+        Half4,
+        Short2,
+        Short4,
+        UShort2,
+        UShort4,
+        Int1010102, // GL_INT_2_10_10_10_REV, xyz + 2 bit w
+        // Appended, the values above are stored in cooked mesh files
+        UByte4
     };
 
     static glm::uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -45,6 +57,17 @@ namespace ForgeEngine
             return 4 * 4;
         case ShaderDataType::Bool:
             return 1;
+        case ShaderDataType::Half2:
+        case ShaderDataType::Short2:
+        case ShaderDataType::UShort2:
+            return 2 * 2;
+        case ShaderDataType::Half4:
+        case ShaderDataType::Short4:
+        case ShaderDataType::UShort4:
+            return 2 * 4;
+        case ShaderDataType::UByte4:
+        case ShaderDataType::Int1010102:
+            return 4;
         }
 
         FENGINE_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -94,6 +117,16 @@ namespace ForgeEngine
                 return 4;
             case ShaderDataType::Bool:
                 return 1;
+            case ShaderDataType::Half2:
+            case ShaderDataType::Short2:
+            case ShaderDataType::UShort2:
+                return 2;
+            case ShaderDataType::Half4:
+            case ShaderDataType::Short4:
+            case ShaderDataType::UShort4:
+            case ShaderDataType::UByte4:
+            case ShaderDataType::Int1010102:
+                return 4;
             }
 
             FENGINE_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -114,6 +147,18 @@ namespace ForgeEngine
             CalculateOffsetsAndStride();
         }
 
+        BufferLayout(const std::vector<BufferElement>& elements)
+            : m_Elements(elements)
+        {
+            CalculateOffsetsAndStride();
+        }
+
+        // Keeps the element offsets as given, for vertex structs with padding
+        BufferLayout(const std::vector<BufferElement>& elements, uint32_t stride)
+            : m_Elements(elements), m_Stride(stride)
+        {
+        }
+
         uint32_t GetStride() const { return m_Stride; }
 
         const std::vector<BufferElement>& GetElements() const
@@ -164,15 +209,49 @@ namespace ForgeEngine
         virtual void Bind() const = 0;
         virtual void Unbind() const = 0;
 
-        virtual void SetData(const void* data, uint32_t size) = 0;
+        // offset is in bytes from the start of the buffer
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
 
         virtual const BufferLayout& GetLayout() const = 0;
         virtual void SetLayout(const BufferLayout& layout) = 0;
 
+        // Dynamic storage, filled later through SetData
         static Ref<VertexBuffer> Create(uint32_t size);
-        static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
+        // Immutable storage initialised straight from the given memory (which
+        // may be a memory mapped file); SetData is not allowed afterwards
+        static Ref<VertexBuffer> Create(const void* vertices, uint32_t size);
     };
 
+    enum class IndexType : uint8_t
+    {
+        UInt16 = 0,
+        UInt32
+    };
+
+    // How an index buffer is assembled into primitives
+    enum class PrimitiveTopology : uint8_t
+    {
+        Triangles = 0,
+        Lines,
+        TriangleStrip
+    };
+
+    // Ends the current strip. Always written as a uint32_t, it is narrowed
+    // to 0xffff together with the rest of a 16 bit buffer.
+    constexpr uint32_t PrimitiveRestartIndex = 0xffffffff;
+
+    static uint32_t IndexTypeSize(IndexType type)
+    {
+        return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
+    // Smallest index type that can address vertexCount vertices while keeping
+    // the all-ones value free for primitive restart
+    static IndexType GetIndexTypeForVertexCount(uint32_t vertexCount)
+    {
+        return vertexCount <= 0xffff ? IndexType::UInt16 : IndexType::UInt32;
+    }
+
     class IndexBuffer
     {
     public:
@@ -182,7 +261,14 @@ namespace ForgeEngine
         virtual void Unbind() const = 0;
 
         virtual uint32_t GetCount() const = 0;
+        virtual IndexType GetIndexType() const = 0;
 
-        static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+        // Immutable storage, see VertexBuffer::Create(const void*, uint32_t)
+        static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count);
+        static Ref<IndexBuffer> Create(const uint16_t* indices, uint32_t count);
+        // Stores 32 bit source indices as type, narrowing them when it is
+        // UInt16 (every index must then be below 0xffff or a restart)
+        static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count,
+                                       IndexType type);
     };
 } // namespace ForgeEngine
@@ -0,0 +1,81 @@
+#include "Core/Renderer/CookedTexture.h"
+
+#include "FEPCH.h"
+
+namespace ForgeEngine
+{
+    Ref<CookedTexture> CookedTexture::Open(const std::string& path)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        Scope<MappedFile> file = MappedFile::Open(path);
+        if (!file)
+            return nullptr;
+
+        if (file->GetSize() < sizeof(CookedTextureHeader))
+        {
+            FENGINE_CORE_ERROR("Cooked texture '{}' is truncated", path);
+            return nullptr;
+        }
+
+        auto header = (const CookedTextureHeader*)file->GetData();
+        if (header->Magic != Magic || header->Version != Version)
+        {
+            FENGINE_CORE_ERROR("'{}' is not a cooked texture (version {})", path,
+                               Version);
+            return nullptr;
+        }
+
+        ImageFormat format = (ImageFormat)header->Format;
+        if (ImageFormatBlockSize(format) == 0 || header->Width == 0
+            || header->Height == 0 || header->MipCount == 0
+            || header->MipCount > CalculateMipCount(header->Width,
+                                                    header->Height))
+        {
+            FENGINE_CORE_ERROR("Cooked texture '{}' has an invalid header", path);
+            return nullptr;
+        }
+
+        size_t tableEnd = sizeof(CookedTextureHeader)
+            + header->MipCount * sizeof(CookedTextureLevel);
+        if (file->GetSize() < tableEnd)
+        {
+            FENGINE_CORE_ERROR("Cooked texture '{}' is truncated", path);
+            return nullptr;
+        }
+
+        auto levels = (const CookedTextureLevel*)(file->GetData()
+                                                  + sizeof(CookedTextureHeader));
+        for (uint32_t i = 0; i < header->MipCount; i++)
+        {
+            // Every level must have the size its dimensions need, those
+            // must match the header and the bytes must lie inside the file
+            const CookedTextureLevel& level = levels[i];
+            if (level.Width != std::max(1u, header->Width >> i)
+                || level.Height != std::max(1u, header->Height >> i)
+                || level.Size != ImageFormatLevelSize(format, level.Width,
+                                                      level.Height)
+                || level.Offset > file->GetSize()
+                || level.Size > file->GetSize() - level.Offset)
+            {
+                FENGINE_CORE_ERROR("Cooked texture '{}' has a corrupt mip {}",
+                                   path, i);
+                return nullptr;
+            }
+        }
+
+        auto texture = CreateRef<CookedTexture>();
+        texture->m_Header = header;
+        texture->m_Levels = levels;
+        texture->m_File = std::move(file);
+        return texture;
+    }
+
+    bool CookedTexture::IsCookedTexturePath(const std::string& path)
+    {
+        std::string extension = Extension;
+        return path.size() > extension.size()
+            && path.compare(path.size() - extension.size(), extension.size(),
+                            extension) == 0;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Renderer/Texture.h"
+#include <cstdint>
+#include <string>
+
+namespace ForgeEngine
+{
+    // On-disk layout of a cooked texture (.ftex):
+    //   CookedTextureHeader
+    //   CookedTextureLevel[MipCount]
+    //   level data, largest first, each level aligned to LevelAlignment
+    // Level data is stored exactly as the GPU consumes it, so loading is a
+    // memory map followed by one upload per level.
+    struct CookedTextureHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Format; // ImageFormat
+        uint32_t MipCount;
+        uint32_t Flags;
+        uint32_t Reserved;
+    };
+
+    struct CookedTextureLevel
+    {
+        uint64_t Offset;
+        uint64_t Size;
+        uint32_t Width;
+        uint32_t Height;
+    };
+
+    class CookedTexture
+    {
+    public:
+        static constexpr uint32_t Magic = 0x58455446; // "FTEX"
+        static constexpr uint32_t Version = 1;
+        static constexpr uint32_t LevelAlignment = 16;
+        static constexpr const char* Extension = ".ftex";
+
+        ImageFormat GetFormat() const { return (ImageFormat)m_Header->Format; }
+        uint32_t GetWidth() const { return m_Header->Width; }
+        uint32_t GetHeight() const { return m_Header->Height; }
+        uint32_t GetMipCount() const { return m_Header->MipCount; }
+
+        const CookedTextureLevel& GetLevel(uint32_t level) const { return m_Levels[level]; }
+        const uint8_t* GetLevelData(uint32_t level) const
+        {
+            return m_File->GetData() + m_Levels[level].Offset;
+        }
+
+        const std::string& GetPath() const { return m_File->GetPath(); }
+        uint64_t GetFileSize() const { return m_File->GetSize(); }
+
+        // Maps the file and validates the header and level table. Returns
+        // nullptr when the file is missing, truncated or from another version.
+        static Ref<CookedTexture> Open(const std::string& path);
+
+        static bool IsCookedTexturePath(const std::string& path);
+
+    private:
+        Scope<MappedFile> m_File;
+        const CookedTextureHeader* m_Header = nullptr;
+        const CookedTextureLevel* m_Levels = nullptr;
+    };
+} // namespace ForgeEngine
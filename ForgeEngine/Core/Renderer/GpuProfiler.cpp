@@ -0,0 +1,46 @@
+#include "Core/Renderer/GpuProfiler.h"
+
+#include "FEPCH.h"
+#include "Platform/OpenGL/OpenGLGpuProfiler.h"
+#include "Core/Renderer/Renderer.h"
+
+namespace ForgeEngine
+{
+    static Scope<GpuProfiler> s_GpuProfiler;
+
+    void GpuProfiler::Init()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (!s_GpuProfiler)
+            s_GpuProfiler = Create();
+    }
+
+    void GpuProfiler::Shutdown()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        s_GpuProfiler.reset();
+    }
+
+    GpuProfiler* GpuProfiler::Get()
+    {
+        return s_GpuProfiler.get();
+    }
+
+    Scope<GpuProfiler> GpuProfiler::Create()
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            FENGINE_CORE_ASSERT(false,
+                                "RendererAPI::None is currently not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return CreateScope<OpenGLGpuProfiler>();
+        }
+
+        FENGINE_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+} // namespace ForgeEngine
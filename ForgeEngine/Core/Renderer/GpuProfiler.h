@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/Debug/Instrumentor.h"
+#include <cstdint>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Counters of the vertex and fragment stages, only gathered for the
+    // outermost scope of a frame because the queries cannot nest
+    struct GpuPipelineStatistics
+    {
+        uint64_t VerticesSubmitted = 0;
+        uint64_t PrimitivesSubmitted = 0;
+        uint64_t VertexShaderInvocations = 0;
+        uint64_t ClippingInputPrimitives = 0;
+        uint64_t ClippingOutputPrimitives = 0;
+        uint64_t FragmentShaderInvocations = 0;
+    };
+
+    struct GpuScopeTiming
+    {
+        const char* Name = nullptr;
+        uint32_t Depth = 0;      // 0 is the whole frame
+        double StartMs = 0.0;    // from the start of the frame
+        double DurationMs = 0.0;
+
+        bool HasPipelineStatistics = false;
+        GpuPipelineStatistics PipelineStatistics;
+    };
+
+    struct GpuFrameTimings
+    {
+        uint64_t FrameIndex = 0;
+        double TotalMs = 0.0;
+        // In the order the scopes began, children follow their parent
+        std::vector<GpuScopeTiming> Scopes;
+    };
+
+    struct GpuProfilerStats
+    {
+        uint32_t ScopesPerFrame = 0;
+        // Frames whose queries were still not done when their slot came
+        // around again; their results are thrown away instead of waiting
+        uint32_t DroppedFrames = 0;
+    };
+
+    // Times passes on the GPU with timestamp queries. Queries of a frame are
+    // read FrameLatency frames later so the readback never waits on the GPU.
+    // Every scope is also a debug group, so external tools show the same
+    // passes, and resolved scopes go to the "GPU" track of the profile trace.
+    class GpuProfiler
+    {
+    public:
+        static constexpr uint32_t FrameLatency = 4;
+
+        virtual ~GpuProfiler() = default;
+
+        // Called by the application around everything a frame submits
+        virtual void BeginFrame() = 0;
+        virtual void EndFrame() = 0;
+
+        // name must outlive the results, string literals are expected
+        virtual void BeginScope(const char* name) = 0;
+        virtual void EndScope() = 0;
+
+        // The newest frame whose queries have been read back
+        virtual const GpuFrameTimings& GetLatestFrame() const = 0;
+        virtual GpuProfilerStats GetStats() const = 0;
+
+        // Disabled scopes still emit their debug groups
+        virtual void SetEnabled(bool enabled) = 0;
+        virtual bool IsEnabled() const = 0;
+
+        virtual bool SupportsPipelineStatistics() const = 0;
+        virtual void SetPipelineStatisticsEnabled(bool enabled) = 0;
+        virtual bool IsPipelineStatisticsEnabled() const = 0;
+
+        // Must be called with the context current
+        static void Init();
+        static void Shutdown();
+
+        // nullptr when the profiler has not been initialized
+        static GpuProfiler* Get();
+
+        static Scope<GpuProfiler> Create();
+    };
+
+    class GpuProfileScope
+    {
+    public:
+        explicit GpuProfileScope(const char* name): m_Profiler(GpuProfiler::Get())
+        {
+            if (m_Profiler)
+                m_Profiler->BeginScope(name);
+        }
+
+        ~GpuProfileScope()
+        {
+            if (m_Profiler)
+                m_Profiler->EndScope();
+        }
+
+        GpuProfileScope(const GpuProfileScope&) = delete;
+        GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+    private:
+        GpuProfiler* m_Profiler;
+    };
+} // namespace ForgeEngine
+
+#if FENGINE_PROFILE
+#define FENGINE_GPU_SCOPE_LINE2(name, line)                                    \
+    ::ForgeEngine::GpuProfileScope gpuScope##line(name)
+#define FENGINE_GPU_SCOPE_LINE(name, line) FENGINE_GPU_SCOPE_LINE2(name, line)
+#define FENGINE_GPU_SCOPE(name) FENGINE_GPU_SCOPE_LINE(name, __LINE__)
+#else
+#define FENGINE_GPU_SCOPE(name)
+#endif
@@ -0,0 +1,80 @@
+#include "Core/Renderer/InstanceData.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FORGE_INSTANCE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FORGE_INSTANCE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ForgeEngine
+{
+    // SSE2 and NEON are part of the x86-64 and AArch64 baselines, so these
+    // need no runtime dispatch
+    void OptimizedInstanceData::SetTransform(const glm::mat4& transform)
+    {
+        const float* m = &transform[0][0];
+#if defined(FORGE_INSTANCE_SSE2)
+        __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(&Row0.x, c0);
+        _mm_storeu_ps(&Row1.x, c1);
+        _mm_storeu_ps(&Row2.x, c2);
+#elif defined(FORGE_INSTANCE_NEON)
+        // De-interleaving load, lane k of val[r] is column k of row r
+        float32x4x4_t rows = vld4q_f32(m);
+        vst1q_f32(&Row0.x, rows.val[0]);
+        vst1q_f32(&Row1.x, rows.val[1]);
+        vst1q_f32(&Row2.x, rows.val[2]);
+#else
+        Row0 = glm::vec4(m[0], m[4], m[8], m[12]);
+        Row1 = glm::vec4(m[1], m[5], m[9], m[13]);
+        Row2 = glm::vec4(m[2], m[6], m[10], m[14]);
+#endif
+    }
+
+    static inline Unorm8x4 PackColor(const glm::vec4& color)
+    {
+#if defined(FORGE_INSTANCE_SSE2)
+        __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&color.x), _mm_setzero_ps()),
+                                    _mm_set1_ps(1.0f));
+        __m128i ints = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+        __m128i shorts = _mm_packs_epi32(ints, ints);
+        return {(uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(shorts, shorts))};
+#elif defined(FORGE_INSTANCE_NEON)
+        float32x4_t clamped = vminq_f32(vmaxq_f32(vld1q_f32(&color.x), vdupq_n_f32(0.0f)),
+                                        vdupq_n_f32(1.0f));
+        uint32x4_t ints = vcvtnq_u32_f32(vmulq_n_f32(clamped, 255.0f));
+        uint16x4_t shorts = vmovn_u32(ints);
+        uint8x8_t bytes = vmovn_u16(vcombine_u16(shorts, shorts));
+        return {vget_lane_u32(vreinterpret_u32_u8(bytes), 0)};
+#else
+        return VertexPacking::PackUnorm8x4(color);
+#endif
+    }
+
+    glm::mat4 OptimizedInstanceData::GetTransform() const
+    {
+        return glm::transpose(glm::mat4(Row0, Row1, Row2, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+    }
+
+    void OptimizedInstanceData::SetColor(const glm::vec4& color) { Color = PackColor(color); }
+
+    void OptimizedInstanceData::SetSurface(float metallic, float roughness)
+    {
+        Surface = VertexPacking::PackUnorm8x4(glm::vec4(metallic, roughness, 0.0f, 0.0f));
+    }
+
+    glm::mat3 ComputeNormalMatrix(const glm::mat4& transform)
+    {
+        glm::vec3 c0 = glm::vec3(transform[0]);
+        glm::vec3 c1 = glm::vec3(transform[1]);
+        glm::vec3 c2 = glm::vec3(transform[2]);
+
+        glm::vec3 n0 = glm::cross(c1, c2);
+        float sign = glm::dot(c0, n0) < 0.0f ? -1.0f : 1.0f;
+        return glm::mat3(n0 * sign, glm::cross(c2, c0) * sign, glm::cross(c0, c1) * sign);
+    }
+} // namespace ForgeEngine
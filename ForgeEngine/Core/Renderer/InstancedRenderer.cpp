@@ -1,13 +1,13 @@
 #include "Core/Renderer/InstancedRenderer.h"
 #include "Core/Renderer/RenderCommand.h"
-#include "glad/glad.h"
 #include <gtc/matrix_transform.hpp>
 #include "FEPCH.h"
 
 namespace ForgeEngine
 {
     // Forward declaration para função de culling (definida em Renderer3D.cpp)
-    bool PerformCulling(int entityID, const glm::mat4& transform, float* outBoundingRadius);
+    bool PerformCulling(int entityID, const glm::mat4& transform, const Mesh* mesh,
+                        float* outBoundingRadius);
 
     void InstancedRenderer::Init()
     {
@@ -24,12 +24,7 @@ namespace ForgeEngine
             return;
         }
 
-        BufferLayout instanceLayout = {
-            {ShaderDataType::Mat4, "a_InstanceMatrix"}, // locations 3,4,5,6
-            {ShaderDataType::Float4, "a_InstanceColor"}, // location 7
-            {ShaderDataType::Float4, "a_InstanceCustomData"} // location 8
-        };
-        m_InstanceBuffer->SetLayout(instanceLayout);
+        m_InstanceBuffer->SetLayout(GetInstanceLayout());
 
         m_InstanceData.reserve(MAX_INSTANCES);
 
@@ -44,9 +39,8 @@ namespace ForgeEngine
 #ifdef FENGINE_RENDER_DEBUG
         FENGINE_CORE_INFO("Shutting down Instanced Renderer...");
 #endif
-        // Clear cache
-        m_InstancedVAOs.clear();
         m_InstanceData.clear();
+        m_InstancedVertexArray.reset();
 
         // Reset pointers
         m_InstanceBuffer.reset();
@@ -78,7 +72,7 @@ namespace ForgeEngine
 
         m_Stats.TotalInstances += transforms.size();
 
-        PrepareInstanceData(transforms, colors, entityIDs);
+        PrepareInstanceData(mesh.get(), transforms, colors, entityIDs);
 
         if (m_InstanceData.empty())
         {
@@ -87,7 +81,7 @@ namespace ForgeEngine
 
         m_Stats.VisibleInstances += m_InstanceData.size();
 
-        Ref<VertexArray> instancedVAO = GetOrCreateInstancedVAO(mesh);
+        const Ref<VertexArray>& instancedVAO = AttachMeshBuffers(mesh);
 
         if (!instancedVAO)
         {
@@ -109,6 +103,11 @@ namespace ForgeEngine
         m_Stats.DrawCalls++;
     }
 
+    BufferLayout InstancedRenderer::GetInstanceLayout()
+    {
+        return GetVertexLayout<OptimizedInstanceData>();
+    }
+
     void InstancedRenderer::CreateInstancedShader()
     {
         std::string vertexCode = R"(
@@ -119,9 +118,13 @@ layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec3 a_Tangent;
 layout(location = 3) in vec2 a_TexCoord;
 
-layout(location = 4) in mat4 a_InstanceMatrix;     // locations 4,5,6,7
-layout(location = 8) in vec4 a_InstanceColor;      // location 8
-layout(location = 9) in vec4 a_InstanceCustomData; // location 9
+// OptimizedInstanceData: row major 3x4 transform, unorm8 color and surface
+layout(location = 4) in vec4 a_InstanceRow0;
+layout(location = 5) in vec4 a_InstanceRow1;
+layout(location = 6) in vec4 a_InstanceRow2;
+layout(location = 7) in vec4 a_InstanceColor;
+layout(location = 8) in vec4 a_InstanceSurface; // metallic, roughness
+layout(location = 9) in ivec2 a_InstanceIDs;    // entity, material
 
 layout(std140, binding = 0) uniform Camera
 {
@@ -138,22 +141,36 @@ layout(std140, binding = 1) uniform Light
     float u_AmbientLightIntensity;
 };
 
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
+
 out vec3 v_WorldPos;
 out vec3 v_Normal;
 out vec2 v_TexCoord;
 out vec4 v_InstanceColor;
-out vec4 v_CustomData;
+out vec2 v_Surface;
+flat out ivec2 v_InstanceIDs;
 
 void main()
 {
-    vec4 worldPos = a_InstanceMatrix * vec4(a_Position, 1.0);
+    vec4 position = vec4(a_Position * u_PositionScale + u_PositionOffset, 1.0);
+    vec4 worldPos = vec4(dot(a_InstanceRow0, position), dot(a_InstanceRow1, position),
+                         dot(a_InstanceRow2, position), 1.0);
     v_WorldPos = worldPos.xyz;
 
-    v_Normal = mat3(a_InstanceMatrix) * a_Normal;
+    // Cofactor matrix: inverse transpose up to a scale, which the fragment
+    // shader normalizes away, and correct for non uniform scale
+    vec3 c0 = vec3(a_InstanceRow0.x, a_InstanceRow1.x, a_InstanceRow2.x);
+    vec3 c1 = vec3(a_InstanceRow0.y, a_InstanceRow1.y, a_InstanceRow2.y);
+    vec3 c2 = vec3(a_InstanceRow0.z, a_InstanceRow1.z, a_InstanceRow2.z);
+    vec3 n0 = cross(c1, c2);
+    float handedness = dot(c0, n0) < 0.0 ? -1.0 : 1.0;
+    v_Normal = mat3(n0, cross(c2, c0), cross(c0, c1)) * (a_Normal * handedness);
 
     v_TexCoord = a_TexCoord;
     v_InstanceColor = a_InstanceColor;
-    v_CustomData = a_InstanceCustomData;
+    v_Surface = a_InstanceSurface.xy;
+    v_InstanceIDs = a_InstanceIDs;
 
     gl_Position = u_ViewProjection * worldPos;
 }
@@ -168,7 +185,8 @@ in vec3 v_WorldPos;
 in vec3 v_Normal;
 in vec2 v_TexCoord;
 in vec4 v_InstanceColor;
-in vec4 v_CustomData;
+in vec2 v_Surface;
+flat in ivec2 v_InstanceIDs;
 
 out vec4 o_Color;
 
@@ -195,9 +213,9 @@ uniform int u_Wireframe;
 
 void main()
 {
-    float metallic = v_CustomData.x;
-    float roughness = v_CustomData.y;
-    int entityID = int(v_CustomData.z);
+    float metallic = v_Surface.x;
+    float roughness = v_Surface.y;
+    int entityID = v_InstanceIDs.x;
 
     vec4 albedoSample = texture(u_AlbedoMap, v_TexCoord);
     vec4 finalAlbedo = albedoSample * v_InstanceColor;
@@ -236,7 +254,8 @@ void main()
         }
     }
 
-    void InstancedRenderer::PrepareInstanceData(const std::vector<glm::mat4>& transforms,
+    void InstancedRenderer::PrepareInstanceData(const Mesh* mesh,
+                                                const std::vector<glm::mat4>& transforms,
                                                 const std::vector<glm::vec4>& colors,
                                                 const std::vector<int>& entityIDs)
     {
@@ -245,41 +264,30 @@ void main()
         for (size_t i = 0; i < transforms.size(); ++i)
         {
             // Use the culling function from Renderer3D
-            if (!PerformCulling(entityIDs[i], transforms[i]))
+            if (!PerformCulling(entityIDs[i], transforms[i], mesh, nullptr))
             {
                 continue;
             }
 
             if (m_InstanceData.size() >= MAX_INSTANCES)
             {
-                FENGINE_CORE_WARN("Reached maximum instance limit: {}", MAX_INSTANCES);
+                FENGINE_CORE_LOG_RATE_LIMITED(WARN, 1000, "Reached maximum instance limit: {}", MAX_INSTANCES);
                 break;
             }
 
-            OptimizedInstanceData instance;
-            instance.Transform = transforms[i];
-            instance.Color = colors[i];
-            instance.CustomData = glm::vec4(
-                0.0f, // Metallic
-                0.5f, // Roughness
-                float(entityIDs[i]), // EntityID
-                0.0f // Padding
-            );
-
-            m_InstanceData.push_back(instance);
+            OptimizedInstanceData& instance = m_InstanceData.emplace_back();
+            instance.SetTransform(transforms[i]);
+            instance.SetColor(colors[i]);
+            instance.SetSurface(0.0f, 0.5f);
+            instance.SetIDs(entityIDs[i]);
         }
 
         m_BufferNeedsUpdate = true;
     }
 
-    Ref<VertexArray> InstancedRenderer::GetOrCreateInstancedVAO(Ref<Mesh> mesh)
+    Ref<VertexArray> InstancedRenderer::CreateInstancedVAO(const Ref<Mesh>& mesh,
+                                                           const Ref<VertexBuffer>& instanceBuffer)
     {
-        auto it = m_InstancedVAOs.find(mesh);
-        if (it != m_InstancedVAOs.end())
-        {
-            return it->second;
-        }
-
         Ref<VertexArray> instancedVAO = VertexArray::Create();
 
         if (!instancedVAO)
@@ -296,68 +304,46 @@ void main()
         }
 
         instancedVAO->AddVertexBuffer(meshVAO->GetVertexBuffers()[0]);
-        instancedVAO->AddVertexBuffer(m_InstanceBuffer);
+        instancedVAO->AddVertexBuffer(instanceBuffer, 1);
         instancedVAO->SetIndexBuffer(meshVAO->GetIndexBuffer());
-
-        SetupInstanceAttributes(instancedVAO);
-
-        m_InstancedVAOs[mesh] = instancedVAO;
-        m_Stats.CachedVAOs = m_InstancedVAOs.size();
-
-#ifdef FENGINE_RENDER_DEBUG
-        FENGINE_CORE_INFO("Created new instanced VAO for mesh. Total cached: {}", m_Stats.CachedVAOs);
-#endif
         return instancedVAO;
     }
 
-    void InstancedRenderer::SetupInstanceAttributes(Ref<VertexArray> vao)
+    const Ref<VertexArray>& InstancedRenderer::AttachMeshBuffers(const Ref<Mesh>& mesh)
     {
-        vao->Bind();
-        m_InstanceBuffer->Bind();
-
-        const auto& layout = m_InstanceBuffer->GetLayout();
-        uint32_t index = 4; // Start after mesh attributes (0,1,2,3)
+        if (!m_InstancedVertexArray)
+        {
+            m_InstancedVertexArray = CreateInstancedVAO(mesh, m_InstanceBuffer);
+            return m_InstancedVertexArray;
+        }
 
-        for (const auto& element : layout.GetElements())
+        const auto& meshVAO = mesh->GetVertexArray();
+        if (!meshVAO || meshVAO->GetVertexBuffers().empty())
         {
-            if (element.Type == ShaderDataType::Mat4)
-            {
-                std::size_t vec4Size = sizeof(glm::vec4);
-                for (uint32_t i = 0; i < 4; i++)
-                {
-                    glEnableVertexAttribArray(index + i);
-                    glVertexAttribPointer(index + i, 4, GL_FLOAT, GL_FALSE,
-                                          layout.GetStride(), // Stride correto: tamanho total da estrutura
-                                          (void*)(element.Offset + i * vec4Size)); // Offset correto: offset do elemento + deslocamento do vec4
-                    glVertexAttribDivisor(index + i, 1);
-                }
-                index += 4;
-            }
-            else if (element.Type == ShaderDataType::Float4)
-            {
-                glEnableVertexAttribArray(index);
-                glVertexAttribPointer(index, 4, GL_FLOAT, GL_FALSE,
-                                      layout.GetStride(), (void*)element.Offset); // Já estava correto
-                glVertexAttribDivisor(index, 1);
-                index++;
-            }
+            FENGINE_CORE_ERROR("Mesh has no vertex buffers!");
+            static const Ref<VertexArray> s_NoVertexArray;
+            return s_NoVertexArray;
         }
 
-        vao->Unbind();
+        m_InstancedVertexArray->SetVertexBuffer(0, meshVAO->GetVertexBuffers()[0]);
+        m_InstancedVertexArray->SetIndexBuffer(meshVAO->GetIndexBuffer());
+        return m_InstancedVertexArray;
     }
 
-    void InstancedRenderer::RenderInstanced(Ref<VertexArray> vao, Ref<Mesh> mesh, uint32_t instanceCount)
+    void InstancedRenderer::BindInstancedShader(const Ref<Mesh>& mesh, const Ref<Material>& material)
     {
-        // Use default material if available
-        if (m_DefaultMaterial && m_DefaultMaterial->GetAlbedoMap())
+        // Use the given or the default material if it has textures
+        const Ref<Material>& textured
+            = material && material->GetAlbedoMap() ? material : m_DefaultMaterial;
+        if (textured && textured->GetAlbedoMap())
         {
-            m_DefaultMaterial->GetAlbedoMap()->Bind(0);
-            if (m_DefaultMaterial->GetNormalMap())
-                m_DefaultMaterial->GetNormalMap()->Bind(1);
-            if (m_DefaultMaterial->GetMetallicMap())
-                m_DefaultMaterial->GetMetallicMap()->Bind(2);
-            if (m_DefaultMaterial->GetRoughnessMap())
-                m_DefaultMaterial->GetRoughnessMap()->Bind(3);
+            textured->GetAlbedoMap()->Bind(0);
+            if (textured->GetNormalMap())
+                textured->GetNormalMap()->Bind(1);
+            if (textured->GetMetallicMap())
+                textured->GetMetallicMap()->Bind(2);
+            if (textured->GetRoughnessMap())
+                textured->GetRoughnessMap()->Bind(3);
         }
         else
         {
@@ -381,22 +367,42 @@ void main()
         m_InstancedShader->SetInt("u_NormalMap", 1);
         m_InstancedShader->SetInt("u_MetallicMap", 2);
         m_InstancedShader->SetInt("u_RoughnessMap", 3);
+        m_InstancedShader->SetFloat3("u_PositionScale",
+                                     mesh->GetVertexQuantization().Scale);
+        m_InstancedShader->SetFloat3("u_PositionOffset",
+                                     mesh->GetVertexQuantization().Offset);
+    }
+
+    void InstancedRenderer::RenderInstanced(Ref<VertexArray> vao, Ref<Mesh> mesh, uint32_t instanceCount)
+    {
+        BindInstancedShader(mesh, m_DefaultMaterial);
 
-        vao->Bind();
-        glDrawElementsInstanced(GL_TRIANGLES, mesh->GetIndexCount(),
-                                GL_UNSIGNED_INT, 0, instanceCount);
-        vao->Unbind();
+        RenderCommand::DrawIndexedInstanced(vao, mesh->GetIndexCount(), instanceCount,
+                                            mesh->GetTopology());
     }
 
-    void InstancedRenderer::ClearCache()
+    void InstancedRenderer::DrawInstanceRanges(const Ref<VertexArray>& vao, const Ref<Mesh>& mesh,
+                                               const Ref<Material>& material,
+                                               const uint32_t* firstInstances,
+                                               const uint32_t* instanceCounts, uint32_t rangeCount)
     {
-        m_InstancedVAOs.clear();
-        m_Stats.CachedVAOs = 0;
+        FENGINE_PROFILE_FUNCTION();
 
-#ifdef FENGINE_RENDER_DEBUG
-        FENGINE_CORE_INFO("Instanced renderer cache cleared");
-#endif
+        if (!vao || !mesh || !m_InstancedShader || rangeCount == 0)
+        {
+            return;
+        }
+
+        BindInstancedShader(mesh, material);
 
+        for (uint32_t i = 0; i < rangeCount; i++)
+        {
+            RenderCommand::DrawIndexedInstancedBaseInstance(vao, mesh->GetIndexCount(),
+                                                            instanceCounts[i], firstInstances[i],
+                                                            mesh->GetTopology());
+            m_Stats.VisibleInstances += instanceCounts[i];
+        }
+        m_Stats.DrawCalls += rangeCount;
     }
 
     void InstancedRenderer::ResetStats()
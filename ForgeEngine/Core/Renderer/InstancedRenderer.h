@@ -3,22 +3,15 @@
 #include "Config.h"
 #include "Core/Renderer/VertexArray.h"
 #include "Core/Renderer/Buffer.h"
+#include "Core/Renderer/InstanceData.h"
 #include "Core/Renderer/Shader.h"
 #include "Core/Renderer/Mesh.h"
 #include "Core/Renderer/Material.h"
 #include <glm.hpp>
 #include <vector>
-#include <unordered_map>
 
 namespace ForgeEngine
 {
-    struct OptimizedInstanceData
-    {
-        glm::mat4 Transform;
-        glm::vec4 Color;
-        glm::vec4 CustomData; // Metallic, Roughness, EntityID, padding
-    };
-
     class InstancedRenderer
     {
     public:
@@ -36,8 +29,22 @@ namespace ForgeEngine
                                const std::vector<glm::vec4>& colors,
                                const std::vector<int>& entityIDs);
 
+        // Vertex array that reads the mesh's vertices and per-instance data
+        // from instanceBuffer, whose layout must be GetInstanceLayout(). It
+        // shares the API object of its vertex format, so it is cheap to make.
+        Ref<VertexArray> CreateInstancedVAO(const Ref<Mesh>& mesh,
+                                            const Ref<VertexBuffer>& instanceBuffer);
+        // Draws several instance ranges of a vertex array built by
+        // CreateInstancedVAO with a single shader and texture setup.
+        // material may be null for the default one.
+        void DrawInstanceRanges(const Ref<VertexArray>& vao, const Ref<Mesh>& mesh,
+                                const Ref<Material>& material,
+                                const uint32_t* firstInstances,
+                                const uint32_t* instanceCounts, uint32_t rangeCount);
+
+        static BufferLayout GetInstanceLayout();
+
         // Utility functions
-        void ClearCache();
         uint32_t GetMaxInstances() const { return MAX_INSTANCES; }
 
         // Stats
@@ -45,7 +52,6 @@ namespace ForgeEngine
         {
             uint32_t TotalInstances = 0;
             uint32_t VisibleInstances = 0;
-            uint32_t CachedVAOs = 0;
             uint32_t BufferUpdates = 0;
             uint32_t DrawCalls = 0;
         };
@@ -63,13 +69,16 @@ namespace ForgeEngine
         Ref<VertexBuffer> m_InstanceBuffer;
         Ref<Shader> m_InstancedShader;
 
+        // Vertex array of DrawInstancedMesh over m_InstanceBuffer. Every draw
+        // attaches the buffers of its mesh, meshes of the same vertex format
+        // share the GL object and only rebind the buffers. It keeps the
+        // buffers of the last drawn mesh alive.
+        Ref<VertexArray> m_InstancedVertexArray;
+
         // Instance data management
         std::vector<OptimizedInstanceData> m_InstanceData;
         bool m_BufferNeedsUpdate = true;
 
-        // VAO cache for different mesh types
-        std::unordered_map<Ref<Mesh>, Ref<VertexArray>> m_InstancedVAOs;
-
         // Material padrão para compatibilidade
         Ref<Material> m_DefaultMaterial;
 
@@ -78,12 +87,12 @@ namespace ForgeEngine
 
         // Private helper functions
         void CreateInstancedShader();
-        void PrepareInstanceData(const std::vector<glm::mat4>& transforms,
+        void PrepareInstanceData(const Mesh* mesh, const std::vector<glm::mat4>& transforms,
                                  const std::vector<glm::vec4>& colors,
                                  const std::vector<int>& entityIDs);
 
-        Ref<VertexArray> GetOrCreateInstancedVAO(Ref<Mesh> mesh);
-        void SetupInstanceAttributes(Ref<VertexArray> vao);
+        const Ref<VertexArray>& AttachMeshBuffers(const Ref<Mesh>& mesh);
+        void BindInstancedShader(const Ref<Mesh>& mesh, const Ref<Material>& material);
         void RenderInstanced(Ref<VertexArray> vao, Ref<Mesh> mesh, uint32_t instanceCount);
     };
 
@@ -3,7 +3,15 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+
 #include "VertexArray.h"
+#include "Core/Renderer/MeshFile.h"
+#include "Core/Asset/GltfImporter.h"
+#include "Core/Asset/MeshOptimizer.h"
 
 namespace ForgeEngine {
 
@@ -15,26 +23,169 @@ Mesh::Mesh() {
   }
 }
 
-  void Mesh::SetVertices(std::vector<float>& vertices, uint32_t vertexCount) {
+void Mesh::SetVertices(const void* vertices, uint32_t size,
+                       uint32_t vertexCount, const BufferLayout& layout) {
+  FENGINE_CORE_ASSERT(!layout.GetElements().empty(), "Layout is not defined!");
+
   m_VertexCount = vertexCount;
 
-  m_VertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
+  m_VertexBuffer = VertexBuffer::Create(vertices, size);
+  m_VertexBuffer->SetLayout(layout);
+  m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+}
+
+void Mesh::SetQuantizedVertices(const StandardVertex* vertices, uint32_t count) {
+  m_VertexQuantization = CalculateVertexQuantization(vertices, count);
 
-  // ✅ Adicionar layout padrão ou exigir que seja definido externamente
-  if (!m_VertexBuffer->GetLayout().GetElements().empty()) {
-    m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+  // Unorm16 UVs are exact enough for [0, 1], anything tiling needs halves
+  if (HasNormalizedTexCoords(vertices, count)) {
+    std::vector<QuantizedVertex> quantized(count);
+    QuantizeVertices(vertices, count, m_VertexQuantization, quantized.data());
+    SetVertices(quantized);
   } else {
-    FENGINE_ASSERT(false, "Layout is not defined!")
+    std::vector<QuantizedTiledVertex> quantized(count);
+    QuantizeVertices(vertices, count, m_VertexQuantization, quantized.data());
+    SetVertices(quantized);
+  }
+
+  // Not from the quantization range, that one is padded on flat axes
+  ComputeBounds(vertices, count);
+}
+
+void Mesh::SetBounds(const glm::vec3& min, const glm::vec3& max) {
+  m_BoundsMin = min;
+  m_BoundsMax = max;
+  m_BoundingSphereCenter = (min + max) * 0.5f;
+  m_BoundingSphereRadius = glm::length(max - min) * 0.5f;
+}
+
+void Mesh::SetBoundingSphere(const glm::vec3& center, float radius) {
+  m_BoundingSphereCenter = center;
+  m_BoundingSphereRadius = radius;
+}
+
+void Mesh::ComputeBounds(const StandardVertex* vertices, uint32_t count) {
+  if (count == 0)
+    return;
+
+  glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+  for (uint32_t i = 0; i < count; i++) {
+    min = glm::min(min, vertices[i].Position);
+    max = glm::max(max, vertices[i].Position);
+  }
+
+  // Centered on the box, only the radius comes from the vertices. Spheres
+  // and cylinders end up far tighter than the box's half diagonal.
+  glm::vec3 center = (min + max) * 0.5f;
+  float radiusSquared = 0.0f;
+  for (uint32_t i = 0; i < count; i++) {
+    glm::vec3 offset = vertices[i].Position - center;
+    radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
   }
+
+  m_BoundsMin = min;
+  m_BoundsMax = max;
+  m_BoundingSphereCenter = center;
+  m_BoundingSphereRadius = std::sqrt(radiusSquared);
 }
 
-void Mesh::SetIndices(std::vector<uint32_t>& indices) {
-  m_IndexCount = indices.size();
+void Mesh::SetIndices(const uint32_t* indices, uint32_t count) {
+  m_IndexCount = count;
+
+  // Size by the vertices actually referenced, submeshes of a .fmesh share
+  // one vertex buffer and only use part of it
+  uint32_t vertexRange = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (indices[i] != PrimitiveRestartIndex)
+      vertexRange = std::max(vertexRange, indices[i] + 1);
+  }
 
-  m_IndexBuffer = IndexBuffer::Create(indices.data(), indices.size());
+  m_IndexBuffer = IndexBuffer::Create(indices, count,
+                                      GetIndexTypeForVertexCount(vertexRange));
   m_VertexArray->SetIndexBuffer(m_IndexBuffer);
 }
 
+void Mesh::SetIndices(const std::vector<uint32_t>& indices) {
+  SetIndices(indices.data(), (uint32_t)indices.size());
+}
+
+void Mesh::SetMaterial(const Ref<Material>& material) {
+  m_Material = material;
+  for (const Lod& lod : m_Lods)
+    lod.LodMesh->m_Material = material;
+}
+
+void Mesh::AddLod(const std::vector<uint32_t>& indices, float error) {
+  FENGINE_CORE_ASSERT(m_VertexBuffer, "LODs need the vertex buffer to exist first!");
+
+  Ref<Mesh> lod = CreateRef<Mesh>();
+  lod->SetVertexBuffer(m_VertexBuffer);
+  lod->SetIndices(indices);
+  lod->m_VertexCount = m_VertexCount;
+  lod->m_Material = m_Material;
+  lod->m_Topology = m_Topology;
+  lod->m_BoundsMin = m_BoundsMin;
+  lod->m_BoundsMax = m_BoundsMax;
+  lod->m_BoundingSphereCenter = m_BoundingSphereCenter;
+  lod->m_BoundingSphereRadius = m_BoundingSphereRadius;
+  lod->m_VertexQuantization = m_VertexQuantization;
+
+  m_Lods.push_back({lod, error});
+}
+
+void Mesh::GenerateLods(const void* vertices, uint32_t vertexCount,
+                        uint32_t stride, uint32_t positionOffset,
+                        const std::vector<uint32_t>& indices,
+                        const MeshSimplificationSettings& settings) {
+  FENGINE_PROFILE_FUNCTION();
+
+  std::vector<MeshLodLevel> levels = MeshSimplifier::GenerateLods(
+      indices.data(), indices.size(), vertices, vertexCount, stride,
+      positionOffset, settings);
+
+  for (const MeshLodLevel& level : levels)
+    AddLod(level.Indices, level.Error);
+}
+
+uint64_t Mesh::GetGpuMemorySize() const {
+  uint64_t size = 0;
+  if (m_VertexBuffer)
+    size += (uint64_t)m_VertexCount * m_VertexBuffer->GetLayout().GetStride();
+  if (m_IndexBuffer)
+    size += (uint64_t)m_IndexCount * IndexTypeSize(m_IndexBuffer->GetIndexType());
+
+  // LODs share the vertex buffer, only their indices are extra
+  for (const Lod& lod : m_Lods) {
+    const Ref<Mesh>& mesh = lod.LodMesh;
+    size += (uint64_t)mesh->m_IndexCount * IndexTypeSize(mesh->m_IndexBuffer->GetIndexType());
+  }
+  return size;
+}
+
+void Mesh::SetMeshlets(const MeshletData& meshlets) {
+  FENGINE_CORE_ASSERT(m_Topology == PrimitiveTopology::Triangles,
+                      "Meshlets need a triangle list!");
+
+  SetIndices(meshlets.Indices);
+  m_Meshlets = meshlets.Meshlets;
+  m_MeshletBounds = meshlets.Bounds;
+}
+
+void Mesh::BuildMeshlets(const void* vertices, uint32_t vertexCount,
+                         uint32_t stride, uint32_t positionOffset,
+                         const std::vector<uint32_t>& indices,
+                         const MeshletSettings& settings) {
+  FENGINE_PROFILE_FUNCTION();
+
+  if (indices.size() / 3 < MinMeshletTriangles) {
+    SetIndices(indices);
+    return;
+  }
+
+  SetMeshlets(MeshletBuilder::Build(indices.data(), indices.size(), vertices,
+                                    vertexCount, stride, positionOffset, settings));
+}
+
 void Mesh::SetVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) {
   m_VertexBuffer = vertexBuffer;
   m_VertexArray->AddVertexBuffer(vertexBuffer);
@@ -49,53 +200,45 @@ void Mesh::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) {
 Ref<Mesh> Mesh::CreateCube(float size) {
   Ref<Mesh> mesh = CreateRef<Mesh>();
 
-  // Define vertex layout
-  BufferLayout layout = {
-    { ShaderDataType::Float3, "a_Position" },
-    { ShaderDataType::Float3, "a_Normal" },
-    { ShaderDataType::Float3, "a_Tangent" },
-    { ShaderDataType::Float2, "a_TexCoord" }
-  };
-
   // Create cube vertices
   // This is a simplified cube with positions, normals, tangents, and texture coordinates
   float halfSize = size * 0.5f;
-  std::vector<float> vertices = {
+  std::vector<StandardVertex> vertices = {
     // Front face - each vertex has position (3), normal (3), tangent (3), texcoord (2)
-    -halfSize, -halfSize,  halfSize,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, // bottom-left
-     halfSize, -halfSize,  halfSize,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f, 0.0f,  1.0f, 0.0f, // bottom-right
-     halfSize,  halfSize,  halfSize,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f, 0.0f,  1.0f, 1.0f, // top-right
-    -halfSize,  halfSize,  halfSize,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f, // top-left
+    {{-halfSize, -halfSize, halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}}, // bottom-left
+    {{halfSize, -halfSize, halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-right
+    {{halfSize, halfSize, halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}}, // top-right
+    {{-halfSize, halfSize, halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}, // top-left
 
     // Back face
-    -halfSize, -halfSize, -halfSize,  0.0f, 0.0f, -1.0f, -1.0f, 0.0f, 0.0f,  1.0f, 0.0f, // bottom-left
-    -halfSize,  halfSize, -halfSize,  0.0f, 0.0f, -1.0f, -1.0f, 0.0f, 0.0f,  1.0f, 1.0f, // top-left
-     halfSize,  halfSize, -halfSize,  0.0f, 0.0f, -1.0f, -1.0f, 0.0f, 0.0f,  0.0f, 1.0f, // top-right
-     halfSize, -halfSize, -halfSize,  0.0f, 0.0f, -1.0f, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, // bottom-right
+    {{-halfSize, -halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-left
+    {{-halfSize, halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}}, // top-left
+    {{halfSize, halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}, // top-right
+    {{halfSize, -halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}}, // bottom-right
 
     // Left face
-    -halfSize, -halfSize, -halfSize, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, -1.0f,  0.0f, 0.0f, // bottom-left
-    -halfSize, -halfSize,  halfSize, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, -1.0f,  1.0f, 0.0f, // bottom-right
-    -halfSize,  halfSize,  halfSize, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, -1.0f,  1.0f, 1.0f, // top-right
-    -halfSize,  halfSize, -halfSize, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, -1.0f,  0.0f, 1.0f, // top-left
+    {{-halfSize, -halfSize, -halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}}, // bottom-left
+    {{-halfSize, -halfSize, halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}}, // bottom-right
+    {{-halfSize, halfSize, halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}}, // top-right
+    {{-halfSize, halfSize, -halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}}, // top-left
 
     // Right face
-     halfSize, -halfSize,  halfSize,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 0.0f, // bottom-left
-     halfSize, -halfSize, -halfSize,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // bottom-right
-     halfSize,  halfSize, -halfSize,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // top-right
-     halfSize,  halfSize,  halfSize,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 1.0f, // top-left
+    {{halfSize, -halfSize, halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}}, // bottom-left
+    {{halfSize, -halfSize, -halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}}, // bottom-right
+    {{halfSize, halfSize, -halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}}, // top-right
+    {{halfSize, halfSize, halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}, // top-left
 
     // Bottom face
-    -halfSize, -halfSize, -halfSize,  0.0f, -1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f, // bottom-left
-     halfSize, -halfSize, -halfSize,  0.0f, -1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 0.0f, // bottom-right
-     halfSize, -halfSize,  halfSize,  0.0f, -1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 1.0f, // top-right
-    -halfSize, -halfSize,  halfSize,  0.0f, -1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f, // top-left
+    {{-halfSize, -halfSize, -halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}}, // bottom-left
+    {{halfSize, -halfSize, -halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-right
+    {{halfSize, -halfSize, halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}}, // top-right
+    {{-halfSize, -halfSize, halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}, // top-left
 
     // Top face
-    -halfSize,  halfSize,  halfSize,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // bottom-left
-     halfSize,  halfSize,  halfSize,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // bottom-right
-     halfSize,  halfSize, -halfSize,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // top-right
-    -halfSize,  halfSize, -halfSize,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,   0.0f, 1.0f  // top-left
+    {{-halfSize, halfSize, halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}}, // bottom-left
+    {{halfSize, halfSize, halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-right
+    {{halfSize, halfSize, -halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}}, // top-right
+    {{-halfSize, halfSize, -halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}  // top-left
   };
 
   // Create indices for the cube
@@ -120,12 +263,11 @@ Ref<Mesh> Mesh::CreateCube(float size) {
   };
 
   // Set up the mesh
-  Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
-  vertexBuffer->SetLayout(layout);
-  mesh->SetVertexBuffer(vertexBuffer);
-  mesh->m_VertexCount = 24; // 6 faces * 4 vertices per face
+  mesh->SetQuantizedVertices(vertices.data(), (uint32_t)vertices.size());
 
   mesh->SetIndices(indices);
+  mesh->SetSourceGeometry(CreateRef<MeshGeometry>(
+      MeshGeometry{std::move(vertices), std::move(indices)}));
 
   return mesh;
 }
@@ -133,15 +275,7 @@ Ref<Mesh> Mesh::CreateCube(float size) {
 Ref<Mesh> Mesh::CreateSphere(float radius, uint32_t segmentsX, uint32_t segmentsY) {
   Ref<Mesh> mesh = CreateRef<Mesh>();
 
-  // Define vertex layout
-  BufferLayout layout = {
-    { ShaderDataType::Float3, "a_Position" },
-    { ShaderDataType::Float3, "a_Normal" },
-    { ShaderDataType::Float3, "a_Tangent" },
-    { ShaderDataType::Float2, "a_TexCoord" }
-  };
-
-  std::vector<float> vertices;
+  std::vector<StandardVertex> vertices;
   std::vector<uint32_t> indices;
 
   const float PI = static_cast<float>(M_PI);
@@ -175,17 +309,10 @@ Ref<Mesh> Mesh::CreateSphere(float radius, uint32_t segmentsX, uint32_t segments
       }
 
       // Add to vertices
-      vertices.push_back(xPos * radius);    // Position X
-      vertices.push_back(yPos * radius);    // Position Y
-      vertices.push_back(zPos * radius);    // Position Z
-      vertices.push_back(nx);               // Normal X
-      vertices.push_back(ny);               // Normal Y
-      vertices.push_back(nz);               // Normal Z
-      vertices.push_back(tx);               // Tangent X
-      vertices.push_back(ty);               // Tangent Y
-      vertices.push_back(tz);               // Tangent Z
-      vertices.push_back(xSegment);         // Texture U
-      vertices.push_back(ySegment);         // Texture V
+      vertices.push_back({{xPos * radius, yPos * radius, zPos * radius},
+                          {nx, ny, nz},
+                          {tx, ty, tz},
+                          {xSegment, ySegment}});
     }
   }
 
@@ -207,13 +334,21 @@ Ref<Mesh> Mesh::CreateSphere(float radius, uint32_t segmentsX, uint32_t segments
     }
   }
 
+  // Rows come out in generator order, reorder them for the vertex cache
+  uint32_t vertexCount = (segmentsX + 1) * (segmentsY + 1);
+  MeshOptimizer::Optimize(vertices.data(), vertexCount, sizeof(StandardVertex), 0,
+                          indices.data(), indices.size());
+  vertices.resize(vertexCount);
+
   // Set up the mesh
-  Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
-  vertexBuffer->SetLayout(layout);
-  mesh->SetVertexBuffer(vertexBuffer);
-  mesh->m_VertexCount = (segmentsX + 1) * (segmentsY + 1);
+  mesh->SetQuantizedVertices(vertices.data(), (uint32_t)vertices.size());
 
-  mesh->SetIndices(indices);
+  mesh->BuildMeshlets(vertices.data(), (uint32_t)vertices.size(),
+                      sizeof(StandardVertex), 0, indices);
+  mesh->GenerateLods(vertices.data(), (uint32_t)vertices.size(),
+                     sizeof(StandardVertex), 0, indices);
+  mesh->SetSourceGeometry(CreateRef<MeshGeometry>(
+      MeshGeometry{std::move(vertices), std::move(indices)}));
 
   return mesh;
 }
@@ -221,15 +356,7 @@ Ref<Mesh> Mesh::CreateSphere(float radius, uint32_t segmentsX, uint32_t segments
 Ref<Mesh> Mesh::CreateCylinder(float radius, float height, uint32_t segments) {
   Ref<Mesh> mesh = CreateRef<Mesh>();
 
-  // Define vertex layout
-  BufferLayout layout = {
-    { ShaderDataType::Float3, "a_Position" },
-    { ShaderDataType::Float3, "a_Normal" },
-    { ShaderDataType::Float3, "a_Tangent" },
-    { ShaderDataType::Float2, "a_TexCoord" }
-  };
-
-  std::vector<float> vertices;
+  std::vector<StandardVertex> vertices;
   std::vector<uint32_t> indices;
 
   const float PI = static_cast<float>(M_PI);
@@ -237,30 +364,16 @@ Ref<Mesh> Mesh::CreateCylinder(float radius, float height, uint32_t segments) {
 
   // Create top and bottom center vertices
   // Top center vertex (center top)
-  vertices.push_back(0.0f);            // Position X
-  vertices.push_back(halfHeight);      // Position Y
-  vertices.push_back(0.0f);            // Position Z
-  vertices.push_back(0.0f);            // Normal X
-  vertices.push_back(1.0f);            // Normal Y
-  vertices.push_back(0.0f);            // Normal Z
-  vertices.push_back(1.0f);            // Tangent X
-  vertices.push_back(0.0f);            // Tangent Y
-  vertices.push_back(0.0f);            // Tangent Z
-  vertices.push_back(0.5f);            // Texture U
-  vertices.push_back(0.5f);            // Texture V
+  vertices.push_back({{0.0f, halfHeight, 0.0f},
+                      {0.0f, 1.0f, 0.0f},
+                      {1.0f, 0.0f, 0.0f},
+                      {0.5f, 0.5f}});
 
   // Bottom center vertex (center bottom)
-  vertices.push_back(0.0f);            // Position X
-  vertices.push_back(-halfHeight);     // Position Y
-  vertices.push_back(0.0f);            // Position Z
-  vertices.push_back(0.0f);            // Normal X
-  vertices.push_back(-1.0f);           // Normal Y
-  vertices.push_back(0.0f);            // Normal Z
-  vertices.push_back(1.0f);            // Tangent X
-  vertices.push_back(0.0f);            // Tangent Y
-  vertices.push_back(0.0f);            // Tangent Z
-  vertices.push_back(0.5f);            // Texture U
-  vertices.push_back(0.5f);            // Texture V
+  vertices.push_back({{0.0f, -halfHeight, 0.0f},
+                      {0.0f, -1.0f, 0.0f},
+                      {1.0f, 0.0f, 0.0f},
+                      {0.5f, 0.5f}});
 
   // Create vertices for the cylinder sides, top, and bottom
   for (uint32_t i = 0; i <= segments; i++) {
@@ -269,56 +382,28 @@ Ref<Mesh> Mesh::CreateCylinder(float radius, float height, uint32_t segments) {
     float z = std::sin(angle);
 
     // Top rim vertex
-    vertices.push_back(x * radius);     // Position X
-    vertices.push_back(halfHeight);     // Position Y
-    vertices.push_back(z * radius);     // Position Z
-    vertices.push_back(0.0f);           // Normal X
-    vertices.push_back(1.0f);           // Normal Y
-    vertices.push_back(0.0f);           // Normal Z
-    vertices.push_back(1.0f);           // Tangent X
-    vertices.push_back(0.0f);           // Tangent Y
-    vertices.push_back(0.0f);           // Tangent Z
-    vertices.push_back((x + 1.0f) * 0.5f); // Texture U
-    vertices.push_back((z + 1.0f) * 0.5f); // Texture V
+    vertices.push_back({{x * radius, halfHeight, z * radius},
+                        {0.0f, 1.0f, 0.0f},
+                        {1.0f, 0.0f, 0.0f},
+                        {(x + 1.0f) * 0.5f, (z + 1.0f) * 0.5f}});
 
     // Bottom rim vertex
-    vertices.push_back(x * radius);     // Position X
-    vertices.push_back(-halfHeight);    // Position Y
-    vertices.push_back(z * radius);     // Position Z
-    vertices.push_back(0.0f);           // Normal X
-    vertices.push_back(-1.0f);          // Normal Y
-    vertices.push_back(0.0f);           // Normal Z
-    vertices.push_back(1.0f);           // Tangent X
-    vertices.push_back(0.0f);           // Tangent Y
-    vertices.push_back(0.0f);           // Tangent Z
-    vertices.push_back((x + 1.0f) * 0.5f); // Texture U
-    vertices.push_back((z + 1.0f) * 0.5f); // Texture V
+    vertices.push_back({{x * radius, -halfHeight, z * radius},
+                        {0.0f, -1.0f, 0.0f},
+                        {1.0f, 0.0f, 0.0f},
+                        {(x + 1.0f) * 0.5f, (z + 1.0f) * 0.5f}});
 
     // Side vertex top
-    vertices.push_back(x * radius);     // Position X
-    vertices.push_back(halfHeight);     // Position Y
-    vertices.push_back(z * radius);     // Position Z
-    vertices.push_back(x);              // Normal X
-    vertices.push_back(0.0f);           // Normal Y
-    vertices.push_back(z);              // Normal Z
-    vertices.push_back(-z);             // Tangent X
-    vertices.push_back(0.0f);           // Tangent Y
-    vertices.push_back(x);              // Tangent Z
-    vertices.push_back(float(i) / float(segments)); // Texture U
-    vertices.push_back(1.0f);           // Texture V
+    vertices.push_back({{x * radius, halfHeight, z * radius},
+                        {x, 0.0f, z},
+                        {-z, 0.0f, x},
+                        {float(i) / float(segments), 1.0f}});
 
     // Side vertex bottom
-    vertices.push_back(x * radius);     // Position X
-    vertices.push_back(-halfHeight);    // Position Y
-    vertices.push_back(z * radius);     // Position Z
-    vertices.push_back(x);              // Normal X
-    vertices.push_back(0.0f);           // Normal Y
-    vertices.push_back(z);              // Normal Z
-    vertices.push_back(-z);             // Tangent X
-    vertices.push_back(0.0f);           // Tangent Y
-    vertices.push_back(x);              // Tangent Z
-    vertices.push_back(float(i) / float(segments)); // Texture U
-    vertices.push_back(0.0f);           // Texture V
+    vertices.push_back({{x * radius, -halfHeight, z * radius},
+                        {x, 0.0f, z},
+                        {-z, 0.0f, x},
+                        {float(i) / float(segments), 0.0f}});
   }
 
   // Create indices
@@ -356,69 +441,195 @@ Ref<Mesh> Mesh::CreateCylinder(float radius, float height, uint32_t segments) {
     indices.push_back(sideTopStartIndex + nextI * 4);
   }
 
+  // Reorder for the vertex cache, this also drops the unused seam vertices
+  uint32_t vertexCount = 2 + 4 * (segments + 1); // Centers + 4 vertices per segment
+  MeshOptimizer::Optimize(vertices.data(), vertexCount, sizeof(StandardVertex), 0,
+                          indices.data(), indices.size());
+  vertices.resize(vertexCount);
+
   // Set up the mesh
-  Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
-  vertexBuffer->SetLayout(layout);
-  mesh->SetVertexBuffer(vertexBuffer);
-  mesh->m_VertexCount = 2 + 4 * (segments + 1); // Centers + 4 vertices per segment
+  mesh->SetQuantizedVertices(vertices.data(), (uint32_t)vertices.size());
 
-  mesh->SetIndices(indices);
+  mesh->BuildMeshlets(vertices.data(), (uint32_t)vertices.size(),
+                      sizeof(StandardVertex), 0, indices);
+  mesh->GenerateLods(vertices.data(), (uint32_t)vertices.size(),
+                     sizeof(StandardVertex), 0, indices);
+  mesh->SetSourceGeometry(CreateRef<MeshGeometry>(
+      MeshGeometry{std::move(vertices), std::move(indices)}));
 
   return mesh;
 }
 
-Ref<Mesh> Mesh::CreatePlane(float width, float height) {
+Ref<Mesh> Mesh::CreatePlane(float width, float height, uint32_t segments) {
   Ref<Mesh> mesh = CreateRef<Mesh>();
-
-  // Define vertex layout
-  BufferLayout layout = {
-    { ShaderDataType::Float3, "a_Position" },
-    { ShaderDataType::Float3, "a_Normal" },
-    { ShaderDataType::Float3, "a_Tangent" },
-    { ShaderDataType::Float2, "a_TexCoord" }
-  };
+  segments = std::max(segments, 1u);
 
   float halfWidth = width * 0.5f;
   float halfHeight = height * 0.5f;
 
-  // Create plane vertices (facing up in Y direction)
-  std::vector<float> vertices = {
-    // Position (3), Normal (3), Tangent (3), TexCoord (2)
-    -halfWidth, 0.0f, -halfHeight,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 0.0f,
-     halfWidth, 0.0f, -halfHeight,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 0.0f,
-     halfWidth, 0.0f,  halfHeight,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 1.0f,
-    -halfWidth, 0.0f,  halfHeight,  0.0f, 1.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f
-  };
+  // Grid facing up in Y direction, one UV square over the whole plane
+  std::vector<StandardVertex> vertices;
+  vertices.reserve((segments + 1) * (segments + 1));
+  for (uint32_t z = 0; z <= segments; z++) {
+    float v = (float)z / (float)segments;
+    for (uint32_t x = 0; x <= segments; x++) {
+      float u = (float)x / (float)segments;
+      vertices.push_back({{-halfWidth + u * width, 0.0f, -halfHeight + v * height},
+                          {0.0f, 1.0f, 0.0f},
+                          {1.0f, 0.0f, 0.0f},
+                          {u, v}});
+    }
+  }
 
-  // Create plane indices
-  std::vector<uint32_t> indices = {
-    1, 0, 2,
-    2, 0, 3
-  };
+  std::vector<uint32_t> indices;
+  indices.reserve(segments * segments * 6);
+  for (uint32_t z = 0; z < segments; z++) {
+    for (uint32_t x = 0; x < segments; x++) {
+      uint32_t first = z * (segments + 1) + x;
+      uint32_t below = first + segments + 1;
+
+      indices.push_back(first + 1);
+      indices.push_back(first);
+      indices.push_back(below + 1);
+
+      indices.push_back(below + 1);
+      indices.push_back(first);
+      indices.push_back(below);
+    }
+  }
+
+  if (segments > 1) {
+    uint32_t vertexCount = (uint32_t)vertices.size();
+    MeshOptimizer::Optimize(vertices.data(), vertexCount, sizeof(StandardVertex), 0,
+                            indices.data(), indices.size());
+    vertices.resize(vertexCount);
+  }
 
   // Set up the mesh
-  Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
-  vertexBuffer->SetLayout(layout);
-  mesh->SetVertexBuffer(vertexBuffer);
-  mesh->m_VertexCount = 4;
+  mesh->SetQuantizedVertices(vertices.data(), (uint32_t)vertices.size());
 
-  mesh->SetIndices(indices);
+  mesh->BuildMeshlets(vertices.data(), (uint32_t)vertices.size(),
+                      sizeof(StandardVertex), 0, indices);
+  mesh->SetSourceGeometry(CreateRef<MeshGeometry>(
+      MeshGeometry{std::move(vertices), std::move(indices)}));
 
   return mesh;
 }
 
 // Model implementation
 
+void Model::AddMesh(const Ref<Mesh>& mesh) {
+  m_Meshes.push_back(mesh);
+  if (!mesh->HasBounds())
+    return;
+
+  const glm::vec3& center = mesh->GetBoundingSphereCenter();
+  float radius = mesh->GetBoundingSphereRadius();
+  if (m_BoundingSphereRadius <= 0.0f) {
+    m_BoundsMin = mesh->GetBoundsMin();
+    m_BoundsMax = mesh->GetBoundsMax();
+    m_BoundingSphereCenter = center;
+    m_BoundingSphereRadius = radius;
+    return;
+  }
+
+  m_BoundsMin = glm::min(m_BoundsMin, mesh->GetBoundsMin());
+  m_BoundsMax = glm::max(m_BoundsMax, mesh->GetBoundsMax());
+
+  // Smallest sphere enclosing both, unless one already holds the other
+  float distance = glm::length(center - m_BoundingSphereCenter);
+  if (distance + radius <= m_BoundingSphereRadius)
+    return;
+  if (distance + m_BoundingSphereRadius <= radius) {
+    m_BoundingSphereCenter = center;
+    m_BoundingSphereRadius = radius;
+    return;
+  }
+
+  float merged = (distance + radius + m_BoundingSphereRadius) * 0.5f;
+  m_BoundingSphereCenter += (center - m_BoundingSphereCenter)
+                            * ((merged - m_BoundingSphereRadius) / distance);
+  m_BoundingSphereRadius = merged;
+}
+
 Ref<Model> Model::Load(const std::string& filepath) {
-  // This is a placeholder - in a real engine, this would use a model loading library
-  // like Assimp to load models from various formats (OBJ, FBX, etc.)
+  FENGINE_PROFILE_FUNCTION();
 
-  Ref<Model> model = CreateRef<Model>();
+  if (MeshFile::IsMeshFilePath(filepath))
+    return LoadMeshFile(filepath);
+
+  if (GltfImporter::IsGltfPath(filepath))
+    return GltfImporter::Import(filepath);
+
+  FENGINE_CORE_WARN("Unsupported model format '{}', using a cube instead",
+                    filepath);
 
-  // For now, we'll just return a simple cube model as an example
+  Ref<Model> model = CreateRef<Model>();
   model->AddMesh(Mesh::CreateCube());
 
   return model;
 }
 
+Ref<Model> Model::LoadMeshFile(const std::string& filepath) {
+  FENGINE_PROFILE_FUNCTION();
+
+  Ref<MeshFile> file = MeshFile::Open(filepath);
+  if (!file)
+    return nullptr;
+
+  const MeshFileHeader& header = file->GetHeader();
+  std::filesystem::path directory = std::filesystem::path(filepath).parent_path();
+
+  // Materials first so submeshes can share them
+  std::vector<Ref<Material>> materials;
+  materials.reserve(header.MaterialCount);
+  for (uint32_t i = 0; i < header.MaterialCount; i++) {
+    const MeshFileMaterial& slot = file->GetMaterial(i);
+
+    Ref<Material> material = CreateRef<Material>();
+    material->SetAlbedoColor({slot.AlbedoColor[0], slot.AlbedoColor[1],
+                              slot.AlbedoColor[2], slot.AlbedoColor[3]});
+    material->SetMetallic(slot.Metallic);
+    material->SetRoughness(slot.Roughness);
+
+    std::string albedoMap(slot.AlbedoMap, strnlen(slot.AlbedoMap, sizeof(slot.AlbedoMap)));
+    if (!albedoMap.empty())
+      material->SetAlbedoMap(Texture2D::CreateAsync((directory / albedoMap).string()));
+
+    std::string normalMap(slot.NormalMap, strnlen(slot.NormalMap, sizeof(slot.NormalMap)));
+    if (!normalMap.empty())
+      material->SetNormalMap(Texture2D::CreateAsync((directory / normalMap).string()));
+
+    materials.push_back(material);
+  }
+
+  // One vertex buffer for the whole file, uploaded straight from the mapping
+  Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(
+      file->GetVertexData(), header.VertexCount * header.VertexStride);
+  vertexBuffer->SetLayout(file->GetLayout());
+
+  Ref<Model> model = CreateRef<Model>();
+  for (uint32_t i = 0; i < header.SubmeshCount; i++) {
+    const MeshFileSubmesh& submesh = file->GetSubmesh(i);
+
+    Ref<Mesh> mesh = CreateRef<Mesh>();
+    mesh->SetVertexBuffer(vertexBuffer);
+    mesh->SetIndices(file->GetIndexData() + submesh.IndexOffset, submesh.IndexCount);
+    mesh->m_VertexCount = submesh.VertexCount;
+    mesh->SetBounds({submesh.BoundsMin[0], submesh.BoundsMin[1], submesh.BoundsMin[2]},
+                    {submesh.BoundsMax[0], submesh.BoundsMax[1], submesh.BoundsMax[2]});
+
+    if (submesh.MaterialIndex < materials.size())
+      mesh->SetMaterial(materials[submesh.MaterialIndex]);
+
+    model->AddMesh(mesh);
+  }
+
+  FENGINE_CORE_INFO("Loaded '{}': {} vertices, {} indices, {} submeshes",
+                    filepath, header.VertexCount, header.IndexCount,
+                    header.SubmeshCount);
+
+  return model;
+}
+
 } // namespace BEngine
\ No newline at end of file
@@ -3,17 +3,47 @@
 #include "Config.h"
 #include "Core/Renderer/VertexArray.h"
 #include "Core/Renderer/Material.h"
+#include "Core/Renderer/VertexFormat.h"
+#include "Core/Asset/MeshSimplifier.h"
+#include "Core/Asset/MeshletBuilder.h"
+#include "vec3.hpp"
 
 namespace ForgeEngine
 {
+    // CPU side copy of a mesh's triangle list, unquantized and in object
+    // space. Only kept where something needs to rebuild geometry from it.
+    struct MeshGeometry
+    {
+        std::vector<StandardVertex> Vertices;
+        std::vector<uint32_t> Indices;
+    };
+
     class Mesh
     {
     public:
         Mesh();
         ~Mesh() = default;
 
-        void SetVertices(std::vector<float>& vertices, uint32_t vertexCount);
-        void SetIndices(std::vector<uint32_t>& indices);
+        // The data is copied straight into immutable GPU storage, it does not
+        // need to outlive the call
+        void SetVertices(const void* vertices, uint32_t size,
+                         uint32_t vertexCount, const BufferLayout& layout);
+
+        // Typed upload, the layout comes from the vertex struct's VertexFormat
+        template <typename Vertex>
+        void SetVertices(const std::vector<Vertex>& vertices)
+        {
+            SetVertices(vertices.data(), (uint32_t)(vertices.size() * sizeof(Vertex)),
+                        (uint32_t)vertices.size(), GetVertexLayout<Vertex>());
+        }
+
+        // Packs the vertices into a 20 byte quantized format before upload
+        // and records the dequantization parameters and bounds
+        void SetQuantizedVertices(const StandardVertex* vertices, uint32_t count);
+        // Stored as 16 bit whenever every index fits, PrimitiveRestartIndex
+        // ends a strip in either width
+        void SetIndices(const uint32_t* indices, uint32_t count);
+        void SetIndices(const std::vector<uint32_t>& indices);
 
         void SetVertexBuffer(const Ref<VertexBuffer>& vertexBuffer);
         void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer);
@@ -22,17 +52,89 @@ namespace ForgeEngine
         uint32_t GetVertexCount() const { return m_VertexCount; }
         uint32_t GetIndexCount() const { return m_IndexCount; }
 
-        void SetMaterial(const Ref<Material>& material) { m_Material = material; }
+        void SetTopology(PrimitiveTopology topology) { m_Topology = topology; }
+        PrimitiveTopology GetTopology() const { return m_Topology; }
+
+        void SetMaterial(const Ref<Material>& material);
         Ref<Material> GetMaterial() const { return m_Material; }
 
+        // Object space bounds. SetQuantizedVertices computes both volumes
+        // from the vertices; SetBounds alone can only give the sphere around
+        // the box, which is what .fmesh files get.
+        void SetBounds(const glm::vec3& min, const glm::vec3& max);
+        void SetBoundingSphere(const glm::vec3& center, float radius);
+        // Exact box and a sphere centered on it through the farthest vertex
+        void ComputeBounds(const StandardVertex* vertices, uint32_t count);
+
+        const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+        const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+        const glm::vec3& GetBoundingSphereCenter() const { return m_BoundingSphereCenter; }
+        float GetBoundingSphereRadius() const { return m_BoundingSphereRadius; }
+        // False for meshes built by hand without bounds
+        bool HasBounds() const { return m_BoundingSphereRadius > 0.0f; }
+
+        // Null unless the geometry was kept, which the procedural primitives
+        // do and the loaders do not. Static batching needs it.
+        void SetSourceGeometry(const Ref<const MeshGeometry>& geometry) { m_SourceGeometry = geometry; }
+        const Ref<const MeshGeometry>& GetSourceGeometry() const { return m_SourceGeometry; }
+
+        // Identity unless the vertices were uploaded quantized, the mesh
+        // shaders apply it to a_Position
+        const VertexQuantization& GetVertexQuantization() const { return m_VertexQuantization; }
+
+        // Bytes of vertex and index storage this mesh owns, LOD index
+        // buffers included
+        uint64_t GetGpuMemorySize() const;
+
+        // Coarser versions of this mesh. They share its vertex buffer and only
+        // own an index buffer; LOD 0 is the mesh itself.
+        void AddLod(const std::vector<uint32_t>& indices, float error);
+        // Simplifies the given triangle list, which must be the one this mesh
+        // was built from, into LOD levels
+        void GenerateLods(const void* vertices, uint32_t vertexCount,
+                          uint32_t stride, uint32_t positionOffset,
+                          const std::vector<uint32_t>& indices,
+                          const MeshSimplificationSettings& settings = {});
+
+        uint32_t GetLodCount() const { return (uint32_t)m_Lods.size() + 1; }
+        // Only valid for level >= 1
+        const Ref<Mesh>& GetLodMesh(uint32_t level) const { return m_Lods[level - 1].LodMesh; }
+        // Geometric error relative to the bounds extent, 0 for LOD 0
+        float GetLodError(uint32_t level) const
+        {
+            return level == 0 ? 0.0f : m_Lods[level - 1].Error;
+        }
+
+        // Meshes below this are drawn whole, culling their clusters would cost
+        // more than it saves
+        static constexpr uint32_t MinMeshletTriangles = 256;
+
+        // Replaces the index buffer with meshlets.Indices and keeps the
+        // cluster ranges and bounds for per-cluster culling of LOD 0
+        void SetMeshlets(const MeshletData& meshlets);
+        // Uploads a triangle list reordered into meshlets, or as it is when
+        // it has fewer than MinMeshletTriangles triangles
+        void BuildMeshlets(const void* vertices, uint32_t vertexCount,
+                           uint32_t stride, uint32_t positionOffset,
+                           const std::vector<uint32_t>& indices,
+                           const MeshletSettings& settings = {});
+
+        bool HasMeshlets() const { return !m_Meshlets.empty(); }
+        const std::vector<Meshlet>& GetMeshlets() const { return m_Meshlets; }
+        const std::vector<MeshletBounds>& GetMeshletBounds() const { return m_MeshletBounds; }
+
         // Static factory methods for primitive creation
         static Ref<Mesh> CreateCube(float size = 1.0f);
         static Ref<Mesh> CreateSphere(float radius = 0.5f, uint32_t segmentsX = 8, uint32_t segmentsY = 8);
         static Ref<Mesh> CreateCylinder(float radius = 0.5f, float height = 1.0f, uint32_t segments = 16);
-        static Ref<Mesh> CreatePlane(float width = 1.0f, float height = 1.0f);
+        // segments subdivides each side, large floors need it for their
+        // clusters to be culled
+        static Ref<Mesh> CreatePlane(float width = 1.0f, float height = 1.0f,
+                                     uint32_t segments = 1);
 
     private:
         friend class TestMesh;
+        friend class Model;
         Ref<VertexArray> m_VertexArray;
         Ref<VertexBuffer> m_VertexBuffer;
         Ref<IndexBuffer> m_IndexBuffer;
@@ -40,6 +142,26 @@ namespace ForgeEngine
 
         uint32_t m_VertexCount = 0;
         uint32_t m_IndexCount = 0;
+        PrimitiveTopology m_Topology = PrimitiveTopology::Triangles;
+
+        glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+        glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+        glm::vec3 m_BoundingSphereCenter = glm::vec3(0.0f);
+        float m_BoundingSphereRadius = 0.0f;
+
+        VertexQuantization m_VertexQuantization;
+
+        struct Lod
+        {
+            Ref<Mesh> LodMesh;
+            float Error;
+        };
+        std::vector<Lod> m_Lods;
+
+        std::vector<Meshlet> m_Meshlets;
+        std::vector<MeshletBounds> m_MeshletBounds;
+
+        Ref<const MeshGeometry> m_SourceGeometry;
     };
 
     // A model class to hold multiple meshes
@@ -50,12 +172,29 @@ namespace ForgeEngine
         ~Model() = default;
 
         const std::vector<Ref<Mesh>>& GetMeshes() const { return m_Meshes; }
-        void AddMesh(const Ref<Mesh>& mesh) { m_Meshes.push_back(mesh); }
+        // Grows the model bounds to enclose the mesh's
+        void AddMesh(const Ref<Mesh>& mesh);
 
-        // Factory method for loading models from files
+        // Union of the mesh bounds, in the space the meshes share
+        const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+        const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+        const glm::vec3& GetBoundingSphereCenter() const { return m_BoundingSphereCenter; }
+        float GetBoundingSphereRadius() const { return m_BoundingSphereRadius; }
+
+        // Factory method for loading models from files. Binary .fmesh files
+        // are memory mapped and uploaded without any parsing, .gltf/.glb go
+        // through the GltfImporter; returns nullptr when the file cannot be
+        // loaded.
         static Ref<Model> Load(const std::string& filepath);
 
     private:
+        static Ref<Model> LoadMeshFile(const std::string& filepath);
+
         std::vector<Ref<Mesh>> m_Meshes;
+
+        glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+        glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+        glm::vec3 m_BoundingSphereCenter = glm::vec3(0.0f);
+        float m_BoundingSphereRadius = 0.0f;
     };
 } // namespace BEngine
@@ -0,0 +1,309 @@
+#include "Core/Renderer/MeshFile.h"
+
+#include "FEPCH.h"
+
+#include <cfloat>
+#include <cstring>
+#include <fstream>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        static uint64_t AlignMeshSection(uint64_t offset)
+        {
+            uint64_t alignment = MeshFile::SectionAlignment;
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        static bool MeshSectionFits(uint64_t offset, uint64_t size,
+                                    uint64_t fileSize)
+        {
+            return offset <= fileSize && size <= fileSize - offset;
+        }
+    } // namespace Utils
+
+    Ref<MeshFile> MeshFile::Open(const std::string& path)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        Scope<MappedFile> file = MappedFile::Open(path);
+        if (!file)
+            return nullptr;
+
+        uint64_t fileSize = file->GetSize();
+        if (fileSize < sizeof(MeshFileHeader))
+        {
+            FENGINE_CORE_ERROR("Mesh file '{}' is truncated", path);
+            return nullptr;
+        }
+
+        auto header = (const MeshFileHeader*)file->GetData();
+        if (header->Magic != Magic || header->Version != Version)
+        {
+            FENGINE_CORE_ERROR("'{}' is not a mesh file (version {})", path,
+                               Version);
+            return nullptr;
+        }
+
+        if (header->IndexSize != sizeof(uint32_t))
+        {
+            FENGINE_CORE_ERROR("Mesh file '{}' uses unsupported {}-byte indices",
+                               path, header->IndexSize);
+            return nullptr;
+        }
+
+        // Only the tables are checked, the blobs are handed to the GPU as is
+        bool fits = Utils::MeshSectionFits(
+                        header->AttributeOffset,
+                        (uint64_t)header->AttributeCount * sizeof(MeshFileAttribute),
+                        fileSize)
+            && Utils::MeshSectionFits(
+                header->SubmeshOffset,
+                (uint64_t)header->SubmeshCount * sizeof(MeshFileSubmesh), fileSize)
+            && Utils::MeshSectionFits(
+                header->MaterialOffset,
+                (uint64_t)header->MaterialCount * sizeof(MeshFileMaterial),
+                fileSize)
+            && Utils::MeshSectionFits(
+                header->VertexDataOffset,
+                (uint64_t)header->VertexCount * header->VertexStride, fileSize)
+            && Utils::MeshSectionFits(
+                header->IndexDataOffset,
+                (uint64_t)header->IndexCount * header->IndexSize, fileSize);
+        if (!fits || header->AttributeCount == 0)
+        {
+            FENGINE_CORE_ERROR("Mesh file '{}' is truncated or corrupt", path);
+            return nullptr;
+        }
+
+        auto attributes = (const MeshFileAttribute*)(file->GetData()
+                                                     + header->AttributeOffset);
+        std::vector<BufferElement> elements;
+        elements.reserve(header->AttributeCount);
+        for (uint32_t i = 0; i < header->AttributeCount; i++)
+        {
+            const MeshFileAttribute& attribute = attributes[i];
+            if (attribute.Type == (uint32_t)ShaderDataType::None
+                || attribute.Type > (uint32_t)ShaderDataType::Int1010102)
+            {
+                FENGINE_CORE_ERROR("Mesh file '{}' has an unknown attribute type",
+                                   path);
+                return nullptr;
+            }
+
+            std::string name(attribute.Name,
+                             strnlen(attribute.Name, sizeof(attribute.Name)));
+            elements.emplace_back((ShaderDataType)attribute.Type, name,
+                                  attribute.Normalized != 0);
+        }
+
+        // The layout computes tightly packed offsets, which is what the
+        // writer produces
+        BufferLayout layout(elements);
+        bool layoutMatches = layout.GetStride() == header->VertexStride;
+        for (uint32_t i = 0; i < header->AttributeCount && layoutMatches; i++)
+            layoutMatches = layout.GetElements()[i].Offset == attributes[i].Offset;
+
+        if (!layoutMatches)
+        {
+            FENGINE_CORE_ERROR("Mesh file '{}' has a non packed vertex format",
+                               path);
+            return nullptr;
+        }
+
+        auto submeshes = (const MeshFileSubmesh*)(file->GetData()
+                                                  + header->SubmeshOffset);
+        for (uint32_t i = 0; i < header->SubmeshCount; i++)
+        {
+            const MeshFileSubmesh& submesh = submeshes[i];
+            bool valid = (uint64_t)submesh.IndexOffset + submesh.IndexCount
+                    <= header->IndexCount
+                && (header->MaterialCount == 0
+                    || submesh.MaterialIndex < header->MaterialCount);
+            if (!valid)
+            {
+                FENGINE_CORE_ERROR("Mesh file '{}' has a corrupt submesh {}",
+                                   path, i);
+                return nullptr;
+            }
+        }
+
+        auto meshFile = CreateRef<MeshFile>();
+        meshFile->m_Header = header;
+        meshFile->m_Layout = layout;
+        meshFile->m_Submeshes = submeshes;
+        meshFile->m_Materials = (const MeshFileMaterial*)(file->GetData()
+                                                          + header->MaterialOffset);
+        meshFile->m_File = std::move(file);
+        return meshFile;
+    }
+
+    bool MeshFile::Write(const std::string& path, const MeshData& data)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        const auto& elements = data.Layout.GetElements();
+        uint32_t stride = data.Layout.GetStride();
+        if (elements.empty()
+            || data.Vertices.size() != (size_t)data.VertexCount * stride)
+        {
+            FENGINE_CORE_ERROR("Cannot write '{}': vertex data does not match "
+                               "the layout", path);
+            return false;
+        }
+
+        // Bounds come from a_Position, or the first Float3 attribute
+        const BufferElement* position = nullptr;
+        for (const auto& element : elements)
+        {
+            if (element.Type != ShaderDataType::Float3)
+                continue;
+            if (!position || element.Name == "a_Position")
+                position = &element;
+        }
+
+        std::vector<MeshFileSubmesh> submeshes = data.Submeshes;
+        if (submeshes.empty())
+        {
+            MeshFileSubmesh whole = {};
+            whole.IndexCount = (uint32_t)data.Indices.size();
+            submeshes.push_back(whole);
+        }
+
+        MeshFileHeader header = {};
+        header.Magic = Magic;
+        header.Version = Version;
+        header.VertexCount = data.VertexCount;
+        header.VertexStride = stride;
+        header.IndexCount = (uint32_t)data.Indices.size();
+        header.IndexSize = sizeof(uint32_t);
+        header.AttributeCount = (uint32_t)elements.size();
+        header.SubmeshCount = (uint32_t)submeshes.size();
+        header.MaterialCount = (uint32_t)data.Materials.size();
+
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            header.BoundsMin[c] = FLT_MAX;
+            header.BoundsMax[c] = -FLT_MAX;
+        }
+
+        for (auto& submesh : submeshes)
+        {
+            if ((uint64_t)submesh.IndexOffset + submesh.IndexCount
+                > data.Indices.size())
+            {
+                FENGINE_CORE_ERROR("Cannot write '{}': submesh range is out of "
+                                   "bounds", path);
+                return false;
+            }
+
+            uint32_t minIndex = UINT32_MAX, maxIndex = 0;
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                submesh.BoundsMin[c] = FLT_MAX;
+                submesh.BoundsMax[c] = -FLT_MAX;
+            }
+
+            for (uint32_t i = 0; i < submesh.IndexCount; i++)
+            {
+                uint32_t index = data.Indices[submesh.IndexOffset + i];
+                if (index >= data.VertexCount)
+                {
+                    FENGINE_CORE_ERROR("Cannot write '{}': index {} is out of "
+                                       "range", path, index);
+                    return false;
+                }
+
+                minIndex = std::min(minIndex, index);
+                maxIndex = std::max(maxIndex, index);
+
+                if (!position)
+                    continue;
+
+                float vertex[3];
+                std::memcpy(vertex, &data.Vertices[(size_t)index * stride
+                                                   + position->Offset],
+                            sizeof(vertex));
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    submesh.BoundsMin[c] = std::min(submesh.BoundsMin[c], vertex[c]);
+                    submesh.BoundsMax[c] = std::max(submesh.BoundsMax[c], vertex[c]);
+                }
+            }
+
+            submesh.VertexOffset = submesh.IndexCount ? minIndex : 0;
+            submesh.VertexCount = submesh.IndexCount ? maxIndex - minIndex + 1 : 0;
+
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                header.BoundsMin[c] = std::min(header.BoundsMin[c],
+                                               submesh.BoundsMin[c]);
+                header.BoundsMax[c] = std::max(header.BoundsMax[c],
+                                               submesh.BoundsMax[c]);
+            }
+        }
+
+        std::vector<MeshFileAttribute> attributes(elements.size());
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            MeshFileAttribute& attribute = attributes[i];
+            attribute = {};
+            std::strncpy(attribute.Name, elements[i].Name.c_str(),
+                         sizeof(attribute.Name) - 1);
+            attribute.Type = (uint32_t)elements[i].Type;
+            attribute.Offset = (uint32_t)elements[i].Offset;
+            attribute.Normalized = elements[i].Normalized ? 1 : 0;
+        }
+
+        uint64_t offset = Utils::AlignMeshSection(sizeof(MeshFileHeader));
+        header.AttributeOffset = offset;
+        offset = Utils::AlignMeshSection(
+            offset + attributes.size() * sizeof(MeshFileAttribute));
+        header.SubmeshOffset = offset;
+        offset = Utils::AlignMeshSection(
+            offset + submeshes.size() * sizeof(MeshFileSubmesh));
+        header.MaterialOffset = offset;
+        offset = Utils::AlignMeshSection(
+            offset + data.Materials.size() * sizeof(MeshFileMaterial));
+        header.VertexDataOffset = offset;
+        offset = Utils::AlignMeshSection(offset + data.Vertices.size());
+        header.IndexDataOffset = offset;
+
+        std::ofstream out(path, std::ios::out | std::ios::binary);
+        if (!out)
+        {
+            FENGINE_CORE_ERROR("Could not write mesh file '{}'", path);
+            return false;
+        }
+
+        auto writeSection = [&out](uint64_t sectionOffset, const void* bytes,
+                                   size_t size) {
+            static const char padding[SectionAlignment] = {};
+            out.write(padding, sectionOffset - (uint64_t)out.tellp());
+            out.write((const char*)bytes, size);
+        };
+
+        out.write((const char*)&header, sizeof(header));
+        writeSection(header.AttributeOffset, attributes.data(),
+                     attributes.size() * sizeof(MeshFileAttribute));
+        writeSection(header.SubmeshOffset, submeshes.data(),
+                     submeshes.size() * sizeof(MeshFileSubmesh));
+        writeSection(header.MaterialOffset, data.Materials.data(),
+                     data.Materials.size() * sizeof(MeshFileMaterial));
+        writeSection(header.VertexDataOffset, data.Vertices.data(),
+                     data.Vertices.size());
+        writeSection(header.IndexDataOffset, data.Indices.data(),
+                     data.Indices.size() * sizeof(uint32_t));
+
+        return out.good();
+    }
+
+    bool MeshFile::IsMeshFilePath(const std::string& path)
+    {
+        std::string extension = Extension;
+        return path.size() > extension.size()
+            && path.compare(path.size() - extension.size(), extension.size(),
+                            extension) == 0;
+    }
+} // namespace ForgeEngine
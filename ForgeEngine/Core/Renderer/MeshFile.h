@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Renderer/Buffer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // On-disk layout of a binary mesh (.fmesh). Offsets are from the start of
+    // the file and every section is aligned to MeshFile::SectionAlignment:
+    //   MeshFileHeader
+    //   MeshFileAttribute[AttributeCount]  vertex format descriptor
+    //   MeshFileSubmesh[SubmeshCount]      index ranges + bounds
+    //   MeshFileMaterial[MaterialCount]    material slots
+    //   vertex blob                        VertexCount * VertexStride bytes
+    //   index blob                         IndexCount * IndexSize bytes
+    // The blobs are exactly what the GPU consumes, so loading is a memory map
+    // and one buffer upload each.
+    struct MeshFileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+
+        uint32_t VertexCount;
+        uint32_t VertexStride;
+        uint32_t IndexCount;
+        uint32_t IndexSize;
+
+        uint32_t AttributeCount;
+        uint32_t SubmeshCount;
+        uint32_t MaterialCount;
+        uint32_t Flags;
+
+        float BoundsMin[3];
+        float BoundsMax[3];
+
+        uint64_t AttributeOffset;
+        uint64_t SubmeshOffset;
+        uint64_t MaterialOffset;
+        uint64_t VertexDataOffset;
+        uint64_t IndexDataOffset;
+    };
+
+    struct MeshFileAttribute
+    {
+        char Name[32];
+        uint32_t Type; // ShaderDataType
+        uint32_t Offset;
+        uint32_t Normalized;
+        uint32_t Reserved;
+    };
+
+    struct MeshFileSubmesh
+    {
+        uint32_t IndexOffset;
+        uint32_t IndexCount;
+        uint32_t VertexOffset; // first vertex referenced by the range
+        uint32_t VertexCount;
+        uint32_t MaterialIndex;
+        uint32_t Reserved;
+        float BoundsMin[3];
+        float BoundsMax[3];
+    };
+
+    // Texture paths are relative to the .fmesh file
+    struct MeshFileMaterial
+    {
+        char Name[64];
+        char AlbedoMap[192];
+        char NormalMap[192];
+        float AlbedoColor[4];
+        float Metallic;
+        float Roughness;
+        uint32_t Reserved[2];
+    };
+
+    // CPU-side mesh handed to MeshFile::Write by importers. Submesh bounds and
+    // vertex ranges are computed while writing.
+    struct MeshData
+    {
+        BufferLayout Layout;
+        std::vector<uint8_t> Vertices;
+        uint32_t VertexCount = 0;
+        std::vector<uint32_t> Indices;
+        std::vector<MeshFileSubmesh> Submeshes;
+        std::vector<MeshFileMaterial> Materials;
+    };
+
+    class MeshFile
+    {
+    public:
+        static constexpr uint32_t Magic = 0x48534D46; // "FMSH"
+        static constexpr uint32_t Version = 1;
+        static constexpr uint32_t SectionAlignment = 16;
+        static constexpr const char* Extension = ".fmesh";
+
+        const MeshFileHeader& GetHeader() const { return *m_Header; }
+
+        // Rebuilt from the attribute table, offsets match the file exactly
+        const BufferLayout& GetLayout() const { return m_Layout; }
+
+        const MeshFileSubmesh& GetSubmesh(uint32_t index) const { return m_Submeshes[index]; }
+        const MeshFileMaterial& GetMaterial(uint32_t index) const { return m_Materials[index]; }
+
+        const uint8_t* GetVertexData() const { return m_File->GetData() + m_Header->VertexDataOffset; }
+        const uint32_t* GetIndexData() const
+        {
+            return (const uint32_t*)(m_File->GetData() + m_Header->IndexDataOffset);
+        }
+
+        const std::string& GetPath() const { return m_File->GetPath(); }
+
+        // Maps the file and validates every table against the file size.
+        // Returns nullptr for missing, truncated or incompatible files.
+        static Ref<MeshFile> Open(const std::string& path);
+
+        static bool Write(const std::string& path, const MeshData& data);
+
+        static bool IsMeshFilePath(const std::string& path);
+
+    private:
+        Scope<MappedFile> m_File;
+        BufferLayout m_Layout;
+
+        const MeshFileHeader* m_Header = nullptr;
+        const MeshFileSubmesh* m_Submeshes = nullptr;
+        const MeshFileMaterial* m_Materials = nullptr;
+    };
+} // namespace ForgeEngine
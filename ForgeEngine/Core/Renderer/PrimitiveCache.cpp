@@ -0,0 +1,137 @@
+#include "Core/Renderer/PrimitiveCache.h"
+
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        // Parameters are compared bit for bit, 1.0f and 1.0000001f are two
+        // different meshes
+        struct PrimitiveKey
+        {
+            PrimitiveType Type;
+            float Sizes[3];
+            uint32_t Segments[2];
+
+            bool operator==(const PrimitiveKey& other) const
+            {
+                return Type == other.Type
+                    && std::memcmp(Sizes, other.Sizes, sizeof(Sizes)) == 0
+                    && Segments[0] == other.Segments[0]
+                    && Segments[1] == other.Segments[1];
+            }
+        };
+
+        struct PrimitiveKeyHash
+        {
+            size_t operator()(const PrimitiveKey& key) const
+            {
+                size_t hash = std::hash<uint32_t>()((uint32_t)key.Type);
+                auto combine = [&hash](uint32_t value) {
+                    hash ^= std::hash<uint32_t>()(value) + 0x9e3779b9 + (hash << 6)
+                        + (hash >> 2);
+                };
+
+                for (float size : key.Sizes)
+                {
+                    uint32_t bits;
+                    std::memcpy(&bits, &size, sizeof(bits));
+                    combine(bits);
+                }
+                combine(key.Segments[0]);
+                combine(key.Segments[1]);
+                return hash;
+            }
+        };
+    } // namespace Utils
+
+    struct PrimitiveCacheData
+    {
+        std::unordered_map<Utils::PrimitiveKey, Ref<Mesh>, Utils::PrimitiveKeyHash> Meshes;
+        PrimitiveCacheStats Stats;
+    };
+
+    static PrimitiveCacheData s_PrimitiveCache;
+
+    template <typename CreateFn>
+    static Ref<Mesh> GetOrCreatePrimitive(const Utils::PrimitiveKey& key, CreateFn&& create)
+    {
+        auto it = s_PrimitiveCache.Meshes.find(key);
+        if (it != s_PrimitiveCache.Meshes.end())
+        {
+            s_PrimitiveCache.Stats.Hits++;
+            return it->second;
+        }
+
+        Ref<Mesh> mesh = create();
+        s_PrimitiveCache.Meshes.emplace(key, mesh);
+        s_PrimitiveCache.Stats.Misses++;
+        s_PrimitiveCache.Stats.GpuBytes += mesh->GetGpuMemorySize();
+        return mesh;
+    }
+
+    Ref<Mesh> PrimitiveCache::GetCube(float size)
+    {
+        Utils::PrimitiveKey key = {PrimitiveType::Cube, {size, 0.0f, 0.0f}, {0, 0}};
+        return GetOrCreatePrimitive(key, [&]() { return Mesh::CreateCube(size); });
+    }
+
+    Ref<Mesh> PrimitiveCache::GetSphere(float radius, uint32_t segmentsX, uint32_t segmentsY)
+    {
+        Utils::PrimitiveKey key = {PrimitiveType::Sphere, {radius, 0.0f, 0.0f},
+                                   {segmentsX, segmentsY}};
+        return GetOrCreatePrimitive(
+            key, [&]() { return Mesh::CreateSphere(radius, segmentsX, segmentsY); });
+    }
+
+    Ref<Mesh> PrimitiveCache::GetCylinder(float radius, float height, uint32_t segments)
+    {
+        Utils::PrimitiveKey key = {PrimitiveType::Cylinder, {radius, height, 0.0f},
+                                   {segments, 0}};
+        return GetOrCreatePrimitive(
+            key, [&]() { return Mesh::CreateCylinder(radius, height, segments); });
+    }
+
+    Ref<Mesh> PrimitiveCache::GetPlane(float width, float height, uint32_t segments)
+    {
+        Utils::PrimitiveKey key = {PrimitiveType::Plane, {width, height, 0.0f},
+                                   {segments, 0}};
+        return GetOrCreatePrimitive(
+            key, [&]() { return Mesh::CreatePlane(width, height, segments); });
+    }
+
+    uint32_t PrimitiveCache::Trim()
+    {
+        uint32_t dropped = 0;
+        for (auto it = s_PrimitiveCache.Meshes.begin(); it != s_PrimitiveCache.Meshes.end();)
+        {
+            if (it->second.use_count() == 1)
+            {
+                s_PrimitiveCache.Stats.GpuBytes -= it->second->GetGpuMemorySize();
+                it = s_PrimitiveCache.Meshes.erase(it);
+                dropped++;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return dropped;
+    }
+
+    void PrimitiveCache::Clear()
+    {
+        s_PrimitiveCache.Meshes.clear();
+        s_PrimitiveCache.Stats.GpuBytes = 0;
+    }
+
+    PrimitiveCacheStats PrimitiveCache::GetStats()
+    {
+        PrimitiveCacheStats stats = s_PrimitiveCache.Stats;
+        stats.Meshes = (uint32_t)s_PrimitiveCache.Meshes.size();
+        return stats;
+    }
+} // namespace ForgeEngine
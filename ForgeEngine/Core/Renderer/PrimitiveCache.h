@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/Renderer/Mesh.h"
+#include <cstdint>
+
+namespace ForgeEngine
+{
+    enum class PrimitiveType : uint8_t
+    {
+        Cube = 0,
+        Sphere,
+        Cylinder,
+        Plane
+    };
+
+    struct PrimitiveCacheStats
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        uint32_t Meshes = 0;   // currently cached
+        uint64_t GpuBytes = 0; // vertex and index storage of the cached meshes
+    };
+
+    // Shared procedural meshes keyed by primitive type and parameters. The
+    // same request always returns the same Ref<Mesh>, so per-frame calls do
+    // not allocate GPU buffers and keep batching on one mesh pointer.
+    // Returned meshes are shared: never change their buffers or material,
+    // use Mesh::Create* for a private copy. Main thread only, like any GPU
+    // resource creation.
+    class PrimitiveCache
+    {
+    public:
+        static Ref<Mesh> GetCube(float size = 1.0f);
+        static Ref<Mesh> GetSphere(float radius = 0.5f, uint32_t segmentsX = 8,
+                                   uint32_t segmentsY = 8);
+        static Ref<Mesh> GetCylinder(float radius = 0.5f, float height = 1.0f,
+                                     uint32_t segments = 16);
+        static Ref<Mesh> GetPlane(float width = 1.0f, float height = 1.0f,
+                                  uint32_t segments = 1);
+
+        // Releases the meshes nobody outside the cache holds anymore and
+        // returns how many were dropped
+        static uint32_t Trim();
+        // Releases everything, must run before the graphics context goes away
+        static void Clear();
+
+        static PrimitiveCacheStats GetStats();
+    };
+} // namespace ForgeEngine
@@ -30,9 +30,33 @@ namespace ForgeEngine
             renderer_api_->Clear();
         }
 
-        static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0)
+        static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0,
+                                PrimitiveTopology topology = PrimitiveTopology::Triangles)
         {
-            renderer_api_->DrawIndexed(vertexArray, indexCount);
+            renderer_api_->DrawIndexed(vertexArray, indexCount, topology);
+        }
+
+        static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount,
+                                         uint32_t instanceCount,
+                                         PrimitiveTopology topology = PrimitiveTopology::Triangles)
+        {
+            renderer_api_->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, topology);
+        }
+
+        static void DrawIndexedInstancedBaseInstance(const Ref<VertexArray>& vertexArray,
+                                                     uint32_t indexCount, uint32_t instanceCount,
+                                                     uint32_t baseInstance,
+                                                     PrimitiveTopology topology = PrimitiveTopology::Triangles)
+        {
+            renderer_api_->DrawIndexedInstancedBaseInstance(vertexArray, indexCount, instanceCount,
+                                                            baseInstance, topology);
+        }
+
+        static void MultiDrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t* counts,
+                                     const uint32_t* firstIndices, uint32_t drawCount,
+                                     PrimitiveTopology topology = PrimitiveTopology::Triangles)
+        {
+            renderer_api_->MultiDrawIndexed(vertexArray, counts, firstIndices, drawCount, topology);
         }
 
         static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
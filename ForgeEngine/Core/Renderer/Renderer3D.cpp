@@ -1,13 +1,20 @@
 #include "Core/Renderer/Renderer3D.h"
 #include "Config.h"
+#include "Core/Renderer/Bounds.h"
+#include "Core/Renderer/GpuProfiler.h"
 #include "Core/Renderer/InstancedRenderer.h"
+#include "Core/Renderer/PrimitiveCache.h"
 #include "Core/Renderer/RenderCommand.h"
 #include "Core/Renderer/Shader.h"
+#include "Core/Renderer/TextureStreamer.h"
 #include "Core/Renderer/UniformBuffer.h"
 #include "Core/Renderer/VertexArray.h"
+#include "Core/Threading/JobSystem.h"
 #include "glad/glad.h"
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cfloat>
 #include <unordered_map>
 
 namespace ForgeEngine
@@ -29,6 +36,51 @@ namespace ForgeEngine
         int EntityID;
     };
 
+    struct MeshClusterDraw
+    {
+        // Adjacent surviving clusters are merged into one range
+        std::vector<uint32_t> Counts;
+        std::vector<uint32_t> FirstIndices;
+        // False when the item was not cluster culled and is drawn whole
+        bool Active = false;
+    };
+
+    // Proxies sharing a mesh, material and static flag. Slot order is the
+    // order of the GPU instance buffer; removal moves the last slot into
+    // the hole so the buffer stays dense.
+    struct RenderProxyBatch
+    {
+        Ref<Mesh> MeshPtr;
+        Ref<Material> MaterialPtr;
+        bool Static = false;
+
+        std::vector<OptimizedInstanceData> Instances;
+        // World space bounding sphere per slot, xyz center and w radius
+        std::vector<glm::vec4> Spheres;
+        std::vector<uint32_t> SlotProxies;
+
+        Ref<VertexBuffer> InstanceBuffer;
+        Ref<VertexArray> InstancedVertexArray;
+        uint32_t Capacity = 0;
+
+        // Slots changed since the last upload, [DirtyBegin, DirtyEnd)
+        uint32_t DirtyBegin = UINT32_MAX;
+        uint32_t DirtyEnd = 0;
+
+        void MarkDirty(uint32_t slot)
+        {
+            DirtyBegin = std::min(DirtyBegin, slot);
+            DirtyEnd = std::max(DirtyEnd, slot + 1);
+        }
+    };
+
+    struct RenderProxySlot
+    {
+        uint32_t Generation = 0;
+        uint32_t Batch = UINT32_MAX; // UINT32_MAX while the slot is free
+        uint32_t Slot = 0;
+    };
+
     struct Renderer3DData
     {
         static constexpr uint32_t MaxVertices = 100000;
@@ -49,19 +101,68 @@ namespace ForgeEngine
 
         // Reference to the InstancedRenderer
         std::unique_ptr<InstancedRenderer> InstanceRenderer;
+        std::unique_ptr<StaticBatcher> StaticBatches;
 
         // Active camera for frustum culling
         const Camera3D* ActiveCamera = nullptr;
 
-        // Entity culling info (stores bounding volumes)
+        // LOD selection
+        Renderer3D::LodSettings Lod;
+        // Pixels covered by one world unit at distance one, 0 disables LOD
+        // selection (no viewport size known)
+        float LodProjectionScale = 0.0f;
+        glm::vec3 LodCameraPosition = glm::vec3(0.0f);
+        // Last level per (entity, mesh) for the hysteresis band
+        static constexpr uint8_t CulledLod = 0xff;
+        std::unordered_map<uint64_t, uint8_t> LodHistory;
+
+        // Cluster culling of the items drawn individually this frame. The
+        // clusters of every item are laid out back to back so the workers
+        // split the total evenly, whatever the size of each mesh.
+        struct ClusterCullItem
+        {
+            uint32_t ItemIndex;
+            uint32_t FirstCluster;
+            uint32_t ClusterCount;
+            const MeshletBounds* Bounds;
+            // Frustum planes and camera position in the item's object space,
+            // so the meshlet bounds are tested without being transformed
+            std::array<glm::vec4, 6> Planes;
+            glm::vec3 CameraPosition;
+            // Mirroring transforms flip the winding, the cones do not apply
+            bool ConeCulling;
+        };
+
+        // Retained proxies, indexed by ProxyHandle::Index
+        std::vector<RenderProxySlot> Proxies;
+        std::vector<uint32_t> FreeProxies;
+        std::vector<RenderProxyBatch> ProxyBatches;
+        std::unordered_map<std::string, uint32_t> ProxyBatchLookup;
+        uint32_t ProxyCount = 0;
+        // Culled instances between two visible runs that are still drawn to
+        // save a draw call
+        static constexpr uint32_t ProxyRunGap = 8;
+        std::vector<uint8_t> ProxyVisibility;
+        std::vector<uint32_t> ProxyRangeFirst;
+        std::vector<uint32_t> ProxyRangeCount;
+
+        bool ClusterCullingEnabled = true;
+        std::vector<const Renderer3D::RenderItem*> IndividualItems;
+        std::vector<MeshClusterDraw> ClusterDraws;
+        std::vector<ClusterCullItem> ClusterCullItems;
+        std::vector<uint8_t> ClusterVisibility;
+
+        // World bounds of each entity as of its last culling test
         struct EntityCullingData
         {
-            glm::vec3 BoundingBoxMin;
-            glm::vec3 BoundingBoxMax;
-            float BoundingSphereRadius;
+            glm::vec3 BoundingBoxMin = glm::vec3(0.0f);
+            glm::vec3 BoundingBoxMax = glm::vec3(0.0f);
+            float BoundingSphereRadius = 0.0f;
             bool WasVisible = true;
         };
 
+        Renderer3D::CullingVolume Culling = Renderer3D::CullingVolume::AABB;
+
         std::unordered_map<int, EntityCullingData> EntityCullingInfo;
 
         // Tracks visible and total entities for culling stats
@@ -139,22 +240,30 @@ namespace ForgeEngine
                                     const glm::vec3& scale,
                                     const glm::vec3& rotation)
     {
-        glm::mat4 transformMatrix = glm::mat4(1.0f);
-        transformMatrix = glm::translate(transformMatrix, position);
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.z),
-                                      glm::vec3(0.0f, 0.0f, 1.0f));
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.y),
-                                      glm::vec3(0.0f, 1.0f, 0.0f));
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.x),
-                                      glm::vec3(1.0f, 0.0f, 0.0f));
-        transformMatrix = glm::scale(transformMatrix, scale);
+        // T * Rz * Ry * Rx * S written out, one sin/cos pair per axis
+        // instead of three rotate calls
+        glm::vec3 radians = glm::radians(rotation);
+        float cx = std::cos(radians.x), sx = std::sin(radians.x);
+        float cy = std::cos(radians.y), sy = std::sin(radians.y);
+        float cz = std::cos(radians.z), sz = std::sin(radians.z);
+
+        glm::mat4 transformMatrix;
+        transformMatrix[0] = glm::vec4(cz * cy, sz * cy, -sy, 0.0f) * scale.x;
+        transformMatrix[1] = glm::vec4(cz * sy * sx - sz * cx, sz * sy * sx + cz * cx,
+                                       cy * sx, 0.0f)
+            * scale.y;
+        transformMatrix[2] = glm::vec4(cz * sy * cx + sz * sx, sz * sy * cx - cz * sx,
+                                       cy * cx, 0.0f)
+            * scale.z;
+        transformMatrix[3] = glm::vec4(position, 1.0f);
         return transformMatrix;
     }
 
-    // Performs frustum culling for an entity based on its transform and
-    // bounding sphere
+    // Performs frustum culling for an entity from its mesh's bounds: the
+    // bounding sphere first, then the box volume picked by
+    // SetCullingVolume. Meshes without bounds are treated as a unit cube.
     bool PerformCulling(int entityID, const glm::mat4& transform,
-                        float* outBoundingRadius = nullptr)
+                        const Mesh* mesh, float* outBoundingRadius = nullptr)
     {
         if (!s_Data.ActiveCamera || entityID < 0)
         {
@@ -171,38 +280,56 @@ namespace ForgeEngine
             return true;
         }
 
-        auto& cullingData = s_Data.EntityCullingInfo[entityID];
-
-        // Calculate bounding sphere radius if not set yet
-        if (cullingData.BoundingSphereRadius == 0.0f)
+        glm::vec3 localMin(-0.5f), localMax(0.5f), localCenter(0.0f);
+        float localRadius = 0.866f; // ~sqrt(3)/2 for a unit cube
+        if (mesh && mesh->HasBounds())
         {
-            glm::vec3 scale;
-            scale.x = glm::length(glm::vec3(transform[0]));
-            scale.y = glm::length(glm::vec3(transform[1]));
-            scale.z = glm::length(glm::vec3(transform[2]));
-            float maxScale = glm::max(glm::max(scale.x, scale.y), scale.z);
-            cullingData.BoundingSphereRadius
-                = maxScale * 0.866f; // ~sqrt(3)/2 for a cube
+            localMin = mesh->GetBoundsMin();
+            localMax = mesh->GetBoundsMax();
+            localCenter = mesh->GetBoundingSphereCenter();
+            localRadius = mesh->GetBoundingSphereRadius();
         }
 
+        const Camera3D& camera = *s_Data.ActiveCamera;
+        float maxScale = GetMaxScale(transform);
+        glm::vec3 center = glm::vec3(transform * glm::vec4(localCenter, 1.0f));
+        float radius = localRadius * maxScale;
+
+        bool isVisible = camera.SphereInFrustum(center, radius);
+        bool sphereVisible = isVisible;
+
+        glm::vec3 worldMin, worldMax;
+        TransformAABB(transform, localMin, localMax, worldMin, worldMax);
+        if (isVisible && s_Data.Culling == Renderer3D::CullingVolume::AABB)
+            isVisible = camera.AABBInFrustum(worldMin, worldMax);
+        else if (isVisible && s_Data.Culling == Renderer3D::CullingVolume::OBB)
+            isVisible = camera.OBBInFrustum(transform, localMin, localMax);
+
         s_Data.TotalMeshCount++;
 
-        bool isVisible = Renderer3D::IsEntityVisible(
-            entityID, transform, cullingData.BoundingSphereRadius);
+        if (!isVisible)
+        {
+            // What the unit cube guess at the origin used to decide
+            glm::vec3 origin(transform[3]);
+            if (camera.SphereInFrustum(origin, maxScale * 0.866f))
+                s_Data.Stats.BoundsFalsePositivesRemoved++;
+            if (sphereVisible)
+                s_Data.Stats.BoxCulledCount++;
+        }
 
+        auto& cullingData = s_Data.EntityCullingInfo[entityID];
+        cullingData.BoundingBoxMin = worldMin;
+        cullingData.BoundingBoxMax = worldMax;
+        cullingData.BoundingSphereRadius = radius;
+        cullingData.WasVisible = isVisible;
         if (isVisible)
         {
             s_Data.VisibleMeshCount++;
-            cullingData.WasVisible = true;
-        }
-        else
-        {
-            cullingData.WasVisible = false;
         }
 
         if (outBoundingRadius)
         {
-            *outBoundingRadius = cullingData.BoundingSphereRadius;
+            *outBoundingRadius = radius;
         }
 
         return isVisible;
@@ -210,7 +337,8 @@ namespace ForgeEngine
 
     // Internal function to handle mesh/material binding and draw call
     void DrawMeshInternal(const glm::mat4& transform, Ref<Mesh> mesh,
-                          Ref<Material> material, int entityID)
+                          Ref<Material> material, int entityID,
+                          const MeshClusterDraw* clusters = nullptr)
     {
         // Bind material textures, fallback to white texture if missing
         if (material->GetAlbedoMap())
@@ -239,6 +367,10 @@ namespace ForgeEngine
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
             s_Data.WireframeShader->Bind();
             s_Data.WireframeShader->SetMat4("u_Transform", transform);
+            s_Data.WireframeShader->SetFloat3(
+                "u_PositionScale", mesh->GetVertexQuantization().Scale);
+            s_Data.WireframeShader->SetFloat3(
+                "u_PositionOffset", mesh->GetVertexQuantization().Offset);
             s_Data.WireframeShader->SetFloat4("u_Color",
                                               material->GetAlbedoColor());
             s_Data.WireframeShader->SetInt("u_EntityID", entityID);
@@ -248,6 +380,12 @@ namespace ForgeEngine
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
             s_Data.MeshShader->Bind();
             s_Data.MeshShader->SetMat4("u_Transform", transform);
+            s_Data.MeshShader->SetMat3("u_NormalMatrix",
+                                       ComputeNormalMatrix(transform));
+            s_Data.MeshShader->SetFloat3("u_PositionScale",
+                                         mesh->GetVertexQuantization().Scale);
+            s_Data.MeshShader->SetFloat3("u_PositionOffset",
+                                         mesh->GetVertexQuantization().Offset);
             s_Data.MeshShader->SetFloat4("u_MaterialAlbedoColor",
                                          material->GetAlbedoColor());
             s_Data.MeshShader->SetFloat("u_MaterialMetallic",
@@ -266,13 +404,51 @@ namespace ForgeEngine
 
         // Bind VAO and issue draw call
         mesh->GetVertexArray()->Bind();
-        RenderCommand::DrawIndexed(mesh->GetVertexArray(),
-                                   mesh->GetIndexCount());
+        if (clusters && clusters->Active)
+        {
+            uint32_t rangeCount = (uint32_t)clusters->Counts.size();
+            RenderCommand::MultiDrawIndexed(mesh->GetVertexArray(),
+                                            clusters->Counts.data(),
+                                            clusters->FirstIndices.data(),
+                                            rangeCount, mesh->GetTopology());
+
+            for (uint32_t count : clusters->Counts)
+                s_Data.Stats.IndexCount += count;
+            s_Data.Stats.ClusterDrawRanges += rangeCount;
+        }
+        else
+        {
+            RenderCommand::DrawIndexed(mesh->GetVertexArray(),
+                                       mesh->GetIndexCount(),
+                                       mesh->GetTopology());
+            s_Data.Stats.IndexCount += mesh->GetIndexCount();
+        }
 
         s_Data.Stats.DrawCalls++;
         s_Data.Stats.IndividualDrawCalls++;
         s_Data.Stats.VertexCount += mesh->GetVertexCount();
-        s_Data.Stats.IndexCount += mesh->GetIndexCount();
+    }
+
+    // Sphere against the frustum, then the normal cone against the camera:
+    // a cluster whose triangles all face away is skipped even on screen
+    static bool IsClusterVisible(const Renderer3DData::ClusterCullItem& item,
+                                 const MeshletBounds& bounds)
+    {
+        glm::vec3 center(bounds.Center[0], bounds.Center[1], bounds.Center[2]);
+
+        for (const glm::vec4& plane : item.Planes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -bounds.Radius)
+                return false;
+        }
+
+        if (!item.ConeCulling)
+            return true;
+
+        glm::vec3 axis(bounds.ConeAxis[0], bounds.ConeAxis[1], bounds.ConeAxis[2]);
+        glm::vec3 toCenter = center - item.CameraPosition;
+        return glm::dot(toCenter, axis)
+            < bounds.ConeCutoff * glm::length(toCenter) + bounds.Radius;
     }
 
     void Renderer3D::Init()
@@ -293,6 +469,7 @@ namespace ForgeEngine
         // Initialize InstancedRenderer
         s_Data.InstanceRenderer = std::make_unique<InstancedRenderer>();
         s_Data.InstanceRenderer->Init();
+        s_Data.StaticBatches = std::make_unique<StaticBatcher>();
 
         FENGINE_CORE_INFO(
             "Instanced rendering system initialized with threshold: {}",
@@ -317,17 +494,22 @@ namespace ForgeEngine
         s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
         s_Data.TextureSlots[0] = s_Data.WhiteTexture;
 
+        TextureStreamer::Init();
+        GpuProfiler::Init();
+
         // Create primitive meshes
-        s_Data.CubeMesh = Mesh::CreateCube(1.0f);
-        s_Data.SphereMesh = Mesh::CreateSphere(0.5f, 16, 16);
+        s_Data.CubeMesh = PrimitiveCache::GetCube(1.0f);
+        // Dense enough for close ups, distant spheres use the LOD chain
+        s_Data.SphereMesh = PrimitiveCache::GetSphere(0.5f, 32, 32);
 
         FENGINE_CORE_INFO("Primitive meshes created:");
         FENGINE_CORE_INFO("  Cube: {} vertices, {} indices",
                           s_Data.CubeMesh->GetVertexCount(),
                           s_Data.CubeMesh->GetIndexCount());
-        FENGINE_CORE_INFO("  Sphere: {} vertices, {} indices",
+        FENGINE_CORE_INFO("  Sphere: {} vertices, {} indices, {} LODs",
                           s_Data.SphereMesh->GetVertexCount(),
-                          s_Data.SphereMesh->GetIndexCount());
+                          s_Data.SphereMesh->GetIndexCount(),
+                          s_Data.SphereMesh->GetLodCount());
 
         // Create default material
         s_Data.DefaultMaterial = CreateRef<Material>();
@@ -357,6 +539,11 @@ namespace ForgeEngine
     {
         FENGINE_PROFILE_FUNCTION();
 
+        TextureStreamer::Shutdown();
+        GpuProfiler::Shutdown();
+
+        s_Data.StaticBatches.reset();
+
         // Shutdown instanced renderer
         if (s_Data.InstanceRenderer)
         {
@@ -365,6 +552,18 @@ namespace ForgeEngine
         }
 
         delete[] s_Data.LineVertexBufferBase;
+
+        s_Data.Proxies.clear();
+        s_Data.FreeProxies.clear();
+        s_Data.ProxyBatches.clear();
+        s_Data.ProxyBatchLookup.clear();
+        s_Data.ProxyCount = 0;
+
+        s_Data.CubeMesh.reset();
+        s_Data.SphereMesh.reset();
+        PrimitiveCache::Clear();
+
+        VertexArray::ReleaseSharedFormats();
     }
 
     void Renderer3D::BeginScene(const Camera& camera,
@@ -388,6 +587,7 @@ namespace ForgeEngine
                                            sizeof(Renderer3DData::LightData));
 
         s_Data.ActiveCamera = nullptr;
+        s_Data.LodProjectionScale = 0.0f;
         StartBatch();
     }
 
@@ -409,6 +609,9 @@ namespace ForgeEngine
                                            sizeof(Renderer3DData::LightData));
 
         s_Data.ActiveCamera = &camera;
+        s_Data.LodProjectionScale = camera.GetProjectionMatrix()[1][1] * 0.5f
+            * camera.GetViewportHeight();
+        s_Data.LodCameraPosition = camera.GetPosition();
         StartBatch();
     }
 
@@ -426,9 +629,22 @@ namespace ForgeEngine
         s_Data.Stats.CulledMeshCount
             = s_Data.TotalMeshCount - s_Data.VisibleMeshCount;
 
-        ProcessBatches();
-
-        Flush();
+        {
+            FENGINE_GPU_SCOPE("Scene");
+            ProcessBatches();
+            {
+                FENGINE_GPU_SCOPE("Proxies");
+                RenderProxies();
+            }
+            {
+                FENGINE_GPU_SCOPE("Static Batches");
+                RenderStaticBatches();
+            }
+            {
+                FENGINE_GPU_SCOPE("Lines");
+                Flush();
+            }
+        }
 
         if (s_Data.Stats.TotalInstances > 0)
         {
@@ -441,6 +657,11 @@ namespace ForgeEngine
                 = (float)(drawCallsWithoutInstancing - actualDrawCalls)
                 / (float)drawCallsWithoutInstancing * 100.0f;
         }
+
+        const VertexArrayStats& vertexArrayStats = VertexArray::GetStats();
+        s_Data.Stats.VertexArrayBinds = vertexArrayStats.Binds;
+        s_Data.Stats.VertexBufferBindings = vertexArrayStats.BufferBindings;
+        s_Data.Stats.VertexFormats = vertexArrayStats.SharedFormats;
     }
 
     void Renderer3D::StartBatch()
@@ -466,31 +687,162 @@ namespace ForgeEngine
     {
         FENGINE_PROFILE_FUNCTION();
 
+        s_Data.IndividualItems.clear();
+
         if (!s_Data.AutoInstancingEnabled)
         {
             // If auto instancing is disabled, render everything individually
             for (const auto& item : s_Data.RenderQueue)
             {
-                RenderIndividualItem(item);
+                s_Data.IndividualItems.push_back(&item);
+            }
+        }
+        else
+        {
+            FENGINE_GPU_SCOPE("Instanced");
+
+            // Group items by mesh and material. MeshPtr is already the
+            // selected LOD, so every (mesh, LOD) pair batches on its own
+            for (const auto& item : s_Data.RenderQueue)
+            {
+                std::string meshKey = GetMeshKey(item.MeshPtr, item.MaterialPtr);
+                s_Data.MeshBatches[meshKey].push_back(item);
+            }
+
+            // Process each group
+            for (const auto& [meshKey, items] : s_Data.MeshBatches)
+            {
+                if (ShouldUseInstancing(items)) { RenderInstancedBatch(items); }
+                else
+                {
+                    for (const auto& item : items)
+                    {
+                        s_Data.IndividualItems.push_back(&item);
+                    }
+                }
             }
-            return;
         }
 
-        // Group items by mesh and material
-        for (const auto& item : s_Data.RenderQueue)
+        // Items drawn one by one can skip the clusters they do not need
+        CullClusters();
+
+        FENGINE_GPU_SCOPE("Individual");
+        for (size_t i = 0; i < s_Data.IndividualItems.size(); i++)
         {
-            std::string meshKey = GetMeshKey(item.MeshPtr, item.MaterialPtr);
-            s_Data.MeshBatches[meshKey].push_back(item);
+            RenderIndividualItem(*s_Data.IndividualItems[i],
+                                 &s_Data.ClusterDraws[i]);
         }
+    }
+
+    void Renderer3D::CullClusters()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        auto& items = s_Data.IndividualItems;
+        auto& cullItems = s_Data.ClusterCullItems;
 
-        // Process each group
-        for (const auto& [meshKey, items] : s_Data.MeshBatches)
+        s_Data.ClusterDraws.resize(items.size());
+        cullItems.clear();
+
+        uint32_t clusterCount = 0;
+        for (size_t i = 0; i < items.size(); i++)
         {
-            if (ShouldUseInstancing(items)) { RenderInstancedBatch(items); }
-            else
+            MeshClusterDraw& draw = s_Data.ClusterDraws[i];
+            draw.Counts.clear();
+            draw.FirstIndices.clear();
+            draw.Active = false;
+
+            const Ref<Mesh>& mesh = items[i]->MeshPtr;
+            if (!s_Data.ClusterCullingEnabled || !s_Data.ActiveCamera
+                || !mesh->HasMeshlets())
+                continue;
+
+            // A world plane p becomes transpose(M) * p in object space;
+            // renormalizing keeps the distances comparable to the radii
+            const glm::mat4& transform = items[i]->Transform;
+            glm::mat4 transposed = glm::transpose(transform);
+
+            Renderer3DData::ClusterCullItem cullItem;
+            cullItem.ItemIndex = (uint32_t)i;
+            cullItem.FirstCluster = clusterCount;
+            cullItem.ClusterCount = (uint32_t)mesh->GetMeshlets().size();
+            cullItem.Bounds = mesh->GetMeshletBounds().data();
+
+            const auto& planes = s_Data.ActiveCamera->GetFrustumPlanes();
+            for (size_t p = 0; p < planes.size(); p++)
             {
-                for (const auto& item : items) { RenderIndividualItem(item); }
+                glm::vec4 plane = transposed * planes[p];
+                float length = glm::length(glm::vec3(plane));
+                cullItem.Planes[p] = length > 0.0f ? plane / length : plane;
             }
+
+            cullItem.CameraPosition = glm::vec3(
+                glm::inverse(transform)
+                * glm::vec4(s_Data.ActiveCamera->GetPosition(), 1.0f));
+            cullItem.ConeCulling = glm::determinant(glm::mat3(transform)) > 0.0f;
+
+            cullItems.push_back(cullItem);
+            clusterCount += cullItem.ClusterCount;
+        }
+
+        if (cullItems.empty()) return;
+
+        s_Data.ClusterVisibility.resize(clusterCount);
+        JobSystem::ParallelFor(
+            clusterCount, 256, [](uint32_t begin, uint32_t end) {
+                const auto& cullItems = s_Data.ClusterCullItems;
+
+                // Item holding the first cluster of the chunk
+                auto it = std::upper_bound(
+                    cullItems.begin(), cullItems.end(), begin,
+                    [](uint32_t cluster,
+                       const Renderer3DData::ClusterCullItem& item) {
+                        return cluster < item.FirstCluster;
+                    });
+                size_t itemIndex = (size_t)(it - cullItems.begin()) - 1;
+
+                for (uint32_t cluster = begin; cluster < end; cluster++)
+                {
+                    while (cluster >= cullItems[itemIndex].FirstCluster
+                                   + cullItems[itemIndex].ClusterCount)
+                        itemIndex++;
+
+                    const auto& item = cullItems[itemIndex];
+                    s_Data.ClusterVisibility[cluster] = IsClusterVisible(
+                        item, item.Bounds[cluster - item.FirstCluster]);
+                }
+            });
+
+        for (const auto& cullItem : cullItems)
+        {
+            MeshClusterDraw& draw = s_Data.ClusterDraws[cullItem.ItemIndex];
+            const auto& meshlets = items[cullItem.ItemIndex]->MeshPtr->GetMeshlets();
+            draw.Active = true;
+
+            for (uint32_t m = 0; m < cullItem.ClusterCount; m++)
+            {
+                const Meshlet& meshlet = meshlets[m];
+                if (!s_Data.ClusterVisibility[cullItem.FirstCluster + m])
+                {
+                    s_Data.Stats.CulledClusterCount++;
+                    s_Data.Stats.CulledClusterTriangles += meshlet.IndexCount / 3;
+                    continue;
+                }
+
+                if (!draw.Counts.empty()
+                    && draw.FirstIndices.back() + draw.Counts.back()
+                        == meshlet.FirstIndex)
+                {
+                    draw.Counts.back() += meshlet.IndexCount;
+                }
+                else
+                {
+                    draw.FirstIndices.push_back(meshlet.FirstIndex);
+                    draw.Counts.push_back(meshlet.IndexCount);
+                }
+            }
+
+            s_Data.Stats.ClusterCount += cullItem.ClusterCount;
         }
     }
 
@@ -534,9 +886,13 @@ namespace ForgeEngine
 
     }
 
-    void Renderer3D::RenderIndividualItem(const RenderItem& item)
+    void Renderer3D::RenderIndividualItem(const RenderItem& item,
+                                          const MeshClusterDraw* clusters)
     {
-        FENGINE_PROFILE_FUNCTION();
+        FENGINE_PROFILE_DETAIL_FUNCTION();
+
+        // Every cluster was culled, nothing left to draw
+        if (clusters && clusters->Active && clusters->Counts.empty()) return;
 
         Ref<Material> material = item.MaterialPtr;
         if (!material)
@@ -546,7 +902,8 @@ namespace ForgeEngine
             material = s_Data.DefaultMaterial;
         }
 
-        DrawMeshInternal(item.Transform, item.MeshPtr, material, item.EntityID);
+        DrawMeshInternal(item.Transform, item.MeshPtr, material, item.EntityID,
+                         clusters);
         s_Data.Stats.IndividualObjects++;
     }
 
@@ -570,16 +927,84 @@ namespace ForgeEngine
         s_Data.RenderQueue.push_back(item);
     }
 
+    int32_t Renderer3D::SelectLod(const glm::mat4& transform,
+                                  const Ref<Mesh>& mesh, int entityID)
+    {
+        if (!s_Data.Lod.Enabled || s_Data.LodProjectionScale <= 0.0f || !mesh)
+            return 0;
+
+        // Meshes built by hand have no bounds to measure
+        glm::vec3 extent = mesh->GetBoundsMax() - mesh->GetBoundsMin();
+        float maxExtent = glm::max(glm::max(extent.x, extent.y), extent.z);
+        if (maxExtent <= 0.0f)
+            return 0;
+
+        float maxScale = glm::max(glm::max(glm::length(glm::vec3(transform[0])),
+                                           glm::length(glm::vec3(transform[1]))),
+                                  glm::length(glm::vec3(transform[2])));
+        glm::vec3 center = glm::vec3(
+            transform
+            * glm::vec4((mesh->GetBoundsMin() + mesh->GetBoundsMax()) * 0.5f, 1.0f));
+        float radius = glm::length(extent) * 0.5f * maxScale;
+        float distance = glm::length(center - s_Data.LodCameraPosition);
+        if (distance <= radius)
+            return 0;
+
+        float screenRadius = radius / distance * s_Data.LodProjectionScale;
+
+        uint8_t untracked = 0;
+        uint8_t& previous = entityID >= 0
+            ? s_Data.LodHistory[((uint64_t)(uint32_t)entityID << 32)
+                                ^ (uint64_t)std::hash<const Mesh*>()(mesh.get())]
+            : untracked;
+        float hysteresis = s_Data.Lod.Hysteresis;
+
+        // Sub-pixel objects come back only once they are clearly visible
+        bool wasCulled = previous == Renderer3DData::CulledLod;
+        if (screenRadius < s_Data.Lod.CullPixels * (wasCulled ? 1.0f + hysteresis : 1.0f))
+        {
+            previous = Renderer3DData::CulledLod;
+            return -1;
+        }
+
+        // Largest screen radius at which a level's error stays in budget
+        auto threshold = [&](uint32_t level) {
+            float error = mesh->GetLodError(level) * maxExtent * maxScale;
+            return error > 0.0f ? s_Data.Lod.ErrorPixels * radius / error : FLT_MAX;
+        };
+
+        uint32_t lodCount = mesh->GetLodCount();
+        uint32_t level = wasCulled ? lodCount - 1 : glm::min<uint32_t>(previous, lodCount - 1);
+        while (level > 0 && screenRadius > threshold(level))
+            level--;
+        while (level + 1 < lodCount
+               && screenRadius <= threshold(level + 1) * (1.0f - hysteresis))
+            level++;
+
+        previous = (uint8_t)level;
+        return (int32_t)level;
+    }
+
     void Renderer3D::DrawMesh(const glm::mat4& transform, Ref<Mesh> mesh,
                               const glm::vec4& color, int entityID)
     {
-        FENGINE_PROFILE_FUNCTION();
+        FENGINE_PROFILE_DETAIL_FUNCTION();
 
-        if (!PerformCulling(entityID, transform)) { return; }
+        if (!PerformCulling(entityID, transform, mesh.get())) { return; }
+
+        int32_t lod = SelectLod(transform, mesh, entityID);
+        if (lod < 0)
+        {
+            s_Data.Stats.LodCulledCount++;
+            return;
+        }
+        s_Data.Stats.LodCounts[glm::min<uint32_t>(
+            lod, Statistics::MaxLodStats - 1)]++;
 
         RenderItem item;
         item.Transform = transform;
-        item.MeshPtr = mesh;
+        item.MeshPtr = lod == 0 ? mesh : mesh->GetLodMesh(lod);
+        item.LodIndex = (uint32_t)lod;
         item.MaterialPtr = nullptr; // Use color directly
         item.Color = color;
         item.EntityID = entityID;
@@ -591,13 +1016,23 @@ namespace ForgeEngine
     void Renderer3D::DrawMesh(const glm::mat4& transform, Ref<Mesh> mesh,
                               Ref<Material> material, int entityID)
     {
-        FENGINE_PROFILE_FUNCTION();
+        FENGINE_PROFILE_DETAIL_FUNCTION();
 
-        if (!PerformCulling(entityID, transform)) { return; }
+        if (!PerformCulling(entityID, transform, mesh.get())) { return; }
+
+        int32_t lod = SelectLod(transform, mesh, entityID);
+        if (lod < 0)
+        {
+            s_Data.Stats.LodCulledCount++;
+            return;
+        }
+        s_Data.Stats.LodCounts[glm::min<uint32_t>(
+            lod, Statistics::MaxLodStats - 1)]++;
 
         RenderItem item;
         item.Transform = transform;
-        item.MeshPtr = mesh;
+        item.MeshPtr = lod == 0 ? mesh : mesh->GetLodMesh(lod);
+        item.LodIndex = (uint32_t)lod;
         item.MaterialPtr = material;
         item.Color = material ? material->GetAlbedoColor() : glm::vec4(1.0f);
         item.EntityID = entityID;
@@ -790,6 +1225,304 @@ namespace ForgeEngine
         }
     }
 
+    static glm::vec4 ComputeProxySphere(const Ref<Mesh>& mesh,
+                                        const glm::mat4& transform)
+    {
+        return glm::vec4(
+            glm::vec3(transform * glm::vec4(mesh->GetBoundingSphereCenter(), 1.0f)),
+            mesh->GetBoundingSphereRadius() * GetMaxScale(transform));
+    }
+
+    static glm::vec4 GetProxyColor(const Ref<Material>& material,
+                                   const glm::vec4& color)
+    {
+        return material ? material->GetAlbedoColor() * color : color;
+    }
+
+    // Null when the handle is stale or was never valid
+    static RenderProxySlot* ResolveProxy(Renderer3D::ProxyHandle handle)
+    {
+        if (handle.Index >= s_Data.Proxies.size()) return nullptr;
+
+        RenderProxySlot& proxy = s_Data.Proxies[handle.Index];
+        if (proxy.Batch == UINT32_MAX || proxy.Generation != handle.Generation)
+            return nullptr;
+        return &proxy;
+    }
+
+    Renderer3D::ProxyHandle Renderer3D::RegisterProxy(Ref<Mesh> mesh,
+                                                      Ref<Material> material,
+                                                      const glm::mat4& transform,
+                                                      uint32_t flags,
+                                                      const glm::vec4& color,
+                                                      int entityID)
+    {
+        if (!mesh)
+        {
+            FENGINE_CORE_ERROR("RegisterProxy: mesh is null!");
+            return {};
+        }
+
+        bool isStatic = (flags & ProxyFlagStatic) != 0;
+        std::string batchKey
+            = GetMeshKey(mesh, material) + (isStatic ? "_static" : "_dynamic");
+
+        auto it = s_Data.ProxyBatchLookup.find(batchKey);
+        uint32_t batchIndex;
+        if (it != s_Data.ProxyBatchLookup.end()) { batchIndex = it->second; }
+        else
+        {
+            batchIndex = (uint32_t)s_Data.ProxyBatches.size();
+            RenderProxyBatch& batch = s_Data.ProxyBatches.emplace_back();
+            batch.MeshPtr = mesh;
+            batch.MaterialPtr = material;
+            batch.Static = isStatic;
+            s_Data.ProxyBatchLookup[batchKey] = batchIndex;
+        }
+
+        uint32_t proxyIndex;
+        if (!s_Data.FreeProxies.empty())
+        {
+            proxyIndex = s_Data.FreeProxies.back();
+            s_Data.FreeProxies.pop_back();
+        }
+        else
+        {
+            proxyIndex = (uint32_t)s_Data.Proxies.size();
+            s_Data.Proxies.emplace_back();
+        }
+
+        RenderProxyBatch& batch = s_Data.ProxyBatches[batchIndex];
+        uint32_t slot = (uint32_t)batch.Instances.size();
+
+        OptimizedInstanceData& instance = batch.Instances.emplace_back();
+        instance.SetTransform(transform);
+        instance.SetColor(GetProxyColor(material, color));
+        instance.SetSurface(material ? material->GetMetallic() : 0.0f,
+                            material ? material->GetRoughness() : 0.5f);
+        instance.SetIDs(entityID);
+        batch.Spheres.push_back(ComputeProxySphere(mesh, transform));
+        batch.SlotProxies.push_back(proxyIndex);
+        batch.MarkDirty(slot);
+
+        RenderProxySlot& proxy = s_Data.Proxies[proxyIndex];
+        proxy.Batch = batchIndex;
+        proxy.Slot = slot;
+        s_Data.ProxyCount++;
+
+        return {proxyIndex, proxy.Generation};
+    }
+
+    void Renderer3D::UpdateProxyTransform(ProxyHandle handle,
+                                          const glm::mat4& transform)
+    {
+        RenderProxySlot* proxy = ResolveProxy(handle);
+        if (!proxy) return;
+
+        RenderProxyBatch& batch = s_Data.ProxyBatches[proxy->Batch];
+        batch.Instances[proxy->Slot].SetTransform(transform);
+        batch.Spheres[proxy->Slot] = ComputeProxySphere(batch.MeshPtr, transform);
+        batch.MarkDirty(proxy->Slot);
+    }
+
+    void Renderer3D::SetProxyColor(ProxyHandle handle, const glm::vec4& color)
+    {
+        RenderProxySlot* proxy = ResolveProxy(handle);
+        if (!proxy) return;
+
+        RenderProxyBatch& batch = s_Data.ProxyBatches[proxy->Batch];
+        batch.Instances[proxy->Slot].SetColor(GetProxyColor(batch.MaterialPtr, color));
+        batch.MarkDirty(proxy->Slot);
+    }
+
+    void Renderer3D::RemoveProxy(ProxyHandle handle)
+    {
+        RenderProxySlot* proxy = ResolveProxy(handle);
+        if (!proxy) return;
+
+        RenderProxyBatch& batch = s_Data.ProxyBatches[proxy->Batch];
+        uint32_t slot = proxy->Slot;
+        uint32_t last = (uint32_t)batch.Instances.size() - 1;
+
+        if (slot != last)
+        {
+            batch.Instances[slot] = batch.Instances[last];
+            batch.Spheres[slot] = batch.Spheres[last];
+            batch.SlotProxies[slot] = batch.SlotProxies[last];
+            s_Data.Proxies[batch.SlotProxies[slot]].Slot = slot;
+            batch.MarkDirty(slot);
+        }
+
+        batch.Instances.pop_back();
+        batch.Spheres.pop_back();
+        batch.SlotProxies.pop_back();
+
+        proxy->Batch = UINT32_MAX;
+        proxy->Generation++;
+        s_Data.FreeProxies.push_back(handle.Index);
+        s_Data.ProxyCount--;
+    }
+
+    bool Renderer3D::IsProxyAlive(ProxyHandle handle)
+    {
+        return ResolveProxy(handle) != nullptr;
+    }
+
+    uint32_t Renderer3D::GetProxyCount() { return s_Data.ProxyCount; }
+
+    void Renderer3D::ProxyHandle::UpdateTransform(const glm::mat4& transform) const
+    {
+        Renderer3D::UpdateProxyTransform(*this, transform);
+    }
+
+    void Renderer3D::ProxyHandle::SetColor(const glm::vec4& color) const
+    {
+        Renderer3D::SetProxyColor(*this, color);
+    }
+
+    void Renderer3D::ProxyHandle::Remove()
+    {
+        Renderer3D::RemoveProxy(*this);
+        *this = {};
+    }
+
+    StaticMeshHandle Renderer3D::AddStaticMesh(Ref<Mesh> mesh, Ref<Material> material,
+                                               const glm::mat4& transform)
+    {
+        return s_Data.StaticBatches->Add(mesh, material, transform);
+    }
+
+    void Renderer3D::RemoveStaticMesh(StaticMeshHandle handle)
+    {
+        if (s_Data.StaticBatches) s_Data.StaticBatches->Remove(handle);
+    }
+
+    bool Renderer3D::IsStaticMeshAlive(StaticMeshHandle handle)
+    {
+        return s_Data.StaticBatches && s_Data.StaticBatches->IsAlive(handle);
+    }
+
+    void Renderer3D::SetStaticBatchCellSize(float cellSize)
+    {
+        s_Data.StaticBatches->SetCellSize(cellSize);
+    }
+
+    void Renderer3D::RenderStaticBatches()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (!s_Data.StaticBatches || !s_Data.InstanceRenderer) return;
+
+        s_Data.StaticBatches->Update(*s_Data.InstanceRenderer);
+        s_Data.StaticBatches->Render(*s_Data.InstanceRenderer, s_Data.ActiveCamera);
+
+        const StaticBatchStats& stats = s_Data.StaticBatches->GetStats();
+        s_Data.Stats.StaticObjectCount = stats.Objects;
+        s_Data.Stats.StaticBatchCount = stats.Batches;
+        s_Data.Stats.VisibleStaticBatches += stats.VisibleBatches;
+        s_Data.Stats.StaticDrawCallsSaved += stats.DrawCallsSaved;
+        s_Data.Stats.RebuiltStaticBatches += stats.RebuiltBatches;
+    }
+
+    void Renderer3D::RenderProxies()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (!s_Data.InstanceRenderer) return;
+
+        for (RenderProxyBatch& batch : s_Data.ProxyBatches)
+        {
+            uint32_t count = (uint32_t)batch.Instances.size();
+            if (count == 0) continue;
+
+            // Growing reallocates the GPU buffer, everything goes up again
+            if (count > batch.Capacity)
+            {
+                batch.Capacity = std::max({count, batch.Capacity * 2, 64u});
+                batch.InstanceBuffer = VertexBuffer::Create(
+                    batch.Capacity * (uint32_t)sizeof(OptimizedInstanceData));
+                batch.InstanceBuffer->SetLayout(
+                    InstancedRenderer::GetInstanceLayout());
+                batch.InstancedVertexArray
+                    = s_Data.InstanceRenderer->CreateInstancedVAO(
+                        batch.MeshPtr, batch.InstanceBuffer);
+                batch.DirtyBegin = 0;
+                batch.DirtyEnd = count;
+            }
+
+            // Removals can leave the range past the end of the batch
+            uint32_t dirtyEnd = std::min(batch.DirtyEnd, count);
+            if (batch.DirtyBegin < dirtyEnd)
+            {
+                uint32_t stride = (uint32_t)sizeof(OptimizedInstanceData);
+                uint32_t bytes = (dirtyEnd - batch.DirtyBegin) * stride;
+                batch.InstanceBuffer->SetData(&batch.Instances[batch.DirtyBegin],
+                                              bytes, batch.DirtyBegin * stride);
+                s_Data.Stats.ProxyUploadBytes += bytes;
+            }
+            batch.DirtyBegin = UINT32_MAX;
+            batch.DirtyEnd = 0;
+
+            if (!batch.InstancedVertexArray) continue;
+
+            // Frustum test per slot on the workers
+            s_Data.ProxyVisibility.resize(count);
+            if (s_Data.ActiveCamera)
+            {
+                JobSystem::ParallelFor(
+                    count, 1024, [&batch](uint32_t begin, uint32_t end) {
+                        for (uint32_t i = begin; i < end; i++)
+                        {
+                            const glm::vec4& sphere = batch.Spheres[i];
+                            s_Data.ProxyVisibility[i]
+                                = s_Data.ActiveCamera->SphereInFrustum(
+                                    glm::vec3(sphere), sphere.w);
+                        }
+                    });
+            }
+            else
+            {
+                std::fill(s_Data.ProxyVisibility.begin(),
+                          s_Data.ProxyVisibility.end(), (uint8_t)1);
+            }
+
+            // Visible runs, short culled gaps are drawn through
+            s_Data.ProxyRangeFirst.clear();
+            s_Data.ProxyRangeCount.clear();
+            uint32_t visible = 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (!s_Data.ProxyVisibility[i]) continue;
+
+                visible++;
+                if (!s_Data.ProxyRangeFirst.empty())
+                {
+                    uint32_t runEnd = s_Data.ProxyRangeFirst.back()
+                        + s_Data.ProxyRangeCount.back();
+                    if (i - runEnd <= Renderer3DData::ProxyRunGap)
+                    {
+                        s_Data.ProxyRangeCount.back() = i + 1
+                            - s_Data.ProxyRangeFirst.back();
+                        continue;
+                    }
+                }
+                s_Data.ProxyRangeFirst.push_back(i);
+                s_Data.ProxyRangeCount.push_back(1);
+            }
+
+            s_Data.Stats.ProxyCount += count;
+            s_Data.Stats.VisibleProxyCount += visible;
+            if (visible == 0) continue;
+
+            uint32_t rangeCount = (uint32_t)s_Data.ProxyRangeFirst.size();
+            s_Data.InstanceRenderer->DrawInstanceRanges(
+                batch.InstancedVertexArray, batch.MeshPtr, batch.MaterialPtr,
+                s_Data.ProxyRangeFirst.data(), s_Data.ProxyRangeCount.data(),
+                rangeCount);
+            s_Data.Stats.ProxyDrawCalls += rangeCount;
+        }
+    }
+
     void Renderer3D::Flush()
     {
         FENGINE_PROFILE_FUNCTION();
@@ -818,14 +1551,44 @@ namespace ForgeEngine
 
     void Renderer3D::PreparePrimitives()
     {
-        s_Data.CubeMesh = Mesh::CreateCube();
-        s_Data.SphereMesh = Mesh::CreateSphere();
+        s_Data.CubeMesh = PrimitiveCache::GetCube();
+        s_Data.SphereMesh = PrimitiveCache::GetSphere();
+    }
+
+    void Renderer3D::EnableClusterCulling(bool enable)
+    {
+        s_Data.ClusterCullingEnabled = enable;
+    }
+
+    bool Renderer3D::IsClusterCullingEnabled()
+    {
+        return s_Data.ClusterCullingEnabled;
+    }
+
+    void Renderer3D::SetCullingVolume(CullingVolume volume)
+    {
+        s_Data.Culling = volume;
+    }
+
+    Renderer3D::CullingVolume Renderer3D::GetCullingVolume()
+    {
+        return s_Data.Culling;
+    }
+
+    void Renderer3D::SetLodSettings(const LodSettings& settings)
+    {
+        s_Data.Lod = settings;
+    }
+
+    const Renderer3D::LodSettings& Renderer3D::GetLodSettings()
+    {
+        return s_Data.Lod;
     }
 
     void Renderer3D::SetInstancingThreshold(uint32_t threshold)
     {
         s_Data.InstancingThreshold = threshold;
-        FENGINE_CORE_INFO("Instancing threshold set to: {}", threshold);
+        FENGINE_CORE_DEBUG("Instancing threshold set to: {}", threshold);
     }
 
     uint32_t Renderer3D::GetInstancingThreshold()
@@ -836,7 +1599,7 @@ namespace ForgeEngine
     void Renderer3D::EnableAutoInstancing(bool enable)
     {
         s_Data.AutoInstancingEnabled = enable;
-        FENGINE_CORE_INFO("Auto instancing {}",
+        FENGINE_CORE_DEBUG("Auto instancing {}",
                           enable ? "enabled" : "disabled");
     }
 
@@ -876,14 +1639,7 @@ namespace ForgeEngine
                                      float boundingSphereRadius)
     {
         glm::vec3 position(transform[3][0], transform[3][1], transform[3][2]);
-
-        glm::vec3 scale;
-        scale.x = glm::length(glm::vec3(transform[0]));
-        scale.y = glm::length(glm::vec3(transform[1]));
-        scale.z = glm::length(glm::vec3(transform[2]));
-
-        float maxScale = glm::max(glm::max(scale.x, scale.y), scale.z);
-        float adjustedRadius = boundingSphereRadius * maxScale;
+        float adjustedRadius = boundingSphereRadius * GetMaxScale(transform);
 
         return IsSphereVisible(position, adjustedRadius);
     }
@@ -914,6 +1670,7 @@ namespace ForgeEngine
         s_Data.LastFrameStats = s_Data.Stats;
 
         memset(&s_Data.Stats, 0, sizeof(s_Data.Stats));
+        VertexArray::ResetStats();
     }
 
     Renderer3D::Statistics Renderer3D::GetStats()
@@ -1008,15 +1765,13 @@ namespace ForgeEngine
 
     void Renderer3D::RecalculateEntityBounds(int entityID)
     {
-        auto it = s_Data.EntityCullingInfo.find(entityID);
-        if (it != s_Data.EntityCullingInfo.end())
-        {
-            it->second.BoundingSphereRadius = 0.0f;
-        }
+        // Bounds are recomputed on every test, only the cached copy goes
+        s_Data.EntityCullingInfo.erase(entityID);
     }
 
     void Renderer3D::ClearCullingData()
     {
         s_Data.EntityCullingInfo.clear();
+        s_Data.LodHistory.clear();
     }
 } // namespace ForgeEngine
@@ -5,6 +5,7 @@
 #include "Core/Camera/Camera3DController.h"
 #include "Core/Renderer/Material.h"
 #include "Core/Renderer/Mesh.h"
+#include "Core/Renderer/StaticBatcher.h"
 #include "Core/Renderer/Texture.h"
 #include "Core/Scene/Components.h"
 #include "glad/glad.h"
@@ -14,6 +15,8 @@ namespace ForgeEngine
 {
     // Forward declaration do InstancedRenderer existente
     class InstancedRenderer;
+    // Index ranges of a meshlet mesh that survived cluster culling
+    struct MeshClusterDraw;
 
     class EarlyDepthTestManager
     {
@@ -160,6 +163,93 @@ namespace ForgeEngine
             uint32_t IndividualObjects = 0;
             float InstancingEfficiency
                 = 0.0f; // Porcentagem de redução de draw calls
+
+            // Objects submitted at each LOD, deeper levels share the last
+            // slot; sub-pixel objects are counted as LOD culled instead
+            static constexpr uint32_t MaxLodStats = 4;
+            uint32_t LodCounts[MaxLodStats] = {};
+            uint32_t LodCulledCount = 0;
+
+            // Per-cluster culling of meshlet meshes drawn individually.
+            // ClusterDrawRanges is what reached the GPU after adjacent
+            // surviving clusters were merged.
+            uint32_t ClusterCount = 0;
+            uint32_t CulledClusterCount = 0;
+            uint32_t CulledClusterTriangles = 0;
+            uint32_t ClusterDrawRanges = 0;
+
+            // Retained proxies. ProxyUploadBytes is the instance data
+            // patched this frame, zero when nothing moved.
+            uint32_t ProxyCount = 0;
+            uint32_t VisibleProxyCount = 0;
+            uint32_t ProxyDrawCalls = 0;
+            uint32_t ProxyUploadBytes = 0;
+
+            // Static batching. DrawCallsSaved counts the visible merged
+            // objects beyond the first of each batch.
+            uint32_t StaticObjectCount = 0;
+            uint32_t StaticBatchCount = 0;
+            uint32_t VisibleStaticBatches = 0;
+            uint32_t StaticDrawCallsSaved = 0;
+            uint32_t RebuiltStaticBatches = 0;
+
+            // Objects the old unit cube sphere guess would have drawn that
+            // the mesh's own bounds culled, and of those the ones that
+            // passed the tight sphere and only failed the box test
+            uint32_t BoundsFalsePositivesRemoved = 0;
+            uint32_t BoxCulledCount = 0;
+
+            // Vertex array objects bound and buffers attached to them, and
+            // the shared per-format objects alive
+            uint32_t VertexArrayBinds = 0;
+            uint32_t VertexBufferBindings = 0;
+            uint32_t VertexFormats = 0;
+        };
+
+        // Volume tested against the frustum after the bounding sphere.
+        // AABB tests the world box around the transformed local box, OBB
+        // the transformed box itself: tighter under rotation, a bit slower.
+        enum class CullingVolume : uint8_t
+        {
+            Sphere = 0,
+            AABB,
+            OBB
+        };
+
+        enum RenderProxyFlags : uint32_t
+        {
+            ProxyFlagNone = 0,
+            // Rarely moves. Static proxies get their own batches so updates
+            // to dynamic ones never dirty them.
+            ProxyFlagStatic = BIT(0)
+        };
+
+        // Refers to a retained proxy. Handles of removed proxies stay
+        // harmless: every call on them is ignored.
+        struct ProxyHandle
+        {
+            uint32_t Index = UINT32_MAX;
+            uint32_t Generation = 0;
+
+            bool IsValid() const { return Index != UINT32_MAX; }
+            void UpdateTransform(const glm::mat4& transform) const;
+            void SetColor(const glm::vec4& color) const;
+            // Removes the proxy and resets this handle
+            void Remove();
+        };
+
+        // Screen space LOD selection. A level is used while its simplification
+        // error projects to at most ErrorPixels; moving to a coarser level
+        // needs a Hysteresis fraction of margin so objects near a threshold
+        // do not pop back and forth.
+        struct LodSettings
+        {
+            bool Enabled = true;
+            float ErrorPixels = 1.0f;
+            float Hysteresis = 0.1f;
+            // Objects whose bounding sphere covers less than this radius in
+            // pixels are not drawn at all
+            float CullPixels = 0.5f;
         };
 
         struct RenderItem
@@ -169,6 +259,8 @@ namespace ForgeEngine
             Ref<Material> MaterialPtr;
             glm::vec4 Color;
             int EntityID;
+            // MeshPtr already points at this level's mesh
+            uint32_t LodIndex = 0;
 
             // Para compatibilidade com diferentes tipos de renderização
             enum class Type { Mesh, Cube, Sphere } ItemType = Type::Mesh;
@@ -232,12 +324,50 @@ namespace ForgeEngine
         static void DrawModel(const glm::mat4& transform,
                               ModelRendererComponent& src, int entityID = -1);
 
+        // Retained mode. A proxy is drawn every scene until it is removed;
+        // its instance data lives in a GPU buffer per (mesh, material) that
+        // is only patched where proxies changed, so one that does not move
+        // costs a frustum test per frame. The Draw* calls above stay
+        // available for debug and per-frame geometry.
+        static ProxyHandle RegisterProxy(Ref<Mesh> mesh, Ref<Material> material,
+                                         const glm::mat4& transform,
+                                         uint32_t flags = ProxyFlagNone,
+                                         const glm::vec4& color = glm::vec4(1.0f),
+                                         int entityID = -1);
+        static void UpdateProxyTransform(ProxyHandle handle,
+                                         const glm::mat4& transform);
+        static void SetProxyColor(ProxyHandle handle, const glm::vec4& color);
+        static void RemoveProxy(ProxyHandle handle);
+        static bool IsProxyAlive(ProxyHandle handle);
+        static uint32_t GetProxyCount();
+
+        // Static batching. The mesh is transformed into world space and
+        // merged with every other static mesh of the same material in its
+        // grid cell; adding or removing one rebuilds that cell at the next
+        // EndScene. Meant for scenery that never moves and only needs the
+        // material's color. See StaticBatcher.
+        static StaticMeshHandle AddStaticMesh(Ref<Mesh> mesh, Ref<Material> material,
+                                              const glm::mat4& transform);
+        static void RemoveStaticMesh(StaticMeshHandle handle);
+        static bool IsStaticMeshAlive(StaticMeshHandle handle);
+        static void SetStaticBatchCellSize(float cellSize);
+
         static void SetPointLightPosition(const glm::vec3& position);
         static void SetAmbientLight(const glm::vec3& color, float intensity);
 
         static void EnableWireframe(bool enable);
         static bool IsWireframeEnabled();
 
+        // Frustum and backface cone culling of meshlets, on by default
+        static void EnableClusterCulling(bool enable);
+        static bool IsClusterCullingEnabled();
+
+        static void SetCullingVolume(CullingVolume volume);
+        static CullingVolume GetCullingVolume();
+
+        static void SetLodSettings(const LodSettings& settings);
+        static const LodSettings& GetLodSettings();
+
         static void SetInstancingThreshold(uint32_t threshold);
         static uint32_t GetInstancingThreshold();
         static void EnableAutoInstancing(bool enable);
@@ -266,9 +396,19 @@ namespace ForgeEngine
 
     private:
         static void SubmitRenderItem(const RenderItem& item);
+        // Level to draw mesh at, or -1 when it is below the cull size
+        static int32_t SelectLod(const glm::mat4& transform,
+                                 const Ref<Mesh>& mesh, int entityID);
         static void ProcessBatches();
+        // Uploads dirty instance ranges, culls and draws every proxy batch
+        static void RenderProxies();
+        static void RenderStaticBatches();
         static void RenderInstancedBatch(const std::vector<RenderItem>& items);
-        static void RenderIndividualItem(const RenderItem& item);
+        static void RenderIndividualItem(const RenderItem& item,
+                                         const MeshClusterDraw* clusters = nullptr);
+        // Culls the meshlets of every individually drawn item on the
+        // JobSystem workers and fills one MeshClusterDraw per item
+        static void CullClusters();
 
         // Helpers para agrupamento
         static bool ShouldUseInstancing(const std::vector<RenderItem>& items);
@@ -276,10 +416,11 @@ namespace ForgeEngine
 
         // Função helper para culling centralizado (mantida)
         friend bool PerformCulling(int entityID, const glm::mat4& transform,
-                                   float* outBoundingRadius);
+                                   const Mesh* mesh, float* outBoundingRadius);
 
         // Função interna de renderização (modificada para usar o novo sistema)
         friend void DrawMeshInternal(const glm::mat4& transform, Ref<Mesh> mesh,
-                                     Ref<Material> material, int entityID);
+                                     Ref<Material> material, int entityID,
+                                     const MeshClusterDraw* clusters);
     };
 } // namespace ForgeEngine
@@ -19,7 +19,22 @@ namespace ForgeEngine
     virtual void SetClearColor(const glm::vec4& color) = 0;
     virtual void Clear() = 0;
 
-    virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+    // The index type comes from the vertex array's index buffer
+    virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0,
+                             PrimitiveTopology topology = PrimitiveTopology::Triangles) = 0;
+    virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount,
+                                      uint32_t instanceCount,
+                                      PrimitiveTopology topology = PrimitiveTopology::Triangles) = 0;
+    // Instance attributes start at baseInstance instead of 0
+    virtual void DrawIndexedInstancedBaseInstance(const Ref<VertexArray>& vertexArray,
+                                                  uint32_t indexCount, uint32_t instanceCount,
+                                                  uint32_t baseInstance,
+                                                  PrimitiveTopology topology = PrimitiveTopology::Triangles) = 0;
+    // One submission for several index ranges of the same vertex array,
+    // firstIndices are in indices, not bytes
+    virtual void MultiDrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t* counts,
+                                  const uint32_t* firstIndices, uint32_t drawCount,
+                                  PrimitiveTopology topology = PrimitiveTopology::Triangles) = 0;
     virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) = 0;
 
     virtual void SetLineWidth(float width) = 0;
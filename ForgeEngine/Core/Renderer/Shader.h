@@ -21,6 +21,7 @@ class Shader {
   virtual void SetFloat2(const std::string& name, const glm::vec2& value) = 0;
   virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
   virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
+  virtual void SetMat3(const std::string& name, const glm::mat3& value) = 0;
   virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 
   virtual const std::string& GetName() const = 0;
@@ -0,0 +1,295 @@
+#include "Core/Renderer/StaticBatcher.h"
+#include "Core/Camera/Camera3D.h"
+#include "Core/Renderer/InstancedRenderer.h"
+#include "Core/Threading/JobSystem.h"
+#include <algorithm>
+#include <functional>
+
+namespace ForgeEngine
+{
+    size_t StaticBatcher::CellKeyHash::operator()(const CellKey& key) const
+    {
+        size_t hash = std::hash<const Material*>()(key.MaterialPtr);
+        for (int i = 0; i < 3; i++)
+        {
+            hash ^= std::hash<int>()(key.Coord[i]) + 0x9e3779b9 + (hash << 6)
+                + (hash >> 2);
+        }
+        return hash;
+    }
+
+    StaticBatcher::StaticBatcher(float cellSize)
+        : m_CellSize(cellSize)
+    {
+        FENGINE_CORE_ASSERT(cellSize > 0.0f, "Static batch cells need a positive size");
+    }
+
+    StaticMeshHandle StaticBatcher::Add(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                        const glm::mat4& transform)
+    {
+        if (!mesh || !mesh->GetSourceGeometry())
+        {
+            FENGINE_CORE_ERROR("StaticBatcher: mesh has no source geometry to merge!");
+            return {};
+        }
+        if (mesh->GetTopology() != PrimitiveTopology::Triangles)
+        {
+            FENGINE_CORE_ERROR("StaticBatcher: only triangle lists can be merged!");
+            return {};
+        }
+
+        uint32_t objectIndex;
+        if (!m_FreeObjects.empty())
+        {
+            objectIndex = m_FreeObjects.back();
+            m_FreeObjects.pop_back();
+        }
+        else
+        {
+            objectIndex = (uint32_t)m_Objects.size();
+            m_Objects.emplace_back();
+        }
+
+        Object& object = m_Objects[objectIndex];
+        object.MeshPtr = mesh;
+        object.MaterialPtr = material;
+        object.Transform = transform;
+        Insert(objectIndex);
+        m_ObjectCount++;
+
+        return {objectIndex, object.Generation};
+    }
+
+    void StaticBatcher::Remove(StaticMeshHandle handle)
+    {
+        Object* object = Resolve(handle);
+        if (!object) return;
+
+        Detach(handle.Index);
+        object->MeshPtr.reset();
+        object->MaterialPtr.reset();
+        object->Generation++;
+        m_FreeObjects.push_back(handle.Index);
+        m_ObjectCount--;
+    }
+
+    bool StaticBatcher::IsAlive(StaticMeshHandle handle) const
+    {
+        return const_cast<StaticBatcher*>(this)->Resolve(handle) != nullptr;
+    }
+
+    void StaticBatcher::Clear()
+    {
+        // Bump generations so outstanding handles stop resolving
+        for (uint32_t i = 0; i < (uint32_t)m_Objects.size(); i++)
+        {
+            if (m_Objects[i].CellIndex == UINT32_MAX) continue;
+            Object reset;
+            reset.Generation = m_Objects[i].Generation + 1;
+            m_Objects[i] = reset;
+            m_FreeObjects.push_back(i);
+        }
+
+        m_Cells.clear();
+        m_CellLookup.clear();
+        m_DirtyCells.clear();
+        m_ObjectCount = 0;
+    }
+
+    void StaticBatcher::SetCellSize(float cellSize)
+    {
+        FENGINE_CORE_ASSERT(cellSize > 0.0f, "Static batch cells need a positive size");
+        if (cellSize == m_CellSize) return;
+
+        m_CellSize = cellSize;
+        m_Cells.clear();
+        m_CellLookup.clear();
+        m_DirtyCells.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_Objects.size(); i++)
+        {
+            if (m_Objects[i].CellIndex != UINT32_MAX) Insert(i);
+        }
+    }
+
+    StaticBatcher::Object* StaticBatcher::Resolve(StaticMeshHandle handle)
+    {
+        if (handle.Index >= m_Objects.size()) return nullptr;
+
+        Object& object = m_Objects[handle.Index];
+        if (object.CellIndex == UINT32_MAX || object.Generation != handle.Generation)
+            return nullptr;
+        return &object;
+    }
+
+    void StaticBatcher::Insert(uint32_t objectIndex)
+    {
+        Object& object = m_Objects[objectIndex];
+
+        // Bucketed by the world position of the bounds center, objects larger
+        // than a cell simply grow their cell's bounds
+        glm::vec3 center = (object.MeshPtr->GetBoundsMin() + object.MeshPtr->GetBoundsMax()) * 0.5f;
+        glm::vec3 world = glm::vec3(object.Transform * glm::vec4(center, 1.0f));
+        CellKey key = {object.MaterialPtr.get(), glm::ivec3(glm::floor(world / m_CellSize))};
+
+        auto it = m_CellLookup.find(key);
+        uint32_t cellIndex;
+        if (it != m_CellLookup.end()) { cellIndex = it->second; }
+        else
+        {
+            cellIndex = (uint32_t)m_Cells.size();
+            m_Cells.emplace_back().MaterialPtr = object.MaterialPtr;
+            m_CellLookup[key] = cellIndex;
+        }
+
+        Cell& cell = m_Cells[cellIndex];
+        object.CellIndex = cellIndex;
+        object.Position = (uint32_t)cell.Objects.size();
+        cell.Objects.push_back(objectIndex);
+
+        if (!cell.Dirty)
+        {
+            cell.Dirty = true;
+            m_DirtyCells.push_back(cellIndex);
+        }
+    }
+
+    void StaticBatcher::Detach(uint32_t objectIndex)
+    {
+        Object& object = m_Objects[objectIndex];
+        Cell& cell = m_Cells[object.CellIndex];
+
+        uint32_t last = cell.Objects.back();
+        cell.Objects[object.Position] = last;
+        m_Objects[last].Position = object.Position;
+        cell.Objects.pop_back();
+
+        if (!cell.Dirty)
+        {
+            cell.Dirty = true;
+            m_DirtyCells.push_back(object.CellIndex);
+        }
+        object.CellIndex = UINT32_MAX;
+    }
+
+    void StaticBatcher::MergeCell(const Cell& cell, const std::vector<Object>& objects,
+                                  MeshGeometry& merged)
+    {
+        merged.Vertices.clear();
+        merged.Indices.clear();
+
+        for (uint32_t objectIndex : cell.Objects)
+        {
+            const Object& object = objects[objectIndex];
+            const MeshGeometry& source = *object.MeshPtr->GetSourceGeometry();
+
+            glm::mat3 linear = glm::mat3(object.Transform);
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+            // A mirroring transform turns the triangles inside out
+            bool flip = glm::determinant(linear) < 0.0f;
+
+            uint32_t base = (uint32_t)merged.Vertices.size();
+            for (const StandardVertex& vertex : source.Vertices)
+            {
+                StandardVertex& out = merged.Vertices.emplace_back();
+                out.Position = glm::vec3(object.Transform * glm::vec4(vertex.Position, 1.0f));
+                out.Normal = glm::normalize(normalMatrix * vertex.Normal);
+                out.Tangent = glm::normalize(linear * vertex.Tangent);
+                out.TexCoord = vertex.TexCoord;
+            }
+
+            for (size_t i = 0; i + 2 < source.Indices.size(); i += 3)
+            {
+                merged.Indices.push_back(base + source.Indices[i]);
+                merged.Indices.push_back(base + source.Indices[i + (flip ? 2 : 1)]);
+                merged.Indices.push_back(base + source.Indices[i + (flip ? 1 : 2)]);
+            }
+        }
+    }
+
+    void StaticBatcher::Update(InstancedRenderer& renderer)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        m_Stats.RebuiltBatches = 0;
+        m_Stats.RebuiltVertices = 0;
+        if (m_DirtyCells.empty()) return;
+
+        // Transforming vertices is the bulk of a rebuild and cells do not
+        // share anything, so they merge in parallel
+        uint32_t dirtyCount = (uint32_t)m_DirtyCells.size();
+        if (m_MergeScratch.size() < dirtyCount) m_MergeScratch.resize(dirtyCount);
+
+        JobSystem::ParallelFor(dirtyCount, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                MergeCell(m_Cells[m_DirtyCells[i]], m_Objects, m_MergeScratch[i]);
+            }
+        });
+
+        for (uint32_t i = 0; i < dirtyCount; i++)
+        {
+            Cell& cell = m_Cells[m_DirtyCells[i]];
+            MeshGeometry& merged = m_MergeScratch[i];
+            cell.Dirty = false;
+
+            if (merged.Indices.empty())
+            {
+                cell.Merged.reset();
+                cell.InstancedVertexArray.reset();
+                continue;
+            }
+
+            cell.Merged = CreateRef<Mesh>();
+            cell.Merged->SetQuantizedVertices(merged.Vertices.data(),
+                                              (uint32_t)merged.Vertices.size());
+            cell.Merged->SetIndices(merged.Indices);
+
+            if (!cell.InstanceBuffer)
+            {
+                const Ref<Material>& material = cell.MaterialPtr;
+                OptimizedInstanceData instance;
+                instance.SetTransform(glm::mat4(1.0f));
+                instance.SetColor(material ? material->GetAlbedoColor() : glm::vec4(1.0f));
+                instance.SetSurface(material ? material->GetMetallic() : 0.0f,
+                                    material ? material->GetRoughness() : 0.5f);
+                instance.SetIDs(-1);
+
+                cell.InstanceBuffer = VertexBuffer::Create(&instance, sizeof(instance));
+                cell.InstanceBuffer->SetLayout(InstancedRenderer::GetInstanceLayout());
+            }
+            cell.InstancedVertexArray = renderer.CreateInstancedVAO(cell.Merged, cell.InstanceBuffer);
+
+            m_Stats.RebuiltBatches++;
+            m_Stats.RebuiltVertices += (uint32_t)merged.Vertices.size();
+        }
+        m_DirtyCells.clear();
+    }
+
+    void StaticBatcher::Render(InstancedRenderer& renderer, const Camera3D* camera)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        m_Stats.Objects = m_ObjectCount;
+        m_Stats.Batches = 0;
+        m_Stats.VisibleBatches = 0;
+        m_Stats.DrawCallsSaved = 0;
+
+        const uint32_t firstInstance = 0;
+        const uint32_t instanceCount = 1;
+        for (const Cell& cell : m_Cells)
+        {
+            if (!cell.InstancedVertexArray) continue;
+            m_Stats.Batches++;
+
+            if (camera
+                && !camera->AABBInFrustum(cell.Merged->GetBoundsMin(),
+                                          cell.Merged->GetBoundsMax()))
+                continue;
+
+            renderer.DrawInstanceRanges(cell.InstancedVertexArray, cell.Merged, cell.MaterialPtr,
+                                        &firstInstance, &instanceCount, 1);
+            m_Stats.VisibleBatches++;
+            m_Stats.DrawCallsSaved += (uint32_t)cell.Objects.size() - 1;
+        }
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/Renderer/Material.h"
+#include "Core/Renderer/Mesh.h"
+#include <glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ForgeEngine
+{
+    class Camera3D;
+    class InstancedRenderer;
+
+    // Refers to an object merged by a StaticBatcher. Handles of removed
+    // objects stay harmless, every call on them is ignored.
+    struct StaticMeshHandle
+    {
+        uint32_t Index = UINT32_MAX;
+        uint32_t Generation = 0;
+
+        bool IsValid() const { return Index != UINT32_MAX; }
+    };
+
+    struct StaticBatchStats
+    {
+        uint32_t Objects = 0;
+        uint32_t Batches = 0;       // non empty cells
+        uint32_t VisibleBatches = 0;
+        // Draw calls the visible objects would have needed one by one,
+        // minus the merged draws actually issued
+        uint32_t DrawCallsSaved = 0;
+        uint32_t RebuiltBatches = 0; // this frame
+        uint32_t RebuiltVertices = 0;
+    };
+
+    // Merges static geometry that shares a material into one mesh per cell
+    // of a uniform world grid. Vertices are transformed to world space once,
+    // so a whole cell costs one AABB test and one draw call no matter how
+    // many different meshes it holds. Adding or removing an object only
+    // rebuilds the cell it lands in, on the next Update.
+    //
+    // Meshes must be triangle lists that kept their source geometry (see
+    // Mesh::GetSourceGeometry). Color and entity ID come from the material,
+    // merged objects cannot be picked one by one.
+    class StaticBatcher
+    {
+    public:
+        explicit StaticBatcher(float cellSize = 32.0f);
+
+        StaticMeshHandle Add(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                             const glm::mat4& transform);
+        void Remove(StaticMeshHandle handle);
+        bool IsAlive(StaticMeshHandle handle) const;
+        void Clear();
+
+        // Larger cells merge more draws but cull coarser and rebuild more
+        // vertices per change. Re-buckets everything.
+        void SetCellSize(float cellSize);
+        float GetCellSize() const { return m_CellSize; }
+
+        // Rebuilds the cells changed since the last call, merging on the
+        // JobSystem and uploading on the calling thread
+        void Update(InstancedRenderer& renderer);
+        // Draws the cells whose bounds intersect the camera frustum, all of
+        // them without a camera
+        void Render(InstancedRenderer& renderer, const Camera3D* camera);
+
+        const StaticBatchStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct CellKey
+        {
+            const Material* MaterialPtr;
+            glm::ivec3 Coord;
+
+            bool operator==(const CellKey& other) const
+            {
+                return MaterialPtr == other.MaterialPtr && Coord == other.Coord;
+            }
+        };
+
+        struct CellKeyHash
+        {
+            size_t operator()(const CellKey& key) const;
+        };
+
+        struct Cell
+        {
+            Ref<Material> MaterialPtr;
+            std::vector<uint32_t> Objects;
+            bool Dirty = false;
+
+            Ref<Mesh> Merged;
+            Ref<VertexBuffer> InstanceBuffer; // a single identity instance
+            Ref<VertexArray> InstancedVertexArray;
+        };
+
+        struct Object
+        {
+            uint32_t Generation = 0;
+            uint32_t CellIndex = UINT32_MAX; // UINT32_MAX while free
+            uint32_t Position = 0;           // in Cell::Objects
+            Ref<Mesh> MeshPtr;
+            Ref<Material> MaterialPtr;
+            glm::mat4 Transform;
+        };
+
+        Object* Resolve(StaticMeshHandle handle);
+        void Insert(uint32_t objectIndex);
+        void Detach(uint32_t objectIndex);
+        static void MergeCell(const Cell& cell, const std::vector<Object>& objects,
+                              MeshGeometry& merged);
+
+        float m_CellSize;
+        std::vector<Object> m_Objects;
+        std::vector<uint32_t> m_FreeObjects;
+        std::vector<Cell> m_Cells;
+        std::unordered_map<CellKey, uint32_t, CellKeyHash> m_CellLookup;
+        uint32_t m_ObjectCount = 0;
+
+        std::vector<uint32_t> m_DirtyCells;
+        std::vector<MeshGeometry> m_MergeScratch;
+
+        StaticBatchStats m_Stats;
+    };
+} // namespace ForgeEngine
@@ -3,6 +3,7 @@
 #include "FEPCH.h"
 #include "Platform/OpenGL/OpenGLTexture2D.h"
 #include "Core/Renderer/Renderer.h"
+#include "Core/Renderer/TextureStreamer.h"
 
 namespace ForgeEngine
 {
@@ -37,4 +38,14 @@ namespace ForgeEngine
         FENGINE_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
+
+    Ref<Texture2D> Texture2D::CreateAsync(const std::string& path)
+    {
+        if (TextureStreamer* streamer = TextureStreamer::Get())
+            return streamer->Load(path);
+
+        FENGINE_CORE_WARN("TextureStreamer not initialized, loading '{}' "
+                          "synchronously", path);
+        return Create(path);
+    }
 } // namespace BEngine
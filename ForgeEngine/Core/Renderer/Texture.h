@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Config.h"
+#include <algorithm>
+#include <cstdint>
 #include <string>
 
 namespace ForgeEngine
@@ -11,9 +13,74 @@ namespace ForgeEngine
         R8,
         RGB8,
         RGBA8,
-        RGBA32F
+        RGBA32F,
+
+        // Block compressed, 4x4 texels per block. Produced offline by the
+        // TextureCooker, the GPU cannot generate mips for them.
+        BC1,  // RGB + 1 bit alpha, 8 bytes per block
+        BC3,  // RGBA, 16 bytes per block
+        BC5,  // two channels (normal maps), 16 bytes per block
+        BC7   // high quality RGBA, 16 bytes per block
     };
 
+    constexpr bool IsCompressedImageFormat(ImageFormat format)
+    {
+        return format == ImageFormat::BC1 || format == ImageFormat::BC3
+            || format == ImageFormat::BC5 || format == ImageFormat::BC7;
+    }
+
+    // Bytes per texel, or per 4x4 block for compressed formats
+    constexpr uint32_t ImageFormatBlockSize(ImageFormat format)
+    {
+        switch (format)
+        {
+        case ImageFormat::R8:
+            return 1;
+        case ImageFormat::RGB8:
+            return 3;
+        case ImageFormat::RGBA8:
+            return 4;
+        case ImageFormat::RGBA32F:
+            return 16;
+        case ImageFormat::BC1:
+            return 8;
+        case ImageFormat::BC3:
+        case ImageFormat::BC5:
+        case ImageFormat::BC7:
+            return 16;
+        case ImageFormat::None:
+            break;
+        }
+
+        return 0;
+    }
+
+    // Tightly packed size of one mip level
+    constexpr uint64_t ImageFormatLevelSize(ImageFormat format, uint32_t width,
+                                            uint32_t height)
+    {
+        if (IsCompressedImageFormat(format))
+        {
+            uint64_t blocksX = (width + 3) / 4;
+            uint64_t blocksY = (height + 3) / 4;
+            return blocksX * blocksY * ImageFormatBlockSize(format);
+        }
+
+        return (uint64_t)width * height * ImageFormatBlockSize(format);
+    }
+
+    constexpr uint32_t CalculateMipCount(uint32_t width, uint32_t height)
+    {
+        uint32_t levels = 1;
+        uint32_t size = std::max(width, height);
+        while (size > 1)
+        {
+            size >>= 1;
+            levels++;
+        }
+        return levels;
+    }
+
     struct TextureSpecification
     {
         uint32_t Width = 1;
@@ -48,6 +115,12 @@ namespace ForgeEngine
     {
     public:
         static Ref<Texture2D> Create(const TextureSpecification& specification);
+        // Accepts any image stb_image can decode, or a cooked .ftex file
         static Ref<Texture2D> Create(const std::string& path);
+
+        // Returns a placeholder right away and streams the image in the
+        // background (see TextureStreamer). Falls back to a blocking load when
+        // the streamer is not running.
+        static Ref<Texture2D> CreateAsync(const std::string& path);
     };
 }
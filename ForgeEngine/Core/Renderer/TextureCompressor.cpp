@@ -0,0 +1,438 @@
+#include "Core/Renderer/TextureCompressor.h"
+
+#include "FEPCH.h"
+#include "Core/Threading/JobSystem.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        // Fits a line through the block with a few power iterations on the
+        // covariance matrix and returns its extremes as the two endpoints
+        static void ComputeEndpoints(const float (*texels)[4], uint32_t count,
+                                     uint32_t channels, float* low, float* high)
+        {
+            float mean[4] = {};
+            for (uint32_t i = 0; i < count; i++)
+                for (uint32_t c = 0; c < channels; c++)
+                    mean[c] += texels[i][c] / (float)count;
+
+            float covariance[4][4] = {};
+            for (uint32_t i = 0; i < count; i++)
+            {
+                for (uint32_t a = 0; a < channels; a++)
+                {
+                    for (uint32_t b = 0; b < channels; b++)
+                    {
+                        covariance[a][b] += (texels[i][a] - mean[a])
+                            * (texels[i][b] - mean[b]);
+                    }
+                }
+            }
+
+            float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+            for (uint32_t iteration = 0; iteration < 8; iteration++)
+            {
+                float next[4] = {};
+                float length = 0.0f;
+                for (uint32_t a = 0; a < channels; a++)
+                {
+                    for (uint32_t b = 0; b < channels; b++)
+                        next[a] += covariance[a][b] * axis[b];
+                    length += next[a] * next[a];
+                }
+
+                // Flat block, every texel has the same value
+                if (length < 1e-6f)
+                    break;
+
+                length = std::sqrt(length);
+                for (uint32_t c = 0; c < channels; c++)
+                    axis[c] = next[c] / length;
+            }
+
+            float minProjection = 0.0f, maxProjection = 0.0f;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                float projection = 0.0f;
+                for (uint32_t c = 0; c < channels; c++)
+                    projection += (texels[i][c] - mean[c]) * axis[c];
+
+                minProjection = std::min(minProjection, projection);
+                maxProjection = std::max(maxProjection, projection);
+            }
+
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                low[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f,
+                                    255.0f);
+                high[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f,
+                                     255.0f);
+            }
+        }
+
+        static float ColorDistance(const float* a, const float* b,
+                                   uint32_t channels)
+        {
+            float distance = 0.0f;
+            for (uint32_t c = 0; c < channels; c++)
+                distance += (a[c] - b[c]) * (a[c] - b[c]);
+            return distance;
+        }
+
+        static uint16_t ToRGB565(const float* color)
+        {
+            uint32_t r = (uint32_t)std::lround(color[0] * 31.0f / 255.0f);
+            uint32_t g = (uint32_t)std::lround(color[1] * 63.0f / 255.0f);
+            uint32_t b = (uint32_t)std::lround(color[2] * 31.0f / 255.0f);
+            return (uint16_t)((r << 11) | (g << 5) | b);
+        }
+
+        static void FromRGB565(uint16_t value, float* color)
+        {
+            uint32_t r = (value >> 11) & 31;
+            uint32_t g = (value >> 5) & 63;
+            uint32_t b = value & 31;
+            color[0] = (float)((r << 3) | (r >> 2));
+            color[1] = (float)((g << 2) | (g >> 4));
+            color[2] = (float)((b << 3) | (b >> 2));
+        }
+
+        // BC1 colour block. allowPunchThrough enables the 3-colour mode for
+        // texels with alpha < 128; BC3 always decodes the 4-colour mode.
+        static void EncodeColorBlock(const uint8_t* texels, uint8_t* output,
+                                     bool allowPunchThrough)
+        {
+            float opaque[16][4];
+            uint32_t opaqueCount = 0;
+            bool transparent[16];
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                transparent[i] = allowPunchThrough && texels[i * 4 + 3] < 128;
+                if (transparent[i])
+                    continue;
+
+                for (uint32_t c = 0; c < 3; c++)
+                    opaque[opaqueCount][c] = texels[i * 4 + c];
+                opaqueCount++;
+            }
+
+            bool threeColorMode = opaqueCount < 16;
+
+            float low[3] = {}, high[3] = {};
+            if (opaqueCount > 0)
+                ComputeEndpoints(opaque, opaqueCount, 3, low, high);
+
+            uint16_t color0 = ToRGB565(high);
+            uint16_t color1 = ToRGB565(low);
+
+            // The endpoint order selects the mode: color0 > color1 is the
+            // 4-colour mode, otherwise the 3-colour + transparent mode
+            if (threeColorMode ? color0 > color1 : color0 < color1)
+                std::swap(color0, color1);
+
+            float palette[4][3];
+            FromRGB565(color0, palette[0]);
+            FromRGB565(color1, palette[1]);
+
+            uint32_t paletteSize = 4;
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                if (threeColorMode)
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+                    palette[3][c] = 0.0f;
+                }
+                else
+                {
+                    palette[2][c] = (2.0f * palette[0][c] + palette[1][c])
+                        / 3.0f;
+                    palette[3][c] = (palette[0][c] + 2.0f * palette[1][c])
+                        / 3.0f;
+                }
+            }
+            if (threeColorMode)
+                paletteSize = 3;
+
+            uint32_t indices = 0;
+            if (color0 != color1 || threeColorMode)
+            {
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    uint32_t best = 0;
+                    if (transparent[i])
+                    {
+                        best = 3;
+                    }
+                    else
+                    {
+                        float texel[3] = {(float)texels[i * 4 + 0],
+                                          (float)texels[i * 4 + 1],
+                                          (float)texels[i * 4 + 2]};
+                        float bestDistance = ColorDistance(texel, palette[0], 3);
+                        for (uint32_t p = 1; p < paletteSize; p++)
+                        {
+                            float distance = ColorDistance(texel, palette[p], 3);
+                            if (distance < bestDistance)
+                            {
+                                bestDistance = distance;
+                                best = p;
+                            }
+                        }
+                    }
+
+                    indices |= best << (i * 2);
+                }
+            }
+
+            std::memcpy(output, &color0, 2);
+            std::memcpy(output + 2, &color1, 2);
+            std::memcpy(output + 4, &indices, 4);
+        }
+
+        // BC4 block for one 8-bit channel, always the 8-value mode
+        static void EncodeChannelBlock(const uint8_t* texels, uint32_t channel,
+                                       uint8_t* output)
+        {
+            uint8_t minValue = 255, maxValue = 0;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                minValue = std::min(minValue, texels[i * 4 + channel]);
+                maxValue = std::max(maxValue, texels[i * 4 + channel]);
+            }
+
+            std::memset(output, 0, 8);
+            output[0] = maxValue;
+            output[1] = minValue;
+            if (maxValue == minValue)
+                return;
+
+            float palette[8];
+            palette[0] = maxValue;
+            palette[1] = minValue;
+            for (uint32_t i = 1; i < 7; i++)
+                palette[i + 1] = ((7 - i) * maxValue + i * minValue) / 7.0f;
+
+            uint64_t indices = 0;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float value = texels[i * 4 + channel];
+                uint64_t best = 0;
+                float bestDistance = std::abs(value - palette[0]);
+                for (uint32_t p = 1; p < 8; p++)
+                {
+                    float distance = std::abs(value - palette[p]);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+
+                indices |= best << (i * 3);
+            }
+
+            for (uint32_t i = 0; i < 6; i++)
+                output[2 + i] = (uint8_t)(indices >> (i * 8));
+        }
+
+        class BlockBitWriter
+        {
+        public:
+            BlockBitWriter(uint8_t* output) : m_Output(output)
+            {
+                std::memset(m_Output, 0, 16);
+            }
+
+            void Write(uint32_t value, uint32_t bitCount)
+            {
+                for (uint32_t i = 0; i < bitCount; i++, m_Position++)
+                {
+                    if (value & (1u << i))
+                        m_Output[m_Position / 8] |= 1u << (m_Position % 8);
+                }
+            }
+
+        private:
+            uint8_t* m_Output;
+            uint32_t m_Position = 0;
+        };
+    } // namespace Utils
+
+    void TextureCompressor::EncodeBC1Block(const uint8_t* texels,
+                                           uint8_t* output)
+    {
+        Utils::EncodeColorBlock(texels, output, true);
+    }
+
+    void TextureCompressor::EncodeBC3Block(const uint8_t* texels,
+                                           uint8_t* output)
+    {
+        Utils::EncodeChannelBlock(texels, 3, output);
+        Utils::EncodeColorBlock(texels, output + 8, false);
+    }
+
+    void TextureCompressor::EncodeBC5Block(const uint8_t* texels,
+                                           uint8_t* output)
+    {
+        Utils::EncodeChannelBlock(texels, 0, output);
+        Utils::EncodeChannelBlock(texels, 1, output + 8);
+    }
+
+    void TextureCompressor::EncodeBC7Block(const uint8_t* texels,
+                                           uint8_t* output)
+    {
+        static constexpr uint32_t Weights[16] = {0,  4,  9,  13, 17, 21, 26, 30,
+                                                 34, 38, 43, 47, 51, 55, 60, 64};
+
+        float block[16][4];
+        for (uint32_t i = 0; i < 16; i++)
+            for (uint32_t c = 0; c < 4; c++)
+                block[i][c] = texels[i * 4 + c];
+
+        float endpoints[2][4];
+        Utils::ComputeEndpoints(block, 16, 4, endpoints[0], endpoints[1]);
+
+        // Mode 6 stores 7 bits per channel plus one shared p-bit per endpoint;
+        // pick the p-bit that lands closest to the ideal endpoint
+        uint32_t quantized[2][4];
+        uint32_t pBits[2];
+        for (uint32_t e = 0; e < 2; e++)
+        {
+            float bestError = 0.0f;
+            for (uint32_t p = 0; p < 2; p++)
+            {
+                uint32_t candidate[4];
+                float error = 0.0f;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    long value = std::lround((endpoints[e][c] - p) / 2.0f);
+                    candidate[c] = (uint32_t)std::clamp(value, 0l, 127l);
+                    float reconstructed = (float)((candidate[c] << 1) | p);
+                    error += (reconstructed - endpoints[e][c])
+                        * (reconstructed - endpoints[e][c]);
+                }
+
+                if (p == 0 || error < bestError)
+                {
+                    bestError = error;
+                    pBits[e] = p;
+                    std::memcpy(quantized[e], candidate, sizeof(candidate));
+                }
+            }
+        }
+
+        float palette[16][4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            uint32_t e0 = (quantized[0][c] << 1) | pBits[0];
+            uint32_t e1 = (quantized[1][c] << 1) | pBits[1];
+            for (uint32_t i = 0; i < 16; i++)
+                palette[i][c] = (float)(((64 - Weights[i]) * e0
+                                         + Weights[i] * e1 + 32) >> 6);
+        }
+
+        uint32_t indices[16];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t best = 0;
+            float bestDistance = Utils::ColorDistance(block[i], palette[0], 4);
+            for (uint32_t p = 1; p < 16; p++)
+            {
+                float distance = Utils::ColorDistance(block[i], palette[p], 4);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices[i] = best;
+        }
+
+        // The anchor index is stored with an implicit 0 high bit, so flip the
+        // endpoints when the first texel would need it set
+        if (indices[0] & 8)
+        {
+            std::swap(quantized[0], quantized[1]);
+            std::swap(pBits[0], pBits[1]);
+            for (uint32_t i = 0; i < 16; i++)
+                indices[i] = 15 - indices[i];
+        }
+
+        Utils::BlockBitWriter writer(output);
+        writer.Write(1u << 6, 7);
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            writer.Write(quantized[0][c], 7);
+            writer.Write(quantized[1][c], 7);
+        }
+        writer.Write(pBits[0], 1);
+        writer.Write(pBits[1], 1);
+
+        writer.Write(indices[0], 3);
+        for (uint32_t i = 1; i < 16; i++)
+            writer.Write(indices[i], 4);
+    }
+
+    std::vector<uint8_t> TextureCompressor::Compress(ImageFormat format,
+                                                     const uint8_t* rgba,
+                                                     uint32_t width,
+                                                     uint32_t height)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        void (*encodeBlock)(const uint8_t*, uint8_t*) = nullptr;
+        switch (format)
+        {
+        case ImageFormat::BC1:
+            encodeBlock = EncodeBC1Block;
+            break;
+        case ImageFormat::BC3:
+            encodeBlock = EncodeBC3Block;
+            break;
+        case ImageFormat::BC5:
+            encodeBlock = EncodeBC5Block;
+            break;
+        case ImageFormat::BC7:
+            encodeBlock = EncodeBC7Block;
+            break;
+        default:
+            FENGINE_CORE_ASSERT(false, "Format is not block compressed!");
+            return {};
+        }
+
+        uint32_t blockSize = ImageFormatBlockSize(format);
+        uint32_t blocksX = (width + 3) / 4;
+        uint32_t blocksY = (height + 3) / 4;
+
+        std::vector<uint8_t> output((size_t)blocksX * blocksY * blockSize);
+
+        JobSystem::ParallelFor(blocksY, 4, [&](uint32_t begin, uint32_t end) {
+            uint8_t texels[16 * 4];
+            for (uint32_t by = begin; by < end; by++)
+            {
+                for (uint32_t bx = 0; bx < blocksX; bx++)
+                {
+                    for (uint32_t y = 0; y < 4; y++)
+                    {
+                        uint32_t sy = std::min(by * 4 + y, height - 1);
+                        for (uint32_t x = 0; x < 4; x++)
+                        {
+                            uint32_t sx = std::min(bx * 4 + x, width - 1);
+                            std::memcpy(&texels[(y * 4 + x) * 4],
+                                        &rgba[((size_t)sy * width + sx) * 4], 4);
+                        }
+                    }
+
+                    encodeBlock(texels, &output[((size_t)by * blocksX + bx)
+                                                * blockSize]);
+                }
+            }
+        });
+
+        return output;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Core/Renderer/Texture.h"
+#include <cstdint>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // CPU block compression used when cooking textures. It favours speed and
+    // predictability over the last bit of quality: endpoints come from the
+    // principal axis of each block and every texel picks its nearest palette
+    // entry. BC7 always uses mode 6 (one subset, RGBA endpoints, 4-bit indices).
+    class TextureCompressor
+    {
+    public:
+        // Each block function reads 16 RGBA8 texels in row-major order
+        static void EncodeBC1Block(const uint8_t* texels, uint8_t* output);
+        static void EncodeBC3Block(const uint8_t* texels, uint8_t* output);
+        static void EncodeBC5Block(const uint8_t* texels, uint8_t* output);
+        static void EncodeBC7Block(const uint8_t* texels, uint8_t* output);
+
+        // Compresses a whole RGBA8 image, splitting the block rows across the
+        // JobSystem workers. Edge blocks are padded by clamping.
+        static std::vector<uint8_t> Compress(ImageFormat format,
+                                             const uint8_t* rgba,
+                                             uint32_t width, uint32_t height);
+    };
+} // namespace ForgeEngine
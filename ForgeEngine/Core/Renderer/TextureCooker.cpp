@@ -0,0 +1,209 @@
+#include "Core/Renderer/TextureCooker.h"
+
+#include "FEPCH.h"
+#include "Core/Renderer/CookedTexture.h"
+#include "Core/Renderer/TextureCompressor.h"
+#include "ThirdParty/stbimage/stb_image.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        struct CookLevel
+        {
+            uint32_t Width;
+            uint32_t Height;
+            std::vector<uint8_t> Data;
+        };
+
+        // 2x2 box filter, the last row/column is repeated for odd sizes
+        template <typename T>
+        static void Downsample(const T* source, uint32_t width, uint32_t height,
+                               uint32_t channels, T* destination,
+                               uint32_t destinationWidth,
+                               uint32_t destinationHeight)
+        {
+            for (uint32_t y = 0; y < destinationHeight; y++)
+            {
+                uint32_t y0 = std::min(y * 2, height - 1);
+                uint32_t y1 = std::min(y * 2 + 1, height - 1);
+                for (uint32_t x = 0; x < destinationWidth; x++)
+                {
+                    uint32_t x0 = std::min(x * 2, width - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, width - 1);
+                    for (uint32_t c = 0; c < channels; c++)
+                    {
+                        float sum = (float)source[(y0 * width + x0) * channels + c]
+                            + (float)source[(y0 * width + x1) * channels + c]
+                            + (float)source[(y1 * width + x0) * channels + c]
+                            + (float)source[(y1 * width + x1) * channels + c];
+
+                        T& out = destination[(y * destinationWidth + x) * channels
+                                             + c];
+                        if constexpr (std::is_floating_point_v<T>)
+                            out = (T)(sum * 0.25f);
+                        else
+                            out = (T)(sum * 0.25f + 0.5f);
+                    }
+                }
+            }
+        }
+
+        // Channel count stored in the intermediate (uncompressed) levels
+        static uint32_t CookSourceChannels(ImageFormat format)
+        {
+            switch (format)
+            {
+            case ImageFormat::R8:
+                return 1;
+            case ImageFormat::RGB8:
+                return 3;
+            default:
+                return 4;
+            }
+        }
+    } // namespace Utils
+
+    bool TextureCooker::Cook(const std::string& sourcePath,
+                             const std::string& outputPath,
+                             const TextureCookSettings& settings)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        ImageFormat format = settings.Format;
+        if (format == ImageFormat::None)
+        {
+            FENGINE_CORE_ERROR("Cannot cook '{}' without a target format",
+                               sourcePath);
+            return false;
+        }
+
+        bool isFloat = format == ImageFormat::RGBA32F;
+        uint32_t channels = Utils::CookSourceChannels(format);
+        uint32_t texelSize = channels * (isFloat ? sizeof(float) : 1);
+
+        stbi_set_flip_vertically_on_load(settings.FlipVertically ? 1 : 0);
+
+        int width, height, sourceChannels;
+        void* pixels = isFloat
+            ? (void*)stbi_loadf(sourcePath.c_str(), &width, &height,
+                                &sourceChannels, channels)
+            : (void*)stbi_load(sourcePath.c_str(), &width, &height,
+                               &sourceChannels, channels);
+        // The runtime loaders rely on the flag staying set
+        stbi_set_flip_vertically_on_load(1);
+
+        if (!pixels)
+        {
+            FENGINE_CORE_ERROR("Failed to decode '{}': {}", sourcePath,
+                               stbi_failure_reason());
+            return false;
+        }
+
+        // Build the whole chain uncompressed first, each level is filtered
+        // from the previous one
+        std::vector<Utils::CookLevel> levels;
+        uint32_t levelCount = settings.GenerateMips
+            ? CalculateMipCount(width, height)
+            : 1;
+        levels.reserve(levelCount);
+
+        Utils::CookLevel base;
+        base.Width = (uint32_t)width;
+        base.Height = (uint32_t)height;
+        base.Data.resize((size_t)width * height * texelSize);
+        std::memcpy(base.Data.data(), pixels, base.Data.size());
+        levels.push_back(std::move(base));
+        stbi_image_free(pixels);
+
+        for (uint32_t i = 1; i < levelCount; i++)
+        {
+            const Utils::CookLevel& previous = levels.back();
+
+            Utils::CookLevel level;
+            level.Width = std::max(previous.Width / 2, 1u);
+            level.Height = std::max(previous.Height / 2, 1u);
+            level.Data.resize((size_t)level.Width * level.Height * texelSize);
+
+            if (isFloat)
+            {
+                Utils::Downsample((const float*)previous.Data.data(),
+                                  previous.Width, previous.Height, channels,
+                                  (float*)level.Data.data(), level.Width,
+                                  level.Height);
+            }
+            else
+            {
+                Utils::Downsample(previous.Data.data(), previous.Width,
+                                  previous.Height, channels, level.Data.data(),
+                                  level.Width, level.Height);
+            }
+
+            levels.push_back(std::move(level));
+        }
+
+        if (IsCompressedImageFormat(format))
+        {
+            for (auto& level : levels)
+            {
+                level.Data = TextureCompressor::Compress(format,
+                                                         level.Data.data(),
+                                                         level.Width,
+                                                         level.Height);
+            }
+        }
+
+        CookedTextureHeader header = {};
+        header.Magic = CookedTexture::Magic;
+        header.Version = CookedTexture::Version;
+        header.Width = (uint32_t)width;
+        header.Height = (uint32_t)height;
+        header.Format = (uint32_t)format;
+        header.MipCount = levelCount;
+
+        auto alignOffset = [](uint64_t offset) {
+            uint64_t alignment = CookedTexture::LevelAlignment;
+            return (offset + alignment - 1) / alignment * alignment;
+        };
+
+        std::vector<CookedTextureLevel> table(levelCount);
+        uint64_t offset = alignOffset(sizeof(CookedTextureHeader)
+                                      + levelCount * sizeof(CookedTextureLevel));
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            table[i].Offset = offset;
+            table[i].Size = levels[i].Data.size();
+            table[i].Width = levels[i].Width;
+            table[i].Height = levels[i].Height;
+            offset = alignOffset(offset + table[i].Size);
+        }
+
+        std::ofstream out(outputPath, std::ios::out | std::ios::binary);
+        if (!out)
+        {
+            FENGINE_CORE_ERROR("Could not write cooked texture '{}'", outputPath);
+            return false;
+        }
+
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)table.data(),
+                  table.size() * sizeof(CookedTextureLevel));
+
+        const char padding[CookedTexture::LevelAlignment] = {};
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            uint64_t position = (uint64_t)out.tellp();
+            out.write(padding, table[i].Offset - position);
+            out.write((const char*)levels[i].Data.data(), table[i].Size);
+        }
+
+        FENGINE_CORE_INFO("Cooked '{}' -> '{}' ({}x{}, {} mips, {} bytes)",
+                          sourcePath, outputPath, width, height, levelCount,
+                          (uint64_t)out.tellp());
+
+        return out.good();
+    }
+} // namespace ForgeEngine
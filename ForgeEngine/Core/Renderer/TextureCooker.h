@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Core/Renderer/Texture.h"
+#include <string>
+
+namespace ForgeEngine
+{
+    struct TextureCookSettings
+    {
+        ImageFormat Format = ImageFormat::BC7;
+        bool GenerateMips = true;
+        // Matches the runtime loader, which flips images on decode
+        bool FlipVertically = true;
+    };
+
+    // Offline conversion of a source image (PNG, JPG, HDR, ...) into a cooked
+    // .ftex file: decoded once, box-filtered mip chain, optionally block
+    // compressed. See CookedTexture for the file layout.
+    class TextureCooker
+    {
+    public:
+        static bool Cook(const std::string& sourcePath,
+                         const std::string& outputPath,
+                         const TextureCookSettings& settings = {});
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,46 @@
+#include "Core/Renderer/TextureStreamer.h"
+
+#include "FEPCH.h"
+#include "Platform/OpenGL/OpenGLTextureStreamer.h"
+#include "Core/Renderer/Renderer.h"
+
+namespace ForgeEngine
+{
+    static Scope<TextureStreamer> s_TextureStreamer;
+
+    void TextureStreamer::Init()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (!s_TextureStreamer)
+            s_TextureStreamer = Create();
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        s_TextureStreamer.reset();
+    }
+
+    TextureStreamer* TextureStreamer::Get()
+    {
+        return s_TextureStreamer.get();
+    }
+
+    Scope<TextureStreamer> TextureStreamer::Create()
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            FENGINE_CORE_ASSERT(false,
+                                "RendererAPI::None is currently not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return CreateScope<OpenGLTextureStreamer>();
+        }
+
+        FENGINE_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Config.h"
+#include "Core/Renderer/Texture.h"
+#include <cstdint>
+#include <string>
+
+namespace ForgeEngine
+{
+    struct TextureStreamingStats
+    {
+        uint32_t Queued = 0;    // waiting for / running the decode on a worker
+        uint32_t InFlight = 0;  // decoded, pixels being uploaded to the GPU
+        uint32_t Completed = 0;
+        uint32_t Failed = 0;
+
+        uint64_t BytesUploaded = 0;
+        float BytesPerSecond = 0.0f; // averaged over the last second
+    };
+
+    // Loads textures off the main thread. Decoding runs on the JobSystem
+    // workers, the upload is spread over several frames through
+    // ProcessUploads so a burst of loads never stalls a single frame.
+    class TextureStreamer
+    {
+    public:
+        static constexpr float DefaultUploadBudgetMs = 2.0f;
+
+        virtual ~TextureStreamer() = default;
+
+        // Returns a texture that is immediately usable; it shows a placeholder
+        // until the real image has been uploaded and swapped in
+        virtual Ref<Texture2D> Load(const std::string& path) = 0;
+
+        // Must be called once per frame on the thread that owns the context
+        virtual void ProcessUploads(float budgetMs = DefaultUploadBudgetMs) = 0;
+
+        virtual TextureStreamingStats GetStats() const = 0;
+
+        static void Init();
+        static void Shutdown();
+
+        // nullptr when the streamer has not been initialized
+        static TextureStreamer* Get();
+
+        static Scope<TextureStreamer> Create();
+    };
+} // namespace ForgeEngine
@@ -18,4 +18,23 @@ namespace ForgeEngine {
         return nullptr;
     }
 
+    VertexArrayStats VertexArray::s_Stats;
+
+    void VertexArray::ReleaseSharedFormats()
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:    return;
+        case RendererAPI::API::OpenGL:  OpenGLVertexArray::ReleaseSharedFormats(); return;
+        }
+    }
+
+    void VertexArray::ResetStats()
+    {
+        // Still alive, not a per frame count
+        uint32_t sharedFormats = s_Stats.SharedFormats;
+        s_Stats = VertexArrayStats{};
+        s_Stats.SharedFormats = sharedFormats;
+    }
+
 }
\ No newline at end of file
@@ -2,6 +2,16 @@
 #include "Buffer.h"
 
 namespace ForgeEngine {
+  // Per frame counters, reset with VertexArray::ResetStats
+  struct VertexArrayStats {
+    uint32_t Binds = 0;           // API vertex array object binds
+    uint32_t BufferBindings = 0;  // vertex and index buffers attached on bind
+    uint32_t SharedFormats = 0;   // API objects alive, one per vertex format
+  };
+
+  // The buffers a draw reads from. Arrays whose buffers have the same
+  // attribute layouts share one API object, binding another mesh of the
+  // same format only swaps the buffers.
   class VertexArray {
   public:
     virtual ~VertexArray() = default;
@@ -10,7 +20,15 @@ namespace ForgeEngine {
 
     virtual void Unbind() const = 0;
 
-    virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) = 0;
+    // Attributes take the next free locations in order. A divisor of 0
+    // advances per vertex, 1 per instance.
+    virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer,
+                                 uint32_t instanceDivisor = 0) = 0;
+
+    // Swaps the buffer of an attached slot. With the same layout as before
+    // the array keeps its format and only rebinds the buffer on the next
+    // Bind; one array can then draw mesh after mesh.
+    virtual void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer> &vertexBuffer) = 0;
 
     virtual void SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) = 0;
 
@@ -19,5 +37,14 @@ namespace ForgeEngine {
     virtual const Ref<IndexBuffer> &GetIndexBuffer() const = 0;
 
     static Ref<VertexArray> Create();
+
+    // Deletes the shared per-format objects, before the context goes away
+    static void ReleaseSharedFormats();
+
+    static const VertexArrayStats &GetStats() { return s_Stats; }
+    static void ResetStats();
+
+  protected:
+    static VertexArrayStats s_Stats;
   };
 } // BEngine
@@ -0,0 +1,85 @@
+#include "Core/Renderer/VertexFormat.h"
+
+#include <cfloat>
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        static Unorm16x2 PackTexCoord(const glm::vec2& uv, Unorm16x2)
+        {
+            return {VertexPacking::PackUnorm16(uv.x), VertexPacking::PackUnorm16(uv.y)};
+        }
+
+        static Half2 PackTexCoord(const glm::vec2& uv, Half2)
+        {
+            return {VertexPacking::PackHalf(uv.x), VertexPacking::PackHalf(uv.y)};
+        }
+    } // namespace Utils
+
+    VertexQuantization CalculateVertexQuantization(const StandardVertex* vertices,
+                                                   uint32_t count)
+    {
+        glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            min = glm::min(min, vertices[i].Position);
+            max = glm::max(max, vertices[i].Position);
+        }
+
+        VertexQuantization quantization;
+        if (count == 0)
+            return quantization;
+
+        // Flat meshes still need a usable scale on their thin axis
+        glm::vec3 halfExtent = (max - min) * 0.5f;
+        float largest = std::fmax(halfExtent.x, std::fmax(halfExtent.y, halfExtent.z));
+        float floor = std::fmax(largest * 1e-3f, 1e-6f);
+
+        quantization.Offset = (min + max) * 0.5f;
+        quantization.Scale = glm::max(halfExtent, glm::vec3(floor));
+        return quantization;
+    }
+
+    bool HasNormalizedTexCoords(const StandardVertex* vertices, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const glm::vec2& uv = vertices[i].TexCoord;
+            if (uv.x < 0.0f || uv.x > 1.0f || uv.y < 0.0f || uv.y > 1.0f)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename QuantizedVertexType>
+    void QuantizeVertices(const StandardVertex* vertices, uint32_t count,
+                          const VertexQuantization& quantization,
+                          QuantizedVertexType* output)
+    {
+        glm::vec3 inverseScale = 1.0f / quantization.Scale;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const StandardVertex& vertex = vertices[i];
+            QuantizedVertexType& quantized = output[i];
+
+            glm::vec3 position = (vertex.Position - quantization.Offset) * inverseScale;
+            quantized.Position = {VertexPacking::PackSnorm16(position.x),
+                                  VertexPacking::PackSnorm16(position.y),
+                                  VertexPacking::PackSnorm16(position.z), 0};
+
+            quantized.Normal = VertexPacking::PackSnorm1010102(glm::vec4(vertex.Normal, 0.0f));
+            quantized.Tangent = VertexPacking::PackSnorm1010102(glm::vec4(vertex.Tangent, 1.0f));
+            quantized.TexCoord = Utils::PackTexCoord(vertex.TexCoord,
+                                                     decltype(quantized.TexCoord){});
+        }
+    }
+
+    template void QuantizeVertices<QuantizedVertex>(const StandardVertex*, uint32_t,
+                                                    const VertexQuantization&,
+                                                    QuantizedVertex*);
+    template void QuantizeVertices<QuantizedTiledVertex>(const StandardVertex*, uint32_t,
+                                                         const VertexQuantization&,
+                                                         QuantizedTiledVertex*);
+} // namespace ForgeEngine
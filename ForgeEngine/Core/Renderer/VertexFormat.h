@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Core/Renderer/Buffer.h"
+
+#include <glm.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Storage types for quantized attributes. Each one maps to exactly one
+    // ShaderDataType, the shader still sees plain floats.
+    struct Half2
+    {
+        uint16_t X, Y;
+    };
+
+    struct Half4
+    {
+        uint16_t X, Y, Z, W;
+    };
+
+    // [-1, 1] in 16 bits per component, W is padding
+    struct Snorm16x4
+    {
+        int16_t X, Y, Z, W;
+    };
+
+    // [0, 1] in 16 bits per component
+    struct Unorm16x2
+    {
+        uint16_t X, Y;
+    };
+
+    // GL_INT_2_10_10_10_REV: xyz in signed 10 bits, w in signed 2 bits
+    struct Snorm1010102
+    {
+        uint32_t Bits;
+    };
+
+    // [0, 1] in 8 bits per component, x in the lowest byte
+    struct Unorm8x4
+    {
+        uint32_t Bits;
+    };
+
+    // Maps the C++ type of a vertex member to its attribute type
+    template <typename T>
+    struct VertexAttributeType;
+
+#define FENGINE_VERTEX_ATTRIBUTE_TYPE(CppType, DataType, IsNormalized)                  \
+    template <>                                                                         \
+    struct VertexAttributeType<CppType>                                                 \
+    {                                                                                   \
+        static constexpr ShaderDataType Type = ShaderDataType::DataType;                \
+        static constexpr bool Normalized = IsNormalized;                                \
+    };
+
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(float, Float, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::vec2, Float2, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::vec3, Float3, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::vec4, Float4, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(int32_t, Int, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::ivec2, Int2, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::ivec3, Int3, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(glm::ivec4, Int4, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Half2, Half2, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Half4, Half4, false)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Snorm16x4, Short4, true)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Unorm16x2, UShort2, true)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Snorm1010102, Int1010102, true)
+    FENGINE_VERTEX_ATTRIBUTE_TYPE(Unorm8x4, UByte4, true)
+
+#undef FENGINE_VERTEX_ATTRIBUTE_TYPE
+
+    struct VertexAttribute
+    {
+        const char* Name;
+        ShaderDataType Type;
+        uint32_t Offset;
+        uint32_t Size;
+        bool Normalized;
+    };
+
+    // Describes one member of a vertex struct, everything but the shader
+    // name comes from the member's declaration
+#define FENGINE_VERTEX_ATTRIBUTE(Vertex, Member, Name)                                  \
+    ::ForgeEngine::VertexAttribute                                                      \
+    {                                                                                   \
+        Name,                                                                           \
+            ::ForgeEngine::VertexAttributeType<decltype(Vertex::Member)>::Type,         \
+            (uint32_t)offsetof(Vertex, Member), (uint32_t)sizeof(Vertex::Member),       \
+            ::ForgeEngine::VertexAttributeType<decltype(Vertex::Member)>::Normalized    \
+    }
+
+    // Specialized next to every vertex struct with a static constexpr
+    // Attributes array built from FENGINE_VERTEX_ATTRIBUTE
+    template <typename Vertex>
+    struct VertexFormat;
+
+    // Compile time check that the attributes cover the struct without
+    // overlapping, so a reordered or resized member cannot go unnoticed
+    template <typename Vertex>
+    constexpr bool IsValidVertexFormat()
+    {
+        uint32_t covered = 0;
+        for (const VertexAttribute& attribute : VertexFormat<Vertex>::Attributes)
+        {
+            if (attribute.Offset + attribute.Size > sizeof(Vertex))
+                return false;
+
+            for (const VertexAttribute& other : VertexFormat<Vertex>::Attributes)
+            {
+                if (&other != &attribute && other.Offset < attribute.Offset + attribute.Size
+                    && attribute.Offset < other.Offset + other.Size)
+                    return false;
+            }
+            covered += attribute.Size;
+        }
+        return covered <= sizeof(Vertex);
+    }
+
+    template <typename Vertex>
+    BufferLayout GetVertexLayout()
+    {
+        static_assert(std::is_standard_layout_v<Vertex>,
+                      "Vertex structs must be standard layout");
+        static_assert(IsValidVertexFormat<Vertex>(),
+                      "Vertex attributes overlap or exceed the struct");
+
+        std::vector<BufferElement> elements;
+        for (const VertexAttribute& attribute : VertexFormat<Vertex>::Attributes)
+        {
+            BufferElement element(attribute.Type, attribute.Name, attribute.Normalized);
+            element.Offset = attribute.Offset;
+            elements.push_back(element);
+        }
+        return BufferLayout(elements, (uint32_t)sizeof(Vertex));
+    }
+
+    // 44 bytes, what the primitive generators and importers produce
+    struct StandardVertex
+    {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec3 Tangent;
+        glm::vec2 TexCoord;
+    };
+
+    template <>
+    struct VertexFormat<StandardVertex>
+    {
+        static constexpr VertexAttribute Attributes[] = {
+            FENGINE_VERTEX_ATTRIBUTE(StandardVertex, Position, "a_Position"),
+            FENGINE_VERTEX_ATTRIBUTE(StandardVertex, Normal, "a_Normal"),
+            FENGINE_VERTEX_ATTRIBUTE(StandardVertex, Tangent, "a_Tangent"),
+            FENGINE_VERTEX_ATTRIBUTE(StandardVertex, TexCoord, "a_TexCoord"),
+        };
+    };
+
+    // 20 bytes. Positions are relative to the mesh bounds and expanded in the
+    // vertex shader with u_PositionScale/u_PositionOffset; UVs must be in
+    // [0, 1].
+    struct QuantizedVertex
+    {
+        Snorm16x4 Position;
+        Snorm1010102 Normal;
+        Snorm1010102 Tangent;
+        Unorm16x2 TexCoord;
+    };
+
+    template <>
+    struct VertexFormat<QuantizedVertex>
+    {
+        static constexpr VertexAttribute Attributes[] = {
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedVertex, Position, "a_Position"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedVertex, Normal, "a_Normal"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedVertex, Tangent, "a_Tangent"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedVertex, TexCoord, "a_TexCoord"),
+        };
+    };
+
+    // Same size as QuantizedVertex, with half float UVs for tiling textures
+    struct QuantizedTiledVertex
+    {
+        Snorm16x4 Position;
+        Snorm1010102 Normal;
+        Snorm1010102 Tangent;
+        Half2 TexCoord;
+    };
+
+    template <>
+    struct VertexFormat<QuantizedTiledVertex>
+    {
+        static constexpr VertexAttribute Attributes[] = {
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedTiledVertex, Position, "a_Position"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedTiledVertex, Normal, "a_Normal"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedTiledVertex, Tangent, "a_Tangent"),
+            FENGINE_VERTEX_ATTRIBUTE(QuantizedTiledVertex, TexCoord, "a_TexCoord"),
+        };
+    };
+
+    static_assert(sizeof(StandardVertex) == 44);
+    static_assert(sizeof(QuantizedVertex) == 20);
+    static_assert(sizeof(QuantizedTiledVertex) == 20);
+
+    namespace VertexPacking
+    {
+        // IEEE 754 binary16, round to nearest even, overflow goes to infinity
+        inline uint16_t PackHalf(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            uint32_t sign = (bits >> 16) & 0x8000;
+            int32_t exponent = (int32_t)((bits >> 23) & 0xff) - 127 + 15;
+            uint32_t mantissa = bits & 0x7fffff;
+
+            // NaN and infinity
+            if (((bits >> 23) & 0xff) == 0xff)
+                return (uint16_t)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+            if (exponent >= 31)
+                return (uint16_t)(sign | 0x7c00);
+
+            if (exponent <= 0)
+            {
+                // Subnormal or zero
+                if (exponent < -10)
+                    return (uint16_t)sign;
+
+                mantissa |= 0x800000;
+                uint32_t shift = (uint32_t)(14 - exponent);
+                uint32_t half = mantissa >> shift;
+                uint32_t remainder = mantissa & ((1u << shift) - 1);
+                uint32_t midpoint = 1u << (shift - 1);
+                if (remainder > midpoint || (remainder == midpoint && (half & 1)))
+                    half++;
+                return (uint16_t)(sign | half);
+            }
+
+            uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+            uint32_t remainder = mantissa & 0x1fff;
+            if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+                half++; // may carry into the exponent, which is still correct
+            return (uint16_t)(sign | half);
+        }
+
+        inline int16_t PackSnorm16(float value)
+        {
+            value = std::fmax(-1.0f, std::fmin(1.0f, value));
+            return (int16_t)std::lround(value * 32767.0f);
+        }
+
+        inline uint16_t PackUnorm16(float value)
+        {
+            value = std::fmax(0.0f, std::fmin(1.0f, value));
+            return (uint16_t)std::lround(value * 65535.0f);
+        }
+
+        inline Snorm1010102 PackSnorm1010102(const glm::vec4& value)
+        {
+            auto pack = [](float v, float scale, uint32_t mask) {
+                v = std::fmax(-1.0f, std::fmin(1.0f, v));
+                return (uint32_t)(int32_t)std::lround(v * scale) & mask;
+            };
+
+            return {pack(value.x, 511.0f, 0x3ff) | (pack(value.y, 511.0f, 0x3ff) << 10)
+                    | (pack(value.z, 511.0f, 0x3ff) << 20)
+                    | (pack(value.w, 1.0f, 0x3) << 30)};
+        }
+
+        inline Unorm8x4 PackUnorm8x4(const glm::vec4& value)
+        {
+            auto pack = [](float v) {
+                return (uint32_t)std::lround(std::fmax(0.0f, std::fmin(1.0f, v)) * 255.0f);
+            };
+
+            return {pack(value.x) | (pack(value.y) << 8) | (pack(value.z) << 16)
+                    | (pack(value.w) << 24)};
+        }
+    } // namespace VertexPacking
+
+    // Dequantization parameters for positions stored relative to the bounds:
+    // position = stored * Scale + Offset
+    struct VertexQuantization
+    {
+        glm::vec3 Scale = glm::vec3(1.0f);
+        glm::vec3 Offset = glm::vec3(0.0f);
+    };
+
+    // Computes the quantization box from the positions
+    VertexQuantization CalculateVertexQuantization(const StandardVertex* vertices,
+                                                   uint32_t count);
+
+    // True when every UV fits QuantizedVertex's unorm16 range
+    bool HasNormalizedTexCoords(const StandardVertex* vertices, uint32_t count);
+
+    template <typename QuantizedVertexType>
+    void QuantizeVertices(const StandardVertex* vertices, uint32_t count,
+                          const VertexQuantization& quantization,
+                          QuantizedVertexType* output);
+} // namespace ForgeEngine
@@ -47,13 +47,16 @@ namespace ForgeEngine
         {
         }
 
+        // T * R * S without the two matrix products: scaling R's columns
+        // and writing the translation gives the same matrix
         glm::mat4 GetTransform() const
         {
-            glm::mat4 rotation = glm::toMat4(glm::quat(Rotation));
-
-            return glm::translate(glm::mat4(1.0f), Translation)
-                * rotation
-                * glm::scale(glm::mat4(1.0f), Scale);
+            glm::mat4 transform = glm::toMat4(glm::quat(Rotation));
+            transform[0] *= Scale.x;
+            transform[1] *= Scale.y;
+            transform[2] *= Scale.z;
+            transform[3] = glm::vec4(Translation, 1.0f);
+            return transform;
         }
     };
 
@@ -65,7 +68,7 @@ namespace ForgeEngine
         ModelRendererComponent() = default;
         ModelRendererComponent(const ModelRendererComponent&) = default;
 
-        ModelRendererComponent(const Ref<ForgeEngine::Model>& model)
+        ModelRendererComponent(const Ref<::ForgeEngine::Model>& model)
             : Model(model)
         {
         }
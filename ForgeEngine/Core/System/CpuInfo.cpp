@@ -0,0 +1,276 @@
+#include "Core/System/CpuInfo.h"
+
+#include "Core/Log/Felog.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FORGE_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace ForgeEngine
+{
+    // Detection result plus the FORGE_FORCE_ISA outcome, which is only
+    // reported by Log: detection can run before the loggers exist
+    struct CpuInfoData
+    {
+        CpuFeatures Features;
+        SimdLevel BestLevel = SimdLevel::Scalar;
+        SimdLevel DispatchLevel = SimdLevel::Scalar;
+        bool Forced = false;
+        std::string ForceRequest; // raw FORGE_FORCE_ISA value, empty when unset
+    };
+
+#ifdef FORGE_CPU_X86
+    static void CpuId(uint32_t leaf, uint32_t subleaf, uint32_t (&regs)[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, (int)leaf, (int)subleaf);
+        for (int i = 0; i < 4; i++)
+            regs[i] = (uint32_t)info[i];
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    // Only valid once CPUID reported OSXSAVE
+    static uint64_t ReadXCR0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        // Raw opcode, _xgetbv would need -mxsave on this whole file
+        uint32_t eax, edx;
+        __asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((uint64_t)edx << 32) | eax;
+#endif
+    }
+
+    static void DetectX86(CpuFeatures& features)
+    {
+        uint32_t regs[4];
+        CpuId(0, 0, regs);
+        uint32_t maxLeaf = regs[0];
+
+        char vendor[13] = {};
+        std::memcpy(vendor, &regs[1], 4);
+        std::memcpy(vendor + 4, &regs[3], 4);
+        std::memcpy(vendor + 8, &regs[2], 4);
+        features.Vendor = vendor;
+
+        CpuId(0x80000000, 0, regs);
+        uint32_t maxExtendedLeaf = regs[0];
+        if (maxExtendedLeaf >= 0x80000004)
+        {
+            char brand[49] = {};
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                CpuId(0x80000002 + i, 0, regs);
+                std::memcpy(brand + i * 16, regs, 16);
+            }
+            // Some vendors pad the brand string on the left
+            const char* start = brand;
+            while (*start == ' ') start++;
+            features.Brand = start;
+        }
+
+        if (maxExtendedLeaf >= 0x80000007)
+        {
+            CpuId(0x80000007, 0, regs);
+            features.InvariantTSC = (regs[3] & (1u << 8)) != 0;
+        }
+
+        if (maxLeaf < 1) return;
+        CpuId(1, 0, regs);
+        uint32_t ecx1 = regs[2], edx1 = regs[3];
+
+        features.SSE2 = (edx1 & (1u << 26)) != 0;
+        features.SSE3 = (ecx1 & (1u << 0)) != 0;
+        features.SSSE3 = (ecx1 & (1u << 9)) != 0;
+        features.SSE41 = (ecx1 & (1u << 19)) != 0;
+        features.SSE42 = (ecx1 & (1u << 20)) != 0;
+        features.POPCNT = (ecx1 & (1u << 23)) != 0;
+
+        // The wide registers are only usable when the OS saves them on
+        // context switches: XMM and YMM state for AVX, plus opmask and the
+        // upper ZMM halves for AVX-512
+        bool osxsave = (ecx1 & (1u << 27)) != 0;
+        uint64_t xcr0 = osxsave ? ReadXCR0() : 0;
+        bool osAvx = (xcr0 & 0x6) == 0x6;
+        bool osAvx512 = osAvx && (xcr0 & 0xE0) == 0xE0;
+
+        features.AVX = osAvx && (ecx1 & (1u << 28)) != 0;
+        features.FMA = features.AVX && (ecx1 & (1u << 12)) != 0;
+        features.F16C = features.AVX && (ecx1 & (1u << 29)) != 0;
+
+        if (maxLeaf < 7) return;
+        CpuId(7, 0, regs);
+        uint32_t ebx7 = regs[1];
+
+        features.BMI1 = (ebx7 & (1u << 3)) != 0;
+        features.BMI2 = (ebx7 & (1u << 8)) != 0;
+        features.AVX2 = features.AVX && (ebx7 & (1u << 5)) != 0;
+        features.AVX512F = osAvx512 && (ebx7 & (1u << 16)) != 0;
+        features.AVX512DQ = features.AVX512F && (ebx7 & (1u << 17)) != 0;
+        features.AVX512BW = features.AVX512F && (ebx7 & (1u << 30)) != 0;
+        features.AVX512VL = features.AVX512F && (ebx7 & (1u << 31)) != 0;
+    }
+#endif
+
+    static bool SupportsLevel(const CpuFeatures& features, SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar: return true;
+        case SimdLevel::SSE2: return features.SSE2;
+        case SimdLevel::SSE4: return features.SSE41 && features.SSE42;
+        case SimdLevel::AVX2: return features.AVX2 && features.FMA;
+        case SimdLevel::AVX512:
+            return features.AVX512F && features.AVX512DQ && features.AVX512BW
+                && features.AVX512VL;
+        case SimdLevel::NEON: return features.NEON;
+        default: return false;
+        }
+    }
+
+    static CpuInfoData DetectCpu()
+    {
+        CpuInfoData data;
+        CpuFeatures& features = data.Features;
+        features.LogicalCores = std::thread::hardware_concurrency();
+
+#ifdef FORGE_CPU_X86
+        DetectX86(features);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        // Part of the AArch64 baseline
+        features.NEON = true;
+#endif
+
+        for (size_t i = SimdLevelCount; i-- > 0;)
+        {
+            if (SupportsLevel(features, (SimdLevel)i))
+            {
+                data.BestLevel = (SimdLevel)i;
+                break;
+            }
+        }
+        data.DispatchLevel = data.BestLevel;
+
+        if (const char* request = std::getenv("FORGE_FORCE_ISA"); request && *request)
+        {
+            data.ForceRequest = request;
+            SimdLevel forced;
+            if (ParseSimdLevel(request, forced) && SupportsLevel(features, forced))
+            {
+                data.DispatchLevel = forced;
+                data.Forced = true;
+            }
+        }
+        return data;
+    }
+
+    static const CpuInfoData& GetCpuInfoData()
+    {
+        static const CpuInfoData s_CpuInfoData = DetectCpu();
+        return s_CpuInfoData;
+    }
+
+    const char* GetSimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar: return "Scalar";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::SSE4: return "SSE4";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX512";
+        case SimdLevel::NEON: return "NEON";
+        default: return "Unknown";
+        }
+    }
+
+    bool ParseSimdLevel(const char* name, SimdLevel& outLevel)
+    {
+        if (!name) return false;
+
+        for (size_t i = 0; i < SimdLevelCount; i++)
+        {
+            const char* candidate = GetSimdLevelName((SimdLevel)i);
+            size_t k = 0;
+            while (name[k] && candidate[k]
+                   && std::tolower((unsigned char)name[k])
+                       == std::tolower((unsigned char)candidate[k]))
+                k++;
+
+            if (!name[k] && !candidate[k])
+            {
+                outLevel = (SimdLevel)i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CpuFeatures& CpuInfo::Get() { return GetCpuInfoData().Features; }
+
+    bool CpuInfo::Supports(SimdLevel level) { return SupportsLevel(Get(), level); }
+
+    SimdLevel CpuInfo::GetBestSimdLevel() { return GetCpuInfoData().BestLevel; }
+
+    SimdLevel CpuInfo::GetDispatchLevel() { return GetCpuInfoData().DispatchLevel; }
+
+    bool CpuInfo::IsDispatchLevelForced() { return GetCpuInfoData().Forced; }
+
+    void CpuInfo::Log()
+    {
+        const CpuInfoData& data = GetCpuInfoData();
+        const CpuFeatures& features = data.Features;
+
+        std::string flags;
+        auto append = [&flags](bool present, const char* name) {
+            if (!present) return;
+            if (!flags.empty()) flags += ' ';
+            flags += name;
+        };
+        append(features.SSE2, "SSE2");
+        append(features.SSE3, "SSE3");
+        append(features.SSSE3, "SSSE3");
+        append(features.SSE41, "SSE4.1");
+        append(features.SSE42, "SSE4.2");
+        append(features.POPCNT, "POPCNT");
+        append(features.AVX, "AVX");
+        append(features.AVX2, "AVX2");
+        append(features.FMA, "FMA");
+        append(features.F16C, "F16C");
+        append(features.BMI1, "BMI1");
+        append(features.BMI2, "BMI2");
+        append(features.AVX512F, "AVX512F");
+        append(features.AVX512DQ, "AVX512DQ");
+        append(features.AVX512BW, "AVX512BW");
+        append(features.AVX512VL, "AVX512VL");
+        append(features.NEON, "NEON");
+        append(features.InvariantTSC, "InvariantTSC");
+
+        FENGINE_CORE_INFO("CPU: {} ({}), {} logical cores",
+                          features.Brand.empty() ? "unknown" : features.Brand,
+                          features.Vendor.empty() ? "unknown vendor" : features.Vendor,
+                          features.LogicalCores);
+        FENGINE_CORE_INFO("CPU features: {}", flags.empty() ? "none" : flags);
+
+        if (!data.ForceRequest.empty() && !data.Forced)
+        {
+            FENGINE_CORE_WARN("FORGE_FORCE_ISA={} is unknown or not supported by this CPU, "
+                              "using {}", data.ForceRequest, GetSimdLevelName(data.BestLevel));
+        }
+        FENGINE_CORE_INFO("SIMD dispatch level: {}{}", GetSimdLevelName(data.DispatchLevel),
+                          data.Forced ? " (forced by FORGE_FORCE_ISA)" : "");
+    }
+} // namespace ForgeEngine
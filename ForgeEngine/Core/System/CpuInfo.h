@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ForgeEngine
+{
+    // Instruction set levels a kernel can ship a variant for. The x86 levels
+    // are ordered, each one implies the ones before it; NEON stands alone.
+    enum class SimdLevel : uint8_t
+    {
+        Scalar = 0,
+        SSE2,
+        SSE4,   // 4.1 and 4.2
+        AVX2,   // with FMA
+        AVX512, // F, DQ, BW and VL
+        NEON,
+        Count
+    };
+
+    constexpr size_t SimdLevelCount = (size_t)SimdLevel::Count;
+
+    const char* GetSimdLevelName(SimdLevel level);
+    // Case insensitive: scalar, sse2, sse4, avx2, avx512 or neon
+    bool ParseSimdLevel(const char* name, SimdLevel& outLevel);
+
+    // What the running CPU and OS can execute. A flag is only set when the
+    // OS also saves the matching registers (XCR0), so AVX on a kernel
+    // without XSAVE support reads as missing.
+    struct CpuFeatures
+    {
+        std::string Vendor;
+        std::string Brand;
+        uint32_t LogicalCores = 0;
+
+        bool SSE2 = false;
+        bool SSE3 = false;
+        bool SSSE3 = false;
+        bool SSE41 = false;
+        bool SSE42 = false;
+        bool POPCNT = false;
+        bool AVX = false;
+        bool AVX2 = false;
+        bool FMA = false;
+        bool F16C = false;
+        bool BMI1 = false;
+        bool BMI2 = false;
+        bool AVX512F = false;
+        bool AVX512DQ = false;
+        bool AVX512BW = false;
+        bool AVX512VL = false;
+        bool NEON = false;
+
+        // The time stamp counter ticks at a constant rate across power
+        // states, so it can serve as a clock
+        bool InvariantTSC = false;
+    };
+
+    // CPU capabilities, detected once on first use, and the instruction set
+    // level SIMD kernels dispatch to.
+    //
+    // FORGE_FORCE_ISA=<level> in the environment caps the dispatch level,
+    // e.g. to benchmark the AVX2 path on an AVX-512 machine or the scalar
+    // reference anywhere. A level the CPU cannot run is ignored with a
+    // warning.
+    class CpuInfo
+    {
+    public:
+        static const CpuFeatures& Get();
+
+        // Hardware and OS support, regardless of FORGE_FORCE_ISA
+        static bool Supports(SimdLevel level);
+        static SimdLevel GetBestSimdLevel();
+
+        // Highest level kernels may pick: the best supported one, or the one
+        // pinned through FORGE_FORCE_ISA
+        static SimdLevel GetDispatchLevel();
+        static bool IsDispatchLevelForced();
+
+        // Picks the variant for the highest level that is at most the
+        // dispatch level, supported by the CPU and not null. variants is
+        // indexed by SimdLevel and the Scalar entry must be set; outLevel
+        // receives the level of the returned variant.
+        template <typename T>
+        static T Resolve(const T (&variants)[SimdLevelCount], SimdLevel* outLevel = nullptr)
+        {
+            for (size_t i = (size_t)GetDispatchLevel(); i > 0; i--)
+            {
+                if (variants[i] && Supports((SimdLevel)i))
+                {
+                    if (outLevel) *outLevel = (SimdLevel)i;
+                    return variants[i];
+                }
+            }
+            if (outLevel) *outLevel = SimdLevel::Scalar;
+            return variants[0];
+        }
+
+        // Brand, core count, features and dispatch level to the core logger
+        static void Log();
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,230 @@
+#include "Core/Threading/ForgeMutex.h"
+
+#include "Core/Debug/Instrumentor.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+namespace ForgeEngine
+{
+    struct LockContentionData
+    {
+        // A plain mutex, this one cannot report on itself
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<ForgeLockStats>> Stats;
+    };
+
+    // Locks are created during static initialization of other files, so the
+    // registry is built on first use
+    static LockContentionData& GetLockContentionData()
+    {
+        static LockContentionData data;
+        return data;
+    }
+
+    static void UpdateMaximum(std::atomic<uint64_t>& maximum, uint64_t value)
+    {
+        uint64_t current = maximum.load(std::memory_order_relaxed);
+        while (value > current
+               && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    ForgeLockStats* LockContention::GetStats(const char* name, bool traceWaits)
+    {
+        LockContentionData& data = GetLockContentionData();
+        std::lock_guard lock(data.Mutex);
+
+        for (auto& stats : data.Stats)
+            if (stats->Name == name) return stats.get();
+
+        auto stats = std::make_unique<ForgeLockStats>();
+        stats->Name = name;
+        stats->WaitEventName = std::string("Lock Wait: ") + name;
+        stats->TraceWaits = traceWaits;
+        data.Stats.push_back(std::move(stats));
+        return data.Stats.back().get();
+    }
+
+    std::vector<LockContentionReport> LockContention::GetReport()
+    {
+        LockContentionData& data = GetLockContentionData();
+        std::vector<LockContentionReport> report;
+        {
+            std::lock_guard lock(data.Mutex);
+            report.reserve(data.Stats.size());
+            for (auto& stats : data.Stats)
+            {
+                LockContentionReport& entry = report.emplace_back();
+                entry.Name = stats->Name;
+                entry.Acquisitions = stats->Acquisitions.load(std::memory_order_relaxed);
+                entry.Contended = stats->Contended.load(std::memory_order_relaxed);
+                entry.TotalWaitNanoseconds = stats->TotalWaitNanoseconds.load(std::memory_order_relaxed);
+                entry.MaxWaitNanoseconds = stats->MaxWaitNanoseconds.load(std::memory_order_relaxed);
+                for (uint32_t i = 0; i < ForgeLockStats::HistogramBuckets; i++)
+                    entry.WaitHistogram[i] = stats->WaitHistogram[i].load(std::memory_order_relaxed);
+                entry.MaxHoldNanoseconds = stats->MaxHoldNanoseconds.load(std::memory_order_relaxed);
+                const char* scope = stats->MaxHoldScope.load(std::memory_order_relaxed);
+                if (scope) entry.MaxHoldScope = scope;
+            }
+        }
+
+        std::sort(report.begin(), report.end(),
+                  [](const LockContentionReport& a, const LockContentionReport& b) {
+                      if (a.TotalWaitNanoseconds != b.TotalWaitNanoseconds)
+                          return a.TotalWaitNanoseconds > b.TotalWaitNanoseconds;
+                      return a.Acquisitions > b.Acquisitions;
+                  });
+        return report;
+    }
+
+    void LockContention::Reset()
+    {
+        LockContentionData& data = GetLockContentionData();
+        std::lock_guard lock(data.Mutex);
+        for (auto& stats : data.Stats)
+        {
+            stats->Acquisitions.store(0, std::memory_order_relaxed);
+            stats->Contended.store(0, std::memory_order_relaxed);
+            stats->TotalWaitNanoseconds.store(0, std::memory_order_relaxed);
+            stats->MaxWaitNanoseconds.store(0, std::memory_order_relaxed);
+            for (auto& bucket : stats->WaitHistogram)
+                bucket.store(0, std::memory_order_relaxed);
+            stats->MaxHoldNanoseconds.store(0, std::memory_order_relaxed);
+            stats->MaxHoldScope.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    void LockContention::SetHoldTracking(bool enabled)
+    {
+        s_HoldTracking.store(enabled, std::memory_order_relaxed);
+    }
+
+    void LockContention::RecordWait(ForgeLockStats& stats, uint64_t beginSteady, uint64_t beginTicks)
+    {
+        uint64_t wait = Instrumentor::SteadyNanoseconds() - beginSteady;
+        stats.Contended.fetch_add(1, std::memory_order_relaxed);
+        stats.TotalWaitNanoseconds.fetch_add(wait, std::memory_order_relaxed);
+        UpdateMaximum(stats.MaxWaitNanoseconds, wait);
+
+        uint64_t microseconds = wait / 1000;
+        uint32_t bucket = std::min<uint32_t>((uint32_t)std::bit_width(microseconds),
+                                             ForgeLockStats::HistogramBuckets - 1);
+        stats.WaitHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        if (beginTicks)
+            Instrumentor::Record(stats.WaitEventName.c_str(), beginTicks, Instrumentor::Now());
+    }
+
+    void LockContention::RecordHold(ForgeLockStats& stats, uint64_t nanoseconds, const char* scope)
+    {
+        // The scope is stored after the maximum, a report taken in between
+        // may pair the new time with the previous owner
+        uint64_t current = stats.MaxHoldNanoseconds.load(std::memory_order_relaxed);
+        while (nanoseconds > current)
+        {
+            if (stats.MaxHoldNanoseconds.compare_exchange_weak(current, nanoseconds,
+                                                               std::memory_order_relaxed))
+            {
+                stats.MaxHoldScope.store(scope, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+#if FENGINE_LOCK_INSTRUMENTATION
+    // Trace start of a contended wait, 0 when it is not going to be recorded
+    static uint64_t LockWaitTicks(const ForgeLockStats& stats)
+    {
+        return stats.TraceWaits && Instrumentor::IsRecording() ? Instrumentor::Now() : 0;
+    }
+
+    static uint64_t LockHoldStart()
+    {
+        return LockContention::IsHoldTracking() ? Instrumentor::SteadyNanoseconds() : 0;
+    }
+
+    void ForgeMutex::lock(const char* scope)
+    {
+        if (!m_Mutex.try_lock())
+        {
+            uint64_t beginSteady = Instrumentor::SteadyNanoseconds();
+            uint64_t beginTicks = LockWaitTicks(*m_Stats);
+            m_Mutex.lock();
+            LockContention::RecordWait(*m_Stats, beginSteady, beginTicks);
+        }
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_Scope = scope;
+        m_LockedAt = LockHoldStart();
+    }
+
+    bool ForgeMutex::try_lock()
+    {
+        if (!m_Mutex.try_lock()) return false;
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_Scope = nullptr;
+        m_LockedAt = LockHoldStart();
+        return true;
+    }
+
+    void ForgeMutex::unlock()
+    {
+        if (m_LockedAt)
+            LockContention::RecordHold(*m_Stats, Instrumentor::SteadyNanoseconds() - m_LockedAt,
+                                       m_Scope);
+        m_Mutex.unlock();
+    }
+
+    void ForgeSharedMutex::lock(const char* scope)
+    {
+        if (!m_Mutex.try_lock())
+        {
+            uint64_t beginSteady = Instrumentor::SteadyNanoseconds();
+            uint64_t beginTicks = LockWaitTicks(*m_Stats);
+            m_Mutex.lock();
+            LockContention::RecordWait(*m_Stats, beginSteady, beginTicks);
+        }
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_Scope = scope;
+        m_LockedAt = LockHoldStart();
+    }
+
+    bool ForgeSharedMutex::try_lock()
+    {
+        if (!m_Mutex.try_lock()) return false;
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_Scope = nullptr;
+        m_LockedAt = LockHoldStart();
+        return true;
+    }
+
+    void ForgeSharedMutex::unlock()
+    {
+        if (m_LockedAt)
+            LockContention::RecordHold(*m_Stats, Instrumentor::SteadyNanoseconds() - m_LockedAt,
+                                       m_Scope);
+        m_Mutex.unlock();
+    }
+
+    void ForgeSharedMutex::lock_shared()
+    {
+        if (!m_Mutex.try_lock_shared())
+        {
+            uint64_t beginSteady = Instrumentor::SteadyNanoseconds();
+            uint64_t beginTicks = LockWaitTicks(*m_Stats);
+            m_Mutex.lock_shared();
+            LockContention::RecordWait(*m_Stats, beginSteady, beginTicks);
+        }
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool ForgeSharedMutex::try_lock_shared()
+    {
+        if (!m_Mutex.try_lock_shared()) return false;
+        m_Stats->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+#endif
+} // namespace ForgeEngine
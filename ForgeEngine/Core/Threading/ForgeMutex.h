@@ -0,0 +1,256 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <source_location>
+#include <string>
+#include <vector>
+
+// 0 turns ForgeMutex and ForgeSharedMutex into plain std mutexes with the
+// same interface; the lock names are then ignored
+#ifndef FENGINE_LOCK_INSTRUMENTATION
+#define FENGINE_LOCK_INSTRUMENTATION 1
+#endif
+
+namespace ForgeEngine
+{
+    // Counters shared by every lock created under one name. They are never
+    // freed, so the report still covers locks that are gone.
+    struct ForgeLockStats
+    {
+        // Bucket 0 holds waits below 1 us, bucket i waits of [2^(i-1), 2^i)
+        // us, the last one everything longer
+        static constexpr uint32_t HistogramBuckets = 16;
+
+        std::string Name;
+        std::string WaitEventName; // the trace keeps this address
+        bool TraceWaits = true;
+
+        std::atomic<uint64_t> Acquisitions{0};
+        std::atomic<uint64_t> Contended{0};
+        std::atomic<uint64_t> TotalWaitNanoseconds{0};
+        std::atomic<uint64_t> MaxWaitNanoseconds{0};
+        std::atomic<uint64_t> WaitHistogram[HistogramBuckets] = {};
+
+        // Only measured while hold tracking is on
+        std::atomic<uint64_t> MaxHoldNanoseconds{0};
+        std::atomic<const char*> MaxHoldScope{nullptr};
+    };
+
+    struct LockContentionReport
+    {
+        std::string Name;
+        uint64_t Acquisitions = 0;
+        uint64_t Contended = 0;
+        uint64_t TotalWaitNanoseconds = 0;
+        uint64_t MaxWaitNanoseconds = 0;
+        uint64_t WaitHistogram[ForgeLockStats::HistogramBuckets] = {};
+        uint64_t MaxHoldNanoseconds = 0;
+        std::string MaxHoldScope;
+    };
+
+    // Registry of the lock statistics. Uncontended acquisitions only bump a
+    // counter; a contended one also measures the wait and, while a profile
+    // session or the flight recorder runs, records it as a "Lock Wait" scope
+    // on the waiting thread. Hold times need a clock read per acquisition
+    // and are off until enabled.
+    class LockContention
+    {
+    public:
+        // Stats for name, created on first use. traceWaits is false for the
+        // locks of the profiler itself.
+        static ForgeLockStats* GetStats(const char* name, bool traceWaits = true);
+
+        // Every lock name seen so far, most total wait first
+        static std::vector<LockContentionReport> GetReport();
+        static void Reset();
+
+        static void SetHoldTracking(bool enabled);
+        static bool IsHoldTracking()
+        {
+            return s_HoldTracking.load(std::memory_order_relaxed);
+        }
+
+        // Wait and hold bookkeeping of ForgeMutex and ForgeSharedMutex
+        static void RecordWait(ForgeLockStats& stats, uint64_t beginSteady, uint64_t beginTicks);
+        static void RecordHold(ForgeLockStats& stats, uint64_t nanoseconds, const char* scope);
+
+    private:
+        static inline std::atomic<bool> s_HoldTracking{false};
+    };
+
+#if FENGINE_LOCK_INSTRUMENTATION
+    // std::mutex with contention statistics under a name. Works with
+    // std::lock_guard and friends; ForgeLockGuard and ForgeUniqueLock also
+    // remember the calling function as the owner for the hold report.
+    class ForgeMutex
+    {
+    public:
+        explicit ForgeMutex(const char* name, bool traceWaits = true)
+            : m_Stats(LockContention::GetStats(name, traceWaits))
+        {
+        }
+
+        ForgeMutex(const ForgeMutex&) = delete;
+        ForgeMutex& operator=(const ForgeMutex&) = delete;
+
+        void lock() { lock(nullptr); }
+        void lock(const char* scope);
+        bool try_lock();
+        void unlock();
+
+        ForgeLockStats& GetStats() const { return *m_Stats; }
+
+    private:
+        std::mutex m_Mutex;
+        ForgeLockStats* m_Stats;
+        // Written by the owner only, while it holds the lock
+        uint64_t m_LockedAt = 0;
+        const char* m_Scope = nullptr;
+    };
+
+    // Exclusive side as ForgeMutex. Shared acquisitions and their waits are
+    // counted, holds are not, readers overlap.
+    class ForgeSharedMutex
+    {
+    public:
+        explicit ForgeSharedMutex(const char* name, bool traceWaits = true)
+            : m_Stats(LockContention::GetStats(name, traceWaits))
+        {
+        }
+
+        ForgeSharedMutex(const ForgeSharedMutex&) = delete;
+        ForgeSharedMutex& operator=(const ForgeSharedMutex&) = delete;
+
+        void lock() { lock(nullptr); }
+        void lock(const char* scope);
+        bool try_lock();
+        void unlock();
+
+        void lock_shared();
+        bool try_lock_shared();
+        void unlock_shared() { m_Mutex.unlock_shared(); }
+
+        ForgeLockStats& GetStats() const { return *m_Stats; }
+
+    private:
+        std::shared_mutex m_Mutex;
+        ForgeLockStats* m_Stats;
+        uint64_t m_LockedAt = 0;
+        const char* m_Scope = nullptr;
+    };
+#else
+    class ForgeMutex
+    {
+    public:
+        explicit ForgeMutex(const char*, bool = true) {}
+
+        ForgeMutex(const ForgeMutex&) = delete;
+        ForgeMutex& operator=(const ForgeMutex&) = delete;
+
+        void lock() { m_Mutex.lock(); }
+        void lock(const char*) { m_Mutex.lock(); }
+        bool try_lock() { return m_Mutex.try_lock(); }
+        void unlock() { m_Mutex.unlock(); }
+
+    private:
+        std::mutex m_Mutex;
+    };
+
+    class ForgeSharedMutex
+    {
+    public:
+        explicit ForgeSharedMutex(const char*, bool = true) {}
+
+        ForgeSharedMutex(const ForgeSharedMutex&) = delete;
+        ForgeSharedMutex& operator=(const ForgeSharedMutex&) = delete;
+
+        void lock() { m_Mutex.lock(); }
+        void lock(const char*) { m_Mutex.lock(); }
+        bool try_lock() { return m_Mutex.try_lock(); }
+        void unlock() { m_Mutex.unlock(); }
+
+        void lock_shared() { m_Mutex.lock_shared(); }
+        bool try_lock_shared() { return m_Mutex.try_lock_shared(); }
+        void unlock_shared() { m_Mutex.unlock_shared(); }
+
+    private:
+        std::shared_mutex m_Mutex;
+    };
+#endif
+
+    template<typename Mutex>
+    class ForgeLockGuard
+    {
+    public:
+        explicit ForgeLockGuard(Mutex& mutex,
+                                std::source_location where = std::source_location::current())
+            : m_Mutex(mutex)
+        {
+            m_Mutex.lock(where.function_name());
+        }
+
+        ~ForgeLockGuard() { m_Mutex.unlock(); }
+
+        ForgeLockGuard(const ForgeLockGuard&) = delete;
+        ForgeLockGuard& operator=(const ForgeLockGuard&) = delete;
+
+    private:
+        Mutex& m_Mutex;
+    };
+
+    // The part of std::unique_lock that condition_variable_any needs
+    template<typename Mutex>
+    class ForgeUniqueLock
+    {
+    public:
+        explicit ForgeUniqueLock(Mutex& mutex,
+                                 std::source_location where = std::source_location::current())
+            : m_Mutex(mutex), m_Scope(where.function_name())
+        {
+            lock();
+        }
+
+        ~ForgeUniqueLock()
+        {
+            if (m_Owns) m_Mutex.unlock();
+        }
+
+        ForgeUniqueLock(const ForgeUniqueLock&) = delete;
+        ForgeUniqueLock& operator=(const ForgeUniqueLock&) = delete;
+
+        void lock()
+        {
+            m_Mutex.lock(m_Scope);
+            m_Owns = true;
+        }
+
+        void unlock()
+        {
+            m_Owns = false;
+            m_Mutex.unlock();
+        }
+
+        bool owns_lock() const { return m_Owns; }
+
+    private:
+        Mutex& m_Mutex;
+        const char* m_Scope;
+        bool m_Owns = false;
+    };
+
+    class ForgeSharedLock
+    {
+    public:
+        explicit ForgeSharedLock(ForgeSharedMutex& mutex) : m_Mutex(mutex) { m_Mutex.lock_shared(); }
+        ~ForgeSharedLock() { m_Mutex.unlock_shared(); }
+
+        ForgeSharedLock(const ForgeSharedLock&) = delete;
+        ForgeSharedLock& operator=(const ForgeSharedLock&) = delete;
+
+    private:
+        ForgeSharedMutex& m_Mutex;
+    };
+} // namespace ForgeEngine
@@ -0,0 +1,184 @@
+#include "Core/Threading/JobSystem.h"
+
+#include "Core/Debug/Instrumentor.h"
+#include "Core/Debug/SamplingProfiler.h"
+#include "Core/Log/Felog.h"
+#include "Core/Threading/ForgeMutex.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ForgeEngine
+{
+    struct JobSystemData
+    {
+        std::vector<std::thread> Workers;
+        std::deque<JobSystem::Job> Queue;
+        ForgeMutex QueueMutex{"JobSystem Queue"};
+        std::condition_variable_any WakeCondition;
+        bool Running = false;
+    };
+
+    static JobSystemData s_JobData;
+
+    static void WorkerLoop(uint32_t index)
+    {
+        std::string name = "Worker " + std::to_string(index);
+        FENGINE_PROFILE_THREAD(name);
+        SamplingProfiler::RegisterThread(name);
+
+        while (true)
+        {
+            JobSystem::Job job;
+            {
+                ForgeUniqueLock lock(s_JobData.QueueMutex);
+                s_JobData.WakeCondition.wait(lock, [] {
+                    return !s_JobData.Running || !s_JobData.Queue.empty();
+                });
+
+                // Drain the remaining jobs before leaving so nothing that was
+                // submitted is silently dropped on shutdown
+                if (s_JobData.Queue.empty())
+                {
+                    SamplingProfiler::UnregisterThread();
+                    return;
+                }
+
+                job = std::move(s_JobData.Queue.front());
+                s_JobData.Queue.pop_front();
+            }
+
+            job();
+        }
+    }
+
+    void JobSystem::Init(uint32_t workerCount)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (s_JobData.Running) return;
+
+        if (workerCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        s_JobData.Running = true;
+        s_JobData.Workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; i++)
+            s_JobData.Workers.emplace_back(WorkerLoop, i);
+
+        FENGINE_CORE_INFO("JobSystem initialized with {} worker threads",
+                          workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        {
+            ForgeLockGuard lock(s_JobData.QueueMutex);
+            if (!s_JobData.Running) return;
+            s_JobData.Running = false;
+        }
+        s_JobData.WakeCondition.notify_all();
+
+        for (auto& worker : s_JobData.Workers)
+            worker.join();
+
+        s_JobData.Workers.clear();
+    }
+
+    void JobSystem::Submit(Job job)
+    {
+        {
+            ForgeLockGuard lock(s_JobData.QueueMutex);
+            if (s_JobData.Running)
+            {
+                s_JobData.Queue.push_back(std::move(job));
+                s_JobData.WakeCondition.notify_one();
+                return;
+            }
+        }
+
+        job();
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t minChunkSize,
+                                const RangeJob& fn)
+    {
+        if (count == 0) return;
+
+        minChunkSize = std::max(minChunkSize, 1u);
+        uint32_t participants = GetWorkerCount() + 1;
+        uint32_t chunkSize = std::max(minChunkSize,
+                                      (count + participants - 1) / participants);
+        uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount == 1 || !IsInitialized())
+        {
+            fn(0, count);
+            return;
+        }
+
+        // Chunks are claimed through an atomic cursor so the caller can keep
+        // working while helpers are still waiting in the queue
+        struct ParallelForState
+        {
+            std::atomic<uint32_t> NextChunk{0};
+            std::atomic<uint32_t> DoneChunks{0};
+            ForgeMutex DoneMutex{"JobSystem ParallelFor"};
+            std::condition_variable_any DoneCondition;
+        };
+
+        auto state = std::make_shared<ParallelForState>();
+
+        auto work = [state, &fn, count, chunkSize, chunkCount]() {
+            uint32_t chunk;
+            while ((chunk = state->NextChunk.fetch_add(1)) < chunkCount)
+            {
+                uint32_t begin = chunk * chunkSize;
+                uint32_t end = std::min(begin + chunkSize, count);
+                fn(begin, end);
+
+                if (state->DoneChunks.fetch_add(1) + 1 == chunkCount)
+                {
+                    ForgeLockGuard lock(state->DoneMutex);
+                    state->DoneCondition.notify_all();
+                }
+            }
+        };
+
+        uint32_t helpers = std::min(chunkCount - 1, GetWorkerCount());
+        for (uint32_t i = 0; i < helpers; i++)
+            Submit(work);
+
+        work();
+
+        ForgeUniqueLock lock(state->DoneMutex);
+        state->DoneCondition.wait(lock, [&state, chunkCount] {
+            return state->DoneChunks.load() == chunkCount;
+        });
+    }
+
+    bool JobSystem::IsInitialized()
+    {
+        return s_JobData.Running;
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return (uint32_t)s_JobData.Workers.size();
+    }
+
+    uint32_t JobSystem::GetPendingJobCount()
+    {
+        ForgeLockGuard lock(s_JobData.QueueMutex);
+        return (uint32_t)s_JobData.Queue.size();
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Config.h"
+#include <cstdint>
+#include <functional>
+
+namespace ForgeEngine
+{
+    // Fixed-size worker pool for background work (asset decoding, importing,
+    // culling). Jobs are executed in submission order by whichever worker is
+    // free. When the system is not initialized, jobs run inline on the caller.
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+        using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+        // workerCount == 0 picks hardware_concurrency - 1 (at least one)
+        static void Init(uint32_t workerCount = 0);
+        static void Shutdown();
+
+        static void Submit(Job job);
+
+        // Splits [0, count) into chunks of at least minChunkSize and runs
+        // fn(begin, end) on the workers. Blocks until every chunk finished;
+        // the calling thread takes part in the work, so it is safe to call
+        // from inside a job.
+        static void ParallelFor(uint32_t count, uint32_t minChunkSize,
+                                const RangeJob& fn);
+
+        static bool IsInitialized();
+        static uint32_t GetWorkerCount();
+        static uint32_t GetPendingJobCount();
+    };
+} // namespace ForgeEngine
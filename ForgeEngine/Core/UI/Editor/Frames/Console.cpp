@@ -7,6 +7,9 @@
 #endif
 
 #include "imgui.h"
+#include <spdlog/details/os.h>
+#include <algorithm>
+#include <cstdio>
 
 namespace ForgeEngine
 {
@@ -22,18 +25,17 @@ namespace ForgeEngine
     {
         Layer::OnAttach();
 
-        log_sink_ = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(1000);
-        auto coreLogger = Felog::GetCoreLogger();
-        if (coreLogger)
-        {
-            coreLogger->sinks().push_back(log_sink_);
-            FENGINE_CORE_INFO("MainUI Layer Attached. Sink de UI adicionado ao CoreLogger.");
-        }
+        log_sink_ = std::make_shared<LogRingSink>(LogCapacity);
+        // The loggers may write from their own thread, never touch their
+        // sink lists directly
+        Felog::AddSink(log_sink_);
+        FENGINE_CORE_INFO("MainUI Layer Attached. Sink de UI adicionado ao CoreLogger.");
     }
 
     void Console::OnDetach()
     {
         Layer::OnDetach();
+        Felog::RemoveSink(log_sink_);
     }
 
     void Console::OnUpdate(Timestep ts)
@@ -48,19 +50,10 @@ namespace ForgeEngine
         ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_FirstUseEver);
         if (ImGui::Begin("Console", nullptr))
         {
-            if (ImGui::Button("Clear"))
+            if (ImGui::Button("Clear") && log_sink_)
             {
-                if (log_sink_)
-                {
-                    auto coreLogger = Felog::GetCoreLogger();
-                    auto& sinks_vec = coreLogger->sinks();
-                    sinks_vec.erase(std::remove(sinks_vec.begin(), sinks_vec.end(), log_sink_), sinks_vec.end());
-
-                    size_t sink_capacity = 1000;
-                    log_sink_ = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(sink_capacity);
-
-                    coreLogger->sinks().push_back(log_sink_);
-                }
+                cleared_at_ = log_sink_->GetGeneration();
+                refilter_ = true;
             }
 
             ImGui::SameLine();
@@ -69,37 +62,31 @@ namespace ForgeEngine
                 FENGINE_CORE_INFO("Sample log message");
             }
 
+            static const char* s_ConsoleLevelNames[LevelCount] = {"Trace", "Debug", "Info", "Warn", "Error", "Critical"};
+            for (int level = 0; level < LevelCount; level++)
+            {
+                ImGui::SameLine();
+                if (ImGui::Checkbox(s_ConsoleLevelNames[level], &show_level_[level]))
+                    refilter_ = true;
+            }
+
+            if (text_filter_.Draw("Filter", 200.0f))
+                refilter_ = true;
+
             ImGui::Separator();
             ImGui::BeginChild("LogScrollingRegion", ImVec2(0, 0), false, window_flags_);
 
             if (log_sink_)
             {
-                auto messages = log_sink_->last_formatted();
-                for (const auto& msg : messages)
+                UpdateFilteredLines();
+
+                // Only the visible lines are looked up and drawn
+                ImGuiListClipper clipper((int)filtered_.size());
+                while (clipper.Step())
                 {
-                    ImVec4 color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-                    if (msg.find("[error]") != std::string::npos || msg.find("[critical]") != std::string::npos ||
-                        msg.find("[ERROR]") != std::string::npos || msg.find("[CRITICAL]") != std::string::npos)
-                    {
-                        color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
-                    }
-                    else if (msg.find("[warning]") != std::string::npos || msg.find("[WARN]") != std::string::npos)
-                    {
-                        color = ImVec4(1.0f, 1.0f, 0.4f, 1.0f);
-                    }
-                    else if (msg.find("[debug]") != std::string::npos || msg.find("[trace]") != std::string::npos ||
-                        msg.find("[DEBUG]") != std::string::npos || msg.find("[TRACE]") != std::string::npos)
-                    {
-                        color = ImVec4(0.6f, 0.6f, 0.6f, 1.0f); // Cinza um pouco mais claro
-                    }
-                    else if (msg.find("[info]") != std::string::npos || msg.find("[INFO]") != std::string::npos)
-                    {
-                        color = ImVec4(0.7f, 0.9f, 1.0f, 1.0f); // Azul claro para info
-                    }
-
-                    ImGui::PushStyleColor(ImGuiCol_Text, color);
-                    ImGui::TextUnformatted(msg.c_str());
-                    ImGui::PopStyleColor();
+                    log_sink_->ForEachOf(filtered_.data() + clipper.DisplayStart,
+                                         (size_t)(clipper.DisplayEnd - clipper.DisplayStart),
+                                         [this](const LogRecord* record) { DrawRecord(record); });
                 }
             }
 
@@ -113,6 +100,94 @@ namespace ForgeEngine
         ImGui::End();
     }
 
+    void Console::UpdateFilteredLines()
+    {
+        if (refilter_)
+        {
+            filtered_.clear();
+            scanned_ = cleared_at_;
+            message_passed_ = false;
+            refilter_ = false;
+        }
+
+        // The generation is an atomic read, the ring is only locked when
+        // something was logged since the last frame
+        if (log_sink_->GetGeneration() != scanned_)
+        {
+            scanned_ = log_sink_->ForEach(scanned_, [this](const LogRecord& record) {
+                if (!record.Continuation)
+                {
+                    message_passed_ = show_level_[std::min<int>(record.Level, LevelCount - 1)]
+                        && text_filter_.PassFilter(record.Text.data(),
+                                                   record.Text.data() + record.Text.size());
+                }
+                if (message_passed_)
+                    filtered_.push_back(record.Sequence);
+            });
+        }
+
+        // Forget the lines the ring has overwritten since
+        uint64_t first = log_sink_->GetFirstSequence();
+        if (!filtered_.empty() && filtered_.front() < first)
+            filtered_.erase(filtered_.begin(), std::lower_bound(filtered_.begin(), filtered_.end(), first));
+    }
+
+    void Console::DrawRecord(const LogRecord* record)
+    {
+        // Overwritten between filtering and drawing, keep the line spacing
+        if (!record)
+        {
+            ImGui::TextUnformatted("");
+            return;
+        }
+
+        ImVec4 color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+        switch (record->Level)
+        {
+            case spdlog::level::err:
+            case spdlog::level::critical:
+                color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+                break;
+            case spdlog::level::warn:
+                color = ImVec4(1.0f, 1.0f, 0.4f, 1.0f);
+                break;
+            case spdlog::level::trace:
+            case spdlog::level::debug:
+                color = ImVec4(0.6f, 0.6f, 0.6f, 1.0f); // Cinza um pouco mais claro
+                break;
+            case spdlog::level::info:
+                color = ImVec4(0.7f, 0.9f, 1.0f, 1.0f); // Azul claro para info
+                break;
+            default:
+                break;
+        }
+
+        char line[LogRingSink::MaxLineLength + 64];
+        int length;
+        if (record->Continuation)
+        {
+            length = std::snprintf(line, sizeof(line), "    %.*s", (int)record->Text.size(),
+                                   record->Text.data());
+        }
+        else
+        {
+            auto time = spdlog::log_clock::to_time_t(record->Time);
+            auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+                record->Time.time_since_epoch()).count() % 1000;
+            std::tm local = spdlog::details::os::localtime(time);
+            auto level = spdlog::level::to_string_view(record->Level);
+            length = std::snprintf(line, sizeof(line), "[%02d:%02d:%02d.%03d] [%.*s] [%.*s] %.*s",
+                                   local.tm_hour, local.tm_min, local.tm_sec, (int)milliseconds,
+                                   (int)record->Logger.size(), record->Logger.data(),
+                                   (int)level.size(), level.data(),
+                                   (int)record->Text.size(), record->Text.data());
+        }
+
+        ImGui::PushStyleColor(ImGuiCol_Text, color);
+        ImGui::TextUnformatted(line, line + std::clamp(length, 0, (int)sizeof(line) - 1));
+        ImGui::PopStyleColor();
+    }
+
     void Console::OnEvent(Event& event)
     {
         Layer::OnEvent(event);
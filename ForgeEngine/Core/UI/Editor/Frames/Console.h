@@ -1,8 +1,9 @@
 #pragma once
 #include "imgui.h"
 #include "Core/Layer/Layer.h"
-#include "Core/Log/Felog.h"
-#include "spdlog/sinks/ringbuffer_sink.h"
+#include "Core/Log/LogRingSink.h"
+
+#include <vector>
 
 namespace ForgeEngine
 {
@@ -21,8 +22,26 @@ namespace ForgeEngine
         void CloseConsole();
 
     private:
+        static constexpr uint32_t LogCapacity = 4096;
+        static constexpr int LevelCount = spdlog::level::critical + 1;
+
+        // Appends the records logged since the last call that pass the
+        // filters, or starts over when a filter changed
+        void UpdateFilteredLines();
+        void DrawRecord(const LogRecord* record);
+
         bool open_;
-        std::shared_ptr<spdlog::sinks::ringbuffer_sink_mt> log_sink_;
+        std::shared_ptr<LogRingSink> log_sink_;
+        ImGuiTextFilter text_filter_;
+        bool show_level_[LevelCount] = {true, true, true, true, true, true};
+        bool refilter_ = true;
+        // Sequences of the records shown, oldest first
+        std::vector<uint64_t> filtered_;
+        // Next sequence to filter; everything before cleared_at_ is hidden
+        uint64_t scanned_ = 0;
+        uint64_t cleared_at_ = 0;
+        // Continuation lines follow the first line of their message
+        bool message_passed_ = false;
         ImGuiWindowFlags window_flags_ = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_HorizontalScrollbar | ImGuiWindowFlags_NoTitleBar;
     };
 }
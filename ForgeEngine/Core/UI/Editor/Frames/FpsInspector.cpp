@@ -8,7 +8,8 @@ namespace ForgeEngine
 {
     FpsInspector::FpsInspector(): opened_(false)
     {
-        frames_ = std::vector<float>(max_frame_values_amount_window_);
+        history_.resize(FrameTelemetry::Capacity);
+        fps_values_.reserve(FrameTelemetry::Capacity);
         debug_name_ = "FpsInspector";
     }
 
@@ -27,23 +28,6 @@ namespace ForgeEngine
     void FpsInspector::OnUpdate(Timestep ts)
     {
         Layer::OnUpdate(ts);
-
-        /*// only updates after update_tick_ms_
-        int app_time_ms = Time::GetTime() * 1000.0f;
-        if (app_time_ms % update_tick_ms_ != 0) return;*/
-
-        float frame = round(1.0f / ts.GetSeconds());
-
-        if (passed_frames_ >= amount_of_frames_to_get_avg_)
-        {
-            UpdateFPSHistory(GetAvgFPS());
-            passed_frames_ = 0;
-            return;
-        }
-
-        temp_frames_[passed_frames_] = frame;
-        passed_frames_++;
-        last_frame_amount_ = frame;
     }
 
     void FpsInspector::OnImGuiRender()
@@ -68,13 +52,6 @@ namespace ForgeEngine
         opened_ = false;
     }
 
-    void FpsInspector::UpdateFPSHistory(const float frame)
-    {
-        if (frames_.size() > max_frame_values_amount_window_)
-            frames_.erase(frames_.begin());
-        frames_.push_back(frame);
-    }
-
     void FpsInspector::PlotGraph()
     {
         ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
@@ -84,63 +61,55 @@ namespace ForgeEngine
         ImGui::Begin("FPSHistory", nullptr, window_flags);
         auto plot_width = ImGui::GetWindowSize().x - 50.0f;
         auto plot_height = 150.0f;
-        auto text_height = ImGui::GetTextLineHeight();
-        auto window_height = (ImGui::GetWindowSize().y - (plot_height + 2.0f * text_height)) * 0.5f;
         plot_size_ = ImVec2(plot_width, plot_height);
 
         ImGui::PopStyleVar(3);
 
-        if (!frames_.empty())
+        uint32_t count = FrameTelemetry::GetHistory(history_.data(), (uint32_t)max_frame_values_amount_window_);
+        if (count > 0)
         {
-            std::vector<float> fps_smooth = SmoothValues(frames_, 1.0f);
-            ImGui::SetCursorPosY(ImGui::GetCursorPosX() + window_height);
+            fps_values_.resize(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                float frame_ms = history_[i].FrameMs;
+                fps_values_[i] = frame_ms > 0.0f ? 1000.0f / frame_ms : 0.0f;
+            }
+
+            std::string last_fps_text = std::to_string((int)fps_values_.back()) + " fps";
             ImGui::BeginGroup();
-            int last_fps_amount = static_cast<int>(fps_smooth.back());
-
-            const char* last_fps_text = std::to_string(last_fps_amount).c_str();
-            int offset = max_frame_values_amount_window_ / 1000 - 1;
-
-            ImGui::PlotLines("##", fps_smooth.data(), 1000, offset, nullptr, 0.0f, 2000.0f, plot_size_);
+            ImGui::PlotLines("##FpsPlot", fps_values_.data(), (int)count, 0, last_fps_text.c_str(),
+                             0.0f, 2000.0f, plot_size_);
             ImGui::SetNextItemWidth(plot_size_.x);
-            ImGui::SliderInt("##", &max_frame_values_amount_window_, 30, 1000);
-
-            ImGui::BeginGroup();
-            ImGui::Text("0");
-            ImGui::SameLine(plot_size_.x - ImGui::CalcTextSize(last_fps_text).x);
-            ImGui::Text(last_fps_text);
-
-            ImGui::EndGroup();
+            ImGui::SliderInt("##FpsWindow", &max_frame_values_amount_window_, 30, 1000, "%d frames");
             ImGui::EndGroup();
+
+            DrawSummary();
         }
 
         ImGui::End();
     }
 
-    float FpsInspector::GetAvgFPS()
-    {
-        float avg_fps = temp_frames_[0];
-        for (int i = 1; i < std::size(temp_frames_); i++)
-        {
-            avg_fps += temp_frames_[i];
-        }
-        avg_fps /= std::size(temp_frames_);
-        return avg_fps;
-    }
-
-    std::vector<float> FpsInspector::SmoothValues(const std::vector<float>& values, float alpha)
+    void FpsInspector::DrawSummary()
     {
-        std::vector<float> smooth_values(values.size());
-
-        if (values.empty())
-            return smooth_values;
-
-        smooth_values[0] = values[0];
-
-        for (size_t i = 1; i < values.size(); ++i)
-        {
-            smooth_values[i] = smooth_values[i - 1] + alpha * (values[i] - smooth_values[i - 1]);
-        }
-
-        return smooth_values;
+        FrameTimeSummary summary = FrameTelemetry::GetSummary((uint32_t)max_frame_values_amount_window_);
+
+        ImGui::Text("Avg: %.0f fps (%.2f ms)", summary.AverageFps, summary.AverageMs);
+        ImGui::Text("p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms",
+                    summary.P50Ms, summary.P95Ms, summary.P99Ms, summary.MaxMs);
+        if (summary.AverageGpuMs >= 0.0f)
+            ImGui::Text("GPU: %.2f ms", summary.AverageGpuMs);
+        ImGui::Text("Hitches: %u (%llu total)", summary.Hitches,
+                    (unsigned long long)summary.TotalHitches);
+
+        float hitch_factor = FrameTelemetry::GetHitchFactor();
+        ImGui::SetNextItemWidth(plot_size_.x * 0.5f);
+        if (ImGui::SliderFloat("Hitch Factor", &hitch_factor, 1.5f, 5.0f, "%.1fx average"))
+            FrameTelemetry::SetHitchFactor(hitch_factor);
+
+        if (ImGui::Button("Export CSV"))
+            FrameTelemetry::ExportCsv("FrameTelemetry.csv");
+        ImGui::SameLine();
+        if (ImGui::Button("Export JSON"))
+            FrameTelemetry::ExportJson("FrameTelemetry.json");
     }
 }
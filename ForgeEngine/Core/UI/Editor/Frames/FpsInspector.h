@@ -1,6 +1,9 @@
 #pragma once
 #include "imgui.h"
 #include "Core/Layer/Layer.h"
+#include "Core/Debug/FrameTelemetry.h"
+
+#include <vector>
 
 namespace ForgeEngine
 {
@@ -19,21 +22,14 @@ namespace ForgeEngine
         void Close();
 
     private:
-        static std::vector<float> SmoothValues(const std::vector<float>& values, float alpha);
-        void UpdateFPSHistory(float frame);
         void PlotGraph();
-        float GetAvgFPS();
+        void DrawSummary();
 
-        std::vector<float> frames_;
-        constexpr static int amount_of_frames_to_get_avg_ = 10;
-        float temp_frames_[amount_of_frames_to_get_avg_] = {};
+        // Reused every frame, sized to the whole telemetry ring once
+        std::vector<FrameRecord> history_;
+        std::vector<float> fps_values_;
         int max_frame_values_amount_window_ = 1000;
         bool opened_ = false;
-        float last_frame_amount_ = 0.0f;
-        int max_values_count_ = 0;
-        int update_tick_ms_ = 10;
-        int offset_ = 0;
-        int passed_frames_ = 0;
         ImVec2 plot_size_ = ImVec2(300, 100);
         ImVec2 window_size_ = ImVec2(400, 200);
         ImGuiWindowFlags window_flags =
@@ -0,0 +1,155 @@
+#include "GpuProfilerPanel.h"
+
+#include "imgui.h"
+#include "Core/Renderer/GpuProfiler.h"
+
+namespace ForgeEngine
+{
+    GpuProfilerPanel::GpuProfilerPanel()
+    {
+        debug_name_ = "GpuProfilerPanel";
+    }
+
+    GpuProfilerPanel::~GpuProfilerPanel() = default;
+
+    void GpuProfilerPanel::OnAttach()
+    {
+        Layer::OnAttach();
+    }
+
+    void GpuProfilerPanel::OnDetach()
+    {
+        Layer::OnDetach();
+    }
+
+    void GpuProfilerPanel::OnUpdate(Timestep ts)
+    {
+        Layer::OnUpdate(ts);
+
+        cpu_frame_ms_ = ts.GetMilliseconds();
+    }
+
+    void GpuProfilerPanel::OnImGuiRender()
+    {
+        Layer::OnImGuiRender();
+
+        if (!opened_)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(420.0f, 320.0f), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("GPU Profiler", &opened_, window_flags_))
+        {
+            ImGui::End();
+            return;
+        }
+
+        GpuProfiler* profiler = GpuProfiler::Get();
+        if (!profiler)
+        {
+            ImGui::Text("GPU profiler not initialized");
+            ImGui::End();
+            return;
+        }
+
+        bool enabled = profiler->IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+            profiler->SetEnabled(enabled);
+
+        if (profiler->SupportsPipelineStatistics())
+        {
+            ImGui::SameLine();
+            bool statistics = profiler->IsPipelineStatisticsEnabled();
+            if (ImGui::Checkbox("Pipeline Statistics", &statistics))
+                profiler->SetPipelineStatisticsEnabled(statistics);
+        }
+
+        const GpuFrameTimings& frame = profiler->GetLatestFrame();
+        GpuProfilerStats stats = profiler->GetStats();
+
+        ImGui::Separator();
+        ImGui::Text("GPU Frame: %.3f ms", frame.TotalMs);
+        ImGui::Text("CPU Frame: %.3f ms", cpu_frame_ms_);
+        // A frame whose GPU work fills most of the frame time is waiting
+        // on the GPU, anything else is waiting on the CPU
+        ImGui::Text("Bound By: %s", frame.TotalMs > cpu_frame_ms_ * 0.9f ? "GPU" : "CPU");
+        ImGui::Text("Latency: %u frames, Dropped: %u", GpuProfiler::FrameLatency,
+                    stats.DroppedFrames);
+        ImGui::SliderFloat("Smoothing", &smoothing_, 0.01f, 1.0f);
+
+        ImGui::Separator();
+        DrawScopes();
+
+        ImGui::End();
+    }
+
+    void GpuProfilerPanel::DrawScopes()
+    {
+        const GpuFrameTimings& frame = GpuProfiler::Get()->GetLatestFrame();
+
+        bool newFrame = frame.FrameIndex != last_frame_index_;
+        last_frame_index_ = frame.FrameIndex;
+
+        ImGui::Columns(3, "GpuScopes");
+        ImGui::Text("Pass");
+        ImGui::NextColumn();
+        ImGui::Text("ms");
+        ImGui::NextColumn();
+        ImGui::Text("Frame %%");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const GpuScopeTiming& scope : frame.Scopes)
+        {
+            std::string key = std::to_string(scope.Depth) + scope.Name;
+            auto it = smoothed_ms_.find(key);
+            if (it == smoothed_ms_.end())
+                it = smoothed_ms_.emplace(key, (float)scope.DurationMs).first;
+            else if (newFrame)
+                it->second += smoothing_ * ((float)scope.DurationMs - it->second);
+            float ms = it->second;
+
+            ImGui::Indent(scope.Depth * 10.0f + 1.0f);
+            ImGui::Text("%s", scope.Name);
+            ImGui::Unindent(scope.Depth * 10.0f + 1.0f);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", ms);
+            ImGui::NextColumn();
+            float fraction = frame.TotalMs > 0.0 ? (float)(scope.DurationMs / frame.TotalMs) : 0.0f;
+            ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f));
+            ImGui::NextColumn();
+
+            if (scope.HasPipelineStatistics)
+            {
+                const GpuPipelineStatistics& pipeline = scope.PipelineStatistics;
+                ImGui::NextColumn();
+                ImGui::TextDisabled("vertices %llu, primitives %llu\n"
+                                    "vs %llu, clipped %llu -> %llu, fs %llu",
+                                    (unsigned long long)pipeline.VerticesSubmitted,
+                                    (unsigned long long)pipeline.PrimitivesSubmitted,
+                                    (unsigned long long)pipeline.VertexShaderInvocations,
+                                    (unsigned long long)pipeline.ClippingInputPrimitives,
+                                    (unsigned long long)pipeline.ClippingOutputPrimitives,
+                                    (unsigned long long)pipeline.FragmentShaderInvocations);
+                ImGui::NextColumn();
+                ImGui::NextColumn();
+            }
+        }
+
+        ImGui::Columns(1);
+    }
+
+    void GpuProfilerPanel::OnEvent(Event& event)
+    {
+        Layer::OnEvent(event);
+    }
+
+    void GpuProfilerPanel::Open()
+    {
+        opened_ = true;
+    }
+
+    void GpuProfilerPanel::Close()
+    {
+        opened_ = false;
+    }
+}
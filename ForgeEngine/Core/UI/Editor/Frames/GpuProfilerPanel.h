@@ -0,0 +1,37 @@
+#pragma once
+#include "imgui.h"
+#include "Core/Layer/Layer.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace ForgeEngine
+{
+    // Per pass GPU times of the latest resolved frame, next to the CPU
+    // frame time to tell which side the frame is bound by
+    class GpuProfilerPanel : public Layer
+    {
+    public:
+        GpuProfilerPanel();
+        ~GpuProfilerPanel() override;
+
+        void OnAttach() override;
+        void OnDetach() override;
+        void OnUpdate(Timestep ts) override;
+        void OnImGuiRender() override;
+        void OnEvent(Event& event) override;
+        void Open();
+        void Close();
+
+    private:
+        void DrawScopes();
+
+        bool opened_ = false;
+        float cpu_frame_ms_ = 0.0f;
+        uint64_t last_frame_index_ = 0;
+        // Smoothed milliseconds per pass, keyed by depth and name
+        std::unordered_map<std::string, float> smoothed_ms_;
+        float smoothing_ = 0.1f;
+        ImGuiWindowFlags window_flags_ = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoFocusOnAppearing;
+    };
+}
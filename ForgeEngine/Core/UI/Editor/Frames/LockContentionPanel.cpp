@@ -0,0 +1,156 @@
+#include "LockContentionPanel.h"
+
+#include "imgui.h"
+
+namespace ForgeEngine
+{
+    static constexpr float s_LockReportRefreshSeconds = 0.25f;
+
+    LockContentionPanel::LockContentionPanel()
+    {
+        debug_name_ = "LockContentionPanel";
+    }
+
+    LockContentionPanel::~LockContentionPanel() = default;
+
+    void LockContentionPanel::OnAttach()
+    {
+        Layer::OnAttach();
+    }
+
+    void LockContentionPanel::OnDetach()
+    {
+        Layer::OnDetach();
+    }
+
+    void LockContentionPanel::OnUpdate(Timestep ts)
+    {
+        Layer::OnUpdate(ts);
+
+        if (!opened_)
+            return;
+
+        refresh_timer_ += ts.GetSeconds();
+        if (refresh_timer_ >= s_LockReportRefreshSeconds || report_.empty())
+        {
+            refresh_timer_ = 0.0f;
+            report_ = LockContention::GetReport();
+        }
+    }
+
+    void LockContentionPanel::OnImGuiRender()
+    {
+        Layer::OnImGuiRender();
+
+        if (!opened_)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(640.0f, 360.0f), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Lock Contention", &opened_, window_flags_))
+        {
+            ImGui::End();
+            return;
+        }
+
+#if !FENGINE_LOCK_INSTRUMENTATION
+        ImGui::TextDisabled("Built without FORGE_LOCK_INSTRUMENTATION, no statistics are collected");
+#endif
+
+        bool holdTracking = LockContention::IsHoldTracking();
+        if (ImGui::Checkbox("Track Hold Times", &holdTracking))
+            LockContention::SetHoldTracking(holdTracking);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Reads the clock on every acquisition and release");
+        ImGui::SameLine();
+        ImGui::Checkbox("Hide Uncontended", &hide_uncontended_);
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
+        {
+            LockContention::Reset();
+            report_ = LockContention::GetReport();
+        }
+
+        ImGui::Separator();
+        DrawLocks();
+
+        ImGui::End();
+    }
+
+    void LockContentionPanel::DrawLocks()
+    {
+        ImGui::BeginChild("Locks");
+        ImGui::Columns(6, "Locks");
+        ImGui::Text("Lock");
+        ImGui::NextColumn();
+        ImGui::Text("Acquired");
+        ImGui::NextColumn();
+        ImGui::Text("Contended");
+        ImGui::NextColumn();
+        ImGui::Text("Wait ms");
+        ImGui::NextColumn();
+        ImGui::Text("Max Wait us");
+        ImGui::NextColumn();
+        ImGui::Text("Max Hold us");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const LockContentionReport& lock : report_)
+        {
+            if (hide_uncontended_ && lock.Contended == 0)
+                continue;
+
+            bool expanded = ImGui::TreeNode(lock.Name.c_str());
+            ImGui::NextColumn();
+            ImGui::Text("%llu", (unsigned long long)lock.Acquisitions);
+            ImGui::NextColumn();
+            float share = lock.Acquisitions ? (float)lock.Contended / (float)lock.Acquisitions : 0.0f;
+            ImGui::Text("%llu (%.1f%%)", (unsigned long long)lock.Contended, share * 100.0f);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", (double)lock.TotalWaitNanoseconds / 1e6);
+            ImGui::NextColumn();
+            ImGui::Text("%.1f", (double)lock.MaxWaitNanoseconds / 1e3);
+            ImGui::NextColumn();
+            ImGui::Text("%.1f", (double)lock.MaxHoldNanoseconds / 1e3);
+            if (!lock.MaxHoldScope.empty() && ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", lock.MaxHoldScope.c_str());
+            ImGui::NextColumn();
+
+            if (!expanded)
+                continue;
+
+            // Bucket 0 is below 1 us, then one bucket per power of two
+            float buckets[ForgeLockStats::HistogramBuckets];
+            for (uint32_t i = 0; i < ForgeLockStats::HistogramBuckets; i++)
+                buckets[i] = (float)lock.WaitHistogram[i];
+            ImGui::PlotHistogram("##WaitHistogram", buckets, ForgeLockStats::HistogramBuckets, 0,
+                                 "waits: <1us .. >16ms", 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+            ImGui::NextColumn();
+            ImGui::NextColumn();
+            ImGui::NextColumn();
+            ImGui::NextColumn();
+            ImGui::NextColumn();
+            if (!lock.MaxHoldScope.empty())
+                ImGui::TextWrapped("%s", lock.MaxHoldScope.c_str());
+            ImGui::NextColumn();
+            ImGui::TreePop();
+        }
+
+        ImGui::Columns(1);
+        ImGui::EndChild();
+    }
+
+    void LockContentionPanel::OnEvent(Event& event)
+    {
+        Layer::OnEvent(event);
+    }
+
+    void LockContentionPanel::Open()
+    {
+        opened_ = true;
+    }
+
+    void LockContentionPanel::Close()
+    {
+        opened_ = false;
+    }
+}
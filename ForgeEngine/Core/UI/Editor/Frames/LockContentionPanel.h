@@ -0,0 +1,35 @@
+#pragma once
+#include "imgui.h"
+#include "Core/Layer/Layer.h"
+#include "Core/Threading/ForgeMutex.h"
+
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Per lock acquisitions, contended waits and the longest hold, to spot
+    // the locks threads queue up on
+    class LockContentionPanel : public Layer
+    {
+    public:
+        LockContentionPanel();
+        ~LockContentionPanel() override;
+
+        void OnAttach() override;
+        void OnDetach() override;
+        void OnUpdate(Timestep ts) override;
+        void OnImGuiRender() override;
+        void OnEvent(Event& event) override;
+        void Open();
+        void Close();
+
+    private:
+        void DrawLocks();
+
+        bool opened_ = false;
+        bool hide_uncontended_ = false;
+        float refresh_timer_ = 0.0f;
+        std::vector<LockContentionReport> report_;
+        ImGuiWindowFlags window_flags_ = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoFocusOnAppearing;
+    };
+}
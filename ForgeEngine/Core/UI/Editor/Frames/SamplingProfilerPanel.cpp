@@ -0,0 +1,164 @@
+#include "SamplingProfilerPanel.h"
+
+#include "imgui.h"
+
+namespace ForgeEngine
+{
+    // Symbolizing takes a while on large captures, a few refreshes per
+    // second are plenty
+    static constexpr float s_SamplingRefreshSeconds = 0.5f;
+
+    SamplingProfilerPanel::SamplingProfilerPanel()
+    {
+        debug_name_ = "SamplingProfilerPanel";
+    }
+
+    SamplingProfilerPanel::~SamplingProfilerPanel() = default;
+
+    void SamplingProfilerPanel::OnAttach()
+    {
+        Layer::OnAttach();
+    }
+
+    void SamplingProfilerPanel::OnDetach()
+    {
+        Layer::OnDetach();
+    }
+
+    void SamplingProfilerPanel::OnUpdate(Timestep ts)
+    {
+        Layer::OnUpdate(ts);
+
+        if (!opened_ || !auto_refresh_ || !SamplingProfiler::IsRunning())
+            return;
+
+        refresh_timer_ += ts.GetSeconds();
+        if (refresh_timer_ >= s_SamplingRefreshSeconds)
+        {
+            refresh_timer_ = 0.0f;
+            Refresh();
+        }
+    }
+
+    void SamplingProfilerPanel::OnImGuiRender()
+    {
+        Layer::OnImGuiRender();
+
+        if (!opened_)
+            return;
+
+        ImGui::SetNextWindowSize(ImVec2(560.0f, 420.0f), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Sampling Profiler", &opened_, window_flags_))
+        {
+            ImGui::End();
+            return;
+        }
+
+        if (!SamplingProfiler::IsSupported())
+        {
+            ImGui::Text("Sampling is not supported on this platform");
+            ImGui::End();
+            return;
+        }
+
+        stats_ = SamplingProfiler::GetStats();
+
+        if (stats_.Running)
+        {
+            if (ImGui::Button("Stop"))
+            {
+                SamplingProfiler::Stop();
+                Refresh();
+            }
+        }
+        else if (ImGui::Button("Start"))
+        {
+            functions_.clear();
+            window_samples_ = 0;
+            SamplingProfiler::Start((uint32_t)frequency_hz_);
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(160.0f);
+        ImGui::SliderInt("Rate (Hz)", &frequency_hz_, 100, 4000);
+
+        ImGui::SliderInt("Frames", &frame_window_, 0, 3600);
+        ImGui::SliderInt("Functions", &function_count_, 10, 200);
+
+        if (ImGui::Button("Refresh"))
+            Refresh();
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto Refresh", &auto_refresh_);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Folded"))
+            SamplingProfiler::ExportFoldedStacks("SamplingProfile.folded", (uint32_t)frame_window_);
+
+        ImGui::Separator();
+        ImGui::Text("Threads: %u, Rate: %u Hz", stats_.Threads, stats_.FrequencyHz);
+        ImGui::Text("Samples: %llu, Stacks: %u, Dropped: %llu",
+                    (unsigned long long)stats_.Samples, stats_.UniqueStacks,
+                    (unsigned long long)stats_.Dropped);
+        if (stats_.Samples)
+            ImGui::Text("Frames: %llu - %llu", (unsigned long long)stats_.FirstFrame,
+                        (unsigned long long)stats_.LastFrame);
+
+        ImGui::Separator();
+        DrawFunctions();
+
+        ImGui::End();
+    }
+
+    void SamplingProfilerPanel::Refresh()
+    {
+        functions_ = SamplingProfiler::GetTopFunctions((uint32_t)function_count_,
+                                                       (uint32_t)frame_window_);
+        window_samples_ = SamplingProfiler::GetSampleCount((uint32_t)frame_window_);
+    }
+
+    void SamplingProfilerPanel::DrawFunctions()
+    {
+        // Of all samples in the window, every thread included
+        uint64_t total = window_samples_;
+
+        ImGui::BeginChild("SampledFunctions");
+        ImGui::Columns(3, "SampledFunctions");
+        ImGui::Text("Function");
+        ImGui::NextColumn();
+        ImGui::Text("Self");
+        ImGui::NextColumn();
+        ImGui::Text("Total");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const SampledFunction& function : functions_)
+        {
+            ImGui::TextUnformatted(function.Name.c_str());
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", function.Name.c_str());
+            ImGui::NextColumn();
+            float self = total ? (float)function.SelfSamples / (float)total : 0.0f;
+            ImGui::Text("%5.1f%% (%u)", self * 100.0f, function.SelfSamples);
+            ImGui::NextColumn();
+            float inclusive = total ? (float)function.TotalSamples / (float)total : 0.0f;
+            ImGui::ProgressBar(inclusive, ImVec2(-1.0f, 0.0f));
+            ImGui::NextColumn();
+        }
+
+        ImGui::Columns(1);
+        ImGui::EndChild();
+    }
+
+    void SamplingProfilerPanel::OnEvent(Event& event)
+    {
+        Layer::OnEvent(event);
+    }
+
+    void SamplingProfilerPanel::Open()
+    {
+        opened_ = true;
+    }
+
+    void SamplingProfilerPanel::Close()
+    {
+        opened_ = false;
+    }
+}
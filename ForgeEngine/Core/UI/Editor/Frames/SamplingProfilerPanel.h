@@ -0,0 +1,42 @@
+#pragma once
+#include "imgui.h"
+#include "Core/Layer/Layer.h"
+#include "Core/Debug/SamplingProfiler.h"
+
+#include <vector>
+
+namespace ForgeEngine
+{
+    // Start and stop the sampling profiler and read where the CPU time of
+    // the last frames went, per function
+    class SamplingProfilerPanel : public Layer
+    {
+    public:
+        SamplingProfilerPanel();
+        ~SamplingProfilerPanel() override;
+
+        void OnAttach() override;
+        void OnDetach() override;
+        void OnUpdate(Timestep ts) override;
+        void OnImGuiRender() override;
+        void OnEvent(Event& event) override;
+        void Open();
+        void Close();
+
+    private:
+        void Refresh();
+        void DrawFunctions();
+
+        bool opened_ = false;
+        int frequency_hz_ = 1000;
+        // 0 aggregates everything since Start
+        int frame_window_ = 300;
+        int function_count_ = 40;
+        bool auto_refresh_ = false;
+        float refresh_timer_ = 0.0f;
+        std::vector<SampledFunction> functions_;
+        uint64_t window_samples_ = 0;
+        SamplingProfilerStats stats_;
+        ImGuiWindowFlags window_flags_ = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoFocusOnAppearing;
+    };
+}
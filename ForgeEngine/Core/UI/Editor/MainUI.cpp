@@ -91,6 +91,21 @@ namespace ForgeEngine
                 {
                     OpenFPSHistory();
                 }
+
+                if (ImGui::MenuItem("GPU Profiler"))
+                {
+                    OpenGpuProfiler();
+                }
+
+                if (ImGui::MenuItem("Sampling Profiler"))
+                {
+                    OpenSamplingProfiler();
+                }
+
+                if (ImGui::MenuItem("Lock Contention"))
+                {
+                    OpenLockContention();
+                }
                 ImGui::EndMenu();
             }
 
@@ -111,4 +126,35 @@ namespace ForgeEngine
         Application::Get().PushLayer(fps_inspector_);
         fps_inspector_->Open();
     }
+
+    void MainUI::OpenGpuProfiler()
+    {
+        // One panel is enough, reopen it instead of stacking another
+        if (!gpu_profiler_)
+        {
+            gpu_profiler_ = new GpuProfilerPanel();
+            Application::Get().PushLayer(gpu_profiler_);
+        }
+        gpu_profiler_->Open();
+    }
+
+    void MainUI::OpenSamplingProfiler()
+    {
+        if (!sampling_profiler_)
+        {
+            sampling_profiler_ = new SamplingProfilerPanel();
+            Application::Get().PushLayer(sampling_profiler_);
+        }
+        sampling_profiler_->Open();
+    }
+
+    void MainUI::OpenLockContention()
+    {
+        if (!lock_contention_)
+        {
+            lock_contention_ = new LockContentionPanel();
+            Application::Get().PushLayer(lock_contention_);
+        }
+        lock_contention_->Open();
+    }
 }
@@ -2,6 +2,9 @@
 #include <imgui.h>
 #include "Core/Layer/Layer.h"
 #include "Frames/FpsInspector.h"
+#include "Frames/GpuProfilerPanel.h"
+#include "Frames/SamplingProfilerPanel.h"
+#include "Frames/LockContentionPanel.h"
 
 namespace ForgeEngine
 {
@@ -30,9 +33,15 @@ namespace ForgeEngine
         void OpenConsole();
 
         void OpenFPSHistory();
+        void OpenGpuProfiler();
+        void OpenSamplingProfiler();
+        void OpenLockContention();
 
         Console* console_;
         FpsInspector* fps_inspector_;
+        GpuProfilerPanel* gpu_profiler_ = nullptr;
+        SamplingProfilerPanel* sampling_profiler_ = nullptr;
+        LockContentionPanel* lock_contention_ = nullptr;
 
     };
 }
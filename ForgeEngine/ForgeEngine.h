@@ -12,6 +12,7 @@
 #include "Core/Camera/Camera3D.h"
 #include "Core/Camera/Camera3DController.h"
 #include "Core/Renderer/Mesh.h"
+#include "Core/Renderer/PrimitiveCache.h"
 #include "Core/Camera/Camera3DController.h"
 
 namespace ForgeEngine {
@@ -13,17 +13,18 @@ namespace ForgeEngine {
 		FENGINE_PROFILE_FUNCTION();
 
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const void* vertices, uint32_t size)
+		: m_Immutable(true)
 	{
 		FENGINE_PROFILE_FUNCTION();
 
+		// Immutable storage lets the driver copy straight from the source
+		// memory and place the buffer wherever it wants
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		glNamedBufferStorage(m_RendererID, size, vertices, 0);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
@@ -35,39 +36,37 @@ namespace ForgeEngine {
 
 	void OpenGLVertexBuffer::Bind() const
 	{
-		FENGINE_PROFILE_FUNCTION();
+		FENGINE_PROFILE_DETAIL_FUNCTION();
 
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		FENGINE_PROFILE_FUNCTION();
+		FENGINE_PROFILE_DETAIL_FUNCTION();
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
-	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
+	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		FENGINE_CORE_ASSERT(!m_Immutable, "Vertex buffer was created immutable!");
+
+		glNamedBufferSubData(m_RendererID, offset, size, data);
 	}
 
 	/////////////////////////////////////////////////////////////////////////////
 	// IndexBuffer //////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		: m_Count(count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type)
+		: m_Count(count), m_Type(type)
 	{
 		FENGINE_PROFILE_FUNCTION();
 
+		// DSA storage does not need a bound VAO to fill an element buffer
 		glCreateBuffers(1, &m_RendererID);
-
-		// GL_ELEMENT_ARRAY_BUFFER is not valid without an actively bound VAO
-		// Binding with GL_ARRAY_BUFFER allows the data to be loaded regardless of VAO state.
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		glNamedBufferStorage(m_RendererID, count * IndexTypeSize(type), indices, 0);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -79,14 +78,14 @@ namespace ForgeEngine {
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		FENGINE_PROFILE_FUNCTION();
+		FENGINE_PROFILE_DETAIL_FUNCTION();
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		FENGINE_PROFILE_FUNCTION();
+		FENGINE_PROFILE_DETAIL_FUNCTION();
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
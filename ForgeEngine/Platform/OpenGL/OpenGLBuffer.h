@@ -8,34 +8,41 @@ namespace ForgeEngine {
   {
   public:
     OpenGLVertexBuffer(uint32_t size);
-    OpenGLVertexBuffer(float* vertices, uint32_t size);
+    OpenGLVertexBuffer(const void* vertices, uint32_t size);
     virtual ~OpenGLVertexBuffer();
 
     virtual void Bind() const override;
     virtual void Unbind() const override;
 
-    virtual void SetData(const void* data, uint32_t size) override;
+    virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
 
     virtual const BufferLayout& GetLayout() const override { return m_Layout; }
     virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+    uint32_t GetRendererID() const { return m_RendererID; }
   private:
     uint32_t m_RendererID;
     BufferLayout m_Layout;
+    bool m_Immutable = false;
   };
 
   class OpenGLIndexBuffer : public IndexBuffer
   {
   public:
-    OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+    OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type);
     virtual ~OpenGLIndexBuffer();
 
     virtual void Bind() const;
     virtual void Unbind() const;
 
     virtual uint32_t GetCount() const { return m_Count; }
+    virtual IndexType GetIndexType() const { return m_Type; }
+
+    uint32_t GetRendererID() const { return m_RendererID; }
   private:
     uint32_t m_RendererID;
     uint32_t m_Count;
+    IndexType m_Type;
   };
 
 }
\ No newline at end of file
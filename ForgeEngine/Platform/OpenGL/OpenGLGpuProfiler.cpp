@@ -0,0 +1,288 @@
+#include "Platform/OpenGL/OpenGLGpuProfiler.h"
+
+#include "FEPCH.h"
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace ForgeEngine
+{
+    // Same order as the fields of GpuPipelineStatistics
+    static const GLenum s_PipelineStatisticsTargets[] = {
+        GL_VERTICES_SUBMITTED,
+        GL_PRIMITIVES_SUBMITTED,
+        GL_VERTEX_SHADER_INVOCATIONS,
+        GL_CLIPPING_INPUT_PRIMITIVES,
+        GL_CLIPPING_OUTPUT_PRIMITIVES,
+        GL_FRAGMENT_SHADER_INVOCATIONS,
+    };
+
+    static bool HasGpuProfilerExtension(const char* name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++)
+        {
+            const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (extension && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    OpenGLGpuProfiler::OpenGLGpuProfiler()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        // Both are core since 4.3 and 4.6, the ARB and KHR names have the
+        // same entry points and enums
+        m_DebugGroups = GLAD_GL_VERSION_4_3 || HasGpuProfilerExtension("GL_KHR_debug");
+        m_SupportsStatistics = GLAD_GL_VERSION_4_6
+            || HasGpuProfilerExtension("GL_ARB_pipeline_statistics_query");
+
+        Calibrate();
+    }
+
+    OpenGLGpuProfiler::~OpenGLGpuProfiler()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        for (FrameSlot& slot : m_Frames)
+        {
+            if (!slot.Timestamps.empty())
+                glDeleteQueries((GLsizei)slot.Timestamps.size(), slot.Timestamps.data());
+            if (!slot.Statistics.empty())
+                glDeleteQueries((GLsizei)slot.Statistics.size(), slot.Statistics.data());
+        }
+    }
+
+    void OpenGLGpuProfiler::BeginFrame()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        FENGINE_CORE_ASSERT(m_OpenScopes.empty(), "GPU scope opened outside of a frame!");
+        while (!m_OpenScopes.empty())
+            PopScope();
+
+        if (m_FrameIndex % CalibrationInterval == 0)
+            Calibrate();
+
+        // The slot was last filled FrameLatency frames ago
+        FrameSlot& slot = m_Frames[m_FrameIndex % FrameLatency];
+        if (slot.Pending)
+            Resolve(slot);
+
+        slot.UsedTimestamps = 0;
+        slot.UsedStatistics = 0;
+        slot.Scopes.clear();
+        slot.FrameIndex = m_FrameIndex;
+        slot.Pending = false;
+
+        m_Current = &slot;
+        m_StatisticsScope = NoStatistics;
+        PushScope("Frame");
+    }
+
+    void OpenGLGpuProfiler::EndFrame()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        if (!m_Current)
+            return;
+
+        // Scopes left open would unbalance the debug groups of the next frame
+        FENGINE_CORE_ASSERT(m_OpenScopes.size() == 1, "GPU scopes still open at the end of the frame!");
+        while (!m_OpenScopes.empty())
+            PopScope();
+
+        m_Current->Pending = !m_Current->Scopes.empty();
+        m_Current = nullptr;
+        m_FrameIndex++;
+    }
+
+    void OpenGLGpuProfiler::BeginScope(const char* name)
+    {
+        PushScope(name);
+    }
+
+    void OpenGLGpuProfiler::EndScope()
+    {
+        if (m_OpenScopes.empty())
+        {
+            FENGINE_CORE_ASSERT(false, "EndScope without a matching BeginScope!");
+            return;
+        }
+        PopScope();
+    }
+
+    void OpenGLGpuProfiler::SetPipelineStatisticsEnabled(bool enabled)
+    {
+        m_StatisticsEnabled = enabled && m_SupportsStatistics;
+    }
+
+    uint32_t OpenGLGpuProfiler::AcquireTimestamp(FrameSlot& slot)
+    {
+        if (slot.UsedTimestamps == slot.Timestamps.size())
+        {
+            size_t oldSize = slot.Timestamps.size();
+            size_t newSize = oldSize ? oldSize * 2 : 64;
+            slot.Timestamps.resize(newSize);
+            glCreateQueries(GL_TIMESTAMP, (GLsizei)(newSize - oldSize),
+                            slot.Timestamps.data() + oldSize);
+        }
+        return slot.Timestamps[slot.UsedTimestamps++];
+    }
+
+    uint32_t OpenGLGpuProfiler::AcquireStatistics(FrameSlot& slot)
+    {
+        if (slot.UsedStatistics == slot.Statistics.size())
+        {
+            size_t oldSize = slot.Statistics.size();
+            slot.Statistics.resize(oldSize + StatisticsQueryCount);
+            for (uint32_t i = 0; i < StatisticsQueryCount; i++)
+                glCreateQueries(s_PipelineStatisticsTargets[i], 1, &slot.Statistics[oldSize + i]);
+        }
+
+        uint32_t first = slot.UsedStatistics;
+        slot.UsedStatistics += StatisticsQueryCount;
+        return first;
+    }
+
+    void OpenGLGpuProfiler::PushScope(const char* name)
+    {
+        if (m_DebugGroups)
+            glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+
+        if (!m_Current || !m_Enabled)
+        {
+            m_OpenScopes.push_back(NotRecorded);
+            return;
+        }
+
+        ScopeRecord record;
+        record.Name = name;
+        record.Depth = (uint32_t)m_OpenScopes.size();
+        record.BeginQuery = AcquireTimestamp(*m_Current);
+        record.EndQuery = 0;
+        record.StatisticsQuery = NoStatistics;
+        glQueryCounter(record.BeginQuery, GL_TIMESTAMP);
+
+        uint32_t index = (uint32_t)m_Current->Scopes.size();
+
+        // Only one query per target can be active, so the counters cover
+        // the outermost pass below the frame
+        if (m_StatisticsEnabled && record.Depth == 1 && m_StatisticsScope == NoStatistics)
+        {
+            record.StatisticsQuery = AcquireStatistics(*m_Current);
+            for (uint32_t i = 0; i < StatisticsQueryCount; i++)
+                glBeginQuery(s_PipelineStatisticsTargets[i],
+                             m_Current->Statistics[record.StatisticsQuery + i]);
+            m_StatisticsScope = index;
+        }
+
+        m_Current->Scopes.push_back(record);
+        m_OpenScopes.push_back(index);
+    }
+
+    void OpenGLGpuProfiler::PopScope()
+    {
+        uint32_t index = m_OpenScopes.back();
+        m_OpenScopes.pop_back();
+
+        if (index != NotRecorded && m_Current)
+        {
+            ScopeRecord& record = m_Current->Scopes[index];
+            if (record.StatisticsQuery != NoStatistics)
+            {
+                for (uint32_t i = 0; i < StatisticsQueryCount; i++)
+                    glEndQuery(s_PipelineStatisticsTargets[i]);
+                m_StatisticsScope = NoStatistics;
+            }
+
+            record.EndQuery = AcquireTimestamp(*m_Current);
+            glQueryCounter(record.EndQuery, GL_TIMESTAMP);
+        }
+
+        if (m_DebugGroups)
+            glPopDebugGroup();
+    }
+
+    void OpenGLGpuProfiler::Resolve(FrameSlot& slot)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        slot.Pending = false;
+
+        // The frame's end timestamp is written last; if even the slot a
+        // full ring ago is not done, drop it rather than stall the CPU
+        GLuint available = 0;
+        glGetQueryObjectuiv(slot.Scopes[0].EndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available && slot.UsedStatistics)
+            glGetQueryObjectuiv(slot.Statistics[slot.UsedStatistics - 1],
+                                GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            m_Stats.DroppedFrames++;
+            return;
+        }
+
+        GLuint64 frameStart = 0;
+        glGetQueryObjectui64v(slot.Scopes[0].BeginQuery, GL_QUERY_RESULT, &frameStart);
+
+        m_Latest.FrameIndex = slot.FrameIndex;
+        m_Latest.Scopes.clear();
+        for (const ScopeRecord& record : slot.Scopes)
+        {
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(record.BeginQuery, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(record.EndQuery, GL_QUERY_RESULT, &end);
+            if (end < begin)
+                end = begin;
+
+            GpuScopeTiming& timing = m_Latest.Scopes.emplace_back();
+            timing.Name = record.Name;
+            timing.Depth = record.Depth;
+            timing.StartMs = (double)(begin - frameStart) / 1.0e6;
+            timing.DurationMs = (double)(end - begin) / 1.0e6;
+
+            if (record.StatisticsQuery != NoStatistics)
+            {
+                GLuint64 values[StatisticsQueryCount] = {};
+                for (uint32_t i = 0; i < StatisticsQueryCount; i++)
+                    glGetQueryObjectui64v(slot.Statistics[record.StatisticsQuery + i],
+                                          GL_QUERY_RESULT, &values[i]);
+
+                timing.HasPipelineStatistics = true;
+                timing.PipelineStatistics.VerticesSubmitted = values[0];
+                timing.PipelineStatistics.PrimitivesSubmitted = values[1];
+                timing.PipelineStatistics.VertexShaderInvocations = values[2];
+                timing.PipelineStatistics.ClippingInputPrimitives = values[3];
+                timing.PipelineStatistics.ClippingOutputPrimitives = values[4];
+                timing.PipelineStatistics.FragmentShaderInvocations = values[5];
+            }
+
+#if FENGINE_PROFILE
+            Instrumentor::Get().WriteGpuProfile(
+                record.Name,
+                FloatingPointMicroseconds((double)((int64_t)begin + m_ClockOffsetNs) / 1.0e3),
+                FloatingPointMicroseconds((double)(end - begin) / 1.0e3));
+#endif
+        }
+
+        m_Latest.TotalMs = m_Latest.Scopes[0].DurationMs;
+        m_Stats.ScopesPerFrame = (uint32_t)m_Latest.Scopes.size();
+    }
+
+    void OpenGLGpuProfiler::Calibrate()
+    {
+        // GL_TIMESTAMP here is the GPU time once the commands issued so far
+        // have reached the GPU, close enough to line both tracks up
+        GLint64 gpuTime = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+        int64_t cpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        m_ClockOffsetNs = cpuTime - (int64_t)gpuTime;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Renderer/GpuProfiler.h"
+
+#include <array>
+#include <vector>
+
+namespace ForgeEngine
+{
+    class OpenGLGpuProfiler : public GpuProfiler
+    {
+    public:
+        OpenGLGpuProfiler();
+        virtual ~OpenGLGpuProfiler();
+
+        virtual void BeginFrame() override;
+        virtual void EndFrame() override;
+
+        virtual void BeginScope(const char* name) override;
+        virtual void EndScope() override;
+
+        virtual const GpuFrameTimings& GetLatestFrame() const override { return m_Latest; }
+        virtual GpuProfilerStats GetStats() const override { return m_Stats; }
+
+        virtual void SetEnabled(bool enabled) override { m_Enabled = enabled; }
+        virtual bool IsEnabled() const override { return m_Enabled; }
+
+        virtual bool SupportsPipelineStatistics() const override { return m_SupportsStatistics; }
+        virtual void SetPipelineStatisticsEnabled(bool enabled) override;
+        virtual bool IsPipelineStatisticsEnabled() const override { return m_StatisticsEnabled; }
+
+    private:
+        static constexpr uint32_t StatisticsQueryCount = 6;
+        static constexpr uint32_t NoStatistics = ~0u;
+        // Frames between two samples of the GPU clock against the CPU one
+        static constexpr uint32_t CalibrationInterval = 256;
+
+        struct ScopeRecord
+        {
+            const char* Name;
+            uint32_t Depth;
+            uint32_t BeginQuery;
+            uint32_t EndQuery;
+            uint32_t StatisticsQuery; // first of StatisticsQueryCount, or NoStatistics
+        };
+
+        // Queries are pooled per slot and only grow, a frame never waits
+        // for the one FrameLatency frames earlier
+        struct FrameSlot
+        {
+            std::vector<uint32_t> Timestamps;
+            std::vector<uint32_t> Statistics;
+            uint32_t UsedTimestamps = 0;
+            uint32_t UsedStatistics = 0;
+
+            std::vector<ScopeRecord> Scopes;
+            uint64_t FrameIndex = 0;
+            bool Pending = false;
+        };
+
+        uint32_t AcquireTimestamp(FrameSlot& slot);
+        uint32_t AcquireStatistics(FrameSlot& slot);
+        void PushScope(const char* name);
+        void PopScope();
+        void Resolve(FrameSlot& slot);
+        void Calibrate();
+
+        std::array<FrameSlot, FrameLatency> m_Frames;
+        FrameSlot* m_Current = nullptr;
+        uint64_t m_FrameIndex = 0;
+
+        // Indices into m_Current->Scopes of the open scopes, NotRecorded for
+        // the ones that only have a debug group
+        static constexpr uint32_t NotRecorded = ~0u;
+        std::vector<uint32_t> m_OpenScopes;
+        uint32_t m_StatisticsScope = NoStatistics;
+
+        bool m_Enabled = true;
+        bool m_DebugGroups = false;
+        bool m_SupportsStatistics = false;
+        bool m_StatisticsEnabled = false;
+
+        // Steady clock minus GPU clock, in nanoseconds
+        int64_t m_ClockOffsetNs = 0;
+
+        GpuFrameTimings m_Latest;
+        GpuProfilerStats m_Stats;
+    };
+} // namespace ForgeEngine
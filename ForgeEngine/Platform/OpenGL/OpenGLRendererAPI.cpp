@@ -3,6 +3,23 @@
 #include <glad/glad.h>
 
 namespace ForgeEngine {
+  namespace Utils {
+    static GLenum PrimitiveTopologyToOpenGL(PrimitiveTopology topology) {
+      switch (topology) {
+        case PrimitiveTopology::Triangles: return GL_TRIANGLES;
+        case PrimitiveTopology::Lines: return GL_LINES;
+        case PrimitiveTopology::TriangleStrip: return GL_TRIANGLE_STRIP;
+      }
+
+      FENGINE_CORE_ASSERT(false, "Unknown PrimitiveTopology!");
+      return GL_TRIANGLES;
+    }
+
+    static GLenum IndexTypeToOpenGL(IndexType type) {
+      return type == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+  }
+
   void OpenGLMessageCallback(
     unsigned source,
     unsigned type,
@@ -12,13 +29,13 @@ namespace ForgeEngine {
     const char *message,
     const void *userParam) {
     switch (severity) {
-      case GL_DEBUG_SEVERITY_HIGH: FENGINE_CORE_CRITICAL(message);
+      case GL_DEBUG_SEVERITY_HIGH: FENGINE_CORE_LOG_DEDUP(CRITICAL, message);
         return;
-      case GL_DEBUG_SEVERITY_MEDIUM: FENGINE_CORE_ERROR(message);
+      case GL_DEBUG_SEVERITY_MEDIUM: FENGINE_CORE_LOG_DEDUP(ERROR, message);
         return;
-      case GL_DEBUG_SEVERITY_LOW: FENGINE_CORE_WARN(message);
+      case GL_DEBUG_SEVERITY_LOW: FENGINE_CORE_LOG_DEDUP(WARN, message);
         return;
-      case GL_DEBUG_SEVERITY_NOTIFICATION: FENGINE_CORE_TRACE(message);
+      case GL_DEBUG_SEVERITY_NOTIFICATION: FENGINE_CORE_LOG_DEDUP(TRACE, message);
         return;
     }
 
@@ -41,6 +58,10 @@ namespace ForgeEngine {
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_LINE_SMOOTH);
+
+    // The restart index is the maximum of the bound index type, 0xffff or
+    // 0xffffffff, so strips of either width share one setting
+    glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
   }
 
   void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -57,10 +78,55 @@ namespace ForgeEngine {
     glDepthMask(GL_TRUE);
   }
 
-  void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount) {
+  void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
+                                      PrimitiveTopology topology) {
+    vertexArray->Bind();
+    const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+    uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+    glDrawElements(Utils::PrimitiveTopologyToOpenGL(topology), count,
+                   Utils::IndexTypeToOpenGL(indexBuffer->GetIndexType()), nullptr);
+  }
+
+  void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
+                                               uint32_t instanceCount, PrimitiveTopology topology) {
     vertexArray->Bind();
-    uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+    const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+    uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+    glDrawElementsInstanced(Utils::PrimitiveTopologyToOpenGL(topology), count,
+                            Utils::IndexTypeToOpenGL(indexBuffer->GetIndexType()), nullptr,
+                            instanceCount);
+  }
+
+  void OpenGLRendererAPI::DrawIndexedInstancedBaseInstance(const Ref<VertexArray> &vertexArray,
+                                                           uint32_t indexCount, uint32_t instanceCount,
+                                                           uint32_t baseInstance,
+                                                           PrimitiveTopology topology) {
+    vertexArray->Bind();
+    const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+    uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+    glDrawElementsInstancedBaseInstance(Utils::PrimitiveTopologyToOpenGL(topology), count,
+                                        Utils::IndexTypeToOpenGL(indexBuffer->GetIndexType()),
+                                        nullptr, instanceCount, baseInstance);
+  }
+
+  void OpenGLRendererAPI::MultiDrawIndexed(const Ref<VertexArray> &vertexArray, const uint32_t *counts,
+                                           const uint32_t *firstIndices, uint32_t drawCount,
+                                           PrimitiveTopology topology) {
+    if (drawCount == 0)
+      return;
+
+    vertexArray->Bind();
+    const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+    uintptr_t indexSize = IndexTypeSize(indexBuffer->GetIndexType());
+
+    m_MultiDrawOffsets.resize(drawCount);
+    for (uint32_t i = 0; i < drawCount; i++)
+      m_MultiDrawOffsets[i] = reinterpret_cast<const void *>(firstIndices[i] * indexSize);
+
+    glMultiDrawElements(Utils::PrimitiveTopologyToOpenGL(topology),
+                        reinterpret_cast<const GLsizei *>(counts),
+                        Utils::IndexTypeToOpenGL(indexBuffer->GetIndexType()),
+                        m_MultiDrawOffsets.data(), (GLsizei)drawCount);
   }
 
   void OpenGLRendererAPI::DrawLines(const Ref<VertexArray> &vertexArray, uint32_t vertexCount) {
@@ -12,10 +12,28 @@ namespace ForgeEngine {
 
     virtual void Clear() override;
 
-    virtual void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount = 0) override;
+    virtual void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount = 0,
+                             PrimitiveTopology topology = PrimitiveTopology::Triangles) override;
+
+    virtual void DrawIndexedInstanced(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
+                                      uint32_t instanceCount,
+                                      PrimitiveTopology topology = PrimitiveTopology::Triangles) override;
+
+    virtual void DrawIndexedInstancedBaseInstance(const Ref<VertexArray> &vertexArray,
+                                                  uint32_t indexCount, uint32_t instanceCount,
+                                                  uint32_t baseInstance,
+                                                  PrimitiveTopology topology = PrimitiveTopology::Triangles) override;
+
+    virtual void MultiDrawIndexed(const Ref<VertexArray> &vertexArray, const uint32_t *counts,
+                                  const uint32_t *firstIndices, uint32_t drawCount,
+                                  PrimitiveTopology topology = PrimitiveTopology::Triangles) override;
 
     virtual void DrawLines(const Ref<VertexArray> &vertexArray, uint32_t vertexCount) override;
 
     virtual void SetLineWidth(float width) override;
+
+  private:
+    // Byte offsets for glMultiDrawElements, kept to avoid a per-call allocation
+    std::vector<const void *> m_MultiDrawOffsets;
   };
 } // BEngine
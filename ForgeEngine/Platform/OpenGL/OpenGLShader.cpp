@@ -254,17 +254,17 @@ void OpenGLShader::CreateProgram(const std::unordered_map<GLenum, std::string>&
 }
 
 void OpenGLShader::Bind() const {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   glUseProgram(m_RendererID);
 }
 
 void OpenGLShader::Unbind() const {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   glUseProgram(0);
 }
 
 void OpenGLShader::SetInt(const std::string& name, int value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformInt(name, value);
 }
 
@@ -273,27 +273,32 @@ void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t co
 }
 
 void OpenGLShader::SetFloat(const std::string& name, float value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformFloat(name, value);
 }
 
 void OpenGLShader::SetFloat2(const std::string& name, const glm::vec2& value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformFloat2(name, value);
 }
 
 void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformFloat3(name, value);
 }
 
 void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformFloat4(name, value);
 }
 
+void OpenGLShader::SetMat3(const std::string& name, const glm::mat3& value) {
+  FENGINE_PROFILE_DETAIL_FUNCTION();
+  UploadUniformMat3(name, value);
+}
+
 void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
   UploadUniformMat4(name, value);
 }
 
@@ -3,38 +3,12 @@
 #include "ThirdParty/stbimage/stb_image.h"
 
 #include "FEPCH.h"
+#include "Core/Renderer/CookedTexture.h"
+#include "Platform/OpenGL/OpenGLTextureUtils.h"
 //#include "example/ImApp.h"
 
 namespace ForgeEngine {
 
-namespace Utils {
-
-static GLenum ForgeEngineImageFormatToGLDataFormat(ImageFormat format) {
-  switch (format) {
-    case ImageFormat::RGB8:
-      return GL_RGB;
-    case ImageFormat::RGBA8:
-      return GL_RGBA;
-  }
-
-  FENGINE_CORE_ASSERT(false);
-  return 0;
-}
-
-static GLenum ForgeEngineImageFormatToGLInternalFormat(ImageFormat format) {
-  switch (format) {
-    case ImageFormat::RGB8:
-      return GL_RGB8;
-    case ImageFormat::RGBA8:
-      return GL_RGBA8;
-  }
-
-  FENGINE_CORE_ASSERT(false);
-  return 0;
-}
-
-}  // namespace Utils
-
 OpenGLTexture2D::OpenGLTexture2D(const TextureSpecification& specification)
     : m_Specification(specification),
       m_Width(m_Specification.Width),
@@ -45,26 +19,34 @@ OpenGLTexture2D::OpenGLTexture2D(const TextureSpecification& specification)
       Utils::ForgeEngineImageFormatToGLInternalFormat(m_Specification.Format);
   m_DataFormat = Utils::ForgeEngineImageFormatToGLDataFormat(m_Specification.Format);
 
-  glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-  glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+  // The GPU cannot build mips for block compressed data, those come cooked
+  if (m_Specification.GenerateMips &&
+      !IsCompressedImageFormat(m_Specification.Format))
+    m_MipLevels = CalculateMipCount(m_Width, m_Height);
 
-  glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+  glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width,
+                     m_Height);
 
-  glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  Utils::SetDefaultTextureParameters(m_RendererID, m_MipLevels);
 }
 
 OpenGLTexture2D::OpenGLTexture2D(const std::string& path) : m_Path(path) {
   FENGINE_PROFILE_FUNCTION();
 
+  if (CookedTexture::IsCookedTexturePath(path)) {
+    LoadCooked(path);
+    return;
+  }
+
   int width, height, channels;
   stbi_set_flip_vertically_on_load(1);
   stbi_uc* data = nullptr;
   {
     FENGINE_PROFILE_SCOPE(
         "stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-    data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    // Always expand to RGBA, 3-channel uploads force the driver to swizzle
+    data = stbi_load(path.c_str(), &width, &height, &channels, 4);
   }
 
   if (data) {
@@ -73,36 +55,85 @@ OpenGLTexture2D::OpenGLTexture2D(const std::string& path) : m_Path(path) {
     m_Width = width;
     m_Height = height;
 
-    GLenum internalFormat = 0, dataFormat = 0;
-    if (channels == 4) {
-      internalFormat = GL_RGBA8;
-      dataFormat = GL_RGBA;
-    } else if (channels == 3) {
-      internalFormat = GL_RGB8;
-      dataFormat = GL_RGB;
-    }
+    m_Specification.Width = m_Width;
+    m_Specification.Height = m_Height;
+    m_Specification.Format = ImageFormat::RGBA8;
 
-    m_InternalFormat = internalFormat;
-    m_DataFormat = dataFormat;
+    m_InternalFormat = GL_RGBA8;
+    m_DataFormat = GL_RGBA;
 
-    FENGINE_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+    if (m_Specification.GenerateMips)
+      m_MipLevels = CalculateMipCount(m_Width, m_Height);
 
     glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-    glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
-
-    glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width,
+                       m_Height);
 
-    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    Utils::SetDefaultTextureParameters(m_RendererID, m_MipLevels);
 
-    glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat,
+    glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat,
                         GL_UNSIGNED_BYTE, data);
 
+    if (m_MipLevels > 1)
+      glGenerateTextureMipmap(m_RendererID);
+
     stbi_image_free(data);
   }
 }
 
+void OpenGLTexture2D::LoadCooked(const std::string& path) {
+  FENGINE_PROFILE_FUNCTION();
+
+  Ref<CookedTexture> cooked = CookedTexture::Open(path);
+  if (!cooked)
+    return;
+
+  m_Width = cooked->GetWidth();
+  m_Height = cooked->GetHeight();
+  m_MipLevels = cooked->GetMipCount();
+
+  m_Specification.Width = m_Width;
+  m_Specification.Height = m_Height;
+  m_Specification.Format = cooked->GetFormat();
+  m_Specification.GenerateMips = m_MipLevels > 1;
+
+  m_InternalFormat =
+      Utils::ForgeEngineImageFormatToGLInternalFormat(m_Specification.Format);
+  m_DataFormat = Utils::ForgeEngineImageFormatToGLDataFormat(m_Specification.Format);
+
+  glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+  glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width,
+                     m_Height);
+
+  Utils::SetDefaultTextureParameters(m_RendererID, m_MipLevels);
+
+  // Straight from the mapping, no intermediate copy
+  for (uint32_t level = 0; level < m_MipLevels; level++) {
+    const CookedTextureLevel& info = cooked->GetLevel(level);
+    Utils::UploadTextureRegion(m_RendererID, level, m_Specification.Format, 0,
+                               info.Width, info.Height,
+                               cooked->GetLevelData(level));
+  }
+
+  m_IsLoaded = true;
+}
+
+void OpenGLTexture2D::AdoptTexture(uint32_t rendererID,
+                                   const TextureSpecification& specification,
+                                   uint32_t mipLevels) {
+  glDeleteTextures(1, &m_RendererID);
+
+  m_RendererID = rendererID;
+  m_Specification = specification;
+  m_Width = specification.Width;
+  m_Height = specification.Height;
+  m_MipLevels = mipLevels;
+  m_InternalFormat =
+      Utils::ForgeEngineImageFormatToGLInternalFormat(specification.Format);
+  m_DataFormat = Utils::ForgeEngineImageFormatToGLDataFormat(specification.Format);
+  m_IsLoaded = true;
+}
+
 OpenGLTexture2D::~OpenGLTexture2D() {
   FENGINE_PROFILE_FUNCTION();
 
@@ -112,16 +143,19 @@ OpenGLTexture2D::~OpenGLTexture2D() {
 void OpenGLTexture2D::SetData(void* data, uint32_t size) {
   FENGINE_PROFILE_FUNCTION();
 
-  uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
-  FENGINE_CORE_ASSERT(size == m_Width * m_Height * bpp,
+  FENGINE_CORE_ASSERT(size == ImageFormatLevelSize(m_Specification.Format,
+                                                   m_Width, m_Height),
                  "Data must be entire texture!");
-  glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat,
-                      GL_UNSIGNED_BYTE, data);
+  Utils::UploadTextureRegion(m_RendererID, 0, m_Specification.Format, 0,
+                             m_Width, m_Height, data);
+
+  if (m_MipLevels > 1 && !IsCompressedImageFormat(m_Specification.Format))
+    glGenerateTextureMipmap(m_RendererID);
 }
 
 void OpenGLTexture2D::Bind(uint32_t slot) const {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
 
   glBindTextureUnit(slot, m_RendererID);
 }
-}  // namespace ForgeEngine
\ No newline at end of file
+}  // namespace ForgeEngine
@@ -30,14 +30,27 @@ namespace ForgeEngine {
         {
             return m_RendererID == other.GetRendererID();
         }
+        uint32_t GetMipLevelCount() const { return m_MipLevels; }
     private:
+        // Swaps the streamed image in place of the placeholder
+        friend class OpenGLTextureStreamer;
+
+        void LoadCooked(const std::string& path);
+
+        // Takes ownership of a fully uploaded texture object and releases the
+        // current one
+        void AdoptTexture(uint32_t rendererID,
+                          const TextureSpecification& specification,
+                          uint32_t mipLevels);
+
         TextureSpecification m_Specification;
 
         std::string m_Path;
         bool m_IsLoaded = false;
-        uint32_t m_Width, m_Height;
-        uint32_t m_RendererID;
-        GLenum m_InternalFormat, m_DataFormat;
+        uint32_t m_Width = 0, m_Height = 0;
+        uint32_t m_RendererID = 0;
+        uint32_t m_MipLevels = 1;
+        GLenum m_InternalFormat = 0, m_DataFormat = 0;
     };
 
 }
\ No newline at end of file
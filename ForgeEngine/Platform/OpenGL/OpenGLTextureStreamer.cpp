@@ -0,0 +1,363 @@
+#include "Platform/OpenGL/OpenGLTextureStreamer.h"
+
+#include "FEPCH.h"
+#include "Core/Threading/JobSystem.h"
+#include "Platform/OpenGL/OpenGLTexture2D.h"
+#include "Platform/OpenGL/OpenGLTextureUtils.h"
+#include "ThirdParty/stbimage/stb_image.h"
+
+#include <cstring>
+
+namespace ForgeEngine
+{
+    OpenGLTextureStreamer::OpenGLTextureStreamer()
+        : m_State(std::make_shared<SharedState>())
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        // The flip flag is global inside stb_image, set it once here instead
+        // of racing on it from the decode jobs
+        stbi_set_flip_vertically_on_load(1);
+
+        // One persistently mapped buffer split in slots. Each slot is guarded
+        // by a fence so we never write into memory the GPU is still reading.
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+            | GL_MAP_COHERENT_BIT;
+        GLsizeiptr totalSize = (GLsizeiptr)StagingSlotCount * StagingSlotSize;
+
+        glCreateBuffers(1, &m_StagingBuffer);
+        glNamedBufferStorage(m_StagingBuffer, totalSize, nullptr, flags);
+        m_StagingMemory = (uint8_t*)glMapNamedBufferRange(m_StagingBuffer, 0,
+                                                         totalSize, flags);
+
+        for (uint32_t i = 0; i < StagingSlotCount; i++)
+            m_Slots[i].Offset = i * StagingSlotSize;
+
+        m_WindowStart = std::chrono::steady_clock::now();
+
+        FENGINE_CORE_ASSERT(m_StagingMemory,
+                            "Failed to map texture staging buffer!");
+    }
+
+    OpenGLTextureStreamer::~OpenGLTextureStreamer()
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        m_State->Alive = false;
+
+        if (m_Active)
+            glDeleteTextures(1, &m_Active->TextureID);
+
+        for (auto& slot : m_Slots)
+        {
+            if (slot.Fence)
+                glDeleteSync(slot.Fence);
+        }
+
+        glUnmapNamedBuffer(m_StagingBuffer);
+        glDeleteBuffers(1, &m_StagingBuffer);
+    }
+
+    Ref<Texture2D> OpenGLTextureStreamer::Load(const std::string& path)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        TextureSpecification placeholderSpec;
+        placeholderSpec.GenerateMips = false;
+
+        auto texture = CreateRef<OpenGLTexture2D>(placeholderSpec);
+        uint32_t placeholderData = 0xff808080;
+        texture->SetData(&placeholderData, sizeof(uint32_t));
+        texture->m_Path = path;
+
+        m_State->Queued++;
+
+        std::weak_ptr<OpenGLTexture2D> target = texture;
+        JobSystem::Submit([state = m_State, target, path]() {
+            FENGINE_PROFILE_SCOPE("OpenGLTextureStreamer Decode");
+
+            // Nobody is waiting for this texture anymore
+            if (!state->Alive || target.expired())
+            {
+                state->Queued--;
+                return;
+            }
+
+            DecodedImage image;
+            image.Target = target;
+            image.Path = path;
+
+            if (CookedTexture::IsCookedTexturePath(path))
+            {
+                image.Cooked = CookedTexture::Open(path);
+                if (!image.Cooked)
+                {
+                    state->Failed++;
+                    state->Queued--;
+                    return;
+                }
+
+                image.Format = image.Cooked->GetFormat();
+                image.Width = image.Cooked->GetWidth();
+                image.Height = image.Cooked->GetHeight();
+                image.GenerateMips = false;
+
+                // Fault the pages in here so the copy into the staging
+                // buffer on the main thread never waits on the disk
+                const volatile uint8_t* bytes = image.Cooked->GetLevelData(0);
+                uint64_t size = image.Cooked->GetFileSize()
+                    - image.Cooked->GetLevel(0).Offset;
+                for (uint64_t offset = 0; offset < size; offset += 4096)
+                    (void)bytes[offset];
+            }
+            else
+            {
+                int width, height, channels;
+                stbi_uc* data = stbi_load(path.c_str(), &width, &height,
+                                          &channels, 4);
+                if (!data)
+                {
+                    FENGINE_CORE_ERROR("Failed to decode texture '{}': {}",
+                                       path, stbi_failure_reason());
+                    state->Failed++;
+                    state->Queued--;
+                    return;
+                }
+
+                image.Width = (uint32_t)width;
+                image.Height = (uint32_t)height;
+                image.Pixels.assign(data, data + (size_t)width * height * 4);
+                stbi_image_free(data);
+            }
+
+            {
+                ForgeLockGuard lock(state->ReadyMutex);
+                state->Ready.push_back(std::move(image));
+            }
+            state->Queued--;
+        });
+
+        return texture;
+    }
+
+    void OpenGLTextureStreamer::ProcessUploads(float budgetMs)
+    {
+        FENGINE_PROFILE_FUNCTION();
+
+        auto start = std::chrono::steady_clock::now();
+        auto budget = std::chrono::duration<float, std::milli>(budgetMs);
+
+        {
+            ForgeLockGuard lock(m_State->ReadyMutex);
+            while (!m_State->Ready.empty())
+            {
+                m_Pending.push_back(std::move(m_State->Ready.front()));
+                m_State->Ready.pop_front();
+            }
+        }
+
+        if (!m_Active && m_Pending.empty())
+        {
+            UpdateThroughput();
+            return;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_StagingBuffer);
+
+        while (std::chrono::steady_clock::now() - start < budget)
+        {
+            if (!m_Active)
+            {
+                if (m_Pending.empty())
+                    break;
+
+                BeginUpload(std::move(m_Pending.front()));
+                m_Pending.pop_front();
+            }
+
+            // The texture was released while we were streaming it
+            if (m_Active->Image.Target.expired())
+            {
+                glDeleteTextures(1, &m_Active->TextureID);
+                m_Active.reset();
+                continue;
+            }
+
+            const DecodedImage& image = m_Active->Image;
+            uint32_t level = m_Active->Level;
+            uint32_t levelWidth = image.GetLevelWidth(level);
+            uint32_t levelHeight = image.GetLevelHeight(level);
+
+            // Compressed levels are copied in rows of 4x4 blocks
+            uint32_t blockHeight = IsCompressedImageFormat(image.Format) ? 4 : 1;
+            uint32_t rowCount = (levelHeight + blockHeight - 1) / blockHeight;
+            uint32_t rowSize = (uint32_t)ImageFormatLevelSize(image.Format,
+                                                              levelWidth,
+                                                              blockHeight);
+            uint32_t rowsPerSlot = StagingSlotSize / rowSize;
+            if (rowsPerSlot == 0)
+            {
+                FENGINE_CORE_ERROR("Texture '{}' is too wide to be streamed "
+                                   "({} pixels)", image.Path, image.Width);
+                glDeleteTextures(1, &m_Active->TextureID);
+                m_Active.reset();
+                m_State->Failed++;
+                continue;
+            }
+
+            // Every slot is still in use by the GPU, try again next frame
+            // instead of stalling on the fence
+            StagingSlot& slot = m_Slots[m_NextSlot];
+            if (!AcquireSlot(slot))
+                break;
+
+            uint32_t rows = std::min(rowsPerSlot, rowCount - m_Active->NextRow);
+            size_t chunkSize = (size_t)rows * rowSize;
+
+            std::memcpy(m_StagingMemory + slot.Offset,
+                        image.GetLevelData(level)
+                            + (size_t)m_Active->NextRow * rowSize,
+                        chunkSize);
+
+            uint32_t y = m_Active->NextRow * blockHeight;
+            uint32_t height = std::min(rows * blockHeight, levelHeight - y);
+            Utils::UploadTextureRegion(m_Active->TextureID, level, image.Format,
+                                       y, levelWidth, height,
+                                       (const void*)(uintptr_t)slot.Offset);
+            slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            m_NextSlot = (m_NextSlot + 1) % StagingSlotCount;
+
+            m_Active->NextRow += rows;
+            m_BytesUploaded += chunkSize;
+            m_WindowBytes += chunkSize;
+
+            if (m_Active->NextRow == rowCount)
+            {
+                m_Active->NextRow = 0;
+                m_Active->Level++;
+                if (m_Active->Level == image.GetLevelCount())
+                    FinishUpload();
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        UpdateThroughput();
+    }
+
+    TextureStreamingStats OpenGLTextureStreamer::GetStats() const
+    {
+        TextureStreamingStats stats;
+        stats.Queued = m_State->Queued.load();
+        stats.Failed = m_State->Failed.load();
+        stats.Completed = m_Completed;
+        stats.BytesUploaded = m_BytesUploaded;
+        stats.BytesPerSecond = m_BytesPerSecond;
+
+        {
+            ForgeLockGuard lock(m_State->ReadyMutex);
+            stats.InFlight = (uint32_t)m_State->Ready.size();
+        }
+        stats.InFlight += (uint32_t)m_Pending.size() + (m_Active ? 1 : 0);
+
+        return stats;
+    }
+
+    bool OpenGLTextureStreamer::AcquireSlot(StagingSlot& slot)
+    {
+        if (!slot.Fence)
+            return true;
+
+        GLenum result = glClientWaitSync(slot.Fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            return false;
+
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+        return true;
+    }
+
+    void OpenGLTextureStreamer::BeginUpload(DecodedImage&& image)
+    {
+        m_Active = std::make_unique<ActiveUpload>();
+        m_Active->Image = std::move(image);
+
+        const DecodedImage& active = m_Active->Image;
+        m_Active->MipLevels = active.GenerateMips
+            ? CalculateMipCount(active.Width, active.Height)
+            : active.GetLevelCount();
+
+        uint32_t& id = m_Active->TextureID;
+        glCreateTextures(GL_TEXTURE_2D, 1, &id);
+        glTextureStorage2D(id, m_Active->MipLevels,
+                           Utils::ForgeEngineImageFormatToGLInternalFormat(
+                               active.Format),
+                           active.Width, active.Height);
+
+        Utils::SetDefaultTextureParameters(id, m_Active->MipLevels);
+    }
+
+    void OpenGLTextureStreamer::FinishUpload()
+    {
+        auto texture = m_Active->Image.Target.lock();
+        if (!texture)
+        {
+            glDeleteTextures(1, &m_Active->TextureID);
+            m_Active.reset();
+            return;
+        }
+
+        const DecodedImage& image = m_Active->Image;
+        if (image.GenerateMips && m_Active->MipLevels > 1)
+            glGenerateTextureMipmap(m_Active->TextureID);
+
+        TextureSpecification specification;
+        specification.Width = image.Width;
+        specification.Height = image.Height;
+        specification.Format = image.Format;
+        specification.GenerateMips = m_Active->MipLevels > 1;
+
+        // Commands are ordered, so anything drawn with the new id after this
+        // point already sees the uploaded pixels
+        texture->AdoptTexture(m_Active->TextureID, specification,
+                              m_Active->MipLevels);
+
+        m_Completed++;
+        m_Active.reset();
+    }
+
+    uint32_t OpenGLTextureStreamer::DecodedImage::GetLevelCount() const
+    {
+        return Cooked ? Cooked->GetMipCount() : 1;
+    }
+
+    uint32_t OpenGLTextureStreamer::DecodedImage::GetLevelWidth(
+        uint32_t level) const
+    {
+        return Cooked ? Cooked->GetLevel(level).Width : Width;
+    }
+
+    uint32_t OpenGLTextureStreamer::DecodedImage::GetLevelHeight(
+        uint32_t level) const
+    {
+        return Cooked ? Cooked->GetLevel(level).Height : Height;
+    }
+
+    const uint8_t* OpenGLTextureStreamer::DecodedImage::GetLevelData(
+        uint32_t level) const
+    {
+        return Cooked ? Cooked->GetLevelData(level) : Pixels.data();
+    }
+
+    void OpenGLTextureStreamer::UpdateThroughput()
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<float> elapsed = now - m_WindowStart;
+        if (elapsed.count() < 1.0f)
+            return;
+
+        m_BytesPerSecond = (float)m_WindowBytes / elapsed.count();
+        m_WindowBytes = 0;
+        m_WindowStart = now;
+    }
+} // namespace ForgeEngine
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core/Renderer/CookedTexture.h"
+#include "Core/Renderer/TextureStreamer.h"
+#include "Core/Threading/ForgeMutex.h"
+#include <glad/glad.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace ForgeEngine
+{
+    class OpenGLTexture2D;
+
+    class OpenGLTextureStreamer : public TextureStreamer
+    {
+    public:
+        OpenGLTextureStreamer();
+        virtual ~OpenGLTextureStreamer();
+
+        virtual Ref<Texture2D> Load(const std::string& path) override;
+        virtual void ProcessUploads(float budgetMs) override;
+        virtual TextureStreamingStats GetStats() const override;
+
+    private:
+        // Output of a worker job: either decoded RGBA8 pixels or a mapped
+        // cooked texture whose levels are uploaded as they are stored
+        struct DecodedImage
+        {
+            std::weak_ptr<OpenGLTexture2D> Target;
+            std::string Path;
+            ImageFormat Format = ImageFormat::RGBA8;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            bool GenerateMips = true;
+
+            std::vector<uint8_t> Pixels;
+            Ref<CookedTexture> Cooked;
+
+            uint32_t GetLevelCount() const;
+            uint32_t GetLevelWidth(uint32_t level) const;
+            uint32_t GetLevelHeight(uint32_t level) const;
+            const uint8_t* GetLevelData(uint32_t level) const;
+        };
+
+        // Shared with the decode jobs so they stay valid if the streamer is
+        // destroyed while a worker is still running
+        struct SharedState
+        {
+            ForgeMutex ReadyMutex{"TextureStreamer Ready"};
+            std::deque<DecodedImage> Ready;
+            std::atomic<uint32_t> Queued{0};
+            std::atomic<uint32_t> Failed{0};
+            std::atomic<bool> Alive{true};
+        };
+
+        struct StagingSlot
+        {
+            uint32_t Offset = 0;
+            GLsync Fence = nullptr;
+        };
+
+        struct ActiveUpload
+        {
+            DecodedImage Image;
+            uint32_t TextureID = 0;
+            uint32_t MipLevels = 1;
+            uint32_t Level = 0;
+            uint32_t NextRow = 0; // in block rows for compressed formats
+        };
+
+        static constexpr uint32_t StagingSlotCount = 4;
+        static constexpr uint32_t StagingSlotSize = 4 * 1024 * 1024;
+
+        bool AcquireSlot(StagingSlot& slot);
+        void BeginUpload(DecodedImage&& image);
+        void FinishUpload();
+        void UpdateThroughput();
+
+    private:
+        std::shared_ptr<SharedState> m_State;
+
+        uint32_t m_StagingBuffer = 0;
+        uint8_t* m_StagingMemory = nullptr;
+        std::array<StagingSlot, StagingSlotCount> m_Slots;
+        uint32_t m_NextSlot = 0;
+
+        std::unique_ptr<ActiveUpload> m_Active;
+        std::deque<DecodedImage> m_Pending;
+
+        uint32_t m_Completed = 0;
+        uint64_t m_BytesUploaded = 0;
+        uint64_t m_WindowBytes = 0;
+        float m_BytesPerSecond = 0.0f;
+        std::chrono::steady_clock::time_point m_WindowStart;
+    };
+} // namespace ForgeEngine
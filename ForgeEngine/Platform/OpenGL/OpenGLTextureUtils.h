@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Core/Renderer/Texture.h"
+#include "Core/Assert/Assert.h"
+#include <glad/glad.h>
+
+// S3TC is not part of core GL but every desktop driver exposes it
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace ForgeEngine
+{
+    namespace Utils
+    {
+        inline GLenum ForgeEngineImageFormatToGLInternalFormat(ImageFormat format)
+        {
+            switch (format)
+            {
+            case ImageFormat::R8:
+                return GL_R8;
+            case ImageFormat::RGB8:
+                return GL_RGB8;
+            case ImageFormat::RGBA8:
+                return GL_RGBA8;
+            case ImageFormat::RGBA32F:
+                return GL_RGBA32F;
+            case ImageFormat::BC1:
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case ImageFormat::BC3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case ImageFormat::BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            case ImageFormat::BC7:
+                return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case ImageFormat::None:
+                break;
+            }
+
+            FENGINE_CORE_ASSERT(false);
+            return 0;
+        }
+
+        // Client pixel format for uncompressed uploads, 0 for compressed ones
+        inline GLenum ForgeEngineImageFormatToGLDataFormat(ImageFormat format)
+        {
+            switch (format)
+            {
+            case ImageFormat::R8:
+                return GL_RED;
+            case ImageFormat::RGB8:
+                return GL_RGB;
+            case ImageFormat::RGBA8:
+            case ImageFormat::RGBA32F:
+                return GL_RGBA;
+            default:
+                return 0;
+            }
+        }
+
+        inline GLenum ForgeEngineImageFormatToGLDataType(ImageFormat format)
+        {
+            return format == ImageFormat::RGBA32F ? GL_FLOAT : GL_UNSIGNED_BYTE;
+        }
+
+        // Uploads one level (or a band of rows of it) from client memory or,
+        // when a GL_PIXEL_UNPACK_BUFFER is bound, from a buffer offset
+        inline void UploadTextureRegion(uint32_t texture, uint32_t level,
+                                        ImageFormat format, uint32_t yOffset,
+                                        uint32_t width, uint32_t height,
+                                        const void* data)
+        {
+            if (IsCompressedImageFormat(format))
+            {
+                GLsizei size = (GLsizei)ImageFormatLevelSize(format, width,
+                                                             height);
+                glCompressedTextureSubImage2D(
+                    texture, level, 0, yOffset, width, height,
+                    ForgeEngineImageFormatToGLInternalFormat(format), size, data);
+                return;
+            }
+
+            // R8 and RGB8 rows are not 4-byte aligned in general
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTextureSubImage2D(texture, level, 0, yOffset, width, height,
+                                ForgeEngineImageFormatToGLDataFormat(format),
+                                ForgeEngineImageFormatToGLDataType(format), data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+        // Trilinear when there is more than one level, otherwise plain linear
+        inline void SetDefaultTextureParameters(uint32_t texture,
+                                                uint32_t levels)
+        {
+            glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER,
+                                levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteri(texture, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        }
+    } // namespace Utils
+} // namespace ForgeEngine
@@ -4,6 +4,9 @@
 
 #include "FEPCH.h"
 #include "Core/Renderer/Buffer.h"
+#include "Platform/OpenGL/OpenGLBuffer.h"
+
+#include <unordered_map>
 
 namespace ForgeEngine {
 
@@ -31,63 +34,72 @@ static GLenum ShaderDataTypeToOpenGLBaseType(ShaderDataType type) {
       return GL_INT;
     case ShaderDataType::Bool:
       return GL_BOOL;
+    case ShaderDataType::Half2:
+    case ShaderDataType::Half4:
+      return GL_HALF_FLOAT;
+    case ShaderDataType::Short2:
+    case ShaderDataType::Short4:
+      return GL_SHORT;
+    case ShaderDataType::UShort2:
+    case ShaderDataType::UShort4:
+      return GL_UNSIGNED_SHORT;
+    case ShaderDataType::UByte4:
+      return GL_UNSIGNED_BYTE;
+    case ShaderDataType::Int1010102:
+      return GL_INT_2_10_10_10_REV;
   }
 
   FENGINE_CORE_ASSERT(false, "Unknown ShaderDataType!");
   return 0;
 }
 
-OpenGLVertexArray::OpenGLVertexArray() {
-  FENGINE_PROFILE_FUNCTION();
-
-  const GLubyte* renderer = glGetString(GL_RENDERER);
-  const GLubyte* vendor = glGetString(GL_VENDOR);
-  const GLubyte* version = glGetString(GL_VERSION);
-  const GLubyte* glslVersion = glGetString(GL_SHADING_LANGUAGE_VERSION);
-
-  glCreateVertexArrays(1, &m_RendererID);
-}
-
-OpenGLVertexArray::~OpenGLVertexArray() {
-  FENGINE_PROFILE_FUNCTION();
-
-  glDeleteVertexArrays(1, &m_RendererID);
-}
-
-void OpenGLVertexArray::Bind() const {
-  FENGINE_PROFILE_FUNCTION();
-
-  glBindVertexArray(m_RendererID);
-}
-
-void OpenGLVertexArray::Unbind() const {
-  FENGINE_PROFILE_FUNCTION();
-
-  glBindVertexArray(0);
-}
+// Layouts and divisors of every buffer, what decides the attribute setup
+struct VertexFormatKey {
+  std::vector<uint32_t> Words;
 
-void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) {
-  FENGINE_PROFILE_FUNCTION();
+  bool operator==(const VertexFormatKey& other) const { return Words == other.Words; }
+};
 
-  FENGINE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(),
-                      "Vertex Buffer has no layout!");
+struct VertexFormatKeyHash {
+  size_t operator()(const VertexFormatKey& key) const {
+    size_t hash = key.Words.size();
+    for (uint32_t word : key.Words)
+      hash ^= std::hash<uint32_t>()(word) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
 
-  glBindVertexArray(m_RendererID);
-  vertexBuffer->Bind();
+// Nodes of an unordered_map do not move, arrays keep pointers into it
+static std::unordered_map<VertexFormatKey, OpenGLVertexArray::SharedFormat, VertexFormatKeyHash>
+    s_SharedVertexFormats;
+// Vertex array object currently bound, redundant binds are skipped
+static uint32_t s_BoundVertexArrayID = 0;
+// Bumped by ReleaseSharedFormats, arrays drop pointers of older ones
+static uint32_t s_SharedFormatGeneration = 1;
 
-  const auto& layout = vertexBuffer->GetLayout();
+static void SetupAttributes(uint32_t vao, uint32_t binding, const BufferLayout& layout,
+                            uint32_t& location) {
   for (const auto& element : layout) {
     switch (element.Type) {
       case ShaderDataType::Float:
       case ShaderDataType::Float2:
       case ShaderDataType::Float3:
-      case ShaderDataType::Float4: {
-        glEnableVertexAttribArray(m_VertexBufferIndex);
-        glVertexAttribPointer(m_VertexBufferIndex, element.GetComponentCount(),
-                              ShaderDataTypeToOpenGLBaseType(element.Type),
-                              element.Normalized ? GL_TRUE : GL_FALSE,
-                              layout.GetStride(), (const void*)element.Offset);
-        m_VertexBufferIndex++;
+      case ShaderDataType::Float4:
+      case ShaderDataType::Half2:
+      case ShaderDataType::Half4:
+      case ShaderDataType::Short2:
+      case ShaderDataType::Short4:
+      case ShaderDataType::UShort2:
+      case ShaderDataType::UShort4:
+      case ShaderDataType::UByte4:
+      case ShaderDataType::Int1010102: {
+        glEnableVertexArrayAttrib(vao, location);
+        glVertexArrayAttribFormat(vao, location, element.GetComponentCount(),
+                                  ShaderDataTypeToOpenGLBaseType(element.Type),
+                                  element.Normalized ? GL_TRUE : GL_FALSE,
+                                  (GLuint)element.Offset);
+        glVertexArrayAttribBinding(vao, location, binding);
+        location++;
         break;
       }
       case ShaderDataType::Int:
@@ -95,25 +107,25 @@ void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) {
       case ShaderDataType::Int3:
       case ShaderDataType::Int4:
       case ShaderDataType::Bool: {
-        glEnableVertexAttribArray(m_VertexBufferIndex);
-        glVertexAttribIPointer(m_VertexBufferIndex, element.GetComponentCount(),
-                               ShaderDataTypeToOpenGLBaseType(element.Type),
-                               layout.GetStride(), (const void*)element.Offset);
-        m_VertexBufferIndex++;
+        glEnableVertexArrayAttrib(vao, location);
+        glVertexArrayAttribIFormat(vao, location, element.GetComponentCount(),
+                                   ShaderDataTypeToOpenGLBaseType(element.Type),
+                                   (GLuint)element.Offset);
+        glVertexArrayAttribBinding(vao, location, binding);
+        location++;
         break;
       }
       case ShaderDataType::Mat3:
       case ShaderDataType::Mat4: {
         uint8_t count = element.GetComponentCount();
         for (uint8_t i = 0; i < count; i++) {
-          glEnableVertexAttribArray(m_VertexBufferIndex);
-          glVertexAttribPointer(
-              m_VertexBufferIndex, count,
-              ShaderDataTypeToOpenGLBaseType(element.Type),
-              element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(),
-              (const void*)(element.Offset + sizeof(float) * count * i));
-          glVertexAttribDivisor(m_VertexBufferIndex, 1);
-          m_VertexBufferIndex++;
+          glEnableVertexArrayAttrib(vao, location);
+          glVertexArrayAttribFormat(vao, location, count,
+                                    ShaderDataTypeToOpenGLBaseType(element.Type),
+                                    element.Normalized ? GL_TRUE : GL_FALSE,
+                                    (GLuint)(element.Offset + sizeof(float) * count * i));
+          glVertexArrayAttribBinding(vao, location, binding);
+          location++;
         }
         break;
       }
@@ -121,17 +133,139 @@ void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) {
         FENGINE_CORE_ASSERT(false, "Unknown ShaderDataType!");
     }
   }
+}
+
+OpenGLVertexArray::~OpenGLVertexArray() {
+  Invalidate();
+}
 
+void OpenGLVertexArray::Bind() const {
+  FENGINE_PROFILE_DETAIL_FUNCTION();
+
+  if (!m_Format || m_FormatGeneration != s_SharedFormatGeneration) {
+    VertexFormatKey key;
+    for (size_t i = 0; i < m_VertexBuffers.size(); i++) {
+      const BufferLayout& layout = m_VertexBuffers[i]->GetLayout();
+      key.Words.push_back(m_Divisors[i]);
+      key.Words.push_back((uint32_t)layout.GetElements().size());
+      for (const auto& element : layout) {
+        key.Words.push_back((uint32_t)element.Type | (element.Normalized ? 0x100u : 0u));
+        key.Words.push_back((uint32_t)element.Offset);
+      }
+    }
+
+    SharedFormat& format = s_SharedVertexFormats[key];
+    if (!format.RendererID) {
+      glCreateVertexArrays(1, &format.RendererID);
+
+      uint32_t location = 0;
+      for (size_t i = 0; i < m_VertexBuffers.size(); i++) {
+        SetupAttributes(format.RendererID, (uint32_t)i, m_VertexBuffers[i]->GetLayout(),
+                        location);
+        glVertexArrayBindingDivisor(format.RendererID, (GLuint)i, m_Divisors[i]);
+      }
+      s_Stats.SharedFormats = (uint32_t)s_SharedVertexFormats.size();
+    }
+    m_Format = &format;
+    m_FormatGeneration = s_SharedFormatGeneration;
+  }
+
+  if (s_BoundVertexArrayID != m_Format->RendererID) {
+    glBindVertexArray(m_Format->RendererID);
+    s_BoundVertexArrayID = m_Format->RendererID;
+    s_Stats.Binds++;
+  }
+
+  if (m_Format->Attached != this) {
+    uint32_t vao = m_Format->RendererID;
+    for (size_t i = 0; i < m_VertexBuffers.size(); i++) {
+      const auto& buffer = static_cast<const OpenGLVertexBuffer&>(*m_VertexBuffers[i]);
+      glVertexArrayVertexBuffer(vao, (GLuint)i, buffer.GetRendererID(), 0,
+                                (GLsizei)buffer.GetLayout().GetStride());
+    }
+    uint32_t indexBufferID
+        = m_IndexBuffer ? static_cast<const OpenGLIndexBuffer&>(*m_IndexBuffer).GetRendererID() : 0;
+    glVertexArrayElementBuffer(vao, indexBufferID);
+
+    s_Stats.BufferBindings += (uint32_t)m_VertexBuffers.size() + (m_IndexBuffer ? 1 : 0);
+    m_Format->Attached = this;
+  }
+}
+
+void OpenGLVertexArray::Unbind() const {
+  FENGINE_PROFILE_DETAIL_FUNCTION();
+
+  glBindVertexArray(0);
+  s_BoundVertexArrayID = 0;
+}
+
+void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer,
+                                        uint32_t instanceDivisor) {
+  FENGINE_PROFILE_FUNCTION();
+
+  FENGINE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(),
+                      "Vertex Buffer has no layout!");
+
+  Invalidate();
   m_VertexBuffers.push_back(vertexBuffer);
+  m_Divisors.push_back(instanceDivisor);
+}
+
+void OpenGLVertexArray::SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) {
+  FENGINE_PROFILE_DETAIL_FUNCTION();
+
+  FENGINE_CORE_ASSERT(index < m_VertexBuffers.size(), "No vertex buffer at this index!");
+  if (m_VertexBuffers[index] == vertexBuffer) return;
+
+  // The format key only holds the layouts, the stride goes with the buffer
+  const auto& previous = m_VertexBuffers[index]->GetLayout().GetElements();
+  const auto& next = vertexBuffer->GetLayout().GetElements();
+  bool sameFormat = previous.size() == next.size();
+  for (size_t i = 0; sameFormat && i < next.size(); i++) {
+    sameFormat = previous[i].Type == next[i].Type && previous[i].Offset == next[i].Offset
+        && previous[i].Normalized == next[i].Normalized;
+  }
+
+  if (sameFormat)
+    Detach();
+  else
+    Invalidate();
+  m_VertexBuffers[index] = vertexBuffer;
 }
 
 void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) {
-  FENGINE_PROFILE_FUNCTION();
+  FENGINE_PROFILE_DETAIL_FUNCTION();
 
-  glBindVertexArray(m_RendererID);
-  indexBuffer->Bind();
+  if (m_IndexBuffer == indexBuffer) return;
 
+  // Not part of the format
+  Detach();
   m_IndexBuffer = indexBuffer;
 }
 
-}  // namespace BEngine
\ No newline at end of file
+void OpenGLVertexArray::Invalidate() {
+  Detach();
+  m_Format = nullptr;
+}
+
+void OpenGLVertexArray::Detach() {
+  if (!m_Format || m_FormatGeneration != s_SharedFormatGeneration)
+    return;
+
+  // The buffers stay attached to the shared object until someone else
+  // binds it, a destroyed or changed array must not be mistaken for them
+  if (m_Format->Attached == this)
+    m_Format->Attached = nullptr;
+}
+
+void OpenGLVertexArray::ReleaseSharedFormats() {
+  for (auto& [key, format] : s_SharedVertexFormats)
+    glDeleteVertexArrays(1, &format.RendererID);
+
+  s_SharedVertexFormats.clear();
+  s_SharedFormatGeneration++;
+  s_BoundVertexArrayID = 0;
+  s_Stats.SharedFormats = 0;
+}
+
+}  // namespace BEngine
@@ -4,25 +4,51 @@
 
 namespace ForgeEngine {
 
+    // Only records buffers; the GL vertex array object belongs to the
+    // vertex format and is shared with every array of the same layouts.
+    // Bind attaches this array's buffers to it with DSA calls, and skips
+    // that when they are still attached from the last bind.
     class OpenGLVertexArray : public VertexArray
     {
     public:
-        OpenGLVertexArray();
+        OpenGLVertexArray() = default;
         virtual ~OpenGLVertexArray();
 
         virtual void Bind() const override;
         virtual void Unbind() const override;
 
-        virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+        virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer,
+                                     uint32_t instanceDivisor = 0) override;
+        virtual void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) override;
         virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
 
         virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
         virtual const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+
+        static void ReleaseSharedFormats();
+
+        // One GL vertex array object per distinct set of layouts and
+        // divisors, plus the array whose buffers it currently holds
+        struct SharedFormat
+        {
+            uint32_t RendererID = 0;
+            const OpenGLVertexArray* Attached = nullptr;
+        };
+
     private:
-        uint32_t m_RendererID = 0;
-        uint32_t m_VertexBufferIndex = 0;
+        // Forgets the shared format after the layouts changed
+        void Invalidate();
+        // Keeps the format, the buffers are attached again on the next bind
+        void Detach();
+
         std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+        std::vector<uint32_t> m_Divisors;
         Ref<IndexBuffer> m_IndexBuffer;
+
+        // Looked up on the first bind after a change, stale once the
+        // shared formats were released
+        mutable SharedFormat* m_Format = nullptr;
+        mutable uint32_t m_FormatGeneration = 0;
     };
 
-}
\ No newline at end of file
+}
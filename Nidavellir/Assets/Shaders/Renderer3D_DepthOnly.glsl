@@ -11,10 +11,13 @@ layout(std140, binding = 0) uniform Camera
 };
 
 uniform mat4 u_Transform;
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
 
 void main()
 {
-    gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+    vec3 position = a_Position * u_PositionScale + u_PositionOffset;
+    gl_Position = u_ViewProjection * u_Transform * vec4(position, 1.0);
 }
 
 #type fragment
@@ -26,6 +26,12 @@ layout(std140, binding = 1) uniform Light
 
 // Uniforms individuais
 uniform mat4 u_Transform;
+// Cofactor of u_Transform, computed once per draw on the CPU
+uniform mat3 u_NormalMatrix;
+
+// Quantized meshes store positions relative to their bounds
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
 
 // Outputs para o fragment shader
 layout(location = 0) out vec3 v_WorldPos;
@@ -34,10 +40,11 @@ layout(location = 2) out vec2 v_TexCoord;
 
 void main()
 {
-    vec4 worldPos = u_Transform * vec4(a_Position, 1.0);
+    vec3 position = a_Position * u_PositionScale + u_PositionOffset;
+    vec4 worldPos = u_Transform * vec4(position, 1.0);
     v_WorldPos = worldPos.xyz;
 
-    v_Normal = mat3(transpose(inverse(u_Transform))) * a_Normal;
+    v_Normal = u_NormalMatrix * a_Normal;
 
     v_TexCoord = a_TexCoord;
 
@@ -1,10 +1,13 @@
 #include "NidavellirLayer.h"
 #include "imgui.h"
 #include "Core/Application/Application.h"
+#include "Core/Debug/FrameTelemetry.h"
 #include "Core/Input/Input.h"
+#include "Core/Renderer/PrimitiveCache.h"
 #include "Core/Renderer/RenderCommand.h"
 #include "Core/Renderer/Renderer3D.h"
 #include "Core/Renderer/TestMesh.h"
+#include "Core/Renderer/TextureStreamer.h"
 #include "GLFW/glfw3.h"
 #include "glad/glad.h"
 
@@ -49,6 +52,14 @@ namespace ForgeEngine
 
     void NidavellirLayer::OnDetach()
     {
+        for (auto& proxy : cube_proxies_)
+            proxy.Remove();
+        cube_proxies_.clear();
+
+        for (auto handle : pillar_meshes_)
+            Renderer3D::RemoveStaticMesh(handle);
+        pillar_meshes_.clear();
+
         Layer::OnDetach();
     }
 
@@ -82,24 +93,65 @@ namespace ForgeEngine
         // Sphere to show where the point light is being positioned
         Renderer3D::DrawSphere(position, 0.2f, glm::vec4(1.0), 0);
 
-        // Floor plane
-        Renderer3D::DrawMesh(glm::vec3(0.0f, -2.0, 0.0), glm::vec3(100.0f), glm::vec3(0.0f), Mesh::CreatePlane(), glm::vec4(1.0), 1);
+        // Floor plane, subdivided so its clusters can be culled
+        Renderer3D::DrawMesh(glm::vec3(0.0f, -2.0, 0.0), glm::vec3(100.0f), glm::vec3(0.0f),
+                             PrimitiveCache::GetPlane(1.0f, 1.0f, 32), glm::vec4(1.0), 1);
 
         EarlyDepthTestManager::DebugDepthBuffer();
 
+        // The cube grid never moves, it lives in the renderer as static
+        // proxies and is only rebuilt when the count changes
+        SyncCubeProxies();
+        SyncStaticPillars();
+
+        Renderer3D::EndScene();
+        framebuffer_->Unbind();
+    }
+
+    void NidavellirLayer::SyncCubeProxies()
+    {
+        if (registered_cube_count_ == cube_count_) return;
+
+        for (auto& proxy : cube_proxies_)
+            proxy.Remove();
+        cube_proxies_.clear();
 
+        auto cube = PrimitiveCache::GetCube();
+        cube_proxies_.reserve(cube_count_ * cube_count_);
         for (int i = 0; i < cube_count_ * cube_count_; i++)
         {
             int x = i % cube_count_;
             int z = i / cube_count_;
-            glm::vec3 cubePos = glm::vec3(x, 0.0f, z);
-            glm::vec4 cubeColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
-            Renderer3D::DrawCube(cubePos, glm::vec3(1.0f), cubeColor, i);
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, z));
+            cube_proxies_.push_back(Renderer3D::RegisterProxy(
+                cube, nullptr, transform, Renderer3D::ProxyFlagStatic, glm::vec4(1.0f), i));
         }
+        registered_cube_count_ = cube_count_;
+    }
 
-
-        Renderer3D::EndScene();
-        framebuffer_->Unbind();
+    void NidavellirLayer::SyncStaticPillars()
+    {
+        if (registered_grid_size_ == grid_size_) return;
+
+        for (auto handle : pillar_meshes_)
+            Renderer3D::RemoveStaticMesh(handle);
+        pillar_meshes_.clear();
+
+        // Alternating meshes with one material, instancing cannot merge
+        // them but static batching can
+        auto cylinder = PrimitiveCache::GetCylinder(0.3f, 3.0f, 16);
+        auto sphere = PrimitiveCache::GetSphere(0.5f, 16, 16);
+        pillar_meshes_.reserve(grid_size_ * grid_size_ * 2);
+        for (int i = 0; i < grid_size_ * grid_size_; i++)
+        {
+            glm::vec3 base = glm::vec3(-4.0f - (i % grid_size_) * 4.0f, -0.5f,
+                                       -4.0f - (i / grid_size_) * 4.0f);
+            pillar_meshes_.push_back(Renderer3D::AddStaticMesh(
+                cylinder, nullptr, glm::translate(glm::mat4(1.0f), base)));
+            pillar_meshes_.push_back(Renderer3D::AddStaticMesh(
+                sphere, nullptr, glm::translate(glm::mat4(1.0f), base + glm::vec3(0.0f, 2.0f, 0.0f))));
+        }
+        registered_grid_size_ = grid_size_;
     }
 
     void NidavellirLayer::OnImGuiRender()
@@ -228,6 +280,14 @@ namespace ForgeEngine
 
         auto stats = Renderer3D::GetStats();
 
+        FrameTimeSummary frameTimes = FrameTelemetry::GetSummary(60);
+        ImGui::Text("=== Frame Timing ===");
+        ImGui::Text("FPS: %.0f (%.2f ms)", frameTimes.AverageFps, frameTimes.AverageMs);
+        ImGui::Text("p95: %.2f ms, p99: %.2f ms", frameTimes.P95Ms, frameTimes.P99Ms);
+        ImGui::Text("Hitches: %u", frameTimes.Hitches);
+
+        ImGui::Separator();
+
         // General statistics
         ImGui::Text("=== General Stats ===");
         ImGui::Text("Total Draw Calls: %d", stats.DrawCalls);
@@ -256,6 +316,84 @@ namespace ForgeEngine
 
         ImGui::Separator();
 
+        ImGui::Text("=== LOD Stats ===");
+        for (uint32_t i = 0; i < Renderer3D::Statistics::MaxLodStats; i++)
+        {
+            bool last = i + 1 == Renderer3D::Statistics::MaxLodStats;
+            ImGui::Text("LOD %u%s: %u", i, last ? "+" : "", stats.LodCounts[i]);
+        }
+        ImGui::Text("LOD Culled: %u", stats.LodCulledCount);
+
+        ImGui::Separator();
+
+        ImGui::Text("=== Bounds Culling ===");
+        const char* cullingVolumes[] = {"Sphere", "AABB", "OBB"};
+        int cullingVolume = (int)Renderer3D::GetCullingVolume();
+        if (ImGui::Combo("Culling Volume", &cullingVolume, cullingVolumes, 3))
+            Renderer3D::SetCullingVolume((Renderer3D::CullingVolume)cullingVolume);
+        ImGui::Text("False Positives Removed: %u", stats.BoundsFalsePositivesRemoved);
+        ImGui::Text("Box Culled: %u", stats.BoxCulledCount);
+
+        ImGui::Separator();
+
+        ImGui::Text("=== Cluster Culling ===");
+        bool clusterCulling = Renderer3D::IsClusterCullingEnabled();
+        if (ImGui::Checkbox("Cluster Culling", &clusterCulling))
+            Renderer3D::EnableClusterCulling(clusterCulling);
+        ImGui::Text("Clusters: %u", stats.ClusterCount);
+        ImGui::Text("Culled Clusters: %u", stats.CulledClusterCount);
+        ImGui::Text("Culled Triangles: %u", stats.CulledClusterTriangles);
+        ImGui::Text("Draw Ranges: %u", stats.ClusterDrawRanges);
+
+        ImGui::Separator();
+
+        if (TextureStreamer* streamer = TextureStreamer::Get())
+        {
+            auto streamingStats = streamer->GetStats();
+
+            ImGui::Text("=== Texture Streaming ===");
+            ImGui::Text("Queued: %u", streamingStats.Queued);
+            ImGui::Text("In Flight: %u", streamingStats.InFlight);
+            ImGui::Text("Completed: %u", streamingStats.Completed);
+            ImGui::Text("Failed: %u", streamingStats.Failed);
+            ImGui::Text("Upload Rate: %.2f MB/s",
+                        streamingStats.BytesPerSecond / (1024.0f * 1024.0f));
+
+            ImGui::Separator();
+        }
+
+        ImGui::Text("=== Render Proxies ===");
+        ImGui::Text("Proxies: %u", stats.ProxyCount);
+        ImGui::Text("Visible: %u", stats.VisibleProxyCount);
+        ImGui::Text("Draw Calls: %u", stats.ProxyDrawCalls);
+        ImGui::Text("Uploaded: %.2f KB", stats.ProxyUploadBytes / 1024.0f);
+
+        ImGui::Separator();
+
+        ImGui::Text("=== Static Batching ===");
+        ImGui::Text("Objects: %u", stats.StaticObjectCount);
+        ImGui::Text("Batches: %u (%u visible)", stats.StaticBatchCount, stats.VisibleStaticBatches);
+        ImGui::Text("Draw Calls Saved: %u", stats.StaticDrawCallsSaved);
+        ImGui::Text("Rebuilt This Frame: %u", stats.RebuiltStaticBatches);
+
+        ImGui::Separator();
+
+        ImGui::Text("=== Vertex Arrays ===");
+        ImGui::Text("Binds: %u", stats.VertexArrayBinds);
+        ImGui::Text("Buffer Bindings: %u", stats.VertexBufferBindings);
+        ImGui::Text("Formats: %u", stats.VertexFormats);
+
+        ImGui::Separator();
+
+        auto primitiveStats = PrimitiveCache::GetStats();
+        ImGui::Text("=== Primitive Cache ===");
+        ImGui::Text("Meshes: %u", primitiveStats.Meshes);
+        ImGui::Text("Hits: %llu", (unsigned long long)primitiveStats.Hits);
+        ImGui::Text("Misses: %llu", (unsigned long long)primitiveStats.Misses);
+        ImGui::Text("GPU Memory: %.2f KB", primitiveStats.GpuBytes / 1024.0f);
+
+        ImGui::Separator();
+
         // performance analysis
         uint32_t totalObjects = stats.InstancedObjects + stats.IndividualObjects;
         uint32_t totalDrawCalls = stats.InstancedDrawCalls + stats.IndividualDrawCalls;
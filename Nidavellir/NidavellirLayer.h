@@ -5,6 +5,7 @@
 #include "Core/Camera/Camera3DController.h"
 #include "Core/Renderer/Mesh.h"
 #include "Core/Renderer/Framebuffer.h"
+#include "Core/Renderer/Renderer3D.h"
 
 namespace ForgeEngine
 {
@@ -23,6 +24,8 @@ namespace ForgeEngine
         Camera3DController camera_controller_ = Camera3DController(1);
         bool OnKeyPressed(KeyPressedEvent& e);
         bool OnKeyReleased(KeyReleasedEvent& e);
+        void SyncCubeProxies();
+        void SyncStaticPillars();
         glm::vec4 square_color_ = { 1.0, 1.0, 1.0, 1.0f };
         glm::vec3 quad_position_ = { 0.0f, 0.0f, 0.0f };
         glm::vec3 quad_size_ = { 2.0f, 2.0f, 2.0f };
@@ -61,6 +64,14 @@ namespace ForgeEngine
         int sphere_count_ = 15;      // Número de esferas flutuantes
         int max_entities_ = 1000;
 
+        // Static cube grid, registered once per cube_count_ change
+        std::vector<Renderer3D::ProxyHandle> cube_proxies_;
+        int registered_cube_count_ = -1;
+
+        // Pillar grid merged by the static batcher, rebuilt per grid_size_
+        std::vector<StaticMeshHandle> pillar_meshes_;
+        int registered_grid_size_ = -1;
+
 
         // Configurações avançadas de teste
         struct PerformanceTestConfig
@@ -82,43 +93,6 @@ namespace ForgeEngine
 
         } perf_config_;
 
-
-        struct FrameMetrics
-        {
-            float frame_time = 0.0f;
-            float avg_frame_time = 0.0f;
-            uint32_t fps = 0;
-            uint32_t avg_fps = 0;
-
-            // Histórico para média móvel
-            static constexpr size_t HISTORY_SIZE = 60;
-            float frame_history[HISTORY_SIZE] = {};
-            size_t history_index = 0;
-            bool history_filled = false;
-
-            void UpdateFrameTime(float delta_time)
-            {
-                frame_time = delta_time;
-                fps = delta_time > 0.0f ? (uint32_t)(1.0f / delta_time) : 0;
-
-                // Atualizar histórico
-                frame_history[history_index] = delta_time;
-                history_index = (history_index + 1) % HISTORY_SIZE;
-                if (history_index == 0) history_filled = true;
-
-                // Calcular média
-                size_t count = history_filled ? HISTORY_SIZE : history_index;
-                float sum = 0.0f;
-                for (size_t i = 0; i < count; i++)
-                {
-                    sum += frame_history[i];
-                }
-                avg_frame_time = sum / count;
-                avg_fps = avg_frame_time > 0.0f ? (uint32_t)(1.0f / avg_frame_time) : 0;
-            }
-        } frame_metrics_;
-
-        void UpdatePerformanceMetrics(float deltaTime);
         void RenderPerformancePanel();
         void RenderInstancingControlPanel();
         void RenderObjectDensityPanel();
@@ -0,0 +1,215 @@
+// CPU benchmark for the batch math kernels. Runs every kernel at every
+// instruction set level the machine supports on random entities, reports
+// throughput per entity and checks each result against the scalar
+// reference; exits with 1 when a level disagrees. FORGE_FORCE_ISA only
+// changes the level the dispatch picks, every level is still measured.
+//
+//   MathKernelBench [entity count]
+
+#include "Core/Math/MathKernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace ForgeEngine;
+
+// Fixed streams of floats, one array per component
+struct Streams
+{
+    std::vector<std::vector<float>> Arrays;
+
+    Streams(size_t components, size_t count)
+        : Arrays(components, std::vector<float>(count, 0.0f))
+    {
+    }
+
+    float* operator[](size_t component) { return Arrays[component].data(); }
+};
+
+struct BenchData
+{
+    size_t Count;
+    Streams TRS;        // position xyz, rotation xyzw, scale xyz
+    Streams Transforms; // 3x4 affine
+    Streams Spheres;    // center xyz, radius
+    Streams Boxes;      // min xyz, max xyz
+    Streams Vectors;    // xyzw
+    float Matrix[16];
+
+    explicit BenchData(size_t count)
+        : Count(count), TRS(10, count), Transforms(12, count), Spheres(4, count),
+          Boxes(6, count), Vectors(4, count)
+    {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float q[4] = {unit(random), unit(random), unit(random), unit(random)};
+            float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            for (int k = 0; k < 3; k++)
+            {
+                TRS[k][i] = position(random);
+                TRS[7 + k][i] = scale(random);
+                Spheres[k][i] = unit(random);
+                Boxes[k][i] = unit(random) - 1.0f;
+                Boxes[3 + k][i] = unit(random) + 1.0f;
+            }
+            for (int k = 0; k < 4; k++)
+            {
+                TRS[3 + k][i] = q[k] / std::max(length, 1e-6f);
+                Vectors[k][i] = position(random);
+            }
+            Spheres[3][i] = scale(random);
+        }
+
+        for (int k = 0; k < 16; k++)
+            Matrix[k] = unit(random);
+
+        // Transforms for the bounds kernels come from the scalar compose
+        MathKernels::GetKernels(SimdLevel::Scalar)->ComposeTRS(GetTRS(), GetTransformsOut(), count);
+    }
+
+    TRSStreams GetTRS()
+    {
+        return {{TRS[0], TRS[1], TRS[2]}, {TRS[3], TRS[4], TRS[5], TRS[6]},
+                {TRS[7], TRS[8], TRS[9]}};
+    }
+
+    AffineStreams GetTransformsOut()
+    {
+        AffineStreams streams;
+        for (int k = 0; k < 12; k++)
+            streams.M[k] = Transforms[k];
+        return streams;
+    }
+
+    ConstAffineStreams GetTransforms()
+    {
+        ConstAffineStreams streams;
+        for (int k = 0; k < 12; k++)
+            streams.M[k] = Transforms[k];
+        return streams;
+    }
+};
+
+struct KernelRun
+{
+    const char* Name;
+    size_t Outputs;
+    // Runs the kernel of the given table into the given output streams
+    std::function<void(const MathKernelTable&, Streams&)> Run;
+};
+
+static float MaxError(Streams& a, Streams& b)
+{
+    float error = 0.0f;
+    for (size_t k = 0; k < a.Arrays.size(); k++)
+    {
+        for (size_t i = 0; i < a.Arrays[k].size(); i++)
+        {
+            float magnitude = std::max(1.0f, std::fabs(a.Arrays[k][i]));
+            error = std::max(error, std::fabs(a.Arrays[k][i] - b.Arrays[k][i]) / magnitude);
+        }
+    }
+    return error;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 65536;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "entity count must be positive\n");
+        return 1;
+    }
+
+    BenchData data(count);
+
+    std::vector<KernelRun> kernels = {
+        {"ComposeTRS", 12,
+         [&](const MathKernelTable& table, Streams& out) {
+             AffineStreams streams;
+             for (int k = 0; k < 12; k++)
+                 streams.M[k] = out[k];
+             table.ComposeTRS(data.GetTRS(), streams, count);
+         }},
+        {"TransformSpheres", 4,
+         [&](const MathKernelTable& table, Streams& out) {
+             ConstSphereStreams local = {{data.Spheres[0], data.Spheres[1], data.Spheres[2]},
+                                         data.Spheres[3]};
+             SphereStreams world = {{out[0], out[1], out[2]}, out[3]};
+             table.TransformSpheres(data.GetTransforms(), local, world, count);
+         }},
+        {"TransformAABBs", 6,
+         [&](const MathKernelTable& table, Streams& out) {
+             ConstAABBStreams local = {{data.Boxes[0], data.Boxes[1], data.Boxes[2]},
+                                       {data.Boxes[3], data.Boxes[4], data.Boxes[5]}};
+             AABBStreams world = {{out[0], out[1], out[2]}, {out[3], out[4], out[5]}};
+             table.TransformAABBs(data.GetTransforms(), local, world, count);
+         }},
+        {"TransformVec4", 4,
+         [&](const MathKernelTable& table, Streams& out) {
+             ConstVec4Streams in = {{data.Vectors[0], data.Vectors[1], data.Vectors[2],
+                                     data.Vectors[3]}};
+             Vec4Streams result = {{out[0], out[1], out[2], out[3]}};
+             table.TransformVec4(data.Matrix, in, result, count);
+         }},
+    };
+
+    const int repetitions = 50;
+    bool failed = false;
+
+    std::printf("%zu entities, best of %d runs, dispatch picks %s\n\n", count, repetitions,
+                GetSimdLevelName(MathKernels::GetLevel()));
+
+    for (const KernelRun& kernel : kernels)
+    {
+        std::printf("%s\n", kernel.Name);
+
+        Streams reference(kernel.Outputs, count);
+        kernel.Run(*MathKernels::GetKernels(SimdLevel::Scalar), reference);
+        double scalarNs = 0.0;
+
+        for (size_t levelIndex = 0; levelIndex < SimdLevelCount; levelIndex++)
+        {
+            SimdLevel level = (SimdLevel)levelIndex;
+            const MathKernelTable* table = MathKernels::GetKernels(level);
+            if (!table)
+                continue;
+
+            Streams out(kernel.Outputs, count);
+            double best = 1e30;
+            for (int r = 0; r < repetitions; r++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                kernel.Run(*table, out);
+                auto end = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+            }
+
+            double nsPerEntity = best / count;
+            if (level == SimdLevel::Scalar)
+                scalarNs = nsPerEntity;
+
+            float error = MaxError(reference, out);
+            bool ok = error <= 1e-4f;
+            failed |= !ok;
+
+            std::printf("  %-7s %7.3f ns/entity %9.1f M entities/s  x%.2f  max error %.2e%s\n",
+                        GetSimdLevelName(level), nsPerEntity, 1e3 / nsPerEntity,
+                        scalarNs / nsPerEntity, error, ok ? "" : "  MISMATCH");
+        }
+        std::printf("\n");
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+// CPU benchmark for the mesh optimizer. Runs every pass on a few generated
+// meshes (and any .fmesh files given on the command line) and reports the
+// simulated post-transform cache behaviour before and after, so changes to
+// the optimizer can be measured without a GPU.
+//
+//   MeshOptimizerBench [mesh.fmesh ...]
+
+#include "Core/Asset/MeshOptimizer.h"
+#include "Core/Renderer/MeshFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ForgeEngine;
+
+struct BenchMesh
+{
+    std::string Name;
+    std::vector<uint8_t> Vertices;
+    uint32_t VertexCount = 0;
+    uint32_t Stride = 0;
+    uint32_t PositionOffset = 0;
+    std::vector<uint32_t> Indices;
+};
+
+static void PushFloats(std::vector<uint8_t>& out, std::initializer_list<float> values)
+{
+    for (float value : values)
+    {
+        uint8_t bytes[sizeof(float)];
+        std::memcpy(bytes, &value, sizeof(float));
+        out.insert(out.end(), bytes, bytes + sizeof(float));
+    }
+}
+
+// Row by row grid, the order a naive generator emits
+static BenchMesh MakeGrid(uint32_t size)
+{
+    BenchMesh mesh;
+    mesh.Name = "grid " + std::to_string(size) + "x" + std::to_string(size);
+    mesh.Stride = sizeof(float) * 5;
+
+    for (uint32_t y = 0; y <= size; y++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+            PushFloats(mesh.Vertices, {(float)x, 0.0f, (float)y, (float)x / size,
+                                       (float)y / size});
+    }
+    mesh.VertexCount = (size + 1) * (size + 1);
+
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t a = y * (size + 1) + x;
+            uint32_t b = a + 1, c = a + size + 1, d = c + 1;
+            mesh.Indices.insert(mesh.Indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return mesh;
+}
+
+// Same layout as Mesh::CreateSphere
+static BenchMesh MakeSphere(uint32_t segments)
+{
+    BenchMesh mesh;
+    mesh.Name = "sphere " + std::to_string(segments) + "x" + std::to_string(segments);
+    mesh.Stride = sizeof(float) * 11;
+
+    const float pi = 3.14159265358979f;
+    for (uint32_t y = 0; y <= segments; y++)
+    {
+        for (uint32_t x = 0; x <= segments; x++)
+        {
+            float u = (float)x / segments, v = (float)y / segments;
+            float px = std::cos(u * 2.0f * pi) * std::sin(v * pi);
+            float py = std::cos(v * pi);
+            float pz = std::sin(u * 2.0f * pi) * std::sin(v * pi);
+            PushFloats(mesh.Vertices, {px, py, pz, px, py, pz,
+                                       -std::sin(u * 2.0f * pi), 0.0f,
+                                       std::cos(u * 2.0f * pi), u, v});
+        }
+    }
+    mesh.VertexCount = (segments + 1) * (segments + 1);
+
+    for (uint32_t y = 0; y < segments; y++)
+    {
+        for (uint32_t x = 0; x < segments; x++)
+        {
+            uint32_t first = y * (segments + 1) + x;
+            uint32_t third = first + segments + 1;
+            mesh.Indices.insert(mesh.Indices.end(),
+                                {first, third, first + 1, first + 1, third, third + 1});
+        }
+    }
+    return mesh;
+}
+
+// Triangles in random order with every corner duplicated, roughly what a
+// careless exporter produces
+static BenchMesh MakeSoup(uint32_t size)
+{
+    BenchMesh grid = MakeGrid(size);
+
+    BenchMesh mesh;
+    mesh.Name = "shuffled soup " + std::to_string(size) + "x" + std::to_string(size);
+    mesh.Stride = grid.Stride;
+
+    size_t triangleCount = grid.Indices.size() / 3;
+    std::vector<uint32_t> order(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+        order[t] = (uint32_t)t;
+    std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+    for (uint32_t t : order)
+    {
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            const uint8_t* vertex = &grid.Vertices[(size_t)grid.Indices[t * 3 + k]
+                                                   * grid.Stride];
+            mesh.Vertices.insert(mesh.Vertices.end(), vertex, vertex + grid.Stride);
+            mesh.Indices.push_back(mesh.VertexCount++);
+        }
+    }
+    return mesh;
+}
+
+static bool LoadMeshFile(const std::string& path, BenchMesh& mesh)
+{
+    Ref<MeshFile> file = MeshFile::Open(path);
+    if (!file)
+        return false;
+
+    const MeshFileHeader& header = file->GetHeader();
+    mesh.Name = path;
+    mesh.Stride = header.VertexStride;
+    mesh.VertexCount = header.VertexCount;
+    mesh.Vertices.assign(file->GetVertexData(),
+                         file->GetVertexData()
+                             + (size_t)header.VertexCount * header.VertexStride);
+    mesh.Indices.assign(file->GetIndexData(),
+                        file->GetIndexData() + header.IndexCount);
+
+    for (const auto& element : file->GetLayout().GetElements())
+    {
+        if (element.Name == "a_Position")
+            mesh.PositionOffset = (uint32_t)element.Offset;
+    }
+    return true;
+}
+
+static void PrintCache(const char* label, const BenchMesh& mesh)
+{
+    struct
+    {
+        const char* Name;
+        uint32_t Size;
+        VertexCacheModel Model;
+    } caches[] = {
+        {"FIFO 16", 16, VertexCacheModel::FIFO},
+        {"FIFO 32", 32, VertexCacheModel::FIFO},
+        {"LRU 32", 32, VertexCacheModel::LRU},
+    };
+
+    std::printf("  %-7s", label);
+    for (const auto& cache : caches)
+    {
+        VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(
+            mesh.Indices.data(), mesh.Indices.size(), mesh.VertexCount, cache.Size,
+            cache.Model);
+        std::printf("  %s ACMR %.3f ATVR %.3f", cache.Name, stats.ACMR, stats.ATVR);
+    }
+    std::printf("\n");
+}
+
+static void Run(BenchMesh& mesh)
+{
+    std::printf("%s: %u vertices, %zu triangles\n", mesh.Name.c_str(),
+                mesh.VertexCount, mesh.Indices.size() / 3);
+    PrintCache("before", mesh);
+
+    MeshOptimizationStats stats = MeshOptimizer::Optimize(
+        mesh.Vertices.data(), mesh.VertexCount, mesh.Stride, mesh.PositionOffset,
+        mesh.Indices.data(), mesh.Indices.size());
+
+    PrintCache("after", mesh);
+    std::printf("  vertices %u -> %u, optimized in %.2f ms\n\n",
+                stats.VerticesBefore, stats.VerticesAfter, stats.OptimizeMs);
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<BenchMesh> meshes;
+    meshes.push_back(MakeGrid(256));
+    meshes.push_back(MakeSphere(64));
+    meshes.push_back(MakeSoup(256));
+
+    for (int i = 1; i < argc; i++)
+    {
+        BenchMesh mesh;
+        if (!LoadMeshFile(argv[i], mesh))
+        {
+            std::fprintf(stderr, "could not load '%s'\n", argv[i]);
+            return 1;
+        }
+        meshes.push_back(std::move(mesh));
+    }
+
+    for (BenchMesh& mesh : meshes)
+        Run(mesh);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Offline texture cooker: converts source images into .ftex files.
+//
+//   TextureCooker <input> <output.ftex> [--format bc1|bc3|bc5|bc7|r8|rgb8|rgba8|rgba32f]
+//                 [--no-mips] [--no-flip]
+
+#include "Core/Log/Felog.h"
+#include "Core/Renderer/TextureCooker.h"
+#include "Core/Threading/JobSystem.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace ForgeEngine;
+
+static bool ParseFormat(const std::string& name, ImageFormat& format)
+{
+    static const struct
+    {
+        const char* Name;
+        ImageFormat Format;
+    } formats[] = {
+        {"bc1", ImageFormat::BC1},     {"bc3", ImageFormat::BC3},
+        {"bc5", ImageFormat::BC5},     {"bc7", ImageFormat::BC7},
+        {"r8", ImageFormat::R8},       {"rgb8", ImageFormat::RGB8},
+        {"rgba8", ImageFormat::RGBA8}, {"rgba32f", ImageFormat::RGBA32F},
+    };
+
+    for (const auto& entry : formats)
+    {
+        if (name == entry.Name)
+        {
+            format = entry.Format;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr,
+                     "usage: %s <input> <output.ftex> [--format bc1|bc3|bc5|bc7|"
+                     "r8|rgb8|rgba8|rgba32f] [--no-mips] [--no-flip]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    TextureCookSettings settings;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+        {
+            if (!ParseFormat(argv[++i], settings.Format))
+            {
+                std::fprintf(stderr, "unknown format '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--no-mips") == 0)
+        {
+            settings.GenerateMips = false;
+        }
+        else if (std::strcmp(argv[i], "--no-flip") == 0)
+        {
+            settings.FlipVertically = false;
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    Felog::Init("TextureCooker");
+    JobSystem::Init();
+
+    bool cooked = TextureCooker::Cook(argv[1], argv[2], settings);
+
+    JobSystem::Shutdown();
+
+    if (!cooked)
+    {
+        std::fprintf(stderr, "failed to cook '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("cooked '%s' -> '%s'\n", argv[1], argv[2]);
+    return 0;
+}
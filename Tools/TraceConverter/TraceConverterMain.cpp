@@ -0,0 +1,360 @@
+// Converts a binary profile trace (.ftrace) written by the Instrumentor into
+// the Chrome trace event JSON that chrome://tracing and Perfetto open.
+// Flight recordings also get a Frames and a Log track, and the cause of the
+// capture as a global marker.
+//
+//   TraceConverter <input.ftrace> [output.json]
+
+#include "Core/Debug/TraceFormat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace ForgeEngine;
+
+struct TraceEvents
+{
+    uint32_t Thread;
+    TraceFormat::EventClock Clock;
+    std::vector<TraceFormat::Event> Events;
+};
+
+struct TraceText
+{
+    uint64_t Time;
+    uint8_t Level;
+    std::string Text;
+};
+
+struct Trace
+{
+    std::string SessionName;
+    std::vector<TraceFormat::ClockSample> Clocks;
+    std::unordered_map<uint64_t, std::string> Strings;
+    std::unordered_map<uint32_t, std::string> ThreadNames;
+    std::unordered_map<uint32_t, uint32_t> Dropped;
+    std::vector<TraceEvents> Blocks;
+    // Flight recordings only
+    std::vector<TraceFormat::FrameMarker> Frames;
+    std::vector<TraceText> LogLines;
+    std::vector<TraceText> Annotations;
+};
+
+// Tracks of the flight recorder records, above any thread index
+static constexpr uint32_t FramesTrack = 100000;
+static constexpr uint32_t LogTrack = 100001;
+
+static const char* LogLevelNames[] = {"trace", "debug", "info", "warning", "error", "critical"};
+
+// Name prefix of the ForgeMutex wait scopes
+static const char* LockWaitPrefix = "Lock Wait: ";
+static const std::string UnknownName = "unknown";
+
+class Reader
+{
+public:
+    explicit Reader(const std::vector<uint8_t>& data): m_Data(data) {}
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (m_Offset + sizeof(T) > m_Data.size()) return false;
+        std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+        m_Offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(uint32_t length, std::string& text)
+    {
+        if (m_Offset + length > m_Data.size()) return false;
+        text.assign((const char*)m_Data.data() + m_Offset, length);
+        m_Offset += length;
+        return true;
+    }
+
+    bool ReadEvents(uint32_t count, std::vector<TraceFormat::Event>& events)
+    {
+        size_t size = (size_t)count * sizeof(TraceFormat::Event);
+        if (m_Offset + size > m_Data.size()) return false;
+        events.resize(count);
+        std::memcpy(events.data(), m_Data.data() + m_Offset, size);
+        m_Offset += size;
+        return true;
+    }
+
+    bool AtEnd() const { return m_Offset >= m_Data.size(); }
+
+private:
+    const std::vector<uint8_t>& m_Data;
+    size_t m_Offset = 0;
+};
+
+// A trace cut short by a crash still converts up to its last full record
+static bool ParseTrace(const std::vector<uint8_t>& data, Trace& trace)
+{
+    Reader reader(data);
+
+    TraceFormat::FileHeader header;
+    if (!reader.Read(header) || std::memcmp(header.Magic, TraceFormat::Magic, 4) != 0)
+    {
+        std::fprintf(stderr, "not a profile trace\n");
+        return false;
+    }
+    // Version 2 only added record types
+    if (header.Version < 1 || header.Version > TraceFormat::Version)
+    {
+        std::fprintf(stderr, "unsupported trace version %u\n", header.Version);
+        return false;
+    }
+    if (!reader.ReadString(header.NameLength, trace.SessionName)) return false;
+
+    while (!reader.AtEnd())
+    {
+        uint8_t type = 0;
+        reader.Read(type);
+
+        bool complete = false;
+        switch ((TraceFormat::RecordType)type)
+        {
+        case TraceFormat::RecordType::Clock:
+        {
+            TraceFormat::ClockSample sample;
+            complete = reader.Read(sample);
+            if (complete) trace.Clocks.push_back(sample);
+            break;
+        }
+        case TraceFormat::RecordType::String:
+        {
+            uint64_t id = 0;
+            uint32_t length = 0;
+            std::string text;
+            complete = reader.Read(id) && reader.Read(length) && reader.ReadString(length, text);
+            if (complete) trace.Strings[id] = std::move(text);
+            break;
+        }
+        case TraceFormat::RecordType::ThreadName:
+        {
+            uint32_t thread = 0, length = 0;
+            std::string text;
+            complete = reader.Read(thread) && reader.Read(length) && reader.ReadString(length, text);
+            if (complete) trace.ThreadNames[thread] = std::move(text);
+            break;
+        }
+        case TraceFormat::RecordType::Events:
+        {
+            TraceEvents block;
+            uint8_t clock = 0;
+            uint32_t count = 0;
+            complete = reader.Read(block.Thread) && reader.Read(clock) && reader.Read(count)
+                && reader.ReadEvents(count, block.Events);
+            block.Clock = (TraceFormat::EventClock)clock;
+            if (complete) trace.Blocks.push_back(std::move(block));
+            break;
+        }
+        case TraceFormat::RecordType::Dropped:
+        {
+            uint32_t thread = 0, count = 0;
+            complete = reader.Read(thread) && reader.Read(count);
+            if (complete) trace.Dropped[thread] += count;
+            break;
+        }
+        case TraceFormat::RecordType::Frame:
+        {
+            TraceFormat::FrameMarker frame;
+            complete = reader.Read(frame);
+            if (complete) trace.Frames.push_back(frame);
+            break;
+        }
+        case TraceFormat::RecordType::LogLine:
+        {
+            TraceText line;
+            uint32_t length = 0;
+            complete = reader.Read(line.Time) && reader.Read(line.Level) && reader.Read(length)
+                && reader.ReadString(length, line.Text);
+            if (complete) trace.LogLines.push_back(std::move(line));
+            break;
+        }
+        case TraceFormat::RecordType::Annotation:
+        {
+            TraceText annotation;
+            uint32_t length = 0;
+            annotation.Level = 0;
+            complete = reader.Read(annotation.Time) && reader.Read(length)
+                && reader.ReadString(length, annotation.Text);
+            if (complete) trace.Annotations.push_back(std::move(annotation));
+            break;
+        }
+        default:
+            std::fprintf(stderr, "unknown record type %u, stopping\n", type);
+            return true;
+        }
+
+        if (!complete)
+        {
+            std::fprintf(stderr, "trace ends in a partial record, it was not closed\n");
+            return true;
+        }
+    }
+    return true;
+}
+
+static void WriteJsonString(std::ofstream& out, const std::string& text)
+{
+    out << '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if ((unsigned char)c < 0x20) out << ' ';
+        else out << c;
+    }
+    out << '"';
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <input.ftrace> [output.json]\n", argv[0]);
+        return 1;
+    }
+
+    std::string inputPath = argv[1];
+    std::string outputPath = argc > 2 ? argv[2] : inputPath + ".json";
+
+    std::ifstream input(inputPath, std::ios::binary);
+    if (!input)
+    {
+        std::fprintf(stderr, "could not open '%s'\n", inputPath.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)),
+                              std::istreambuf_iterator<char>());
+
+    Trace trace;
+    if (!ParseTrace(data, trace)) return 1;
+    if (trace.Clocks.empty())
+    {
+        std::fprintf(stderr, "trace has no clock samples\n");
+        return 1;
+    }
+
+    // Tick rate from the first and last sample, 1 ns per tick when the
+    // profiler clock was the steady clock itself or the session was empty
+    const TraceFormat::ClockSample& first = trace.Clocks.front();
+    const TraceFormat::ClockSample& last = trace.Clocks.back();
+    double nsPerTick = 1.0;
+    if (last.Ticks > first.Ticks && last.SteadyNanoseconds > first.SteadyNanoseconds)
+        nsPerTick = (double)(last.SteadyNanoseconds - first.SteadyNanoseconds)
+            / (double)(last.Ticks - first.Ticks);
+
+    std::ofstream out(outputPath);
+    if (!out)
+    {
+        std::fprintf(stderr, "could not create '%s'\n", outputPath.c_str());
+        return 1;
+    }
+
+    char number[64];
+    out << "{\"otherData\":{},\"traceEvents\":[";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":";
+    WriteJsonString(out, trace.SessionName);
+    out << "}}";
+    for (const auto& [thread, name] : trace.ThreadNames)
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+            << ",\"args\":{\"name\":";
+        WriteJsonString(out, name);
+        out << "}}";
+    }
+
+    if (!trace.Frames.empty())
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << FramesTrack
+            << ",\"args\":{\"name\":\"Frames\"}}";
+    if (!trace.LogLines.empty())
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << LogTrack
+            << ",\"args\":{\"name\":\"Log\"}}";
+
+    auto steadyToUs = [&](uint64_t steady) {
+        return ((double)steady - (double)first.SteadyNanoseconds) / 1000.0;
+    };
+
+    size_t eventCount = 0;
+    for (const TraceFormat::FrameMarker& frame : trace.Frames)
+    {
+        std::string name = (frame.Hitch ? "Hitch " : "Frame ") + std::to_string(frame.Index);
+        out << ",\n{\"cat\":\"frame\",\"name\":";
+        WriteJsonString(out, name);
+        std::snprintf(number, sizeof(number), "%.3f", steadyToUs(frame.Begin));
+        out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << FramesTrack << ",\"ts\":" << number;
+        std::snprintf(number, sizeof(number), "%.3f", (double)(frame.End - frame.Begin) / 1000.0);
+        out << ",\"dur\":" << number << "}";
+        eventCount++;
+    }
+    for (const TraceText& line : trace.LogLines)
+    {
+        out << ",\n{\"cat\":\"log\",\"name\":";
+        WriteJsonString(out, line.Text);
+        std::snprintf(number, sizeof(number), "%.3f", steadyToUs(line.Time));
+        out << ",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << LogTrack << ",\"ts\":" << number
+            << ",\"args\":{\"level\":\""
+            << (line.Level < std::size(LogLevelNames) ? LogLevelNames[line.Level] : "off") << "\"}}";
+        eventCount++;
+    }
+    for (const TraceText& annotation : trace.Annotations)
+    {
+        out << ",\n{\"cat\":\"capture\",\"name\":";
+        WriteJsonString(out, annotation.Text);
+        std::snprintf(number, sizeof(number), "%.3f", steadyToUs(annotation.Time));
+        out << ",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" << number << "}";
+        std::printf("annotation: %s\n", annotation.Text.c_str());
+        eventCount++;
+    }
+
+    for (const TraceEvents& block : trace.Blocks)
+    {
+        bool steady = block.Clock == TraceFormat::EventClock::SteadyNanoseconds;
+        for (const TraceFormat::Event& event : block.Events)
+        {
+            double beginUs, durationUs;
+            if (steady)
+            {
+                beginUs = steadyToUs(event.Begin);
+                durationUs = (double)(event.End - event.Begin) / 1000.0;
+            }
+            else
+            {
+                beginUs = (double)(event.Begin - first.Ticks) * nsPerTick / 1000.0;
+                durationUs = (double)(event.End - event.Begin) * nsPerTick / 1000.0;
+            }
+
+            auto name = trace.Strings.find(event.Name);
+            const std::string& text = name != trace.Strings.end() ? name->second : UnknownName;
+            // Contended ForgeMutex waits get their own category to filter on
+            const char* category = steady ? "\"gpu\""
+                : text.rfind(LockWaitPrefix, 0) == 0 ? "\"lock\"" : "\"function\"";
+            out << ",\n{\"cat\":" << category << ",\"name\":";
+            WriteJsonString(out, text);
+            std::snprintf(number, sizeof(number), "%.3f", beginUs);
+            out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << block.Thread << ",\"ts\":" << number;
+            std::snprintf(number, sizeof(number), "%.3f", durationUs);
+            out << ",\"dur\":" << number << "}";
+            eventCount++;
+        }
+    }
+    out << "]}\n";
+
+    std::printf("%s: %zu events on %zu threads -> %s\n", trace.SessionName.c_str(), eventCount,
+                trace.ThreadNames.size(), outputPath.c_str());
+    for (const auto& [thread, count] : trace.Dropped)
+    {
+        auto name = trace.ThreadNames.find(thread);
+        std::printf("warning: %u events dropped on %s, its buffer was full\n", count,
+                    name != trace.ThreadNames.end() ? name->second.c_str() : "unknown thread");
+    }
+    return 0;
+}